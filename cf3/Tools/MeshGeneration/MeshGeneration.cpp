@@ -47,7 +47,7 @@ void build_serial_gids(Mesh& mesh)
 {
   const Uint nb_nodes = mesh.geometry_fields().size();
 
-  List<Uint>& gids = mesh.geometry_fields().glb_idx(); gids.resize(nb_nodes);
+  List<Gid>& gids = mesh.geometry_fields().glb_idx(); gids.resize(nb_nodes);
   List<Uint>& ranks = mesh.geometry_fields().rank(); ranks.resize(nb_nodes);
   for(Uint i = 0; i != nb_nodes; ++i)
   {
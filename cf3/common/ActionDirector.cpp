@@ -6,6 +6,7 @@
 
 #include "common/BasicExceptions.hpp"
 #include "common/Builder.hpp"
+#include "common/Instrumentation.hpp"
 #include "common/ComponentIterator.hpp"
 #include "common/Log.hpp"
 #include "common/OptionArray.hpp"
@@ -48,6 +49,7 @@ void ActionDirector::execute()
     if(!disabled)
     {
       CFdebug << name() << ": Executing action " << action->uri().path() << CFendl;
+      ScopedRegion region(action->name());
       action->execute();
     }
     else
@@ -0,0 +1,115 @@
+// Copyright (C) 2010-2013 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef cf3_common_AlignedAllocator_hpp
+#define cf3_common_AlignedAllocator_hpp
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <new>
+
+#include "common/Assertions.hpp"
+#include "common/CF.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace cf3 {
+namespace common {
+
+////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Standard conforming allocator that aligns its memory to a boundary chosen at run time
+///
+/// With the default alignment of 0 the memory is obtained from operator new, as with
+/// std::allocator. A non-zero alignment must be a power of two, and makes the allocated
+/// block start at a multiple of that number of bytes. Tables use this for fields that
+/// request padded rows, so vectorized kernels can use aligned loads on every row.
+template<typename T>
+class AlignedAllocator
+{
+public:
+  typedef T value_type;
+  typedef T* pointer;
+  typedef const T* const_pointer;
+  typedef T& reference;
+  typedef const T& const_reference;
+  typedef std::size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+
+  template<typename U>
+  struct rebind
+  {
+    typedef AlignedAllocator<U> other;
+  };
+
+  /// @param alignment Alignment in bytes, 0 for the default alignment of operator new
+  explicit AlignedAllocator(const std::size_t alignment = 0) : m_alignment(alignment)
+  {
+    cf3_assert((alignment & (alignment - 1)) == 0);
+  }
+
+  template<typename U>
+  AlignedAllocator(const AlignedAllocator<U>& other) : m_alignment(other.alignment()) {}
+
+  /// Alignment in bytes, 0 if the allocator uses operator new
+  std::size_t alignment() const { return m_alignment; }
+
+  pointer address(reference x) const { return &x; }
+  const_pointer address(const_reference x) const { return &x; }
+
+  size_type max_size() const { return (std::numeric_limits<size_type>::max() - m_alignment - sizeof(void*)) / sizeof(T); }
+
+  /// Allocate memory for n objects. For aligned blocks, the pointer returned by malloc is stored just before the block
+  pointer allocate(size_type n, const void* = 0)
+  {
+    if(n > max_size())
+      throw std::bad_alloc();
+    if(m_alignment == 0)
+      return static_cast<pointer>(::operator new(n*sizeof(T)));
+    void* raw = std::malloc(n*sizeof(T) + m_alignment + sizeof(void*));
+    if(raw == 0)
+      throw std::bad_alloc();
+    const std::size_t start = reinterpret_cast<std::size_t>(raw) + sizeof(void*);
+    void* aligned = reinterpret_cast<void*>((start + m_alignment - 1) & ~(m_alignment - 1));
+    reinterpret_cast<void**>(aligned)[-1] = raw;
+    return static_cast<pointer>(aligned);
+  }
+
+  void deallocate(pointer p, size_type)
+  {
+    if(p == 0)
+      return;
+    if(m_alignment == 0)
+      ::operator delete(p);
+    else
+      std::free(reinterpret_cast<void**>(p)[-1]);
+  }
+
+  void construct(pointer p, const T& val) { new(static_cast<void*>(p)) T(val); }
+  void destroy(pointer p) { p->~T(); }
+
+private:
+  std::size_t m_alignment;
+};
+
+/// Memory can only be freed by an allocator with the same alignment
+template<typename T, typename U>
+inline bool operator==(const AlignedAllocator<T>& a, const AlignedAllocator<U>& b) { return a.alignment() == b.alignment(); }
+
+template<typename T, typename U>
+inline bool operator!=(const AlignedAllocator<T>& a, const AlignedAllocator<U>& b) { return !(a == b); }
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // common
+} // cf3
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // cf3_common_AlignedAllocator_hpp
@@ -14,6 +14,7 @@
 #include <boost/foreach.hpp>
 
 #include "common/BoostArray.hpp"
+#include "common/Table_fwd.hpp"
 #include "common/BasicExceptions.hpp"
 #include "common/StringConversion.hpp"
 
@@ -46,7 +47,7 @@ class ArrayBufferT
 
 public: // typedef
 
-  typedef boost::multi_array<T,2> Array_t;
+  typedef typename TableArray<T>::type Array_t;
   typedef T value_type;
 
   typedef boost::detail::multi_array::sub_array<T,1> SubArray_t;
@@ -78,7 +79,8 @@ public: // functions
   /// Contructor
   /// @param array The table that will be interfaced with
   /// @param nbRows The size the buffer will be allocated with
-  ArrayBufferT (Array_t& array, size_t nbRows);
+  /// @param row_size Number of values in a row, if the rows of the array are padded
+  ArrayBufferT (Array_t& array, size_t nbRows, const Uint row_size = 0);
 
   /// Virtual destructor
   virtual ~ArrayBufferT();
@@ -181,6 +183,9 @@ private: // data
   /// the number of columns of the array
   Uint m_nb_cols;
 
+  /// the number of values in a row, excluding the padding
+  Uint m_row_size;
+
   /// The size newly created buffers will have
   /// @note it is safe to change in the middle of buffer operations
   Uint m_buffersize;
@@ -205,9 +210,10 @@ private: // data
 ////////////////////////////////////////////////////////////////////////////////
 
 template<typename T>
-ArrayBufferT<T>::ArrayBufferT (typename ArrayBufferT<T>::Array_t& array, size_t nbRows) :
+ArrayBufferT<T>::ArrayBufferT (typename ArrayBufferT<T>::Array_t& array, size_t nbRows, const Uint row_size) :
   m_array(array),
   m_nb_cols(m_array.shape()[1]),
+  m_row_size(row_size == 0 ? m_nb_cols : row_size),
   m_buffersize(nbRows)
 {
 }
@@ -401,8 +407,7 @@ inline Uint ArrayBufferT<T>::add_empty_row()
   if (m_new_buffer_rows.empty())
     add_buffer(); // will make a whole lot of new new_buffer_rows
   Uint idx = m_new_buffer_rows.front();
-  std::vector<T> dummy(m_nb_cols);
-  set_row( idx , std::vector<T>(m_nb_cols) );
+  set_row( idx , std::vector<T>(m_row_size) );
   m_new_buffer_rows.pop_front();
   return idx;
 }
@@ -426,7 +431,7 @@ template<typename T>
 template<typename vectorType>
 inline void ArrayBufferT<T>::set_row(const Uint array_idx, const vectorType& row)
 {
-  cf3_assert(row.size() == m_nb_cols);
+  cf3_assert(row.size() == m_row_size);
   Uint cummulative_size = m_array.size();
   if (array_idx < cummulative_size)
   {
@@ -17,6 +17,7 @@
 
 #include <boost/noncopyable.hpp>
 #include <boost/checked_delete.hpp>
+#include <boost/cstdint.hpp>
 
 #include "coolfluid-config.hpp"  // coolfluid system configuration
 
@@ -87,6 +88,15 @@ namespace cf3 {
 /// typedef for unsigned int
 typedef unsigned int Uint;
 
+/// typedef for global indices, numbering entities over all processes.
+/// Local indices and connectivity tables remain Uint, so only the global
+/// numbering grows when CF3_ENABLE_64BIT_GLOBAL_INDICES is set
+#ifdef CF3_ENABLE_64BIT_GLOBAL_INDICES
+typedef boost::uint64_t Gid;
+#else
+typedef Uint Gid;
+#endif
+
 /// Definition of the default precision
 #ifdef CF3_REAL_IS_FLOAT
 typedef float Real;
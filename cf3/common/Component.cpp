@@ -52,11 +52,26 @@ ComponentBuilder < Component, Component, LibCommon > Component_Builder;
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 
+namespace {
+
+/// Revision of the component trees, increased on every change
+Uint& tree_revision()
+{
+  static Uint revision = 0;
+  return revision;
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
 Component::Component ( const std::string& name ) :
     m_name (),
     m_properties(new PropertyList()),
     m_options(new OptionList()),
-    m_parent(0)
+    m_parent(0),
+    m_tree_revision(0),
+    m_subtree_revision(0)
 {
   // accept name
 
@@ -79,6 +94,14 @@ Component::Component ( const std::string& name ) :
       .description("lists the component tree inside this component")
       .pretty_name("List tree");
 
+  regist_signal( "list_tree_changes" )
+      .connect( boost::bind( &Component::signal_list_tree_changes, this, _1 ) )
+      .hidden(true)
+      .read_only(true)
+      .description("lists the components added, removed or changed inside this component since a tree revision")
+      .pretty_name("List tree changes")
+      .signature( boost::bind(&Component::signature_list_tree_changes, this, _1) );
+
   regist_signal( "list_tree_recursive" )
       .connect( boost::bind( &Component::signal_list_tree_recursive, this, _1 ) )
       .hidden(true)
@@ -235,6 +258,8 @@ void Component::rename ( const std::string& name )
   }
 
   m_name = name;
+
+  mark_tree_changed(true);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////
@@ -301,6 +326,7 @@ Component& Component::add_component ( const boost::shared_ptr<Component>& subcom
 
   subcomp->m_parent = this;
 
+  subcomp->mark_tree_changed(true);
   raise_tree_updated_event();
 
   return *subcomp;
@@ -378,6 +404,7 @@ boost::shared_ptr<Component> Component::remove_component ( const std::string& na
     }
     m_components = new_storage;
 
+    mark_tree_changed(false);
     raise_tree_updated_event();
 
     return comp;                                   // return it to client
@@ -727,6 +754,32 @@ void Component::signal_list_tree( SignalArgs& args ) const
   SignalFrame reply = args.create_reply( uri() );
 
   write_xml_tree(reply.main_map.content, false);
+  reply.main_map.content.set_attribute( "revision", to_str(tree_revision()) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Component::signal_list_tree_changes( SignalArgs& args ) const
+{
+  SignalOptions options( args );
+  const Uint since = options.value<Uint>("revision");
+
+  SignalFrame reply = args.create_reply( uri() );
+
+  // nothing is written if the tree did not change
+  if( m_subtree_revision > since )
+    write_xml_tree_changes(reply.main_map.content, since);
+  reply.main_map.content.set_attribute( "revision", to_str(tree_revision()) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Component::signature_list_tree_changes( SignalArgs& args ) const
+{
+  SignalOptions options( args );
+
+  options.add("revision", 0u )
+      .description("Tree revision from which changes are listed, as given by the last listing");
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////
@@ -1025,6 +1078,54 @@ void Component::signal_signature( SignalArgs & args )
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 
+void Component::write_xml_tree_changes( XmlNode& node, const Uint since ) const
+{
+  cf3_assert( node.is_valid() );
+
+  // added, renamed... entries are written in full
+  if( m_tree_revision > since )
+  {
+    write_xml_tree( node, false );
+    return;
+  }
+
+  const std::string type_name = derived_type_name();
+  if( type_name.empty() )
+    return;
+
+  XmlNode this_node = node.add_node( "node" );
+  this_node.set_attribute( "name", name() );
+  this_node.set_attribute( "atype", type_name );
+
+  if( m_subtree_revision <= since )
+  {
+    this_node.set_attribute( "unchanged", to_str(true) );
+    return;
+  }
+
+  // the children are all listed, so that removed ones can be found
+  this_node.set_attribute( "partial", to_str(true) );
+  boost_foreach( const Component& c, *this )
+  {
+    c.write_xml_tree_changes( this_node, since );
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Component::mark_tree_changed( const bool entry_changed )
+{
+  const Uint revision = ++tree_revision();
+
+  if( entry_changed )
+    m_tree_revision = revision;
+
+  for( Component* comp = this ; is_not_null(comp) ; comp = comp->m_parent )
+    comp->m_subtree_revision = revision;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
 void Component::raise_tree_updated_event ()
 {
   SignalFrame frame ( "tree_updated", uri(), uri() );
@@ -1036,6 +1137,7 @@ void Component::raise_tree_updated_event ()
 Component& Component::mark_basic()
 {
   add_tag("basic");
+  mark_tree_changed(true);
   raise_tree_updated_event();
   return *this;
 }
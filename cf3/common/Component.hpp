@@ -313,6 +313,13 @@ public: // functions
   /// lists the sub components and puts them on the xml_tree
   void signal_list_tree( SignalArgs& args ) const;
 
+  /// lists the sub components added, removed or changed since a tree revision
+  /// and puts them on the xml_tree
+  void signal_list_tree_changes( SignalArgs& args ) const;
+
+  /// signature to signal_list_tree_changes
+  void signature_list_tree_changes( SignalArgs& args ) const;
+
   ///  prints tree recursively
   void signal_list_tree_recursive ( SignalArgs& args) const;
 
@@ -398,6 +405,12 @@ protected: // functions
   /// Add a static (sub)component of this component
   Component& add_static_component ( const boost::shared_ptr<Component>& subcomp );
 
+  /// records a change in the tree at this component, by increasing the tree
+  /// revision and updating the revisions of this component and its parents
+  /// @param entry_changed If @c true, the entry of this component itself
+  /// changed (added, renamed, marked...). If @c false, only its subtree changed.
+  void mark_tree_changed( const bool entry_changed );
+
 private: // helper functions
 
   /// Modify the parent of this component
@@ -412,6 +425,14 @@ private: // helper functions
   /// in the node.
   void write_xml_tree( XML::XmlNode& node, bool put_all_content ) const;
 
+  /// writes the part of the underlying component tree that changed since the
+  /// given tree revision to the xml node. Unchanged subtrees are written as
+  /// nodes with the "unchanged" attribute, subtrees with changes deeper
+  /// down as nodes with the "partial" attribute, and other subtrees in full.
+  /// @param node  xml node to write
+  /// @param since tree revision from which changes are written
+  void write_xml_tree_changes( XML::XmlNode& node, const Uint since ) const;
+
   /// Triggered when the "ping" event is raised. Useful to find out what components still exist
   void on_ping_event( SignalArgs& args );
 
@@ -429,6 +450,10 @@ private: // data
   CompLookupT m_component_lookup;
   /// pointer to parent, naked pointer because of static components
   Component* m_parent;
+  /// tree revision of the last change of this component entry
+  Uint m_tree_revision;
+  /// tree revision of the last change in the subtree of this component
+  Uint m_subtree_revision;
 
 protected: // functions
 
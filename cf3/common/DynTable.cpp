@@ -17,6 +17,10 @@ common::ComponentBuilder < DynTable<bool>, Component, LibCommon > DynTable_bool_
 
 common::ComponentBuilder < DynTable<Uint>, Component, LibCommon > DynTable_Uint_Builder;
 
+#ifdef CF3_ENABLE_64BIT_GLOBAL_INDICES
+common::ComponentBuilder < DynTable<Gid>, Component, LibCommon > DynTable_Gid_Builder;
+#endif
+
 common::ComponentBuilder < DynTable<int>, Component, LibCommon >  DynTable_int_Builder;
 
 common::ComponentBuilder < DynTable<Real>, Component, LibCommon > DynTable_Real_Builder;
@@ -37,6 +41,14 @@ std::ostream& operator<<(std::ostream& os, DynTable<Uint>::ConstRow row)
   return os;
 }
 
+#ifdef CF3_ENABLE_64BIT_GLOBAL_INDICES
+std::ostream& operator<<(std::ostream& os, DynTable<Gid>::ConstRow row)
+{
+  print_vector(os, row);
+  return os;
+}
+#endif
+
 std::ostream& operator<<(std::ostream& os, DynTable<int>::ConstRow row)
 {
   print_vector(os, row);
@@ -99,6 +111,29 @@ std::ostream& operator<<(std::ostream& os, const DynTable<Uint>& table)
   return os;
 }
 
+#ifdef CF3_ENABLE_64BIT_GLOBAL_INDICES
+std::ostream& operator<<(std::ostream& os, const DynTable<Gid>& table)
+{
+  if (table.size())
+    os << "\n";
+  Uint i=0;
+  boost_foreach(DynTable<Gid>::ConstRow row, table.array())
+  {
+    os << "  " << i << ":  ";
+    if (row.size() == 0)
+      os << "~";
+    else
+    {
+      boost_foreach(const Gid entry, row)
+        os << entry << " ";
+    }
+    os << "\n";
+    ++i;
+  }
+  return os;
+}
+#endif
+
 std::ostream& operator<<(std::ostream& os, const DynTable<int>& table)
 {
   if (table.size())
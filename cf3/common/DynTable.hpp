@@ -116,12 +116,18 @@ private: // data
 
 std::ostream& operator<<(std::ostream& os, DynTable<bool>::ConstRow row);
 std::ostream& operator<<(std::ostream& os, DynTable<Uint>::ConstRow row);
+#ifdef CF3_ENABLE_64BIT_GLOBAL_INDICES
+std::ostream& operator<<(std::ostream& os, DynTable<Gid>::ConstRow row);
+#endif
 std::ostream& operator<<(std::ostream& os, DynTable<int>::ConstRow row);
 std::ostream& operator<<(std::ostream& os, DynTable<Real>::ConstRow row);
 std::ostream& operator<<(std::ostream& os, DynTable<std::string>::ConstRow row);
 
 std::ostream& operator<<(std::ostream& os, const DynTable<bool>& table);
 std::ostream& operator<<(std::ostream& os, const DynTable<Uint>& table);
+#ifdef CF3_ENABLE_64BIT_GLOBAL_INDICES
+std::ostream& operator<<(std::ostream& os, const DynTable<Gid>& table);
+#endif
 std::ostream& operator<<(std::ostream& os, const DynTable<int>& table);
 std::ostream& operator<<(std::ostream& os, const DynTable<Real>& table);
 std::ostream& operator<<(std::ostream& os, const DynTable<std::string>& table);
@@ -4,14 +4,19 @@
 // GNU Lesser General Public License version 3 (LGPLv3).
 // See doc/lgpl.txt and doc/gpl.txt for the license text.
 
+#include <sstream>
+
 #include "common/Signal.hpp"
 #include "common/OptionT.hpp"
+#include "common/OptionURI.hpp"
 #include "common/Builder.hpp"
 #include "common/LibCommon.hpp"
 #include "common/LogLevel.hpp"
 #include "common/Log.hpp"
 #include "common/Environment.hpp"
+#include "common/Instrumentation.hpp"
 #include "common/PropertyList.hpp"
+#include "common/XML/SignalOptions.hpp"
 
 namespace cf3 {
 namespace common {
@@ -104,7 +109,29 @@ Environment::Environment ( const std::string& name) : Component ( name )
 
   trigger_log_level();
 
+  options().add("instrumentation", Instrumentation::instance().enabled())
+      .pretty_name("Instrumentation")
+      .description("If true, actions are instrumented with timers and counters, see the signal print_instrumentation_report")
+      .mark_basic()
+      .attach_trigger(boost::bind(&Environment::trigger_instrumentation,this));
+
+  options().add("instrumentation_timeline", Instrumentation::instance().timeline_enabled())
+      .pretty_name("Instrumentation Timeline")
+      .description("If true, every instrumented region is recorded, see the signal write_instrumentation_timeline")
+      .attach_trigger(boost::bind(&Environment::trigger_instrumentation,this));
+
   // signals
+  regist_signal( "print_instrumentation_report" )
+      .connect( boost::bind( &Environment::signal_print_instrumentation_report, this, _1 ) )
+      .description("Print min/avg/max over all ranks of the instrumented timers and counters")
+      .pretty_name("Print Instrumentation Report");
+
+  regist_signal( "write_instrumentation_timeline" )
+      .connect( boost::bind( &Environment::signal_write_instrumentation_timeline, this, _1 ) )
+      .description("Write the recorded instrumentation timeline of every rank in the Chrome trace format")
+      .pretty_name("Write Instrumentation Timeline")
+      .signature( boost::bind( &Environment::signature_write_instrumentation_timeline, this, _1 ) );
+
   signal("create_component")->hidden(true);
   signal("rename_component")->hidden(true);
   signal("delete_component")->hidden(true);
@@ -180,5 +207,41 @@ void Environment::trigger_log_level()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void Environment::trigger_instrumentation()
+{
+  Instrumentation::instance().enable(options().value<bool>("instrumentation"));
+  Instrumentation::instance().enable_timeline(options().value<bool>("instrumentation_timeline"));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Environment::signal_print_instrumentation_report(SignalArgs& args)
+{
+  // Collective, the report is only written on rank 0
+  std::stringstream report;
+  Instrumentation::instance().print_report(report);
+  if(!report.str().empty())
+    CFinfo << report.str() << CFflush;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Environment::signature_write_instrumentation_timeline(SignalArgs& args)
+{
+  XML::SignalOptions opts(args);
+  opts.add("file", URI("timeline.json"))
+      .description("Output file, in parallel the rank is appended to the file name");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Environment::signal_write_instrumentation_timeline(SignalArgs& args)
+{
+  XML::SignalOptions opts(args);
+  Instrumentation::instance().write_timeline(opts.option("file").value<URI>());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 } // common
 } // cf3
@@ -33,6 +33,13 @@ public: // functions
   /// Get the class name
   static std::string type_name () { return "Environment"; }
 
+  /// @name SIGNALS
+  //@{
+  void signal_print_instrumentation_report( SignalArgs& args );
+  void signature_write_instrumentation_timeline( SignalArgs& args );
+  void signal_write_instrumentation_timeline( SignalArgs& args );
+  //@}
+
 private: // functions
 
   void trigger_only_cpu0_writes();
@@ -51,6 +58,8 @@ private: // functions
 
   void trigger_log_level();
 
+  void trigger_instrumentation();
+
 }; // Environment
 
 ////////////////////////////////////////////////////////////////////////////////
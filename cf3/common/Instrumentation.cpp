@@ -0,0 +1,357 @@
+// Copyright (C) 2010-2013 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <set>
+
+#include <boost/filesystem/path.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/thread/locks.hpp>
+
+#include "common/Assertions.hpp"
+#include "common/BasicExceptions.hpp"
+#include "common/Foreach.hpp"
+#include "common/Instrumentation.hpp"
+#include "common/URI.hpp"
+
+#include "common/PE/Comm.hpp"
+
+namespace cf3 {
+namespace common {
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace detail
+{
+  /// Name under which metrics outside of any region are accumulated
+  const std::string root_region("<root>");
+
+  /// Separates the region path from the metric name in the reduced keys
+  const char metric_separator = '|';
+
+  /// Orders region paths depth-first, so children follow their parent directly
+  struct PathLess
+  {
+    bool operator()(const std::string& a, const std::string& b) const
+    {
+      const Uint n = std::min(a.size(), b.size());
+      for(Uint i = 0; i != n; ++i)
+      {
+        if(a[i] == b[i])
+          continue;
+        if(a[i] == '/')
+          return true;
+        if(b[i] == '/')
+          return false;
+        return a[i] < b[i];
+      }
+      return a.size() < b.size();
+    }
+  };
+
+  std::string json_escape(const std::string& str)
+  {
+    std::string result;
+    result.reserve(str.size());
+    boost_foreach(const char c, str)
+    {
+      if(c == '"' || c == '\\')
+        result.push_back('\\');
+      result.push_back(c);
+    }
+    return result;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Instrumentation& Instrumentation::instance()
+{
+  static Instrumentation instrumentation;
+  return instrumentation;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Instrumentation::Instrumentation() :
+  m_enabled(false),
+  m_timeline_enabled(false),
+  m_thread_data(&Instrumentation::no_cleanup)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Instrumentation::ThreadData& Instrumentation::thread_data()
+{
+  ThreadData* data = m_thread_data.get();
+  if(!data)
+  {
+    boost::lock_guard<boost::mutex> lock(m_mutex);
+    m_all_thread_data.push_back(boost::shared_ptr<ThreadData>(new ThreadData(m_all_thread_data.size())));
+    data = m_all_thread_data.back().get();
+    m_thread_data.reset(data);
+  }
+  return *data;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Instrumentation::begin_region(const std::string& name)
+{
+  ThreadData& data = thread_data();
+  data.stack.push_back(data.stack.empty() ? name : data.stack.back() + "/" + name);
+  data.open_regions.push_back(&data.regions[data.stack.back()]);
+  data.begin_times.push_back(m_timer.elapsed());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Instrumentation::end_region()
+{
+  ThreadData& data = thread_data();
+  cf3_assert(!data.stack.empty());
+
+  const Real begin = data.begin_times.back();
+  const Real duration = m_timer.elapsed() - begin;
+
+  RegionData& region = *data.open_regions.back();
+  ++region.calls;
+  region.time += duration;
+
+  if(m_timeline_enabled)
+  {
+    const std::string& path = data.stack.back();
+    Event event;
+    event.name = path.substr(path.find_last_of('/') + 1);
+    event.begin = begin;
+    event.duration = duration;
+    data.events.push_back(event);
+  }
+
+  data.stack.pop_back();
+  data.open_regions.pop_back();
+  data.begin_times.pop_back();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Instrumentation::RegionData& Instrumentation::current_region(ThreadData& data)
+{
+  if(!data.open_regions.empty())
+    return *data.open_regions.back();
+  if(!data.root)
+    data.root = &data.regions[detail::root_region];
+  return *data.root;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Instrumentation::accumulate(const std::string& name, const Real value)
+{
+  current_region(thread_data()).metrics[name] += value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Instrumentation::accumulate(const Uint id, const Real value)
+{
+  RegionData& region = current_region(thread_data());
+  if(id >= region.counters.size())
+  {
+    region.counters.resize(id+1, 0.);
+    region.counter_added.resize(id+1, false);
+  }
+  region.counters[id] += value;
+  region.counter_added[id] = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Uint Instrumentation::counter_id(const std::string& name)
+{
+  boost::lock_guard<boost::mutex> lock(m_mutex);
+  std::map<std::string,Uint>::const_iterator found = m_counter_ids.find(name);
+  if(found != m_counter_ids.end())
+    return found->second;
+  const Uint id = m_counter_names.size();
+  m_counter_ids[name] = id;
+  m_counter_names.push_back(name);
+  return id;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Instrumentation::reset()
+{
+  boost::lock_guard<boost::mutex> lock(m_mutex);
+  boost_foreach(const boost::shared_ptr<ThreadData>& data, m_all_thread_data)
+  {
+    cf3_assert(data->stack.empty());
+    data->regions.clear();
+    data->root = 0;
+    data->events.clear();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+std::map<std::string,Real> Instrumentation::merged_metrics()
+{
+  std::map<std::string,Real> result;
+  boost::lock_guard<boost::mutex> lock(m_mutex);
+  boost_foreach(const boost::shared_ptr<ThreadData>& data, m_all_thread_data)
+  {
+    for(std::map<std::string,RegionData>::const_iterator region = data->regions.begin(); region != data->regions.end(); ++region)
+    {
+      const std::string prefix = region->first + detail::metric_separator;
+      if(region->second.calls)
+      {
+        result[prefix + "calls"] += region->second.calls;
+        result[prefix + "time [s]"] += region->second.time;
+      }
+      for(std::map<std::string,Real>::const_iterator metric = region->second.metrics.begin(); metric != region->second.metrics.end(); ++metric)
+        result[prefix + metric->first] += metric->second;
+      for(Uint id = 0; id != region->second.counters.size(); ++id)
+      {
+        if(region->second.counter_added[id])
+          result[prefix + m_counter_names[id]] += region->second.counters[id];
+      }
+    }
+  }
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Instrumentation::print_report(std::ostream& out)
+{
+  const std::map<std::string,Real> local_metrics = merged_metrics();
+
+  // Union of the keys of all ranks, ordered by region path
+  typedef std::map< std::string, std::set<std::string>, detail::PathLess > RegionsT;
+  RegionsT regions;
+  std::vector<std::string> keys;
+  for(std::map<std::string,Real>::const_iterator it = local_metrics.begin(); it != local_metrics.end(); ++it)
+    keys.push_back(it->first);
+
+  const bool parallel = PE::Comm::instance().is_active() && PE::Comm::instance().size() > 1;
+  const Uint nb_ranks = parallel ? PE::Comm::instance().size() : 1;
+  if(parallel)
+  {
+    std::vector<char> send_keys(1, '\n');
+    boost_foreach(const std::string& key, keys)
+    {
+      send_keys.insert(send_keys.end(), key.begin(), key.end());
+      send_keys.push_back('\n');
+    }
+    std::vector< std::vector<char> > recv_keys;
+    PE::Comm::instance().all_gather(send_keys, recv_keys);
+    keys.clear();
+    boost_foreach(const std::vector<char>& rank_keys, recv_keys)
+    {
+      std::vector<char>::const_iterator begin = rank_keys.begin();
+      while(begin != rank_keys.end())
+      {
+        std::vector<char>::const_iterator end = std::find(begin, rank_keys.end(), '\n');
+        if(end != begin)
+          keys.push_back(std::string(begin, end));
+        begin = end == rank_keys.end() ? end : end + 1;
+      }
+    }
+  }
+
+  boost_foreach(const std::string& key, keys)
+  {
+    const std::size_t separator = key.find_last_of(detail::metric_separator);
+    regions[key.substr(0, separator)].insert(key.substr(separator + 1));
+  }
+
+  // Pack the values in the global key order, and reduce them in one go per operation
+  std::vector<Real> values;
+  for(RegionsT::const_iterator region = regions.begin(); region != regions.end(); ++region)
+  {
+    boost_foreach(const std::string& metric, region->second)
+    {
+      std::map<std::string,Real>::const_iterator found = local_metrics.find(region->first + detail::metric_separator + metric);
+      values.push_back(found == local_metrics.end() ? 0. : found->second);
+    }
+  }
+
+  std::vector<Real> min_values(values), max_values(values), sum_values(values);
+  if(parallel && !values.empty())
+  {
+    PE::Comm::instance().all_reduce(PE::min(),  &values[0], values.size(), &min_values[0]);
+    PE::Comm::instance().all_reduce(PE::max(),  &values[0], values.size(), &max_values[0]);
+    PE::Comm::instance().all_reduce(PE::plus(), &values[0], values.size(), &sum_values[0]);
+  }
+
+  if(parallel && PE::Comm::instance().rank() != 0)
+    return;
+
+  out << "Instrumentation report over " << nb_ranks << " rank(s)\n";
+  out << std::setw(50) << std::left << "region / metric"
+      << std::setw(16) << std::right << "min"
+      << std::setw(16) << std::right << "avg"
+      << std::setw(16) << std::right << "max" << "\n";
+
+  Uint idx = 0;
+  for(RegionsT::const_iterator region = regions.begin(); region != regions.end(); ++region)
+  {
+    out << region->first << "\n";
+    boost_foreach(const std::string& metric, region->second)
+    {
+      out << "    " << std::setw(46) << std::left << metric
+          << std::setw(16) << std::right << min_values[idx]
+          << std::setw(16) << std::right << sum_values[idx] / static_cast<Real>(nb_ranks)
+          << std::setw(16) << std::right << max_values[idx] << "\n";
+      ++idx;
+    }
+  }
+  out << std::flush;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void Instrumentation::write_timeline(const URI& file)
+{
+  boost::filesystem::path path(file.path());
+  const Uint rank = PE::Comm::instance().is_active() ? PE::Comm::instance().rank() : 0;
+  if(PE::Comm::instance().is_active() && PE::Comm::instance().size() > 1)
+  {
+    const std::string filename = path.stem().string() + "-P" + boost::lexical_cast<std::string>(rank) + path.extension().string();
+    path = path.parent_path() / filename;
+  }
+
+  std::ofstream out(path.string().c_str());
+  if(!out)
+    throw FileSystemError(FromHere(), "Could not open file " + path.string() + " for writing the instrumentation timeline");
+
+  out << "{\"traceEvents\":[";
+  bool first = true;
+  boost::lock_guard<boost::mutex> lock(m_mutex);
+  boost_foreach(const boost::shared_ptr<ThreadData>& data, m_all_thread_data)
+  {
+    boost_foreach(const Event& event, data->events)
+    {
+      out << (first ? "\n" : ",\n")
+          << "{\"name\":\"" << detail::json_escape(event.name) << "\",\"cat\":\"cf3\",\"ph\":\"X\""
+          << ",\"ts\":" << std::fixed << std::setprecision(3) << event.begin*1e6
+          << ",\"dur\":" << event.duration*1e6
+          << ",\"pid\":" << rank << ",\"tid\":" << data->thread_id << "}";
+      first = false;
+    }
+  }
+  out << "\n]}\n";
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // common
+} // cf3
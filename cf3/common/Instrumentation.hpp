@@ -0,0 +1,231 @@
+// Copyright (C) 2010-2013 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef cf3_common_Instrumentation_hpp
+#define cf3_common_Instrumentation_hpp
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/tss.hpp>
+
+#include "common/CF.hpp"
+#include "common/Timer.hpp"
+
+namespace cf3 {
+namespace common {
+
+class URI;
+
+////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Low-overhead hierarchical timers and counters
+///
+/// Code is instrumented by opening named regions, using ScopedRegion. Regions
+/// nest, so the path of a region is the path of its enclosing regions, followed
+/// by its own name, e.g. "time_stepping/step/compute_rhs".
+/// Inside a region, counters (e.g. "elements_looped", "bytes_synchronized") and
+/// timers (e.g. "mpi_wait", using ScopedTimer) are accumulated.
+///
+/// Every thread accumulates in its own data, so no locking happens while instrumenting.
+/// The instrumentation is disabled by default, in which case all calls return immediately.
+/// print_report() reduces all regions over the ranks and prints min/avg/max of every
+/// metric, and write_timeline() writes every region execution as an event in the
+/// Chrome trace format (chrome://tracing), if the timeline was enabled.
+///
+/// The instrumentation is controlled through the Environment options
+/// "instrumentation" and "instrumentation_timeline".
+class Common_API Instrumentation : public boost::noncopyable
+{
+public:
+
+  /// Gets the instance of the instrumentation
+  static Instrumentation& instance();
+
+  /// @brief Enable or disable the instrumentation
+  void enable(const bool enabled = true) { m_enabled = enabled; }
+
+  /// @brief Enable or disable the recording of the timeline of all regions
+  void enable_timeline(const bool enabled = true) { m_timeline_enabled = enabled; }
+
+  /// @brief True if the instrumentation is enabled
+  bool enabled() const { return m_enabled; }
+
+  /// @brief True if the timeline is recorded
+  bool timeline_enabled() const { return m_timeline_enabled; }
+
+  /// @brief Open a region, nested in the currently open region of this thread
+  void begin_region(const std::string& name);
+
+  /// @brief Close the innermost open region of this thread
+  void end_region();
+
+  /// @brief Identifier of the counter with the given name, created at first use
+  ///
+  /// Counters added through their identifier avoid looking up the name, so they can be
+  /// used in loops, e.g. once per element: obtain the identifier once, outside the loop.
+  Uint counter_id(const std::string& name);
+
+  /// @brief Add value to a counter of the innermost open region of this thread
+  void add_counter(const Uint id, const Real value)
+  {
+    if(m_enabled)
+      accumulate(id, value);
+  }
+
+  /// @brief Add value to a counter of the innermost open region of this thread, looking up its name
+  void add_counter(const char* name, const Real value)
+  {
+    if(m_enabled)
+      accumulate(name, value);
+  }
+
+  /// @brief Add a duration to a timer of the innermost open region of this thread
+  void add_time(const char* name, const Real seconds)
+  {
+    if(m_enabled)
+      accumulate(std::string(name) + " [s]", seconds);
+  }
+
+  /// @brief Clear all accumulated regions, counters and timeline events
+  /// @pre No regions are open
+  void reset();
+
+  /// @brief Print min/avg/max over all ranks of the metrics of every region
+  /// @note Collective, the report is printed on rank 0 only
+  void print_report(std::ostream& out);
+
+  /// @brief Write the recorded timeline of this rank in the Chrome trace format
+  /// @param file  base file name. In parallel, the rank is appended, e.g. "timeline-P1.json"
+  void write_timeline(const URI& file);
+
+  /// @brief Seconds since the creation of the instrumentation
+  Real wall_time() const { return m_timer.elapsed(); }
+
+private:
+
+  Instrumentation();
+
+  /// Accumulated metrics of one region
+  struct RegionData
+  {
+    RegionData() : calls(0), time(0.) {}
+    Uint calls;
+    Real time;
+    std::map<std::string,Real> metrics;
+    std::vector<Real> counters;           ///< counters added through their identifier
+    std::vector<bool> counter_added;      ///< true for the identifiers in counters that were added to
+  };
+
+  /// One execution of a region, for the timeline
+  struct Event
+  {
+    std::string name;
+    Real begin;
+    Real duration;
+  };
+
+  /// Instrumentation data owned by one thread
+  struct ThreadData
+  {
+    ThreadData(const Uint id) : thread_id(id), root(0) {}
+    Uint thread_id;
+    std::vector<std::string> stack;       ///< paths of the open regions
+    std::vector<RegionData*> open_regions; ///< data of the open regions, in the same order as stack
+    std::vector<Real> begin_times;        ///< begin times of the open regions
+    std::map<std::string,RegionData> regions;
+    RegionData* root;                     ///< data for metrics outside of any region, 0 until first used
+    std::vector<Event> events;
+  };
+
+  /// @brief Add value to a metric of the innermost open region of this thread
+  void accumulate(const std::string& name, const Real value);
+
+  /// @brief Add value to a counter of the innermost open region of this thread
+  void accumulate(const Uint id, const Real value);
+
+  /// @brief Data of the innermost open region of the given thread data
+  RegionData& current_region(ThreadData& data);
+
+  /// @brief Data of the calling thread, created at first use
+  ThreadData& thread_data();
+
+  /// @brief Metrics of all threads, with keys "region path|metric"
+  std::map<std::string,Real> merged_metrics();
+
+  static void no_cleanup(ThreadData*) {}
+
+  bool m_enabled;
+  bool m_timeline_enabled;
+  Timer m_timer;
+  boost::thread_specific_ptr<ThreadData> m_thread_data;
+  std::vector< boost::shared_ptr<ThreadData> > m_all_thread_data;  ///< owns the data, also after thread exit
+  std::map<std::string,Uint> m_counter_ids;                        ///< identifier of every counter name
+  std::vector<std::string> m_counter_names;                        ///< name of every counter identifier
+  boost::mutex m_mutex;                                            ///< guards m_all_thread_data and the counter names
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Opens a region in the instrumentation during its lifetime
+class Common_API ScopedRegion : public boost::noncopyable
+{
+public:
+  ScopedRegion(const std::string& name) : m_active(Instrumentation::instance().enabled())
+  {
+    if(m_active)
+      Instrumentation::instance().begin_region(name);
+  }
+
+  ~ScopedRegion()
+  {
+    if(m_active)
+      Instrumentation::instance().end_region();
+  }
+
+private:
+  const bool m_active;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Adds its lifetime to a timer of the innermost open region, e.g. to measure MPI waits
+class Common_API ScopedTimer : public boost::noncopyable
+{
+public:
+  ScopedTimer(const char* name) : m_name(name), m_active(Instrumentation::instance().enabled())
+  {
+    if(m_active)
+      m_begin = Instrumentation::instance().wall_time();
+  }
+
+  ~ScopedTimer()
+  {
+    if(m_active)
+      Instrumentation::instance().add_time(m_name, Instrumentation::instance().wall_time() - m_begin);
+  }
+
+private:
+  const char* m_name;
+  const bool m_active;
+  Real m_begin;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // common
+} // cf3
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // cf3_common_Instrumentation_hpp
@@ -62,6 +62,7 @@ Link& Link::link_to ( Component& lnkto )
     throw SetupError(FromHere(), "Cannot link a Link to another Link");
 
   m_link_component = lnkto.handle();
+  mark_tree_changed(true); // the target is part of the entry of a link
   return *this;
 }
 
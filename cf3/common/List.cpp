@@ -18,6 +18,10 @@ common::ComponentBuilder < List<bool>, Component, LibCommon > List_bool_Builder;
 
 common::ComponentBuilder < List<Uint>, Component, LibCommon > List_Uint_Builder;
 
+#ifdef CF3_ENABLE_64BIT_GLOBAL_INDICES
+common::ComponentBuilder < List<Gid>, Component, LibCommon > List_Gid_Builder;
+#endif
+
 common::ComponentBuilder < List<int>, Component, LibCommon >  List_int_Builder;
 
 common::ComponentBuilder < List<Real>, Component, LibCommon > List_Real_Builder;
@@ -48,6 +52,19 @@ std::ostream& operator<<(std::ostream& os, const List<Uint>& list)
   return os;
 }
 
+#ifdef CF3_ENABLE_64BIT_GLOBAL_INDICES
+std::ostream& operator<<(std::ostream& os, const List<Gid>& list)
+{
+  if (list.size())
+    os << "\n";
+  for (Uint i=0; i<list.size(); ++i)
+  {
+    os << "  " << i << ":  " << list[i] << "\n";
+  }
+  return os;
+}
+#endif
+
 std::ostream& operator<<(std::ostream& os, const List<int>& list)
 {
   if (list.size())
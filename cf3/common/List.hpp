@@ -121,6 +121,9 @@ private: // data
 
 std::ostream& operator<<(std::ostream& os, const List<bool>& list);
 std::ostream& operator<<(std::ostream& os, const List<Uint>& list);
+#ifdef CF3_ENABLE_64BIT_GLOBAL_INDICES
+std::ostream& operator<<(std::ostream& os, const List<Gid>& list);
+#endif
 std::ostream& operator<<(std::ostream& os, const List<int>& list);
 std::ostream& operator<<(std::ostream& os, const List<Real>& list);
 std::ostream& operator<<(std::ostream& os, const List<std::string>& list);
@@ -12,6 +12,7 @@
 #include "common/LibCommon.hpp"
 #include "common/FindComponents.hpp"
 #include "common/Builder.hpp"
+#include "common/Instrumentation.hpp"
 #include "common/Log.hpp"
 
 #include "common/PE/Comm.hpp"
@@ -84,7 +85,7 @@ void CommPattern::setup(const Handle<CommWrapper>& gid, std::vector<Uint>& rank)
   // basic check
   BOOST_ASSERT( (Uint)gid->size() == rank.size() );
   if (gid->stride()!=1) throw cf3::common::BadValue(FromHere(),"Data to be registered as gid is not of stride=1.");
-  if (gid->is_data_type_Uint()!=true) throw cf3::common::CastingFailed(FromHere(),"Data to be registered as gid is not of type Uint.");
+  if (gid->is_data_type_Gid()!=true) throw cf3::common::CastingFailed(FromHere(),"Data to be registered as gid is not of type Gid.");
   m_gid=gid;
   m_gid->add_tag("gid_of_"+this->name());
   /// @todo really needs to be added?
@@ -102,9 +103,9 @@ void CommPattern::setup(const Handle<CommWrapper>& gid, std::vector<Uint>& rank)
     m_isUpToDate=false;
     std::vector<int> map(gid->size());
     for(int i=0; i<(const int)map.size(); i++) map[i]=i;
-    PE::CommWrapperView<Uint> cwv_gid(m_gid);
+    PE::CommWrapperView<Gid> cwv_gid(m_gid);
     std::vector<Uint>::iterator irank=rank.begin();
-    for (Uint* iigid=cwv_gid();irank!=rank.end();irank++,iigid++)
+    for (Gid* iigid=cwv_gid();irank!=rank.end();irank++,iigid++)
       add_global(*iigid,*irank);
 
 //PECheckPoint(100,"-- Setup comission: (gid|rank|lid|option)--");
@@ -137,7 +138,7 @@ void CommPattern::setup(const Handle<CommWrapper>& gid, boost::multi_array<Uint,
   // basic check
   BOOST_ASSERT( (Uint)gid->size() == rank.size() );
   if (gid->stride()!=1) throw cf3::common::BadValue(FromHere(),"Data to be registered as gid is not of stride=1.");
-  if (gid->is_data_type_Uint()!=true) throw cf3::common::CastingFailed(FromHere(),"Data to be registered as gid is not of type Uint.");
+  if (gid->is_data_type_Gid()!=true) throw cf3::common::CastingFailed(FromHere(),"Data to be registered as gid is not of type Gid.");
   m_gid=gid;
   m_gid->add_tag("gid_of_"+this->name());
   /// @todo really needs to be added?
@@ -154,9 +155,9 @@ void CommPattern::setup(const Handle<CommWrapper>& gid, boost::multi_array<Uint,
     m_isUpToDate=false;
     std::vector<int> map(gid->size());
     for(int i=0; i<(int)map.size(); i++) map[i]=i;
-    PE::CommWrapperView<Uint> cwv_gid(m_gid);
+    PE::CommWrapperView<Gid> cwv_gid(m_gid);
     boost::multi_array<Uint,1>::iterator irank=rank.begin();
-    for (Uint* iigid=cwv_gid();irank!=rank.end();irank++,iigid++)
+    for (Gid* iigid=cwv_gid();irank!=rank.end();irank++,iigid++)
       add_global(*iigid,*irank);
 
 //PECheckPoint(100,"-- Setup comission: (gid|rank|lid|option)--");
@@ -203,7 +204,7 @@ PECheckPoint(1000,"003");
   const CPint nproc=(CPint)PE::Comm::instance().size();
   if (m_gid.get()==nullptr) throw cf3::common::BadValue(FromHere(),"Gid is not registered for for commpattern: " + name());
   if (m_gid->stride()!=1) throw cf3::common::BadValue(FromHere(),"Gid is not of stride==1 for commpattern: " + name());
-  if (m_gid->is_data_type_Uint()!=true) throw cf3::common::CastingFailed(FromHere(),"Gid is not of type Uint for commpattern: " + name());
+  if (m_gid->is_data_type_Gid()!=true) throw cf3::common::CastingFailed(FromHere(),"Gid is not of type Gid for commpattern: " + name());
 
 PECheckPoint(1000,"004");
 
@@ -274,19 +275,19 @@ void CommPattern::setup()
   const CPint nproc=(CPint)PE::Comm::instance().size();
   if (m_gid.get()==nullptr) throw cf3::common::BadValue(FromHere(),"Gid is not registered for for commpattern: " + name());
   if (m_gid->stride()!=1) throw cf3::common::BadValue(FromHere(),"Gid is not of stride==1 for commpattern: " + name());
-  if (m_gid->is_data_type_Uint()!=true) throw cf3::common::CastingFailed(FromHere(),"Gid is not of type Uint for commpattern: " + name());
+  if (m_gid->is_data_type_Gid()!=true) throw cf3::common::CastingFailed(FromHere(),"Gid is not of type Gid for commpattern: " + name());
 
   // look around for max gid for the global array's size
-  Uint nglobalarray=0;
-  Uint maxgid_maxrank[2]={0,0};
+  Gid nglobalarray=0;
+  Gid maxgid_maxrank[2]={0,0};
   BOOST_FOREACH(temp_buffer_item i, m_add_buffer)
   {
     maxgid_maxrank[0]=((i.gid)>(maxgid_maxrank[0]))?(i.gid):(maxgid_maxrank[0]);
     maxgid_maxrank[1]=((i.rank)>(maxgid_maxrank[1]))?(i.rank):(maxgid_maxrank[1]);
   }
   PE::Comm::instance().all_reduce(PE::max(),maxgid_maxrank,2,maxgid_maxrank);
-  if (maxgid_maxrank[0]==std::numeric_limits<Uint>::max()) throw BadValue(FromHere(), type_name() + " at " + uri().path() + ": invalid gid.");
-  if (maxgid_maxrank[1]==std::numeric_limits<Uint>::max()) throw BadValue(FromHere(), type_name() + " at " + uri().path() + ": invalid rank.");
+  if (maxgid_maxrank[0]==std::numeric_limits<Gid>::max()) throw BadValue(FromHere(), type_name() + " at " + uri().path() + ": invalid gid.");
+  if (maxgid_maxrank[1]==std::numeric_limits<Gid>::max()) throw BadValue(FromHere(), type_name() + " at " + uri().path() + ": invalid rank.");
   nglobalarray=maxgid_maxrank[0]+1; // zero based indexing!
 
 //PEProcessSortedExecute(-1,std::cout << "nglobalarray= " << nglobalarray << "\n" << std::flush);
@@ -457,8 +458,8 @@ void CommPattern::setup()
 
   // set gids
   m_gid->resize(m_add_buffer.size());
-  CommWrapperView<Uint> cwv_gid(m_gid);
-  Uint *gid=cwv_gid();
+  CommWrapperView<Gid> cwv_gid(m_gid);
+  Gid *gid=cwv_gid();
   BOOST_FOREACH(temp_buffer_item& i, m_add_buffer) *gid++=i.gid;
 
   // clear stuff and reset other things
@@ -488,7 +489,7 @@ void CommPattern::setup()
   const CPint nproc=(CPint)PE::Comm::instance().size();
   if (m_gid.get()==nullptr) throw cf3::common::BadValue(FromHere(),"Gid is not registered for for commpattern: " + name());
   if (m_gid->stride()!=1) throw cf3::common::BadValue(FromHere(),"Gid is not of stride==1 for commpattern: " + name());
-  if (m_gid->is_data_type_Uint()!=true) throw cf3::common::CastingFailed(FromHere(),"Gid is not of type Uint for commpattern: " + name());
+  if (m_gid->is_data_type_Gid()!=true) throw cf3::common::CastingFailed(FromHere(),"Gid is not of type Gid for commpattern: " + name());
   Uint* gid=(Uint*)m_gid->pack();
   m_isUpdatable.resize(m_gid->size(),true);
 
@@ -600,14 +601,18 @@ void CommPattern::synchronize_this( const CommWrapper& pobj, std::vector<unsigne
   {
     pobj.pack(sndbuf,m_sendMap);
     rcvbuf.resize(m_recvMap.size()*pobj.size_of()*pobj.stride());
-    PE::Comm::instance().all_to_all(sndbuf,m_sendCount,rcvbuf,m_recvCount,pobj.size_of()*pobj.stride());
+    Instrumentation::instance().add_counter("bytes_synchronized", sndbuf.size() + rcvbuf.size());
+    {
+      ScopedTimer timer("mpi_wait");
+      PE::Comm::instance().all_to_all(sndbuf,m_sendCount,rcvbuf,m_recvCount,pobj.size_of()*pobj.stride());
+    }
     pobj.unpack(rcvbuf,m_recvMap);
   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void CommPattern::add_global(Uint gid, Uint rank)
+void CommPattern::add_global(Gid gid, Uint rank)
 {
   // later a mechanism could be implemented when commpattern can give gids by calling a "reserve(int num)" beforehand, to optimize performance
   // submits NEGATIVE lid's to distuingish add_global and add_local
@@ -627,7 +632,7 @@ Uint CommPattern::add_local(bool as_ghost)
   int next_lid=m_free_lids.back();
   if (m_free_lids.size()>1) m_free_lids.pop_back();
   else m_free_lids[0]=next_lid+1;
-  m_add_buffer.push_back(temp_buffer_item(next_lid,std::numeric_limits<Uint>::max(),PE::Comm::instance().rank(),as_ghost));
+  m_add_buffer.push_back(temp_buffer_item(next_lid,std::numeric_limits<Gid>::max(),PE::Comm::instance().rank(),as_ghost));
   m_isUpToDate=false;
   return next_lid;
 }
@@ -637,7 +642,7 @@ Uint CommPattern::add_local(bool as_ghost)
 void CommPattern::move_local(Uint lid, Uint rank, bool keep_as_ghost)
 {
   if (m_isFreeze) throw common::ShouldNotBeHere(FromHere(),"Wanted to moves nodes of commpattern '" + name() + "' which is freezed.");
-  m_mov_buffer.push_back(temp_buffer_item(lid,std::numeric_limits<Uint>::max(),rank,keep_as_ghost));
+  m_mov_buffer.push_back(temp_buffer_item(lid,std::numeric_limits<Gid>::max(),rank,keep_as_ghost));
   if (!keep_as_ghost) m_free_lids.push_back(lid);
   m_isUpToDate=false;
 }
@@ -647,7 +652,7 @@ void CommPattern::move_local(Uint lid, Uint rank, bool keep_as_ghost)
 void CommPattern::remove_local(Uint lid, bool on_all_ranks)
 {
   if (m_isFreeze) throw common::ShouldNotBeHere(FromHere(),"Wanted to delete nodes from commpattern '" + name() + "' which is freezed.");
-  m_rem_buffer.push_back(temp_buffer_item(lid,std::numeric_limits<Uint>::max(),PE::Comm::instance().rank(),on_all_ranks));
+  m_rem_buffer.push_back(temp_buffer_item(lid,std::numeric_limits<Gid>::max(),PE::Comm::instance().rank(),on_all_ranks));
   m_free_lids.push_back(lid);
   m_isUpToDate=false;
 }
@@ -50,7 +50,7 @@ public:
   /// typedef for the temporary buffer
   class temp_buffer_item{
     public:
-      temp_buffer_item(int _lid, Uint _gid, Uint _rank, bool _option)
+      temp_buffer_item(int _lid, Gid _gid, Uint _rank, bool _option)
       {
         lid=_lid;
         gid=_gid;
@@ -60,12 +60,12 @@ public:
       temp_buffer_item()
       {
         lid=std::numeric_limits<int>::max();
-        gid=std::numeric_limits<Uint>::max();
+        gid=std::numeric_limits<Gid>::max();
         rank=std::numeric_limits<CPint>::max();
         option=false;
       }
       int lid;
-      Uint gid;
+      Gid gid;
       CPint rank;
       bool option;
   };
@@ -92,7 +92,7 @@ public:
         data=0;
         flags=UNUSED;
       }
-      dist_struct(Uint _gid, CPint _rank, CPint _lid, dist_struct_flags _flags )
+      dist_struct(Gid _gid, CPint _rank, CPint _lid, dist_struct_flags _flags )
       {
         gid=_gid;
         rank=_rank;
@@ -101,7 +101,7 @@ public:
         flags=_flags;
       }
       inline bool operator < ( const dist_struct& val ) const { return gid < val.gid;  } // operator std::sort
-      Uint  gid;               // global id of the item
+      Gid   gid;               // global id of the item
       CPint rank;              // rank where the item is updatable
       CPint lid;               // local id on that rank
       void *data;              // packed data if it needs to be moved along procs, otherwise nullptr
@@ -167,8 +167,8 @@ public:
   /// @param name the component will appear under this name
   /// @param data Multiarray holding the data (not copied)
   /// @param stride number of array element grouping
-  template<typename ValueT, std::size_t NDims>
-  void insert(const std::string& name, boost::multi_array<ValueT, NDims>& data, const bool needs_update=true)
+  template<typename ValueT, std::size_t NDims, typename AllocatorT>
+  void insert(const std::string& name, boost::multi_array<ValueT, NDims, AllocatorT>& data, const bool needs_update=true)
   {
     typedef CommWrapperMArray<ValueT, NDims> CommWrapperT;
     Handle<CommWrapperT> ow = create_component<CommWrapperT>(name);
@@ -201,7 +201,7 @@ public:
   /// this function sets actually up the communication pattern
   /// beware: interprocess communication heavy
   /// this overload of setup is designed for making no callback functions, so all the registered data should match the size of current size + number of additions
-  /// @param gid CommWrapper to a Uint tpye of data array
+  /// @param gid CommWrapper to a Gid type of data array
   /// @param rank vector of ranks where given global ids are updatable to add
   void setup(const Handle<CommWrapper>& gid, std::vector<Uint>& rank);
 
@@ -209,7 +209,7 @@ public:
   /// this function sets actually up the communication pattern
   /// beware: interprocess communication heavy
   /// this overload of setup is designed for making no callback functions, so all the registered data should match the size of current size + number of additions
-  /// @param gid CommWrapper to a Uint tpye of data array
+  /// @param gid CommWrapper to a Gid type of data array
   /// @param rank vector of ranks where given global ids are updatable to add
   void setup(const Handle<CommWrapper>& gid, boost::multi_array<Uint,1>& rank);
 
@@ -236,7 +236,7 @@ public:
   /// @param gid global id
   /// @param rank rank where given global node is to be updatable
   /// @see setup for committing changes
-  void add_global(Uint gid, Uint rank);
+  void add_global(Gid gid, Uint rank);
 
   /// add element to the commpattern
   /// when all changes done, all needs to be committed by calling setup
@@ -132,10 +132,14 @@ class Common_API CommWrapper : public Component {
     /// @return number of items to be treated as one
     virtual int stride() const = 0;
 
-    /// Check for Uint, necessary for cheking type of gid in commpattern
+    /// Check for Uint
     /// @return true or false depending if registered data's type was Uint or not
     virtual bool is_data_type_Uint() const = 0;
 
+    /// Check for Gid, necessary for checking type of gid in commpattern
+    /// @return true or false depending if registered data's type was Gid or not
+    virtual bool is_data_type_Gid() const = 0;
+
     /// accessor to lag telling if wrapped data needs to be synchronized,
     /// if not then it will only be modified if commpattern changes (for example coordinates of a mesh)
     /// @return true or false depending if to be synchronized
@@ -347,6 +351,7 @@ template<typename T> class CommWrapperPtr: public CommWrapper{
     /// Check for Uint, necessary for cheking type of gid in commpattern
     /// @return true or false depending if registered data's type was Uint or not
     bool is_data_type_Uint() const { return boost::is_same<T,Uint>::value; }
+    bool is_data_type_Gid() const { return boost::is_same<T,Gid>::value; }
 
   private:
 
@@ -493,6 +498,7 @@ template<typename T> class CommWrapperVector: public CommWrapper{
     /// Check for Uint, necessary for cheking type of gid in commpattern
     /// @return true or false depending if registered data's type was Uint or not
     bool is_data_type_Uint() const { return boost::is_same<T,Uint>::value; }
+    bool is_data_type_Gid() const { return boost::is_same<T,Gid>::value; }
 
   private:
 
@@ -15,6 +15,7 @@
 #include "common/PE/CommWrapper.hpp"
 #include "common/BoostArray.hpp"
 #include "common/Foreach.hpp"
+#include "common/Table_fwd.hpp"
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -25,7 +26,7 @@ namespace PE  {
 ////////////////////////////////////////////////////////////////////////////////
 
 /**
-  @file CommWrapperMArray.hpp CommWrapper implementations for accepting boost::multi_array<T,1> and boost::multi_array<T,2>.
+  @file CommWrapperMArray.hpp CommWrapper implementations for accepting boost::multi_array<T,1> and the 2D arrays of tables (TableArray<T>::type).
   @author Willem Deconinck
 **/
 
@@ -148,6 +149,7 @@ class CommWrapperMArray<T,1>: public CommWrapper{
     /// Check for Uint, necessary for cheking type of gid in commpattern
     /// @return true or false depending if registered data's type was Uint or not
     bool is_data_type_Uint() const { return boost::is_same<T,Uint>::value; }
+    bool is_data_type_Gid() const { return boost::is_same<T,Gid>::value; }
 
   private:
 
@@ -194,7 +196,7 @@ class CommWrapperMArray<T,2>: public CommWrapper{
     /// setup of passing by reference
     /// @param std::vector of data
     /// @param stride number of array element grouping
-    void setup(boost::multi_array<T,2>& data, const bool needs_update)
+    void setup(typename TableArray<T>::type& data, const bool needs_update)
     {
       if (boost::is_pod<T>::value==false) throw cf3::common::BadValue(FromHere(),name()+": Data is not POD (plain old datatype).");
       m_data=&data;
@@ -290,6 +292,7 @@ class CommWrapperMArray<T,2>: public CommWrapper{
     /// Check for Uint, necessary for cheking type of gid in commpattern
     /// @return true or false depending if registered data's type was Uint or not
     bool is_data_type_Uint() const { return boost::is_same<T,Uint>::value; }
+    bool is_data_type_Gid() const { return boost::is_same<T,Gid>::value; }
 
   private:
 
@@ -309,7 +312,7 @@ class CommWrapperMArray<T,2>: public CommWrapper{
   private:
 
     /// pointer to std::vector
-    boost::multi_array<T,2>* m_data;
+    typename TableArray<T>::type* m_data;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -13,6 +13,7 @@
 #include "common/BasicExceptions.hpp"
 #include "common/Log.hpp"
 
+#include "common/XML/BinaryPayload.hpp"
 #include "common/XML/FileOperations.hpp"
 
 #include "common/PE/ListeningInfo.hpp"
@@ -173,15 +174,19 @@ void ListeningThread::check_for_data()
     if( !info->ready )
     {
       int flag;
+      MPI_Status status;
 
-      MPI_Test(&info->request, &flag, MPI_STATUS_IGNORE);
+      MPI_Test(&info->request, &flag, &status);
 
       // if data arrived, flag is not zero
       if( flag != 0 )
       {
         try
         {
-          boost::shared_ptr<XmlDoc> doc = XML::parse_cstring( info->data );
+          int count;
+          MPI_Get_count(&status, MPI_CHAR, &count);
+
+          boost::shared_ptr<XmlDoc> doc = XML::parse_frame( info->data, count );
 
           new_signal( it->first, doc );
 
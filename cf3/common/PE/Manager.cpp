@@ -20,6 +20,7 @@
 #include "common/OptionURI.hpp"
 #include "common/Signal.hpp"
 
+#include "common/XML/BinaryPayload.hpp"
 #include "common/XML/FileOperations.hpp"
 #include "common/XML/SignalOptions.hpp"
 
@@ -324,25 +325,18 @@ void Manager::broadcast ( const SignalArgs & args )
 
 void Manager::send_to ( Communicator comm, const SignalArgs &args )
 {
-  std::string str;
-  char * buffer;
+  std::string frame;
   int remote_size;
 
   cf3_assert( is_not_null(args.xml_doc) );
 
-  to_string( *args.xml_doc, str);
-
-  buffer = new char[ str.length() + 1 ];
-  std::strcpy( buffer, str.c_str() );
+  // the frame carries the binary payloads of the signal, if any
+  to_frame( *args.xml_doc, frame );
 
   MPI_Comm_remote_size(comm, &remote_size);
 
-//  std::cout << "Worker[" << Comm::instance().rank() << "]" << " -> Sending " << buffer << std::endl;
-
   for(int i = 0 ; i < remote_size ; ++i)
-    MPI_Send( buffer, str.length() + 1, MPI_CHAR, i, 0, comm );
-
-  delete [] buffer;
+    MPI_Send( const_cast<char*>( frame.data() ), frame.size(), MPI_CHAR, i, 0, comm );
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -18,6 +18,10 @@ common::ComponentBuilder < Table<bool>, Component, LibCommon > Table_bool_Builde
 
 common::ComponentBuilder < Table<Uint>, Component, LibCommon > Table_Uint_Builder;
 
+#ifdef CF3_ENABLE_64BIT_GLOBAL_INDICES
+common::ComponentBuilder < Table<Gid>, Component, LibCommon > Table_Gid_Builder;
+#endif
+
 common::ComponentBuilder < Table<int>, Component, LibCommon >  Table_int_Builder;
 
 common::ComponentBuilder < Table<Real>, Component, LibCommon > Table_Real_Builder;
@@ -38,6 +42,14 @@ std::ostream& operator<<(std::ostream& os, const Table<Uint>::ConstRow row)
   return os;
 }
 
+#ifdef CF3_ENABLE_64BIT_GLOBAL_INDICES
+std::ostream& operator<<(std::ostream& os, const Table<Gid>::ConstRow row)
+{
+  print_vector(os, row);
+  return os;
+}
+#endif
+
 std::ostream& operator<<(std::ostream& os, const Table<int>::ConstRow row)
 {
   print_vector(os, row);
@@ -62,14 +74,12 @@ std::ostream& operator<<(std::ostream& os, const Table<bool>& table)
 {
   if (table.size())
     os << "\n";
-  Uint i=0;
-  boost_foreach(Table<bool>::ConstRow row, table.array())
+  for (Uint i=0; i<table.size(); ++i)
   {
     os << "  " << i << ":  ";
-    boost_foreach(const bool entry, row)
+    boost_foreach(const bool entry, table[i])
       os << entry << " ";
     os << "\n";
-    ++i;
   }
   return os;
 }
@@ -78,30 +88,42 @@ std::ostream& operator<<(std::ostream& os, const Table<Uint>& table)
 {
   if (table.size())
     os << "\n";
-  Uint i=0;
-  boost_foreach(Table<Uint>::ConstRow row, table.array())
+  for (Uint i=0; i<table.size(); ++i)
+  {
+    os << "  " << i << ":  ";
+    boost_foreach(const Uint entry, table[i])
+      os << entry << " ";
+    os << "\n";
+  }
+  return os;
+}
+
+#ifdef CF3_ENABLE_64BIT_GLOBAL_INDICES
+std::ostream& operator<<(std::ostream& os, const Table<Gid>& table)
+{
+  if (table.size())
+    os << "\n";
+  for (Uint i=0; i<table.size(); ++i)
   {
     os << "  " << i << ":  ";
-    boost_foreach(const Uint entry, row)
+    boost_foreach(const Gid entry, table[i])
       os << entry << " ";
     os << "\n";
-    ++i;
   }
   return os;
 }
+#endif
 
 std::ostream& operator<<(std::ostream& os, const Table<int>& table)
 {
   if (table.size())
     os << "\n";
-  Uint i=0;
-  boost_foreach(Table<int>::ConstRow row, table.array())
+  for (Uint i=0; i<table.size(); ++i)
   {
     os << "  " << i << ":  ";
-    boost_foreach(const int entry, row)
+    boost_foreach(const int entry, table[i])
       os << entry << " ";
     os << "\n";
-    ++i;
   }
   return os;
 }
@@ -110,14 +132,12 @@ std::ostream& operator<<(std::ostream& os, const Table<Real>& table)
 {
   if (table.size())
     os << "\n";
-  Uint i=0;
-  boost_foreach(Table<Real>::ConstRow row, table.array())
+  for (Uint i=0; i<table.size(); ++i)
   {
     os << "  " << i << ":  ";
-    boost_foreach(const Real& entry, row)
+    boost_foreach(const Real& entry, table[i])
       os << entry << " ";
     os << "\n";
-    ++i;
   }
   return os;
 }
@@ -126,14 +146,12 @@ std::ostream& operator<<(std::ostream& os, const Table<std::string>& table)
 {
   if (table.size())
     os << "\n";
-  Uint i=0;
-  boost_foreach(Table<std::string>::ConstRow row, table.array())
+  for (Uint i=0; i<table.size(); ++i)
   {
     os << "  " << i << ":  ";
-    boost_foreach(const std::string& entry, row)
+    boost_foreach(const std::string& entry, table[i])
       os << entry << " ";
     os << "\n";
-    ++i;
   }
   return os;
 }
@@ -10,6 +10,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <iosfwd>
+#include <limits>
 
 #include "common/Component.hpp"
 
@@ -24,11 +25,41 @@ namespace common {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+namespace detail {
+
+/// Builds the rows of padded tables. The row constructors of boost::multi_array are only accessible to its value accessor,
+/// so the rows are built through the same access function as for the array itself, but with the extent of a row set to
+/// the number of values without the padding.
+template<typename ValueT>
+struct PaddedRowAccess : boost::detail::multi_array::value_accessor_n<ValueT,2>
+{
+  typedef typename TableArray<ValueT>::type ArrayT;
+
+  /// @param extents Extents used for the access, with the number of values of a row as second extent
+  typename TableRow<ValueT>::type row(ArrayT& array, const Uint idx, const typename ArrayT::size_type* extents) const
+  {
+    return this->access(boost::type<typename TableRow<ValueT>::type>(), idx, array.data(), extents, array.strides(), array.index_bases());
+  }
+
+  typename TableConstRow<ValueT>::type row(const ArrayT& array, const Uint idx, const typename ArrayT::size_type* extents) const
+  {
+    return this->access(boost::type<boost::detail::multi_array::const_sub_array<ValueT,1> >(), idx, array.data(), extents, array.strides(), array.index_bases());
+  }
+};
+
+} // detail
+
+////////////////////////////////////////////////////////////////////////////////
+
 /// @brief Component holding a 2 dimensional array of a templated type
 ///
 /// The internal structure is that of a boost::multi_array,
 /// so storage is contingent in memory for reducing cache missing
 //
+/// Optionally, the rows can be padded to a multiple of an alignment in bytes,
+/// with the storage starting at that alignment, so each row starts aligned.
+/// The padding is only part of the storage: row_size() and the rows returned
+/// by operator[] keep the number of columns. @see set_row_alignment
 /// The table can be filled through a buffer. The buffer avoids
 /// the typical reallocation in a std::vector. Flushing the buffer
 /// will resize the table and copy itself into the table.
@@ -65,8 +96,12 @@ public: // functions
 
   /// Contructor
   /// @param name of the component
-  Table ( const std::string& name )  : Component ( name ), m_pos(0)
-  {  }
+  Table ( const std::string& name )  : Component ( name ), m_row_alignment(0), m_pos(0)
+  {
+    // the row accessor only checks the row index against the first extent, which is checked by operator[] itself
+    m_row_extents[0] = std::numeric_limits<typename ArrayT::size_type>::max();
+    m_row_extents[1] = 0;
+  }
 
   /// Get the component type name
   /// @returns the component type name
@@ -77,22 +112,53 @@ public: // functions
   /// @param[in] nb_cols number of columns in the table.
   void set_row_size(const Uint nb_cols)
   {
-    m_array.resize(boost::extents[size()][nb_cols]);
+    m_row_extents[1] = nb_cols;
+    m_array.resize(boost::extents[size()][padded_row_size(nb_cols)]);
+  }
+
+  /// Pad the rows so each row starts at a multiple of alignment bytes. The existing rows are kept.
+  /// @param[in] alignment Alignment in bytes, a power of two and a multiple of sizeof(ValueT). 0 removes the padding.
+  void set_row_alignment(const Uint alignment)
+  {
+    cf3_assert(alignment % sizeof(ValueT) == 0);
+    const Uint nb_rows = size();
+    const Uint nb_cols = row_size();
+    m_row_alignment = alignment;
+    m_row_extents[1] = nb_cols;
+
+    ArrayT padded(boost::extents[nb_rows][padded_row_size(nb_cols)], boost::c_storage_order(), typename TableAllocator<ValueT>::type(alignment));
+    for(Uint i = 0; i != nb_rows; ++i)
+      for(Uint j = 0; j != nb_cols; ++j)
+        padded[i][j] = m_array[i][j];
+
+    // multi_array assignment requires equal shapes and keeps the allocator, so the array is constructed again
+    m_array.~ArrayT();
+    try
+    {
+      new (&m_array) ArrayT(padded);
+    }
+    catch(...)
+    {
+      new (&m_array) ArrayT();
+      throw;
+    }
   }
 
   /// Resize the array to the given number of rows
   /// @param[in] nb_rows The number of rows after resizing
   virtual void resize(const Uint nb_rows)
   {
-    m_array.resize(boost::extents[nb_rows][row_size()]);
+    m_array.resize(boost::extents[nb_rows][m_array.shape()[1]]);
   }
 
   /// Modifiable access to the internal structure
   /// @return A reference to the array data
+  /// @note For padded tables, the rows of the array include the padding, @see row_stride
   ArrayT& array() { return m_array; }
 
   /// Non-modifiable access to the internal structure
   /// @return A const reference to the array data
+  /// @note For padded tables, the rows of the array include the padding, @see row_stride
   const ArrayT& array() const { return m_array; }
 
   /// Create a buffer with a given number of entries
@@ -103,24 +169,36 @@ public: // functions
   {
     // make sure the array has its columnsize defined
     cf3_assert(row_size() > 0);
-    return Buffer(m_array,buffersize);
+    return Buffer(m_array,buffersize,row_size());
   }
 
   typename boost::shared_ptr<Buffer> create_buffer_ptr(const size_t buffersize=16384)
   {
     // make sure the array has its columnsize defined
     cf3_assert(row_size() > 0);
-    return typename boost::shared_ptr<Buffer> ( new Buffer (m_array,buffersize) );
+    return typename boost::shared_ptr<Buffer> ( new Buffer (m_array,buffersize,row_size()) );
   }
 
 
   /// Operator to have modifiable access to a table-row
   /// @return A mutable row of the underlying array
-  Row operator[](const Uint idx) { return m_array[idx]; }
+  Row operator[](const Uint idx)
+  {
+    if(m_row_alignment == 0)
+      return m_array[idx];
+    cf3_assert(idx < size());
+    return detail::PaddedRowAccess<ValueT>().row(m_array, idx, m_row_extents);
+  }
 
   /// Operator to have non-modifiable access to a table-row
   /// @return A const row of the underlying array
-  ConstRow operator[](const Uint idx) const { return m_array[idx]; }
+  ConstRow operator[](const Uint idx) const
+  {
+    if(m_row_alignment == 0)
+      return m_array[idx];
+    cf3_assert(idx < size());
+    return detail::PaddedRowAccess<ValueT>().row(m_array, idx, m_row_extents);
+  }
 
   /// Number of rows, excluding rows that may be in the buffer
   /// @return The number of local rows in the array
@@ -130,7 +208,13 @@ public: // functions
   /// @return The number of elements in each row, i.e. the number of columns of the array
   /// @note All row_sizes are the same, so an index is not required, but
   /// could be passed to be consistent with DynTable with variable row_sizes
-  Uint row_size(Uint i=0) const { return m_array.shape()[1]; }
+  Uint row_size(Uint i=0) const { return m_row_alignment == 0 ? m_array.shape()[1] : m_row_extents[1]; }
+
+  /// Distance between the start of two rows in the storage, i.e. the row size including the padding
+  Uint row_stride() const { return m_array.shape()[1]; }
+
+  /// Alignment in bytes of the rows, 0 if the rows are not padded
+  Uint row_alignment() const { return m_row_alignment; }
 
   /// copy a given row into the array, The row type must have the size() function declared
   /// @param[in] array_idx the index of the row that will be set
@@ -140,7 +224,7 @@ public: // functions
   {
     cf3_assert(row.size() == row_size());
 
-    Row row_to_set = m_array[array_idx];
+    Row row_to_set = (*this)[array_idx];
 
     for(Uint j=0; j<row.size(); ++j)
       row_to_set[j] = row[j];
@@ -159,10 +243,25 @@ public: // functions
     return m_pos;
   }
 
+private: // functions
+
+  /// Number of columns in the storage for rows of nb_cols values
+  Uint padded_row_size(const Uint nb_cols) const
+  {
+    if(m_row_alignment == 0)
+      return nb_cols;
+    const Uint values_per_alignment = m_row_alignment / sizeof(ValueT);
+    return ((nb_cols + values_per_alignment - 1) / values_per_alignment) * values_per_alignment;
+  }
+
 private: // data
 
   /// storage of the array
   ArrayT m_array;
+  /// extents used to access the rows of padded tables, the second being the number of columns without the padding
+  typename ArrayT::size_type m_row_extents[2];
+  /// alignment of the rows of padded tables, 0 if not padded
+  Uint m_row_alignment;
   /// position when used as output stream
   Uint m_pos;
 };
@@ -171,12 +270,18 @@ private: // data
 
 std::ostream& operator<<(std::ostream& os, const Table<bool>::ConstRow row);
 std::ostream& operator<<(std::ostream& os, const Table<Uint>::ConstRow row);
+#ifdef CF3_ENABLE_64BIT_GLOBAL_INDICES
+std::ostream& operator<<(std::ostream& os, const Table<Gid>::ConstRow row);
+#endif
 std::ostream& operator<<(std::ostream& os, const Table<int>::ConstRow row);
 std::ostream& operator<<(std::ostream& os, const Table<Real>::ConstRow row);
 std::ostream& operator<<(std::ostream& os, const Table<std::string>::ConstRow row);
 
 std::ostream& operator<<(std::ostream& os, const Table<bool>& table);
 std::ostream& operator<<(std::ostream& os, const Table<Uint>& table);
+#ifdef CF3_ENABLE_64BIT_GLOBAL_INDICES
+std::ostream& operator<<(std::ostream& os, const Table<Gid>& table);
+#endif
 std::ostream& operator<<(std::ostream& os, const Table<int>& table);
 std::ostream& operator<<(std::ostream& os, const Table<Real>& table);
 std::ostream& operator<<(std::ostream& os, const Table<std::string>& table);
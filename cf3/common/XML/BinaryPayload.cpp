@@ -0,0 +1,191 @@
+// Copyright (C) 2010-2013 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include "rapidxml/rapidxml.hpp"
+
+#include "common/BasicExceptions.hpp"
+#include "common/StringConversion.hpp"
+
+#include "common/XML/FileOperations.hpp"
+#include "common/XML/Protocol.hpp"
+
+#include "common/XML/BinaryPayload.hpp"
+
+////////////////////////////////////////////////////////////////////////////
+
+namespace cf3 {
+namespace common {
+namespace XML {
+
+////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// Collects the binary payload nodes under the provided node, in document order
+void collect_payloads ( rapidxml::xml_node<>* node, std::vector< rapidxml::xml_node<>* >& payloads )
+{
+  for( rapidxml::xml_node<>* child = node->first_node() ; child != 0 ; child = child->next_sibling() )
+  {
+    if( child->type() == rapidxml::node_element &&
+        std::strcmp( child->name(), Protocol::Tags::node_binary() ) == 0 )
+      payloads.push_back( child );
+    else
+      collect_payloads( child, payloads );
+  }
+}
+
+/// Sets the value of a node to a copy of the provided bytes
+void set_binary_value ( rapidxml::xml_node<>* node, const char * data, std::size_t size )
+{
+  // null-terminated, so that the value can still be read as a C-string
+  char * value = node->document()->allocate_string( 0, size + 1 );
+  std::copy( data, data + size, value );
+  value[size] = '\0';
+  node->value( value, size );
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////
+
+XmlNode add_binary_payload ( const XmlNode& node, const char * data, std::size_t size,
+                             const bool compress )
+{
+  cf3_assert( node.is_valid() );
+
+  XmlNode payload_node = node.add_node( Protocol::Tags::node_binary() );
+
+  if( compress )
+  {
+    std::string compressed;
+    {
+      boost::iostreams::filtering_ostream out;
+      out.push( boost::iostreams::zlib_compressor() );
+      out.push( boost::iostreams::back_inserter(compressed) );
+      out.write( data, size );
+    } // the stream is flushed when going out of scope
+
+    set_binary_value( payload_node.content, compressed.data(), compressed.size() );
+  }
+  else
+    set_binary_value( payload_node.content, data, size );
+
+  payload_node.set_attribute( Protocol::Tags::attr_binary_compressed(), to_str(compress) );
+
+  return payload_node;
+}
+
+////////////////////////////////////////////////////////////////////////////
+
+void get_binary_payload ( const XmlNode& node, std::vector<char>& data )
+{
+  if( !node.is_valid() || std::strcmp( node.content->name(), Protocol::Tags::node_binary() ) != 0 )
+    throw XmlError( FromHere(), "The node is not a binary payload node." );
+
+  const char * value = node.content->value();
+  const std::size_t size = node.content->value_size();
+
+  if( node.attribute_value( Protocol::Tags::attr_binary_compressed() ) == to_str(true) )
+  {
+    boost::iostreams::filtering_istream in;
+    in.push( boost::iostreams::zlib_decompressor() );
+    in.push( boost::iostreams::array_source(value, size) );
+    data.assign( std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>() );
+  }
+  else
+    data.assign( value, value + size );
+}
+
+////////////////////////////////////////////////////////////////////////////
+
+void to_frame ( const XmlNode& node, std::string& frame )
+{
+  cf3_assert( node.is_valid() );
+
+  std::vector< rapidxml::xml_node<>* > payloads;
+  collect_payloads( node.content, payloads );
+
+  // the payloads are removed from the XML text, which only keeps their position in the frame
+  std::vector< std::pair<const char*, std::size_t> > values( payloads.size() );
+  std::size_t offset = 0;
+  for( Uint i = 0 ; i < payloads.size() ; ++i )
+  {
+    XmlNode payload_node( payloads[i] );
+    values[i] = std::make_pair( payloads[i]->value(), payloads[i]->value_size() );
+    payload_node.set_attribute( Protocol::Tags::attr_binary_offset(), boost::lexical_cast<std::string>(offset) );
+    payload_node.set_attribute( Protocol::Tags::attr_array_size(), boost::lexical_cast<std::string>(values[i].second) );
+    payloads[i]->value( "", 0 );
+    offset += values[i].second;
+  }
+
+  to_string( node, frame );
+
+  for( Uint i = 0 ; i < payloads.size() ; ++i )
+    payloads[i]->value( values[i].first, values[i].second );
+
+  if( !payloads.empty() )
+  {
+    frame.reserve( frame.size() + 1 + offset );
+    frame.push_back( '\0' );
+    for( Uint i = 0 ; i < values.size() ; ++i )
+      frame.append( values[i].first, values[i].second );
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////
+
+boost::shared_ptr<XmlDoc> parse_frame ( const char * frame, std::size_t size )
+{
+  cf3_assert( is_not_null(frame) );
+
+  const char * xml_end = std::find( frame, frame + size, '\0' );
+  boost::shared_ptr<XmlDoc> doc = parse_string( std::string(frame, xml_end) );
+
+  const char * payloads_begin = xml_end == frame + size ? xml_end : xml_end + 1;
+  const std::size_t payloads_size = (frame + size) - payloads_begin;
+
+  std::vector< rapidxml::xml_node<>* > payloads;
+  collect_payloads( doc->content, payloads );
+
+  for( Uint i = 0 ; i < payloads.size() ; ++i )
+  {
+    XmlNode payload_node( payloads[i] );
+    std::size_t offset, payload_size;
+
+    try
+    {
+      offset = boost::lexical_cast<std::size_t>( payload_node.attribute_value(Protocol::Tags::attr_binary_offset()) );
+      payload_size = boost::lexical_cast<std::size_t>( payload_node.attribute_value(Protocol::Tags::attr_array_size()) );
+    }
+    catch( boost::bad_lexical_cast& )
+    {
+      throw XmlError( FromHere(), "Binary payload " + to_str(i) + " has no valid offset or size." );
+    }
+
+    if( offset + payload_size > payloads_size )
+      throw XmlError( FromHere(), "Binary payload " + to_str(i) + " is not inside the frame." );
+
+    set_binary_value( payloads[i], payloads_begin + offset, payload_size );
+  }
+
+  return doc;
+}
+
+////////////////////////////////////////////////////////////////////////////
+
+} // XML
+} // common
+} // cf3
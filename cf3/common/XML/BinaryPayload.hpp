@@ -0,0 +1,72 @@
+// Copyright (C) 2010-2013 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef cf3_common_XML_BinaryPayload_hpp
+#define cf3_common_XML_BinaryPayload_hpp
+
+////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include "common/XML/XmlDoc.hpp"
+
+////////////////////////////////////////////////////////////////////////////
+
+namespace cf3 {
+namespace common {
+namespace XML {
+
+////////////////////////////////////////////////////////////////////////////
+
+/// @file BinaryPayload.hpp
+/// Binary payloads carry raw bytes, e.g. the values of large arrays, inside a XML
+/// document without converting them to text.
+///
+/// In memory, a payload is the value of a "binary" node, allocated in the memory
+/// pool of the document. On the wire, a document with payloads is sent as a frame:
+/// the XML text, a null character, and the concatenated payloads. The XML text
+/// only keeps the offset and size of every payload in the frame.
+/// A frame without payloads is plain XML text.
+
+/// Adds raw bytes as a binary payload node in the provided node.
+/// The bytes are copied in the memory pool of the document.
+/// @param node The node in which to add the payload node.
+/// @param data The bytes to add.
+/// @param size The number of bytes.
+/// @param compress If @c true, the bytes are compressed with zlib.
+/// @return Returns the new payload node.
+XmlNode add_binary_payload ( const XmlNode& node, const char * data, std::size_t size,
+                             const bool compress = false );
+
+/// Gets the bytes of a binary payload node, uncompressing them if needed.
+/// @param node The payload node.
+/// @param data The bytes of the payload. The vector is resized.
+/// @throw XmlError If the node is not a binary payload node.
+void get_binary_payload ( const XmlNode& node, std::vector<char>& data );
+
+/// Writes the provided XML node to a frame, with its binary payloads.
+/// @param node The node to write.
+/// @param frame The string to which the frame is written.
+void to_frame ( const XmlNode& node, std::string& frame );
+
+/// Parses a frame written by @c #to_frame(), attaching the binary payloads to
+/// their nodes.
+/// @param frame The frame data. Plain XML text is accepted as well.
+/// @param size The size in bytes of the frame.
+/// @return Returns a shared pointer with the built XML document.
+/// @throw XmlError If the string could not be parsed, or a payload is not
+/// inside the frame.
+boost::shared_ptr<XmlDoc> parse_frame ( const char * frame, std::size_t size );
+
+////////////////////////////////////////////////////////////////////////////
+
+} // XML
+} // common
+} // cf3
+
+////////////////////////////////////////////////////////////////////////////
+
+#endif // cf3_common_XML_BinaryPayload_hpp
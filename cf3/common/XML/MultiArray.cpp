@@ -4,6 +4,8 @@
 // GNU Lesser General Public License version 3 (LGPLv3).
 // See doc/lgpl.txt and doc/gpl.txt for the license text.
 
+#include <algorithm>
+
 #include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/range/as_literal.hpp>
@@ -18,6 +20,7 @@
 
 #include "common/Log.hpp"
 
+#include "common/XML/BinaryPayload.hpp"
 #include "common/XML/Protocol.hpp"
 
 #include "common/XML/MultiArray.hpp"
@@ -31,9 +34,10 @@ namespace XML {
 ////////////////////////////////////////////////////////////////////////////
 
 XmlNode add_multi_array_in( Map & map, const std::string & name,
-                            const boost::multi_array<Real, 2> & array,
+                            const boost::const_multi_array_ref<Real, 2> & array,
                             const std::string & delimiter,
-                            const std::vector<std::string> & labels )
+                            const std::vector<std::string> & labels,
+                            const bool binary )
 {
   cf3_assert( map.content.is_valid() );
   cf3_assert( !name.empty())
@@ -66,6 +70,14 @@ XmlNode add_multi_array_in( Map & map, const std::string & name,
   data_node.set_attribute( Protocol::Tags::attr_array_size(), size);
   data_node.set_attribute( "merge_delimiter", to_str(true) ); // temporary
 
+  if( binary )
+  {
+    // the multi-array storage is contiguous, in row-major order
+    add_binary_payload( data_node, reinterpret_cast<const char*>( array.data() ),
+                        array.num_elements() * sizeof(Real) );
+    return array_node;
+  }
+
   // build the value string (ideas are welcome to avoid multiple
   // memory reallocations
   for(Uint row = 0 ; row < nb_rows ; ++row)
@@ -146,6 +158,25 @@ void get_multi_array( const Map & map, const std::string & name,
   // 2. Fill the multi-array
   //
 
+  // 2a. binary payload: the values are copied as they are
+  XmlNode payload_node( data_node.content->first_node( Protocol::Tags::node_binary() ) );
+
+  if( payload_node.is_valid() )
+  {
+    std::vector<char> data;
+    get_binary_payload( payload_node, data );
+
+    if( data.size() != array.num_elements() * sizeof(Real) )
+      throw XmlError(FromHere(), "The binary payload of multi-array [" + name + "] has "
+                     + to_str(data.size()) + " bytes, expected " +
+                     to_str(array.num_elements() * sizeof(Real)) + ".");
+
+    std::copy( data.begin(), data.end(), reinterpret_cast<char*>( array.data() ) );
+    return;
+  }
+
+  // 2b. text
+
   // the array is written in the XML as a 2D array, with a new line after each
   // row. Thus we first need to tokenize the string on line breaks and then
   // split the line depending on the delimiter and cast each element to Real.
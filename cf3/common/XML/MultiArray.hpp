@@ -22,11 +22,16 @@ namespace XML {
 ////////////////////////////////////////////////////////////////////////////
 
 /// Adds a multi array in the provided @c Map
+/// @param binary If @c true, the values are stored as a binary payload instead
+/// of text (see BinaryPayload.hpp). They are then sent without conversion, in
+/// the native byte order.
 XmlNode add_multi_array_in(Map & map, const std::string & name,
-                           const boost::multi_array<Real, 2> & array,
+                           const boost::const_multi_array_ref<Real, 2> & array,
                            const std::string & delimiter = ";",
-                           const std::vector<std::string> & labels = std::vector<std::string>());
+                           const std::vector<std::string> & labels = std::vector<std::string>(),
+                           const bool binary = false);
 
+/// Gets a multi array from the provided @c Map, stored as text or as a binary payload
 void get_multi_array(const Map & map, const std::string & name,
                          boost::multi_array<Real, 2> & array,
                          std::vector<std::string> & labels);
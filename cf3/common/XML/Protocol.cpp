@@ -33,6 +33,10 @@ namespace XML {
 
   const char * Protocol::Tags::attr_array_type() { return "type"; }
 
+  const char * Protocol::Tags::attr_binary_offset() { return "offset"; }
+
+  const char * Protocol::Tags::attr_binary_compressed() { return "compressed"; }
+
   const char * Protocol::Tags::attr_clientid() { return "clientid"; }
 
   const char * Protocol::Tags::attr_descr() { return "descr"; }
@@ -55,6 +59,8 @@ namespace XML {
 
   const char * Protocol::Tags::node_array() { return "array"; }
 
+  const char * Protocol::Tags::node_binary() { return "binary"; }
+
   const char * Protocol::Tags::node_doc() { return "cfxml"; }
 
   const char * Protocol::Tags::node_frame() { return "frame"; }
@@ -46,6 +46,11 @@ namespace XML {
       /// @returns Returns the name for attribute 'type' of arrays.
       static const char * attr_array_type ();
 
+      /// @returns Returns the name for attribute 'offset' of binary payloads in a frame.
+      static const char * attr_binary_offset ();
+      /// @returns Returns the name for attribute 'compressed' of binary payloads.
+      static const char * attr_binary_compressed ();
+
 
       /// @returns Returns the name for attribute that maintains the client UUID.
       static const char * attr_clientid ();
@@ -81,6 +86,8 @@ namespace XML {
       static const char * node_value ();
       /// @return Returns the node name for arrays.
       static const char * node_array ();
+      /// @return Returns the node name for binary payloads.
+      static const char * node_binary ();
 
       /// @return Returns the type for reply frames.
       static const char * node_type_reply ();
@@ -4,6 +4,8 @@
 // GNU Lesser General Public License version 3 (LGPLv3).
 // See doc/lgpl.txt and doc/gpl.txt for the license text.
 
+#include <algorithm>
+
 #include "rapidxml/rapidxml.hpp"
 
 #include "common/BasicExceptions.hpp"
@@ -123,7 +125,12 @@ void XmlNode::deep_copy ( XmlNode& out ) const
 void XmlNode::deep_copy_names_values ( const XmlNode& in, XmlNode& out ) const
 {
   out.set_name(in.content->name());
-  out.set_value(in.content->value());
+  // copy with the size, since values of binary payloads may contain null characters
+  const std::size_t value_size = in.content->value_size();
+  char * value = out.content->document()->allocate_string(0, value_size + 1);
+  std::copy(in.content->value(), in.content->value() + value_size, value);
+  value[value_size] = '\0';
+  out.content->value(value, value_size);
 
   // copy names and values of the attributes
   rapidxml::xml_attribute<> * iattr = in.content->first_attribute();
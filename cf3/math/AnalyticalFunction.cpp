@@ -121,6 +121,9 @@ void AnalyticalFunction::parse (const std::string& function)
     msg += " Vars: ["    + ss.str() + "]";
     throw common::ParsingFailed (FromHere(),msg);
   }
+
+  // fold constant sub-expressions and simplify the bytecode
+  m_parser->Optimize();
   m_is_parsed = true;
 }
 
@@ -119,6 +119,7 @@ public:
   void get_column_and_replace_to_zero(const Uint iblockcol, Uint ieq, std::vector<Real>& values) { cf3_assert(m_is_created); values.resize(m_blockcol_size*m_neq,0.); }
 
   void symmetric_dirichlet(const Uint blockrow, const Uint ieq, const Real value, Vector& rhs) { cf3_assert(m_is_created); }
+  void symmetric_dirichlet(const std::vector<Uint>& blockrows, const std::vector<Uint>& ieqs, const std::vector<Real>& values, Vector& rhs) { cf3_assert(m_is_created); }
 
   /// Add one line to another and tie to it via dirichlet-style (applying periodicity)
   void tie_blockrow_pairs (const Uint iblockrow_to, const Uint iblockrow_from) { cf3_assert(m_is_created); }
@@ -44,6 +44,10 @@ void EmptyStrategy::solve()
 {
 }
 
+void EmptyStrategy::solve(const std::vector< Handle<Vector> >& rhs, const std::vector< Handle<Vector> >& solutions)
+{
+}
+
 } // namespace LSS
 } // namespace math
 } // namespace cf3
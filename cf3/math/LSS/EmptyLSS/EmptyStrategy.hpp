@@ -42,6 +42,7 @@ public:
   void set_rhs(const Handle<LSS::Vector>& rhs);
   void set_solution(const Handle<LSS::Vector>& solution);
   void solve();
+  void solve(const std::vector< Handle<LSS::Vector> >& rhs, const std::vector< Handle<LSS::Vector> >& solutions);
   Real compute_residual();
 }; // end of class EmptyStrategy
 
@@ -107,6 +107,12 @@ public:
   /// @warning Structural symmetry is not checked, incorrect results will appear if you use this on a non structurally symmetric matrix
   virtual void symmetric_dirichlet(const Uint blockrow, const Uint ieq, const Real value, LSS::Vector& rhs) = 0;
 
+  /// Apply a list of dirichlet boundary conditions at once, preserving symmetry by moving entries to the RHS.
+  /// Each matrix row touched by the conditions is visited only once, contrary to calling the single-value version for each condition.
+  /// @pre The matrix must be structurally symmetric
+  /// @pre blockrows, ieqs and values have the same size
+  virtual void symmetric_dirichlet(const std::vector<Uint>& blockrows, const std::vector<Uint>& ieqs, const std::vector<Real>& values, LSS::Vector& rhs) = 0;
+
   /// Add one line to another and tie to it via dirichlet-style (applying periodicity)
   virtual void tie_blockrow_pairs (const Uint iblockrow_to, const Uint iblockrow_from) = 0;
 
@@ -54,6 +54,11 @@ public:
   /// Solve the system
   virtual void solve() = 0;
 
+  /// Solve the system for several right hand sides at once, reusing the matrix and preconditioner set up for it.
+  /// The i-th solution is stored in solutions[i], whose contents are used as initial guess.
+  /// All vectors must have been created with the same layout as the system vectors.
+  virtual void solve(const std::vector< Handle<LSS::Vector> >& rhs, const std::vector< Handle<LSS::Vector> >& solutions) = 0;
+
   virtual Real compute_residual() = 0;
 
 }; // end of class SolutionStrategy
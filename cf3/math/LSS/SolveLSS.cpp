@@ -4,11 +4,18 @@
 // GNU Lesser General Public License version 3 (LGPLv3).
 // See doc/lgpl.txt and doc/gpl.txt for the license text.
 
+#include <cmath>
+
+#include <boost/assign/list_of.hpp>
+#include <boost/bind.hpp>
+
 #include "common/OptionList.hpp"
 #include "common/PropertyList.hpp"
 #include "common/Builder.hpp"
+#include "common/PE/Comm.hpp"
 
 #include "math/LSS/System.hpp"
+#include "math/LSS/Vector.hpp"
 
 #include "SolveLSS.hpp"
 
@@ -20,6 +27,49 @@ using namespace common;
 
 common::ComponentBuilder < SolveLSS, common::Action, LibLSS > SolveLSS_Builder;
 
+namespace detail
+{
+  /// Dot product over the block rows owned by this process, summed over all processes
+  Real dot(const boost::multi_array<Real, 2>& a, const boost::multi_array<Real, 2>& b, const std::vector<bool>& is_updatable)
+  {
+    const Uint nb_rows = a.shape()[0];
+    const Uint neq = a.shape()[1];
+    Real result = 0.;
+    for(Uint i = 0; i != nb_rows; ++i)
+    {
+      if(!is_updatable[i])
+        continue;
+      for(Uint j = 0; j != neq; ++j)
+        result += a[i][j] * b[i][j];
+    }
+
+    if(PE::Comm::instance().is_active())
+      PE::Comm::instance().all_reduce(PE::plus(), &result, 1, &result);
+
+    return result;
+  }
+
+  /// y += alpha*x
+  void axpy(const Real alpha, const boost::multi_array<Real, 2>& x, boost::multi_array<Real, 2>& y)
+  {
+    const Uint nb_rows = x.shape()[0];
+    const Uint neq = x.shape()[1];
+    for(Uint i = 0; i != nb_rows; ++i)
+      for(Uint j = 0; j != neq; ++j)
+        y[i][j] += alpha * x[i][j];
+  }
+
+  /// x *= alpha
+  void scale(const Real alpha, boost::multi_array<Real, 2>& x)
+  {
+    const Uint nb_rows = x.shape()[0];
+    const Uint neq = x.shape()[1];
+    for(Uint i = 0; i != nb_rows; ++i)
+      for(Uint j = 0; j != neq; ++j)
+        x[i][j] *= alpha;
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 SolveLSS::SolveLSS( const std::string& name  ) :
@@ -36,7 +86,21 @@ SolveLSS::SolveLSS( const std::string& name  ) :
       .description("Linear System solver that gets executed")
       .pretty_name("LSS")
       .mark_basic()
-      .link_to(&m_lss);
+      .link_to(&m_lss)
+      .attach_trigger(boost::bind(&SolveLSS::trigger_initial_guess, this));
+
+  std::vector<boost::any> initial_guesses = boost::assign::list_of<boost::any>(std::string("none"))(std::string("extrapolation"))(std::string("projection"));
+  options().add("initial_guess", std::string("none"))
+      .description("Initial guess for the solver. none uses the contents of the solution vector, extrapolation extrapolates the previous solutions in time (assuming a constant time step), "
+                   "projection projects the system on the space spanned by the previous solutions (for symmetric systems, such as a pressure Poisson equation)")
+      .pretty_name("Initial Guess")
+      .attach_trigger(boost::bind(&SolveLSS::trigger_initial_guess, this))
+      .restricted_list() = initial_guesses;
+
+  options().add("nb_previous_solutions", 3u)
+      .description("Number of previous solutions used for the initial guess")
+      .pretty_name("Number of Previous Solutions")
+      .attach_trigger(boost::bind(&SolveLSS::trigger_initial_guess, this));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -51,7 +115,114 @@ void SolveLSS::execute ()
   if(!lss.is_created())
     throw SetupError(FromHere(), "LSS at " + lss.uri().string() + " is not created!");
 
+  const bool use_initial_guess = options().value<std::string>("initial_guess") != "none";
+
+  if(use_initial_guess)
+    compute_initial_guess();
+
   lss.solve();
+
+  if(use_initial_guess)
+    store_solution();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SolveLSS::compute_initial_guess()
+{
+  LSS::System& lss = *m_lss;
+  LSS::Vector& solution = *lss.solution();
+  const Uint nb_rows = solution.blockrow_size();
+  const Uint neq = solution.neq();
+
+  // The system changed size, so the stored solutions are unusable
+  if(!m_solutions.empty() && (m_solutions.front().shape()[0] != nb_rows || m_solutions.front().shape()[1] != neq))
+    trigger_initial_guess();
+
+  m_rhs.resize(boost::extents[nb_rows][neq]);
+  lss.rhs()->get(m_rhs);
+
+  if(m_solutions.empty())
+    return;
+
+  VectorDataT guess(boost::extents[nb_rows][neq]);
+  const Uint nb_solutions = m_solutions.size();
+
+  if(options().value<std::string>("initial_guess") == "projection")
+  {
+    // The basis is A-orthonormal, so the coefficients of the projection are the dot products with the RHS
+    for(Uint i = 0; i != nb_solutions; ++i)
+      detail::axpy(detail::dot(m_solutions[i], m_rhs, lss.is_updatable()), m_solutions[i], guess);
+  }
+  else
+  {
+    // Lagrange extrapolation for equidistant points: the coefficient of the solution k steps back is (-1)^(k-1) * binomial(n, k)
+    Real coeff = 1.;
+    for(Uint k = 1; k <= nb_solutions; ++k)
+    {
+      coeff *= -static_cast<Real>(nb_solutions - k + 1) / static_cast<Real>(k);
+      detail::axpy(-coeff, m_solutions[nb_solutions - k], guess);
+    }
+  }
+
+  solution.set(guess);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SolveLSS::store_solution()
+{
+  LSS::System& lss = *m_lss;
+  const Uint nb_previous = options().value<Uint>("nb_previous_solutions");
+  if(nb_previous == 0)
+    return;
+
+  VectorDataT solution(boost::extents[m_rhs.shape()[0]][m_rhs.shape()[1]]);
+  lss.solution()->get(solution);
+
+  if(options().value<std::string>("initial_guess") != "projection")
+  {
+    if(m_solutions.size() == nb_previous)
+      m_solutions.erase(m_solutions.begin());
+    m_solutions.push_back(solution);
+    return;
+  }
+
+  // Restart the basis when it is full
+  if(m_solutions.size() == nb_previous)
+  {
+    m_solutions.clear();
+    m_products.clear();
+  }
+
+  // A-orthogonalize against the basis, using the RHS as product of the matrix with the solution
+  const Real norm_before = detail::dot(solution, m_rhs, lss.is_updatable());
+  const Uint nb_solutions = m_solutions.size();
+  for(Uint i = 0; i != nb_solutions; ++i)
+  {
+    const Real beta = detail::dot(m_products[i], solution, lss.is_updatable());
+    detail::axpy(-beta, m_solutions[i], solution);
+    detail::axpy(-beta, m_products[i], m_rhs);
+  }
+
+  // Skip solutions that are (almost) in the span of the basis already
+  const Real norm = detail::dot(solution, m_rhs, lss.is_updatable());
+  if(norm <= 1e-12 * std::abs(norm_before) || norm <= 0.)
+    return;
+
+  const Real inv_norm = 1. / std::sqrt(norm);
+  detail::scale(inv_norm, solution);
+  detail::scale(inv_norm, m_rhs);
+  m_solutions.push_back(solution);
+  m_products.push_back(m_rhs);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SolveLSS::trigger_initial_guess()
+{
+  m_solutions.clear();
+  m_products.clear();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -9,6 +9,8 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <boost/multi_array.hpp>
+
 #include "common/Action.hpp"
 
 #include "LibLSS.hpp"
@@ -22,6 +24,9 @@ class System;
 ////////////////////////////////////////////////////////////////////////////////
 
 /// SolveLSS wraps a linear system math in an action that will execute the solve
+/// Optionally, the initial guess for the solver is computed from the solutions of the previous executions, either by
+/// extrapolating them in time or by projecting the new system on their span (P. F. Fischer, "Projection techniques for iterative
+/// solution of Ax=b with successive right-hand sides", 1998). The projection assumes a symmetric matrix that changes little between solves.
 /// @author Bart Janssens
 class LSS_API SolveLSS : public common::Action
 {
@@ -38,7 +43,27 @@ public: // functions
   void execute();
 
 private:
+  /// Set the initial guess in the solution vector, using the stored solutions
+  void compute_initial_guess();
+
+  /// Store the solution that was just computed
+  void store_solution();
+
+  /// Clear the stored solutions
+  void trigger_initial_guess();
+
   Handle<math::LSS::System> m_lss;
+
+  typedef boost::multi_array<Real, 2> VectorDataT;
+
+  /// Previous solutions, most recent last. When projecting, this is an A-orthonormal basis of the previous solutions.
+  std::vector<VectorDataT> m_solutions;
+
+  /// For the projection, the product of the system matrix with each basis vector
+  std::vector<VectorDataT> m_products;
+
+  /// Copy of the RHS, taken before the solve
+  VectorDataT m_rhs;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -13,6 +13,7 @@
 #include "common/PE/Comm.hpp"
 #include "common/Builder.hpp"
 #include "common/Component.hpp"
+#include "common/Instrumentation.hpp"
 #include "common/OptionT.hpp"
 #include "common/PE/CommPattern.hpp"
 #include "common/Signal.hpp"
@@ -25,6 +26,7 @@
 #include "math/LSS/Matrix.hpp"
 #include "math/LSS/Vector.hpp"
 #include "math/LSS/BlockAccumulator.hpp"
+#include "math/VariablesDescriptor.hpp"
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -47,6 +49,10 @@ using namespace cf3::math;
 
 common::ComponentBuilder < LSS::System, LSS::System, LSS::LibLSS > System_Builder;
 
+/// Instrumentation counter of the matrix entries inserted by set_values and add_values,
+/// which are called once per element during assembly
+const Uint matrix_entries_counter = common::Instrumentation::instance().counter_id("matrix_entries_inserted");
+
 LSS::System::System(const std::string& name) :
   Component(name)
 {
@@ -91,6 +97,8 @@ void LSS::System::create(cf3::common::PE::CommPattern& cp, Uint neq, std::vector
 
   m_rhs->create(cp,neq);
   m_sol->create(cp,neq);
+  m_is_updatable = cp.isUpdatable();
+  m_comm_pattern = cp.handle<common::PE::CommPattern>();
   m_mat->create(cp,neq,node_connectivity,starting_indices,*m_sol,*m_rhs);
 
   m_rhs->mark_basic();
@@ -123,6 +131,9 @@ void LSS::System::create_blocked(common::PE::CommPattern& cp, const VariablesDes
 
   m_rhs->create_blocked(cp,vars);
   m_sol->create_blocked(cp,vars);
+  m_is_updatable = cp.isUpdatable();
+  m_comm_pattern = cp.handle<common::PE::CommPattern>();
+  m_variables = vars.handle<VariablesDescriptor>();
   m_mat->create_blocked(cp,vars,node_connectivity,starting_indices,*m_sol,*m_rhs);
 
   m_rhs->mark_basic();
@@ -186,10 +197,44 @@ void LSS::System::destroy()
   if(is_not_null(get_child("RHS")))
     remove_component("RHS");
 
+  for(std::vector< Handle<LSS::Vector> >::const_iterator it = m_extra_vectors.begin(); it != m_extra_vectors.end(); ++it)
+  {
+    if(is_not_null(*it))
+      remove_component(**it);
+  }
+
   m_solution_strategy.reset();
   m_mat.reset();
   m_sol.reset();
   m_rhs.reset();
+  m_is_updatable.clear();
+  m_comm_pattern.reset();
+  m_variables.reset();
+  m_extra_vectors.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+Handle<LSS::Vector> LSS::System::create_vector(const std::string& name)
+{
+  if(!is_created())
+    throw common::SetupError(FromHere(), "Can't create vector " + name + " for uncreated system " + uri().path());
+  if(is_null(m_comm_pattern))
+    throw common::SetupError(FromHere(), "Comm pattern used to create system " + uri().path() + " no longer exists");
+
+  std::string vector_builder = options().option("vector_builder").value_str();
+  if(vector_builder.empty())
+    vector_builder = m_mat->properties().value_str("vector_type");
+
+  Handle<LSS::Vector> vec = create_component<LSS::Vector>(name, vector_builder);
+  if(is_not_null(m_variables))
+    vec->create_blocked(*m_comm_pattern, *m_variables);
+  else
+    vec->create(*m_comm_pattern, m_sol->neq());
+  vec->reset();
+
+  m_extra_vectors.push_back(vec);
+  return vec;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////
@@ -197,14 +242,28 @@ void LSS::System::destroy()
 void LSS::System::solve()
 {
   cf3_assert(is_created());
+  common::ScopedRegion region("solve");
   m_solution_strategy->solve();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 
+void LSS::System::solve(const std::vector< Handle<LSS::Vector> >& rhs, const std::vector< Handle<LSS::Vector> >& solutions)
+{
+  cf3_assert(is_created());
+  if(rhs.size() != solutions.size())
+    throw common::BadValue(FromHere(), "Number of right hand sides (" + common::to_str(rhs.size()) + ") differs from the number of solution vectors (" + common::to_str(solutions.size()) + ")");
+
+  common::ScopedRegion region("solve");
+  m_solution_strategy->solve(rhs, solutions);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
 void LSS::System::set_values(const LSS::BlockAccumulator& values)
 {
   cf3_assert(is_created());
+  common::Instrumentation::instance().add_counter(matrix_entries_counter, values.mat.size());
   m_mat->set_values(values);
   m_sol->set_sol_values(values);
   m_rhs->set_rhs_values(values);
@@ -215,6 +274,7 @@ void LSS::System::set_values(const LSS::BlockAccumulator& values)
 void LSS::System::add_values(const LSS::BlockAccumulator& values)
 {
   cf3_assert(is_created());
+  common::Instrumentation::instance().add_counter(matrix_entries_counter, values.mat.size());
   m_mat->add_values(values);
   m_sol->add_sol_values(values);
   m_rhs->add_rhs_values(values);
@@ -251,6 +311,33 @@ void LSS::System::dirichlet(const Uint iblockrow, const Uint ieq, const Real val
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 
+void LSS::System::dirichlet(const std::vector<Uint>& iblockrows, const std::vector<Uint>& ieqs, const std::vector<Real>& values, const bool preserve_symmetry)
+{
+  cf3_assert(is_created());
+
+  const Uint nb_bcs = iblockrows.size();
+  if (ieqs.size() != nb_bcs || values.size() != nb_bcs)
+    throw common::BadValue(FromHere(),"Dirichlet condition lists have different sizes: " + common::to_str(nb_bcs) + " blockrows, " + common::to_str(ieqs.size()) + " equations and " + common::to_str(values.size()) + " values");
+
+  if (preserve_symmetry)
+  {
+    m_mat->symmetric_dirichlet(iblockrows, ieqs, values, *m_rhs);
+  }
+  else
+  {
+    for (int i=0; i<(const int)nb_bcs; i++)
+    {
+      m_mat->set_row(iblockrows[i],ieqs[i],1.,0.);
+      m_rhs->set_value(iblockrows[i],ieqs[i],values[i]);
+    }
+  }
+
+  for (int i=0; i<(const int)nb_bcs; i++)
+    m_sol->set_value(iblockrows[i],ieqs[i],values[i]);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
 void LSS::System::periodicity (const Uint iblockrow_to, const Uint iblockrow_from)
 {
   cf3_assert(is_created());
@@ -83,6 +83,10 @@ public:
   /// Deallocate underlying data
   void destroy();
 
+  /// Create an additional vector with the same type and layout as the solution and right hand side of this system, initialized to zero.
+  /// Such vectors can be passed as extra right hand sides or solutions to solve(rhs, solutions). They are destroyed together with the system.
+  Handle<LSS::Vector> create_vector(const std::string& name);
+
   //@} END CREATION, DESTRUCTION AND COMPONENT SYSTEM
 
   /// @name SOLVE THE SYSTEM
@@ -92,6 +96,10 @@ public:
   /// @todo action for it
   void solve();
 
+  /// Solve the system for several right hand sides that share the system matrix, storing the i-th solution in solutions[i].
+  /// The matrix and preconditioner are only set up once, and strategies that support it solve all right hand sides in a single block solve.
+  void solve(const std::vector< Handle<LSS::Vector> >& rhs, const std::vector< Handle<LSS::Vector> >& solutions);
+
   //@} END SOLVE THE SYSTEM
 
   /// @name EFFICCIENT ACCESS
@@ -110,6 +118,10 @@ public:
   /// When preserve_symmetry is true than blockrow*numequations+eq column is is zeroed by moving it to the right hand side (however this usually results in performance penalties).
   void dirichlet(const Uint iblockrow, const Uint ieq, const Real value, const bool preserve_symmetry=false);
 
+  /// Apply a list of dirichlet-type boundary conditions, the i-th condition fixing equation ieqs[i] of blockrow iblockrows[i] to values[i].
+  /// When preserving symmetry, the matrix rows are visited only once for the whole list, which is much faster than applying the conditions one by one.
+  void dirichlet(const std::vector<Uint>& iblockrows, const std::vector<Uint>& ieqs, const std::vector<Real>& values, const bool preserve_symmetry=false);
+
   /// Applying periodicity by adding one line to another and dirichlet-style fixing it to
   /// Note that prerequisite for this is to work that the matrix sparsity should be compatible (same nonzero pattern for the two block rows).
   /// Note that only structural symmetry can be preserved (again, if sparsity input was symmetric).
@@ -153,6 +165,9 @@ public:
   /// Accessor to the solution strategy
   Handle<LSS::SolutionStrategy> solution_strategy() { return m_solution_strategy; }
 
+  /// For each block row, true if it is owned by this process, as given by the comm pattern used in create
+  const std::vector<bool>& is_updatable() const { return m_is_updatable; }
+
   /// Accessor to the state of create
   const bool is_created();
 
@@ -185,6 +200,16 @@ private:
   /// Strategy for the solution
   Handle<LSS::SolutionStrategy> m_solution_strategy;
 
+  /// Ownership of the block rows
+  std::vector<bool> m_is_updatable;
+
+  /// Comm pattern and variables used to create the system, needed to create additional vectors with the same layout
+  Handle<common::PE::CommPattern> m_comm_pattern;
+  Handle<VariablesDescriptor const> m_variables;
+
+  /// Vectors created using create_vector
+  std::vector< Handle<LSS::Vector> > m_extra_vectors;
+
 }; // end of class System
 
 ////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,317 @@
+// Copyright (C) 2010-2013 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include <boost/assign/list_of.hpp>
+#include <boost/bind.hpp>
+
+#include "BelosLinearProblem.hpp"
+#include "BelosEpetraAdapter.hpp"
+#include "BelosThyraAdapter.hpp"
+#include "BelosBlockGmresSolMgr.hpp"
+
+#include "Teuchos_ConfigDefs.hpp"
+#include "Teuchos_RCP.hpp"
+
+#include "Teko_BlockedEpetraOperator.hpp"
+#include "Teko_EpetraBlockPreconditioner.hpp"
+#include "Teko_InverseLibrary.hpp"
+#include "Teko_PreconditionerFactory.hpp"
+
+#include "Thyra_EpetraLinearOp.hpp"
+#include "Thyra_MultiVectorStdOps.hpp"
+#include "Thyra_VectorBase.hpp"
+
+#include "common/Builder.hpp"
+#include "common/Core.hpp"
+#include "common/EventHandler.hpp"
+#include "common/Log.hpp"
+#include "common/OptionList.hpp"
+#include "common/StringConversion.hpp"
+
+#include "common/XML/SignalOptions.hpp"
+
+#include "ParameterList.hpp"
+#include "TrilinosCrsMatrix.hpp"
+#include "TrilinosVector.hpp"
+#include "BlockPreconditionerStrategy.hpp"
+
+namespace cf3 {
+namespace math {
+namespace LSS {
+
+common::ComponentBuilder<BlockPreconditionerStrategy, SolutionStrategy, LibLSS> BlockPreconditionerStrategy_builder;
+
+struct BlockPreconditionerStrategy::Implementation
+{
+  typedef Thyra::MultiVectorBase<Real> MV;
+  typedef Thyra::LinearOpBase<Real> OP;
+
+  Implementation(common::Component& self) :
+    m_self(self),
+    m_solver_parameter_list(Teuchos::createParameterList()),
+    m_preconditioner_parameter_list(Teuchos::createParameterList())
+  {
+    // Default solver parameters
+    m_solver_parameter_list->set( "Verbosity", Belos::Errors | Belos::Warnings | Belos::FinalSummary );
+    m_solver_parameter_list->set( "Maximum Iterations", 500 );
+    m_solver_parameter_list->set( "Convergence Tolerance", 1.0e-8 );
+    m_solver_parameter_list->set( "Num Blocks", 100 );
+
+    // Default block preconditioner settings, using the Teko names. The sub-blocks are inverted using algebraic multigrid.
+    m_preconditioner_parameter_list->set("Inverse Type", "ML");
+    m_preconditioner_parameter_list->set("Inverse Velocity Type", "ML");
+    m_preconditioner_parameter_list->set("Inverse Pressure Type", "ML");
+    m_preconditioner_parameter_list->set("Explicit Velocity Inverse Type", "AbsRowSum");
+
+    update_parameters();
+  }
+
+  void solve()
+  {
+    if(is_null(m_rhs))
+      throw common::SetupError(FromHere(), "Null RHS for " + m_self.uri().path());
+
+    if(is_null(m_solution))
+      throw common::SetupError(FromHere(), "Null solution vector for " + m_self.uri().path());
+
+    prepare();
+    const Teuchos::RCP<const OP> op = m_matrix->thyra_operator();
+    solve_one(m_solution->thyra_vector(op->domain()), m_rhs->thyra_vector(op->range()));
+  }
+
+  void solve(const std::vector< Handle<Vector> >& rhs, const std::vector< Handle<Vector> >& solutions)
+  {
+    if(solutions.size() != rhs.size())
+      throw common::BadValue(FromHere(), "Got " + common::to_str(rhs.size()) + " right hand sides but " + common::to_str(solutions.size()) + " solution vectors for " + m_self.uri().path());
+
+    if(rhs.empty())
+      return;
+
+    prepare();
+    const Teuchos::RCP<const OP> op = m_matrix->thyra_operator();
+    const Uint nb_rhs = rhs.size();
+    for(Uint i = 0; i != nb_rhs; ++i)
+    {
+      Handle<TrilinosVector> rhs_i(rhs[i]);
+      Handle<TrilinosVector> sol_i(solutions[i]);
+      if(is_null(rhs_i) || is_null(sol_i))
+        throw common::SetupError(FromHere(), "Null or non-Trilinos vector at position " + common::to_str(i) + " for " + m_self.uri().path());
+      solve_one(sol_i->thyra_vector(op->domain()), rhs_i->thyra_vector(op->range()));
+    }
+  }
+
+  /// Extract the blocks from the matrix and (re)build the block preconditioner
+  void prepare()
+  {
+    if(is_null(m_matrix))
+      throw common::SetupError(FromHere(), "Null or non-CRS matrix for " + m_self.uri().path() + ". Block preconditioning requires a TrilinosCrsMatrix");
+
+    // The block structure only depends on the sparsity, so it is kept until the matrix or the blocking changes
+    if(m_blocked_operator.is_null())
+    {
+      std::vector< std::vector<int> > block_gids;
+      m_matrix->block_global_indices(m_self.options().value< std::vector<Uint> >("vars_per_block"), block_gids);
+      if(block_gids.size() < 2)
+        CFwarn << "Block preconditioner for " << m_self.uri().path() << " has only one block, so it is equivalent to the sub-block inverse applied to the whole system" << CFendl;
+      m_blocked_operator = Teuchos::rcp(new Teko::Epetra::BlockedEpetraOperator(block_gids, m_matrix->epetra_matrix()));
+      m_preconditioner.reset();
+    }
+    else
+    {
+      // The matrix values may have changed since the last solve
+      m_blocked_operator->RebuildOps();
+    }
+
+    if(m_preconditioner.is_null())
+    {
+      const std::string preconditioner_type = m_self.options().value<std::string>("block_preconditioner");
+      Teuchos::RCP<Teko::InverseLibrary> inverse_library = Teko::InverseLibrary::buildFromStratimikos();
+      Teuchos::RCP<Teko::PreconditionerFactory> factory = Teko::PreconditionerFactory::buildPreconditionerFactory(preconditioner_type, *m_preconditioner_parameter_list, inverse_library);
+      if(factory.is_null())
+        throw common::SetupError(FromHere(), "Unknown Teko preconditioner type " + preconditioner_type + " for " + m_self.uri().path());
+
+      m_preconditioner = Teuchos::rcp(new Teko::Epetra::EpetraBlockPreconditioner(factory));
+      m_preconditioner->buildPreconditioner(m_blocked_operator);
+    }
+    else
+    {
+      m_preconditioner->rebuildPreconditioner(m_blocked_operator);
+    }
+
+    const Teuchos::RCP<const OP> op = m_matrix->thyra_operator();
+    if(m_problem.is_null())
+      m_problem = Teuchos::rcp( new Belos::LinearProblem<Real,MV,OP>() );
+
+    m_problem->setOperator(op);
+    Teuchos::RCP<Belos::EpetraPrecOp> belos_prec = Teuchos::rcp( new Belos::EpetraPrecOp( m_preconditioner ) );
+    m_problem->setRightPrec(Thyra::epetraLinearOp(belos_prec));
+  }
+
+  /// Solve for a single right hand side, using the operator set up by prepare
+  void solve_one(const Teuchos::RCP<MV>& lhs, const Teuchos::RCP<const MV>& rhs)
+  {
+    m_problem->setLHS(lhs);
+    m_problem->setRHS(rhs);
+
+    if(!m_problem->setProblem())
+      throw common::SetupError(FromHere(), "Error setting up Belos problem");
+
+    if(m_solver.is_null())
+      m_solver = Teuchos::rcp(new Belos::BlockGmresSolMgr<Real,MV,OP>(m_problem, m_solver_parameter_list));
+    else
+      m_solver->setProblem(m_problem);
+
+    const Belos::ReturnType result = m_solver->solve();
+
+    CFinfo << "Block preconditioned GMRES " << (result == Belos::Converged ? "converged" : "did not converge") << " after " << m_solver->getNumIters() << " iterations" << CFendl;
+  }
+
+  Real compute_residual()
+  {
+    if(is_null(m_matrix) || is_null(m_rhs) || is_null(m_solution))
+      throw common::SetupError(FromHere(), "Incomplete system for " + m_self.uri().path());
+
+    const Teuchos::RCP<const OP> op = m_matrix->thyra_operator();
+    Teuchos::RCP<MV> residual = m_rhs->thyra_vector(op->range())->clone_mv();
+    op->apply(Thyra::NOTRANS, *m_solution->thyra_vector(op->domain()), residual.ptr(), -1., 1.);
+    std::vector<Real> residuals(residual->domain()->dim());
+    Thyra::norms_2(*residual, Teuchos::arrayViewFromVector(residuals));
+    return *std::max_element(residuals.begin(), residuals.end());
+  }
+
+  void update_parameters()
+  {
+    if(is_not_null(m_solver_parameters))
+      m_self.remove_component("SolverParameters");
+
+    m_solver_parameters = m_self.create_component<ParameterList>("SolverParameters");
+    m_solver_parameters->mark_basic();
+    m_solver_parameters->set_parameter_list(*m_solver_parameter_list);
+
+    if(is_not_null(m_preconditioner_parameters))
+      m_self.remove_component("BlockPreconditionerParameters");
+
+    m_preconditioner_parameters = m_self.create_component<ParameterList>("BlockPreconditionerParameters");
+    m_preconditioner_parameters->mark_basic();
+    m_preconditioner_parameters->set_parameter_list(*m_preconditioner_parameter_list);
+  }
+
+  /// Rebuild the preconditioner and solver on the next solve, keeping the block structure
+  void reset_solver()
+  {
+    m_solver.reset();
+    m_problem.reset();
+    m_preconditioner.reset();
+  }
+
+  /// Discard everything, including the block structure of the matrix
+  void reset_blocks()
+  {
+    reset_solver();
+    m_blocked_operator.reset();
+  }
+
+  common::Component& m_self;
+  Teuchos::RCP<Teuchos::ParameterList> m_solver_parameter_list;
+  Teuchos::RCP<Teuchos::ParameterList> m_preconditioner_parameter_list;
+  Teuchos::RCP<Teko::Epetra::BlockedEpetraOperator> m_blocked_operator;
+  Teuchos::RCP<Teko::Epetra::EpetraBlockPreconditioner> m_preconditioner;
+  Teuchos::RCP< Belos::LinearProblem<Real,MV,OP> > m_problem;
+  Teuchos::RCP< Belos::BlockGmresSolMgr<Real,MV,OP> > m_solver;
+
+  Handle<TrilinosCrsMatrix> m_matrix;
+  Handle<TrilinosVector> m_rhs;
+  Handle<TrilinosVector> m_solution;
+  Handle<ParameterList> m_solver_parameters;
+  Handle<ParameterList> m_preconditioner_parameters;
+};
+
+BlockPreconditionerStrategy::BlockPreconditionerStrategy(const string& name) :
+  SolutionStrategy(name),
+  m_implementation(new Implementation(*this))
+{
+  std::vector<boost::any> preconditioner_types = boost::assign::list_of<boost::any>
+    (std::string("NS SIMPLE"))
+    (std::string("NS LSC"))
+    (std::string("Block Gauss-Seidel"))
+    (std::string("Block Jacobi"));
+
+  options().add("block_preconditioner", std::string("NS SIMPLE"))
+    .pretty_name("Block Preconditioner")
+    .description("Name of the Teko block preconditioner. SIMPLE and LSC require exactly two blocks, with the velocity first")
+    .attach_trigger(boost::bind(&Implementation::reset_solver, m_implementation.get()))
+    .mark_basic()
+    .restricted_list() = preconditioner_types;
+
+  options().add("vars_per_block", std::vector<Uint>())
+    .pretty_name("Variables per Block")
+    .description("Number of consecutive variables in each block, e.g. 1 1 for a velocity and a pressure variable. Empty puts each variable in its own block")
+    .attach_trigger(boost::bind(&Implementation::reset_blocks, m_implementation.get()))
+    .mark_basic();
+
+  common::Core::instance().event_handler().connect_to_event("trilinos_parameters_changed", this, &BlockPreconditionerStrategy::on_parameters_changed_event);
+}
+
+BlockPreconditionerStrategy::~BlockPreconditionerStrategy()
+{
+}
+
+Real BlockPreconditionerStrategy::compute_residual()
+{
+  return m_implementation->compute_residual();
+}
+
+void BlockPreconditionerStrategy::set_rhs(const Handle< Vector >& rhs)
+{
+  m_implementation->m_rhs = Handle<TrilinosVector>(rhs);
+}
+
+void BlockPreconditionerStrategy::set_solution(const Handle< Vector >& solution)
+{
+  m_implementation->m_solution = Handle<TrilinosVector>(solution);
+}
+
+void BlockPreconditionerStrategy::set_matrix(const Handle< Matrix >& matrix)
+{
+  m_implementation->m_matrix = Handle<TrilinosCrsMatrix>(matrix);
+  m_implementation->reset_blocks();
+}
+
+void BlockPreconditionerStrategy::solve()
+{
+  m_implementation->solve();
+}
+
+void BlockPreconditionerStrategy::solve(const std::vector< Handle<Vector> >& rhs, const std::vector< Handle<Vector> >& solutions)
+{
+  m_implementation->solve(rhs, solutions);
+}
+
+void BlockPreconditionerStrategy::on_parameters_changed_event(common::SignalArgs& args)
+{
+  common::XML::SignalOptions options(args);
+  const common::URI parameters_uri = options.value<common::URI>("parameters_uri");
+
+  if(boost::starts_with(parameters_uri.path(), uri().path()))
+  {
+    CFdebug << "Acting on trilinos_parameters_changed event from paramater list " << parameters_uri.string() << CFendl;
+    m_implementation->reset_solver();
+  }
+  else
+  {
+    CFdebug << "Ignoring trilinos_parameters_changed event from paramater list " << parameters_uri.string() << CFendl;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace LSS
+} // namespace math
+} // namespace cf3
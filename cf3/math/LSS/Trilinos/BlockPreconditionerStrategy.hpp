@@ -0,0 +1,59 @@
+// Copyright (C) 2010-2013 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef cf3_Math_LSS_BlockPreconditionerStrategy_hpp
+#define cf3_Math_LSS_BlockPreconditionerStrategy_hpp
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <boost/scoped_ptr.hpp>
+
+#include "math/LSS/SolutionStrategy.hpp"
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ *  @file BlockPreconditionerStrategy.hpp Solution strategy using a Teko block preconditioner for coupled systems
+ **/
+////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace cf3 {
+namespace math {
+namespace LSS {
+
+/// Solves coupled systems such as the velocity-pressure system of the incompressible Navier-Stokes equations using Belos GMRES,
+/// right-preconditioned with a physics-based block preconditioner from Teko (SIMPLE, LSC, block Gauss-Seidel, ...).
+/// The matrix must be a TrilinosCrsMatrix created using create_blocked. Its rows are split into blocks of consecutive variables,
+/// as set by the vars_per_block option, and each diagonal block is approximately inverted using the sub-solver from the
+/// BlockPreconditionerParameters (ML by default).
+class LSS_API BlockPreconditionerStrategy : public SolutionStrategy
+{
+public:
+  BlockPreconditionerStrategy(const std::string& name);
+  ~BlockPreconditionerStrategy();
+
+  /// name of the type
+  static std::string type_name () { return "BlockPreconditionerStrategy"; }
+
+  void set_matrix(const Handle<LSS::Matrix>& matrix);
+  void set_rhs(const Handle<LSS::Vector>& rhs);
+  void set_solution(const Handle<LSS::Vector>& solution);
+  void solve();
+  void solve(const std::vector< Handle<LSS::Vector> >& rhs, const std::vector< Handle<LSS::Vector> >& solutions);
+  Real compute_residual();
+
+private:
+  void on_parameters_changed_event(common::SignalArgs& args);
+  /// Hide the implementation to avoid pulling in lots of Trilinos headers
+  struct Implementation;
+  boost::scoped_ptr<Implementation> m_implementation;
+};
+
+} // namespace LSS
+} // namespace math
+} // namespace cf3
+
+#endif // cf3_Math_LSS_BlockPreconditionerStrategy_hpp
@@ -41,6 +41,7 @@
 #include "common/Builder.hpp"
 #include "common/EventHandler.hpp"
 #include "common/OptionList.hpp"
+#include "common/StringConversion.hpp"
 #include <common/Table.hpp>
 #include <common/List.hpp>
 
@@ -200,6 +201,40 @@ struct ConstantPoissonStrategy::Implementation
     m_solver->solve();
   }
 
+  /// RCG only supports a block size of 1, so the right hand sides are solved one after the other. The preconditioner and
+  /// the recycled Krylov space are shared between the solves.
+  void solve(const std::vector< Handle<Vector> >& rhs, const std::vector< Handle<Vector> >& solutions)
+  {
+    if(solutions.size() != rhs.size())
+      throw common::BadValue(FromHere(), "Got " + common::to_str(rhs.size()) + " right hand sides but " + common::to_str(solutions.size()) + " solution vectors for " + m_self.uri().path());
+
+    if(is_null(m_solver.get()))
+    {
+      setup_solver();
+    }
+
+    const Teuchos::RCP<const Thyra::LinearOpBase<Real> > op = m_matrix->thyra_operator();
+    const Uint nb_rhs = rhs.size();
+    for(Uint i = 0; i != nb_rhs; ++i)
+    {
+      Handle<TrilinosVector> rhs_i(rhs[i]);
+      Handle<TrilinosVector> sol_i(solutions[i]);
+      if(is_null(rhs_i) || is_null(sol_i))
+        throw common::SetupError(FromHere(), "Null or non-Trilinos vector at position " + common::to_str(i) + " for " + m_self.uri().path());
+
+      m_problem->setLHS(sol_i->thyra_vector(op->domain()));
+      m_problem->setRHS(rhs_i->thyra_vector(op->range()));
+      if(!m_problem->setProblem())
+        throw common::SetupError(FromHere(), "Error setting up Belos problem");
+
+      m_solver->solve();
+    }
+
+    // Point the problem back to the system vectors
+    m_problem->setLHS(m_solution->thyra_vector(op->domain()));
+    m_problem->setRHS(m_rhs->thyra_vector(op->range()));
+  }
+
   Real compute_residual()
   {
     return -1.;
@@ -314,6 +349,11 @@ void ConstantPoissonStrategy::solve()
   m_implementation->solve();
 }
 
+void ConstantPoissonStrategy::solve(const std::vector< Handle<Vector> >& rhs, const std::vector< Handle<Vector> >& solutions)
+{
+  m_implementation->solve(rhs, solutions);
+}
+
 void ConstantPoissonStrategy::on_parameters_changed_event(common::SignalArgs& args)
 {
   common::XML::SignalOptions options(args);
@@ -0,0 +1,643 @@
+// Copyright (C) 2010-2013 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+
+#include <boost/assign/list_of.hpp>
+
+#include "Epetra_CrsMatrix.h"
+#include "Epetra_Import.h"
+#include "Epetra_Vector.h"
+
+#include "Teuchos_RCP.hpp"
+
+#include "common/Builder.hpp"
+#include "common/Log.hpp"
+#include "common/OptionList.hpp"
+#include "common/PE/Comm.hpp"
+#include "common/StringConversion.hpp"
+
+#include "TrilinosCrsMatrix.hpp"
+#include "TrilinosVector.hpp"
+#include "MixedPrecisionStrategy.hpp"
+
+namespace cf3 {
+namespace math {
+namespace LSS {
+
+common::ComponentBuilder<MixedPrecisionStrategy, SolutionStrategy, LibLSS> MixedPrecisionStrategy_builder;
+
+struct MixedPrecisionStrategy::Implementation
+{
+  Implementation(common::Component& self) :
+    m_self(self),
+    m_nb_rows(0),
+    m_residual_norm(0.)
+  {
+  }
+
+  void solve()
+  {
+    if(is_null(m_rhs))
+      throw common::SetupError(FromHere(), "Null RHS for " + m_self.uri().path());
+
+    if(is_null(m_solution))
+      throw common::SetupError(FromHere(), "Null solution vector for " + m_self.uri().path());
+
+    prepare();
+    solve_one(*m_solution->epetra_vector(), *m_rhs->epetra_vector());
+  }
+
+  void solve(const std::vector< Handle<Vector> >& rhs, const std::vector< Handle<Vector> >& solutions)
+  {
+    if(solutions.size() != rhs.size())
+      throw common::BadValue(FromHere(), "Got " + common::to_str(rhs.size()) + " right hand sides but " + common::to_str(solutions.size()) + " solution vectors for " + m_self.uri().path());
+
+    if(rhs.empty())
+      return;
+
+    prepare();
+    const Uint nb_rhs = rhs.size();
+    for(Uint i = 0; i != nb_rhs; ++i)
+    {
+      Handle<TrilinosVector> rhs_i(rhs[i]);
+      Handle<TrilinosVector> sol_i(solutions[i]);
+      if(is_null(rhs_i) || is_null(sol_i))
+        throw common::SetupError(FromHere(), "Null or non-Trilinos vector at position " + common::to_str(i) + " for " + m_self.uri().path());
+      solve_one(*sol_i->epetra_vector(), *rhs_i->epetra_vector());
+    }
+  }
+
+  Real compute_residual()
+  {
+    if(is_null(m_rhs) || is_null(m_solution))
+      throw common::SetupError(FromHere(), "Incomplete system for " + m_self.uri().path());
+
+    if(m_row_ptr.empty())
+      prepare();
+
+    return residual(*m_solution->epetra_vector(), *m_rhs->epetra_vector(), m_correction_rhs);
+  }
+
+  /// Copy the matrix values to single precision and build the preconditioner. Called for each solve, since the matrix values may change.
+  void prepare()
+  {
+    if(is_null(m_matrix))
+      throw common::SetupError(FromHere(), "Null or non-CRS matrix for " + m_self.uri().path() + ". Mixed precision solves require a TrilinosCrsMatrix");
+
+    const Epetra_CrsMatrix& mat = *m_matrix->epetra_matrix();
+    const int nb_rows = mat.NumMyRows();
+    const int nb_cols = mat.NumMyCols();
+    m_nb_rows = nb_rows;
+
+    m_row_ptr.resize(nb_rows+1);
+    m_columns.resize(mat.NumMyNonzeros());
+    m_values.resize(mat.NumMyNonzeros());
+    m_row_ptr[0] = 0;
+    for(int i = 0; i != nb_rows; ++i)
+    {
+      int nb_entries;
+      double* values;
+      int* indices;
+      mat.ExtractMyRowView(i, nb_entries, values, indices);
+      const int row_begin = m_row_ptr[i];
+      for(int j = 0; j != nb_entries; ++j)
+      {
+        m_columns[row_begin+j] = indices[j];
+        m_values[row_begin+j] = static_cast<float>(values[j]);
+      }
+      m_row_ptr[i+1] = row_begin + nb_entries;
+    }
+
+    if(m_ghost_exchange.is_null() || m_ghost_exchange->MyLength() != nb_cols)
+    {
+      m_ghost_exchange = Teuchos::rcp(new Epetra_Vector(mat.ColMap()));
+      m_owned_exchange = Teuchos::rcp(new Epetra_Vector(mat.DomainMap()));
+    }
+    m_x_col.resize(nb_cols);
+    m_correction.resize(nb_rows);
+    m_correction_rhs.resize(nb_rows);
+
+    build_preconditioner();
+  }
+
+  /// Build the single precision preconditioner for the rows owned by this process
+  void build_preconditioner()
+  {
+    const std::string preconditioner = m_self.options().value<std::string>("preconditioner");
+    const int n = m_nb_rows;
+
+    m_inverse_diagonal.clear();
+    m_ilu_row_ptr.clear();
+    m_ilu_columns.clear();
+    m_ilu_values.clear();
+    m_ilu_diagonal.clear();
+
+    if(preconditioner == "jacobi")
+    {
+      m_inverse_diagonal.assign(n, 1.f);
+      for(int i = 0; i != n; ++i)
+      {
+        for(int p = m_row_ptr[i]; p != m_row_ptr[i+1]; ++p)
+        {
+          if(m_columns[p] == i && m_values[p] != 0.f)
+            m_inverse_diagonal[i] = 1.f / m_values[p];
+        }
+      }
+    }
+    else if(preconditioner == "ilu0")
+    {
+      // Copy the process-local block with sorted columns, dropping the couplings with ghost columns
+      m_ilu_row_ptr.reserve(n+1);
+      m_ilu_row_ptr.push_back(0);
+      m_ilu_columns.reserve(m_columns.size());
+      m_ilu_values.reserve(m_values.size());
+      m_ilu_diagonal.resize(n);
+      std::vector< std::pair<int, float> > row;
+      for(int i = 0; i != n; ++i)
+      {
+        row.clear();
+        for(int p = m_row_ptr[i]; p != m_row_ptr[i+1]; ++p)
+        {
+          if(m_columns[p] < n)
+            row.push_back(std::make_pair(m_columns[p], m_values[p]));
+        }
+        std::sort(row.begin(), row.end());
+
+        m_ilu_diagonal[i] = -1;
+        for(std::vector< std::pair<int, float> >::const_iterator it = row.begin(); it != row.end(); ++it)
+        {
+          if(it->first == i)
+            m_ilu_diagonal[i] = m_ilu_columns.size();
+          m_ilu_columns.push_back(it->first);
+          m_ilu_values.push_back(it->second);
+        }
+        if(m_ilu_diagonal[i] == -1)
+          throw common::SetupError(FromHere(), "Row " + common::to_str(i) + " has no diagonal entry, ILU(0) is impossible for " + m_self.uri().path());
+        m_ilu_row_ptr.push_back(m_ilu_columns.size());
+      }
+
+      // In-place factorization, keeping the sparsity pattern
+      std::vector<int> position(n, -1);
+      for(int i = 0; i != n; ++i)
+      {
+        const int row_begin = m_ilu_row_ptr[i];
+        const int row_end = m_ilu_row_ptr[i+1];
+        for(int p = row_begin; p != row_end; ++p)
+          position[m_ilu_columns[p]] = p;
+
+        for(int p = row_begin; p != m_ilu_diagonal[i]; ++p)
+        {
+          const int k = m_ilu_columns[p];
+          m_ilu_values[p] /= m_ilu_values[m_ilu_diagonal[k]];
+          for(int q = m_ilu_diagonal[k]+1; q != m_ilu_row_ptr[k+1]; ++q)
+          {
+            const int pos = position[m_ilu_columns[q]];
+            if(pos != -1)
+              m_ilu_values[pos] -= m_ilu_values[p] * m_ilu_values[q];
+          }
+        }
+
+        for(int p = row_begin; p != row_end; ++p)
+          position[m_ilu_columns[p]] = -1;
+
+        if(m_ilu_values[m_ilu_diagonal[i]] == 0.f)
+          throw common::SetupError(FromHere(), "Zero pivot in row " + common::to_str(i) + " during ILU(0) factorization for " + m_self.uri().path());
+      }
+    }
+  }
+
+  /// z = M^-1 v
+  void apply_preconditioner(const std::vector<float>& v, std::vector<float>& z) const
+  {
+    const int n = m_nb_rows;
+    if(!m_inverse_diagonal.empty())
+    {
+      for(int i = 0; i != n; ++i)
+        z[i] = m_inverse_diagonal[i] * v[i];
+    }
+    else if(!m_ilu_diagonal.empty())
+    {
+      for(int i = 0; i != n; ++i)
+      {
+        float sum = v[i];
+        for(int p = m_ilu_row_ptr[i]; p != m_ilu_diagonal[i]; ++p)
+          sum -= m_ilu_values[p] * z[m_ilu_columns[p]];
+        z[i] = sum;
+      }
+      for(int i = n-1; i >= 0; --i)
+      {
+        float sum = z[i];
+        for(int p = m_ilu_diagonal[i]+1; p != m_ilu_row_ptr[i+1]; ++p)
+          sum -= m_ilu_values[p] * z[m_ilu_columns[p]];
+        z[i] = sum / m_ilu_values[m_ilu_diagonal[i]];
+      }
+    }
+    else
+    {
+      std::copy(v.begin(), v.begin() + n, z.begin());
+    }
+  }
+
+  /// Fill the ghost part of m_ghost_exchange from its owned part
+  void exchange_ghosts()
+  {
+    const Epetra_Import* importer = m_matrix->epetra_matrix()->Importer();
+    if(importer == 0)
+      return;
+
+    for(int i = 0; i != m_nb_rows; ++i)
+      (*m_owned_exchange)[i] = (*m_ghost_exchange)[i];
+    m_ghost_exchange->Import(*m_owned_exchange, *importer, Insert);
+  }
+
+  /// y = A x in single precision. Only the ghost exchange is done in double precision.
+  void multiply(const std::vector<float>& x, std::vector<float>& y)
+  {
+    const int n = m_nb_rows;
+    const int nb_cols = m_x_col.size();
+    if(nb_cols != n)
+    {
+      for(int i = 0; i != n; ++i)
+        (*m_ghost_exchange)[i] = x[i];
+      exchange_ghosts();
+      for(int i = n; i != nb_cols; ++i)
+        m_x_col[i] = static_cast<float>((*m_ghost_exchange)[i]);
+    }
+    std::copy(x.begin(), x.begin() + n, m_x_col.begin());
+
+    for(int i = 0; i != n; ++i)
+    {
+      float sum = 0.f;
+      for(int p = m_row_ptr[i]; p != m_row_ptr[i+1]; ++p)
+        sum += m_values[p] * m_x_col[m_columns[p]];
+      y[i] = sum;
+    }
+  }
+
+  /// Compute r = b - A x in double precision, using the original matrix. Returns the norm, and stores the normalized residual in single precision.
+  Real residual(const Epetra_Vector& x, const Epetra_Vector& b, std::vector<float>& r)
+  {
+    const Epetra_CrsMatrix& mat = *m_matrix->epetra_matrix();
+    const int n = m_nb_rows;
+
+    for(int i = 0; i != n; ++i)
+      (*m_ghost_exchange)[i] = x[i];
+    exchange_ghosts();
+    const Epetra_Vector& x_col = *m_ghost_exchange;
+
+    std::vector<Real> residual_values(n);
+    Real local_norm = 0.;
+    for(int i = 0; i != n; ++i)
+    {
+      int nb_entries;
+      double* values;
+      int* indices;
+      mat.ExtractMyRowView(i, nb_entries, values, indices);
+      Real sum = b[i];
+      for(int j = 0; j != nb_entries; ++j)
+        sum -= values[j] * x_col[indices[j]];
+      residual_values[i] = sum;
+      local_norm += sum*sum;
+    }
+
+    const Real norm = std::sqrt(global_sum(local_norm));
+    // Scaling avoids underflow in single precision once the residual gets small
+    const Real scale = norm == 0. ? 0. : 1. / norm;
+    for(int i = 0; i != n; ++i)
+      r[i] = static_cast<float>(residual_values[i] * scale);
+
+    return norm;
+  }
+
+  Real global_sum(Real local) const
+  {
+    Real result = local;
+    if(common::PE::Comm::instance().is_active())
+      common::PE::Comm::instance().all_reduce(common::PE::plus(), &local, 1, &result);
+    return result;
+  }
+
+  /// Sum of each of the values over all processes, in a single reduction
+  void global_sum(std::vector<Real>& values) const
+  {
+    if(common::PE::Comm::instance().is_active() && !values.empty())
+    {
+      const std::vector<Real> local(values);
+      common::PE::Comm::instance().all_reduce(common::PE::plus(), &local[0], local.size(), &values[0]);
+    }
+  }
+
+  /// One pass of classical Gram-Schmidt, removing the components along the first nb_vectors basis vectors from the work vector.
+  /// The dot products and the squared norm of the work vector are reduced together, so each pass needs one all_reduce.
+  /// The dot products are added to h, and the squared norms before and after the projection are returned.
+  void project_work(const Uint nb_vectors, std::vector<Real>& h, Real& norm_sq_before, Real& norm_sq_after)
+  {
+    m_dots.assign(nb_vectors+1, 0.);
+    for(Uint k = 0; k != nb_vectors; ++k)
+    {
+      const std::vector<float>& v = m_basis[k];
+      Real sum = 0.;
+      for(int i = 0; i != m_nb_rows; ++i)
+        sum += static_cast<Real>(m_work[i]) * v[i];
+      m_dots[k] = sum;
+    }
+    Real sum = 0.;
+    for(int i = 0; i != m_nb_rows; ++i)
+      sum += static_cast<Real>(m_work[i]) * m_work[i];
+    m_dots[nb_vectors] = sum;
+    global_sum(m_dots);
+
+    norm_sq_before = m_dots[nb_vectors];
+    norm_sq_after = norm_sq_before;
+    for(Uint k = 0; k != nb_vectors; ++k)
+    {
+      const Real hk = m_dots[k];
+      h[k] += hk;
+      norm_sq_after -= hk*hk;
+      const float hf = static_cast<float>(hk);
+      const std::vector<float>& v = m_basis[k];
+      for(int i = 0; i != m_nb_rows; ++i)
+        m_work[i] -= hf * v[i];
+    }
+  }
+
+  Real dot(const std::vector<float>& a, const std::vector<float>& b) const
+  {
+    Real result = 0.;
+    for(int i = 0; i != m_nb_rows; ++i)
+      result += static_cast<Real>(a[i]) * b[i];
+    return global_sum(result);
+  }
+
+  /// Approximately solve A d = rhs with right-preconditioned, restarted GMRES in single precision. Returns the number of iterations.
+  Uint gmres(const std::vector<float>& rhs, std::vector<float>& d)
+  {
+    const int n = m_nb_rows;
+    const Uint krylov_size = m_self.options().value<Uint>("krylov_size");
+    const Uint max_iterations = m_self.options().value<Uint>("max_inner_iterations");
+    const Real tolerance = m_self.options().value<Real>("inner_tolerance");
+
+    std::fill(d.begin(), d.end(), 0.f);
+    const Real rhs_norm = std::sqrt(dot(rhs, rhs));
+    if(rhs_norm == 0.)
+      return 0;
+
+    m_basis.resize(krylov_size+1);
+    m_preconditioned_basis.resize(krylov_size);
+    for(Uint k = 0; k != krylov_size; ++k)
+    {
+      m_basis[k].resize(n);
+      m_preconditioned_basis[k].resize(n);
+    }
+    m_basis[krylov_size].resize(n);
+    m_work.resize(n);
+    m_h.resize(krylov_size);
+
+    std::vector< std::vector<Real> > hessenberg(krylov_size+1, std::vector<Real>(krylov_size));
+    std::vector<Real> g(krylov_size+1), cs(krylov_size), sn(krylov_size), y(krylov_size);
+
+    std::copy(rhs.begin(), rhs.begin() + n, m_basis[0].begin());
+    Real beta = rhs_norm;
+    Uint nb_iterations = 0;
+    bool converged = false;
+    while(true)
+    {
+      const float inv_beta = static_cast<float>(1. / beta);
+      for(int i = 0; i != n; ++i)
+        m_basis[0][i] *= inv_beta;
+      std::fill(g.begin(), g.end(), 0.);
+      g[0] = beta;
+
+      Uint j = 0;
+      while(j != krylov_size && nb_iterations != max_iterations && !converged)
+      {
+        apply_preconditioner(m_basis[j], m_preconditioned_basis[j]);
+        multiply(m_preconditioned_basis[j], m_work);
+
+        // Classical Gram-Schmidt with a single reduction, the norm of the new vector following from the Pythagorean theorem.
+        // If most of the vector is cancelled, that norm is inaccurate and the vector is not orthogonal enough,
+        // so a second pass is done (DGKS criterion), which takes a second reduction.
+        std::fill(m_h.begin(), m_h.begin() + j + 1, 0.);
+        Real norm_sq_before, norm_sq_after;
+        project_work(j+1, m_h, norm_sq_before, norm_sq_after);
+        if(norm_sq_after <= 0.5*norm_sq_before)
+          project_work(j+1, m_h, norm_sq_before, norm_sq_after);
+        for(Uint k = 0; k <= j; ++k)
+          hessenberg[k][j] = m_h[k];
+        const Real h_next = std::sqrt(std::max(norm_sq_after, 0.));
+        hessenberg[j+1][j] = h_next;
+        if(h_next != 0.)
+        {
+          const float inv_h = static_cast<float>(1. / h_next);
+          for(int i = 0; i != n; ++i)
+            m_basis[j+1][i] = m_work[i] * inv_h;
+        }
+
+        // Apply the previous Givens rotations and compute the new one
+        for(Uint k = 0; k != j; ++k)
+        {
+          const Real t = cs[k]*hessenberg[k][j] + sn[k]*hessenberg[k+1][j];
+          hessenberg[k+1][j] = -sn[k]*hessenberg[k][j] + cs[k]*hessenberg[k+1][j];
+          hessenberg[k][j] = t;
+        }
+        const Real denominator = std::sqrt(hessenberg[j][j]*hessenberg[j][j] + h_next*h_next);
+        cs[j] = hessenberg[j][j] / denominator;
+        sn[j] = h_next / denominator;
+        hessenberg[j][j] = denominator;
+        hessenberg[j+1][j] = 0.;
+        g[j+1] = -sn[j]*g[j];
+        g[j] = cs[j]*g[j];
+
+        converged = std::abs(g[j+1]) <= tolerance*rhs_norm || h_next == 0.;
+        ++j;
+        ++nb_iterations;
+      }
+
+      // Update the correction with the least squares solution in the Krylov space
+      for(int i = static_cast<int>(j)-1; i >= 0; --i)
+      {
+        Real sum = g[i];
+        for(Uint k = i+1; k != j; ++k)
+          sum -= hessenberg[i][k] * y[k];
+        y[i] = sum / hessenberg[i][i];
+      }
+      for(Uint k = 0; k != j; ++k)
+      {
+        const float yk = static_cast<float>(y[k]);
+        for(int i = 0; i != n; ++i)
+          d[i] += yk * m_preconditioned_basis[k][i];
+      }
+
+      if(converged || nb_iterations == max_iterations || j == 0)
+        break;
+
+      // Restart from the true residual of the single precision system
+      multiply(d, m_work);
+      for(int i = 0; i != n; ++i)
+        m_basis[0][i] = rhs[i] - m_work[i];
+      beta = std::sqrt(dot(m_basis[0], m_basis[0]));
+      if(beta <= tolerance*rhs_norm)
+        break;
+    }
+
+    return nb_iterations;
+  }
+
+  /// Iterative refinement: the residual and the update of x are done in double precision, the corrections in single precision
+  void solve_one(Epetra_Vector& x, const Epetra_Vector& b)
+  {
+    const Real tolerance = m_self.options().value<Real>("tolerance");
+    const Uint max_refinements = m_self.options().value<Uint>("max_refinements");
+    const int n = m_nb_rows;
+
+    Real local_b_norm = 0.;
+    for(int i = 0; i != n; ++i)
+      local_b_norm += b[i]*b[i];
+    Real b_norm = std::sqrt(global_sum(local_b_norm));
+    if(b_norm == 0.)
+      b_norm = 1.;
+
+    Uint nb_refinements = 0;
+    Uint nb_inner_iterations = 0;
+    m_residual_norm = residual(x, b, m_correction_rhs);
+    while(m_residual_norm > tolerance*b_norm && nb_refinements != max_refinements)
+    {
+      nb_inner_iterations += gmres(m_correction_rhs, m_correction);
+      for(int i = 0; i != n; ++i)
+        x[i] += m_residual_norm * m_correction[i];
+      m_residual_norm = residual(x, b, m_correction_rhs);
+      ++nb_refinements;
+    }
+
+    CFinfo << "Mixed precision refinement " << (m_residual_norm <= tolerance*b_norm ? "converged" : "did not converge") << " after " << nb_refinements
+           << " refinements and " << nb_inner_iterations << " single precision iterations, relative residual " << m_residual_norm / b_norm << CFendl;
+  }
+
+  common::Component& m_self;
+
+  Handle<TrilinosCrsMatrix> m_matrix;
+  Handle<TrilinosVector> m_rhs;
+  Handle<TrilinosVector> m_solution;
+
+  /// Number of rows owned by this process
+  int m_nb_rows;
+
+  /// Single precision copy of the matrix, in local CSR format with the column indices of the Epetra column map
+  std::vector<int> m_row_ptr;
+  std::vector<int> m_columns;
+  std::vector<float> m_values;
+
+  /// Jacobi preconditioner
+  std::vector<float> m_inverse_diagonal;
+
+  /// ILU(0) factors of the process-local block, with the position of the diagonal in each row
+  std::vector<int> m_ilu_row_ptr;
+  std::vector<int> m_ilu_columns;
+  std::vector<float> m_ilu_values;
+  std::vector<int> m_ilu_diagonal;
+
+  /// Buffers used to update the ghost values of a vector
+  Teuchos::RCP<Epetra_Vector> m_ghost_exchange;
+  Teuchos::RCP<Epetra_Vector> m_owned_exchange;
+  std::vector<float> m_x_col;
+
+  /// Work vectors
+  std::vector<float> m_correction;
+  std::vector<float> m_correction_rhs;
+  std::vector<float> m_work;
+  std::vector< std::vector<float> > m_basis;
+  std::vector< std::vector<float> > m_preconditioned_basis;
+  /// Gram-Schmidt coefficients of the current Arnoldi step, and the buffer for their reduction
+  std::vector<Real> m_h;
+  std::vector<Real> m_dots;
+
+  /// Norm of the residual at the end of the last solve
+  Real m_residual_norm;
+};
+
+MixedPrecisionStrategy::MixedPrecisionStrategy(const string& name) :
+  SolutionStrategy(name),
+  m_implementation(new Implementation(*this))
+{
+  options().add("tolerance", 1e-8)
+    .pretty_name("Tolerance")
+    .description("Reduction of the residual norm, relative to the norm of the right hand side, computed in double precision")
+    .mark_basic();
+
+  options().add("max_refinements", 20u)
+    .pretty_name("Maximum Refinements")
+    .description("Maximum number of double precision residual corrections")
+    .mark_basic();
+
+  options().add("inner_tolerance", 1e-3)
+    .pretty_name("Inner Tolerance")
+    .description("Relative residual reduction for each single precision correction solve. Values below 1e-6 are pointless in single precision")
+    .mark_basic();
+
+  options().add("max_inner_iterations", 200u)
+    .pretty_name("Maximum Inner Iterations")
+    .description("Maximum number of single precision GMRES iterations for each correction")
+    .mark_basic();
+
+  options().add("krylov_size", 30u)
+    .pretty_name("Krylov Size")
+    .description("Number of GMRES iterations before a restart")
+    .mark_basic();
+
+  std::vector<boost::any> preconditioners = boost::assign::list_of<boost::any>
+    (std::string("ilu0"))
+    (std::string("jacobi"))
+    (std::string("none"));
+  options().add("preconditioner", std::string("ilu0"))
+    .pretty_name("Preconditioner")
+    .description("Single precision preconditioner, applied to the rows owned by each process: ilu0, jacobi or none")
+    .mark_basic()
+    .restricted_list() = preconditioners;
+}
+
+MixedPrecisionStrategy::~MixedPrecisionStrategy()
+{
+}
+
+Real MixedPrecisionStrategy::compute_residual()
+{
+  return m_implementation->compute_residual();
+}
+
+void MixedPrecisionStrategy::set_rhs(const Handle< Vector >& rhs)
+{
+  m_implementation->m_rhs = Handle<TrilinosVector>(rhs);
+}
+
+void MixedPrecisionStrategy::set_solution(const Handle< Vector >& solution)
+{
+  m_implementation->m_solution = Handle<TrilinosVector>(solution);
+}
+
+void MixedPrecisionStrategy::set_matrix(const Handle< Matrix >& matrix)
+{
+  m_implementation->m_matrix = Handle<TrilinosCrsMatrix>(matrix);
+}
+
+void MixedPrecisionStrategy::solve()
+{
+  m_implementation->solve();
+}
+
+void MixedPrecisionStrategy::solve(const std::vector< Handle<Vector> >& rhs, const std::vector< Handle<Vector> >& solutions)
+{
+  m_implementation->solve(rhs, solutions);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace LSS
+} // namespace math
+} // namespace cf3
@@ -0,0 +1,58 @@
+// Copyright (C) 2010-2013 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef cf3_Math_LSS_MixedPrecisionStrategy_hpp
+#define cf3_Math_LSS_MixedPrecisionStrategy_hpp
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <boost/scoped_ptr.hpp>
+
+#include "math/LSS/SolutionStrategy.hpp"
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ *  @file MixedPrecisionStrategy.hpp Mixed precision iterative refinement
+ **/
+////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace cf3 {
+namespace math {
+namespace LSS {
+
+/// Solves the system using iterative refinement: the residual and the solution update are computed in double precision,
+/// while the correction equation is solved approximately by a restarted GMRES working on a single precision copy of the matrix
+/// and a single precision preconditioner (ILU(0) or Jacobi on the process-local block).
+/// This halves the memory traffic of the inner iterations, which dominate the cost of bandwidth-bound solves.
+/// The matrix must be a TrilinosCrsMatrix.
+class LSS_API MixedPrecisionStrategy : public SolutionStrategy
+{
+public:
+  MixedPrecisionStrategy(const std::string& name);
+  ~MixedPrecisionStrategy();
+
+  /// name of the type
+  static std::string type_name () { return "MixedPrecisionStrategy"; }
+
+  void set_matrix(const Handle<LSS::Matrix>& matrix);
+  void set_rhs(const Handle<LSS::Vector>& rhs);
+  void set_solution(const Handle<LSS::Vector>& solution);
+  void solve();
+  void solve(const std::vector< Handle<LSS::Vector> >& rhs, const std::vector< Handle<LSS::Vector> >& solutions);
+  Real compute_residual();
+
+private:
+  /// Hide the implementation to avoid pulling in lots of Trilinos headers
+  struct Implementation;
+  boost::scoped_ptr<Implementation> m_implementation;
+};
+
+} // namespace LSS
+} // namespace math
+} // namespace cf3
+
+#endif // cf3_Math_LSS_MixedPrecisionStrategy_hpp
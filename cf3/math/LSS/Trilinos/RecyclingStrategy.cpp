@@ -0,0 +1,318 @@
+// Copyright (C) 2010-2013 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <boost/bind.hpp>
+
+#include "BelosLinearProblem.hpp"
+#include "BelosThyraAdapter.hpp"
+#include "BelosGCRODRSolMgr.hpp"
+
+#include "Teuchos_ConfigDefs.hpp"
+#include "Teuchos_RCP.hpp"
+
+#include "Thyra_LinearOpWithSolveBase.hpp"
+#include "Thyra_MultiVectorStdOps.hpp"
+#include "Thyra_PreconditionerFactoryHelpers.hpp"
+#include "Thyra_VectorBase.hpp"
+
+#include "Stratimikos_DefaultLinearSolverBuilder.hpp"
+
+#include "common/Builder.hpp"
+#include "common/Core.hpp"
+#include "common/EventHandler.hpp"
+#include "common/Log.hpp"
+#include "common/OptionList.hpp"
+#include "common/Signal.hpp"
+#include "common/StringConversion.hpp"
+
+#include "common/XML/SignalOptions.hpp"
+
+#include "ParameterList.hpp"
+#include "ThyraMultiVector.hpp"
+#include "ThyraOperator.hpp"
+#include "RecyclingStrategy.hpp"
+
+namespace cf3 {
+namespace math {
+namespace LSS {
+
+common::ComponentBuilder<RecyclingStrategy, SolutionStrategy, LibLSS> RecyclingStrategy_builder;
+
+struct RecyclingStrategy::Implementation
+{
+  typedef Thyra::MultiVectorBase<Real> MV;
+  typedef Thyra::LinearOpBase<Real> OP;
+
+  Implementation(common::Component& self) :
+    m_self(self),
+    m_solver_parameter_list(Teuchos::createParameterList()),
+    m_preconditioner_parameter_list(Teuchos::createParameterList()),
+    m_nb_solves(0),
+    m_system_size(0)
+  {
+    // Default solver parameters
+    m_solver_parameter_list->set( "Verbosity", Belos::Errors | Belos::Warnings | Belos::FinalSummary );
+    m_solver_parameter_list->set( "Maximum Iterations", 500 );
+    m_solver_parameter_list->set( "Convergence Tolerance", 1.0e-8 );
+    m_solver_parameter_list->set( "Num Blocks", 50 );
+    m_solver_parameter_list->set( "Num Recycled Blocks", 20 );
+
+    // Default preconditioner, using the Stratimikos names
+    m_preconditioner_parameter_list->set("Preconditioner Type", "Ifpack");
+    m_preconditioner_parameter_list->sublist("Preconditioner Types").sublist("Ifpack").set("Prec Type", "ILU");
+    m_linear_solver_builder.setParameterList(m_preconditioner_parameter_list);
+
+    update_parameters();
+  }
+
+  void solve()
+  {
+    if(is_null(m_rhs))
+      throw common::SetupError(FromHere(), "Null RHS for " + m_self.uri().path());
+
+    if(is_null(m_solution))
+      throw common::SetupError(FromHere(), "Null solution vector for " + m_self.uri().path());
+
+    prepare();
+    const Teuchos::RCP<const OP> op = m_matrix->thyra_operator();
+    solve_one(m_solution->thyra_vector(op->domain()), m_rhs->thyra_vector(op->range()));
+  }
+
+  /// The right hand sides are solved in sequence, so each solve benefits from the space recycled by the previous ones
+  void solve(const std::vector< Handle<Vector> >& rhs, const std::vector< Handle<Vector> >& solutions)
+  {
+    if(solutions.size() != rhs.size())
+      throw common::BadValue(FromHere(), "Got " + common::to_str(rhs.size()) + " right hand sides but " + common::to_str(solutions.size()) + " solution vectors for " + m_self.uri().path());
+
+    if(rhs.empty())
+      return;
+
+    prepare();
+    const Teuchos::RCP<const OP> op = m_matrix->thyra_operator();
+    const Uint nb_rhs = rhs.size();
+    for(Uint i = 0; i != nb_rhs; ++i)
+    {
+      Handle<ThyraMultiVector> rhs_i(rhs[i]);
+      Handle<ThyraMultiVector> sol_i(solutions[i]);
+      if(is_null(rhs_i) || is_null(sol_i))
+        throw common::SetupError(FromHere(), "Null or non-Thyra vector at position " + common::to_str(i) + " for " + m_self.uri().path());
+      solve_one(sol_i->thyra_vector(op->domain()), rhs_i->thyra_vector(op->range()));
+    }
+  }
+
+  /// Update the operator and the preconditioner, and discard the recycle space if it is stale
+  void prepare()
+  {
+    if(is_null(m_matrix))
+      throw common::SetupError(FromHere(), "Null matrix for " + m_self.uri().path());
+
+    const Teuchos::RCP<const OP> op = m_matrix->thyra_operator();
+
+    // Stale recycle space: the system was resized, or the maximum number of solves with the same space is reached
+    const Uint reset_interval = m_self.options().value<Uint>("reset_interval");
+    const Uint system_size = op->range()->dim();
+    if(system_size != m_system_size || (reset_interval != 0 && m_nb_solves >= reset_interval))
+    {
+      reset_solver();
+      m_system_size = system_size;
+    }
+
+    if(m_problem.is_null())
+      m_problem = Teuchos::rcp( new Belos::LinearProblem<Real,MV,OP>() );
+
+    // The matrix values may have changed since the last solve, so the operator and preconditioner are always updated
+    m_problem->setOperator(op);
+
+    if(m_preconditioner_factory.is_null())
+      m_preconditioner_factory = m_linear_solver_builder.createPreconditioningStrategy("");
+
+    if(!m_preconditioner_factory.is_null())
+    {
+      m_preconditioner = Thyra::prec<Real>(*m_preconditioner_factory, op);
+      Teuchos::RCP<const OP> prec_op = m_preconditioner->getUnspecifiedPrecOp();
+      if(prec_op.is_null())
+        prec_op = m_preconditioner->getRightPrecOp();
+      m_problem->setRightPrec(prec_op);
+    }
+  }
+
+  /// Solve for a single right hand side, using the operator set up by prepare
+  void solve_one(const Teuchos::RCP<MV>& lhs, const Teuchos::RCP<const MV>& rhs)
+  {
+    m_problem->setLHS(lhs);
+    m_problem->setRHS(rhs);
+
+    if(!m_problem->setProblem())
+      throw common::SetupError(FromHere(), "Error setting up Belos problem");
+
+    if(m_solver.is_null())
+      m_solver = Teuchos::rcp(new Belos::GCRODRSolMgr<Real,MV,OP>(m_problem, m_solver_parameter_list));
+
+    const Belos::ReturnType result = m_solver->solve();
+    ++m_nb_solves;
+
+    CFinfo << "GCRODR " << (result == Belos::Converged ? "converged" : "did not converge") << " after " << m_solver->getNumIters() << " iterations" << CFendl;
+  }
+
+  Real compute_residual()
+  {
+    return -1.;
+  }
+
+  void update_parameters()
+  {
+    if(is_not_null(m_solver_parameters))
+      m_self.remove_component("SolverParameters");
+
+    m_solver_parameters = m_self.create_component<ParameterList>("SolverParameters");
+    m_solver_parameters->mark_basic();
+    m_solver_parameters->set_parameter_list(*m_solver_parameter_list);
+
+    if(is_not_null(m_preconditioner_parameters))
+      m_self.remove_component("PreconditionerParameters");
+
+    m_preconditioner_parameters = m_self.create_component<ParameterList>("PreconditionerParameters");
+    m_preconditioner_parameters->mark_basic();
+    m_preconditioner_parameters->set_parameter_list(*m_preconditioner_parameter_list);
+  }
+
+  void trigger_recycle_space_size()
+  {
+    m_solver_parameter_list->set( "Num Recycled Blocks", static_cast<int>(m_self.options().value<Uint>("recycle_space_size")) );
+    reset_solver();
+  }
+
+  void trigger_nb_blocks()
+  {
+    m_solver_parameter_list->set( "Num Blocks", static_cast<int>(m_self.options().value<Uint>("nb_blocks")) );
+    reset_solver();
+  }
+
+  /// Discard the solver, together with its recycle space
+  void reset_solver()
+  {
+    m_solver.reset();
+    m_problem.reset();
+    m_preconditioner.reset();
+    m_preconditioner_factory.reset();
+    m_nb_solves = 0;
+  }
+
+  common::Component& m_self;
+  Teuchos::RCP<Teuchos::ParameterList> m_solver_parameter_list;
+  Teuchos::RCP<Teuchos::ParameterList> m_preconditioner_parameter_list;
+  Stratimikos::DefaultLinearSolverBuilder m_linear_solver_builder;
+  Teuchos::RCP< Thyra::PreconditionerFactoryBase<Real> > m_preconditioner_factory;
+  Teuchos::RCP< Thyra::PreconditionerBase<Real> > m_preconditioner;
+  Teuchos::RCP< Belos::LinearProblem<Real,MV,OP> > m_problem;
+  Teuchos::RCP< Belos::GCRODRSolMgr<Real,MV,OP> > m_solver;
+
+  Handle<ThyraOperator> m_matrix;
+  Handle<ThyraMultiVector> m_rhs;
+  Handle<ThyraMultiVector> m_solution;
+  Handle<ParameterList> m_solver_parameters;
+  Handle<ParameterList> m_preconditioner_parameters;
+
+  /// Number of solves done with the current recycle space
+  Uint m_nb_solves;
+
+  /// Number of rows of the system that was solved last
+  Uint m_system_size;
+};
+
+RecyclingStrategy::RecyclingStrategy(const string& name) :
+  SolutionStrategy(name),
+  m_implementation(new Implementation(*this))
+{
+  options().add("recycle_space_size", 20u)
+    .pretty_name("Recycle Space Size")
+    .description("Number of vectors kept in the recycle space between solves")
+    .attach_trigger(boost::bind(&Implementation::trigger_recycle_space_size, m_implementation.get()))
+    .mark_basic();
+
+  options().add("nb_blocks", 50u)
+    .pretty_name("Number of Blocks")
+    .description("Maximum number of vectors in the Krylov space before a restart")
+    .attach_trigger(boost::bind(&Implementation::trigger_nb_blocks, m_implementation.get()))
+    .mark_basic();
+
+  options().add("reset_interval", 0u)
+    .pretty_name("Reset Interval")
+    .description("Number of solves after which the recycle space is discarded. 0 keeps it until the matrix or the system size changes")
+    .mark_basic();
+
+  regist_signal( "reset_recycle_space" )
+    .connect( boost::bind( &RecyclingStrategy::signal_reset_recycle_space, this, _1 ) )
+    .description("Discard the recycle space, e.g. after a large change of the system")
+    .pretty_name("Reset Recycle Space");
+
+  common::Core::instance().event_handler().connect_to_event("trilinos_parameters_changed", this, &RecyclingStrategy::on_parameters_changed_event);
+}
+
+RecyclingStrategy::~RecyclingStrategy()
+{
+}
+
+Real RecyclingStrategy::compute_residual()
+{
+  return m_implementation->compute_residual();
+}
+
+void RecyclingStrategy::set_rhs(const Handle< Vector >& rhs)
+{
+  m_implementation->m_rhs = Handle<ThyraMultiVector>(rhs);
+}
+
+void RecyclingStrategy::set_solution(const Handle< Vector >& solution)
+{
+  m_implementation->m_solution = Handle<ThyraMultiVector>(solution);
+}
+
+void RecyclingStrategy::set_matrix(const Handle< Matrix >& matrix)
+{
+  // A new matrix means a new sparsity pattern, so the recycle space is no longer usable
+  m_implementation->m_matrix = Handle<ThyraOperator>(matrix);
+  m_implementation->reset_solver();
+}
+
+void RecyclingStrategy::solve()
+{
+  m_implementation->solve();
+}
+
+void RecyclingStrategy::solve(const std::vector< Handle<Vector> >& rhs, const std::vector< Handle<Vector> >& solutions)
+{
+  m_implementation->solve(rhs, solutions);
+}
+
+void RecyclingStrategy::signal_reset_recycle_space(common::SignalArgs& args)
+{
+  m_implementation->reset_solver();
+}
+
+void RecyclingStrategy::on_parameters_changed_event(common::SignalArgs& args)
+{
+  common::XML::SignalOptions options(args);
+  const common::URI parameters_uri = options.value<common::URI>("parameters_uri");
+
+  if(boost::starts_with(parameters_uri.path(), uri().path()))
+  {
+    CFdebug << "Acting on trilinos_parameters_changed event from paramater list " << parameters_uri.string() << CFendl;
+    m_implementation->reset_solver();
+  }
+  else
+  {
+    CFdebug << "Ignoring trilinos_parameters_changed event from paramater list " << parameters_uri.string() << CFendl;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace LSS
+} // namespace math
+} // namespace cf3
@@ -0,0 +1,61 @@
+// Copyright (C) 2010-2013 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef cf3_Math_LSS_RecyclingStrategy_hpp
+#define cf3_Math_LSS_RecyclingStrategy_hpp
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <boost/scoped_ptr.hpp>
+
+#include "math/LSS/SolutionStrategy.hpp"
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+ *  @file RecyclingStrategy.hpp Solution strategy that recycles Krylov subspaces between successive solves, using Belos GCRODR
+ **/
+////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace cf3 {
+namespace math {
+namespace LSS {
+
+/// Solves a sequence of slowly changing, possibly nonsymmetric systems with GCRODR. The recycle space is kept between calls to solve,
+/// while the operator and the preconditioner are updated for each solve, so the matrix values may change.
+/// The recycle space is reset when a new matrix is set, when the size of the system changes, every reset_interval solves or when
+/// the reset_recycle_space signal is called.
+class LSS_API RecyclingStrategy : public SolutionStrategy
+{
+public:
+  RecyclingStrategy(const std::string& name);
+  ~RecyclingStrategy();
+
+  /// name of the type
+  static std::string type_name () { return "RecyclingStrategy"; }
+
+  void set_matrix(const Handle<LSS::Matrix>& matrix);
+  void set_rhs(const Handle<LSS::Vector>& rhs);
+  void set_solution(const Handle<LSS::Vector>& solution);
+  void solve();
+  void solve(const std::vector< Handle<LSS::Vector> >& rhs, const std::vector< Handle<LSS::Vector> >& solutions);
+  Real compute_residual();
+
+  /// Discard the recycle space, so the next solve starts from scratch
+  void signal_reset_recycle_space(common::SignalArgs& args);
+
+private:
+  void on_parameters_changed_event(common::SignalArgs& args);
+  /// Hide the implementation to avoid pulling in lots of Trilinos headers
+  struct Implementation;
+  boost::scoped_ptr<Implementation> m_implementation;
+};
+
+} // namespace LSS
+} // namespace math
+} // namespace cf3
+
+#endif // cf3_Math_LSS_RecyclingStrategy_hpp
@@ -6,7 +6,10 @@
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <iostream>
+#include <limits>
+#include <numeric>
 
 #include <boost/pointer_cast.hpp>
 
@@ -36,6 +39,7 @@
 #include "common/OptionList.hpp"
 #include "common/OptionT.hpp"
 #include "common/PropertyList.hpp"
+#include "common/StringConversion.hpp"
 #include "math/LSS/Trilinos/TrilinosCrsMatrix.hpp"
 #include "math/LSS/Trilinos/TrilinosDetail.hpp"
 #include "math/LSS/Trilinos/TrilinosVector.hpp"
@@ -130,17 +134,17 @@ void TrilinosCrsMatrix::create_blocked(common::PE::CommPattern& cp, const Variab
 
   // prepare intermediate data
   std::vector<int> num_indices_per_row;
-  std::vector<int> my_global_elements;
+  std::vector<EpetraGid> my_global_elements;
 
   create_map_data(cp, vars, m_p2m, my_global_elements, m_num_my_elements);
   create_nb_indices_per_row(cp, vars, starting_indices, num_indices_per_row);
 
   // rowmap, ghosts not present
-  Epetra_Map rowmap(-1,m_num_my_elements,&my_global_elements[0],0,m_comm);
+  Epetra_Map rowmap(static_cast<EpetraGid>(-1),m_num_my_elements,&my_global_elements[0],0,m_comm);
 
   // colmap, has ghosts at the end
   const Uint nb_nodes_for_rank = cp.isUpdatable().size();
-  Epetra_Map colmap(-1,nb_nodes_for_rank*total_nb_eq,&my_global_elements[0],0,m_comm);
+  Epetra_Map colmap(static_cast<EpetraGid>(-1),nb_nodes_for_rank*total_nb_eq,&my_global_elements[0],0,m_comm);
   my_global_elements.clear();
 
   // Create the graph, using static profile for performance
@@ -185,10 +189,19 @@ void TrilinosCrsMatrix::create_blocked(common::PE::CommPattern& cp, const Variab
   TRILINOS_THROW(m_mat->FillComplete());
   TRILINOS_THROW(m_mat->OptimizeStorage());
 
+  m_var_offsets.clear();
+  for(Uint var_idx = 0; var_idx != vars.nb_vars(); ++var_idx)
+    m_var_offsets.push_back(vars.offset(var_idx));
+  m_var_offsets.push_back(total_nb_eq);
+
   // set class properties
   m_is_created=true;
   m_neq=total_nb_eq;
+#ifdef CF3_ENABLE_64BIT_GLOBAL_INDICES
+  CFdebug << "Rank " << common::PE::Comm::instance().rank() << ": Created a " << m_mat->NumGlobalCols64() << " x " << m_mat->NumGlobalRows64() << " trilinos matrix with " << m_mat->NumGlobalNonzeros64() << " non-zero elements and " << m_num_my_elements << " local rows" << CFendl;
+#else
   CFdebug << "Rank " << common::PE::Comm::instance().rank() << ": Created a " << m_mat->NumGlobalCols() << " x " << m_mat->NumGlobalRows() << " trilinos matrix with " << m_mat->NumGlobalNonzeros() << " non-zero elements and " << m_num_my_elements << " local rows" << CFendl;
+#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////
@@ -201,6 +214,7 @@ void TrilinosCrsMatrix::destroy()
   }
   m_p2m.resize(0);
   m_p2m.reserve(0);
+  m_var_offsets.clear();
   m_neq=0;
   m_num_my_elements=0;
   m_is_created=false;
@@ -208,6 +222,48 @@ void TrilinosCrsMatrix::destroy()
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 
+void TrilinosCrsMatrix::block_global_indices(const std::vector<Uint>& vars_per_block, std::vector< std::vector<int> >& block_gids) const
+{
+  cf3_assert(m_is_created);
+
+  const Uint nb_variables = nb_vars();
+  std::vector<Uint> block_sizes(vars_per_block);
+  if(block_sizes.empty())
+    block_sizes.assign(nb_variables, 1);
+
+  if(std::accumulate(block_sizes.begin(), block_sizes.end(), 0u) != nb_variables)
+    throw common::BadValue(FromHere(), "Variable blocks for " + uri().path() + " cover " + common::to_str(std::accumulate(block_sizes.begin(), block_sizes.end(), 0u)) + " variables, but the matrix has " + common::to_str(nb_variables));
+
+  // Rows are stored per variable, so the rows of a block are contiguous in the row map
+  const Epetra_Map& rowmap = m_mat->RowMap();
+  const int nb_local_nodes = m_num_my_elements / m_neq;
+  const Uint nb_blocks = block_sizes.size();
+  block_gids.resize(nb_blocks);
+  Uint first_var = 0;
+  for(Uint block_idx = 0; block_idx != nb_blocks; ++block_idx)
+  {
+    const int begin = nb_local_nodes*m_var_offsets[first_var];
+    first_var += block_sizes[block_idx];
+    const int end = nb_local_nodes*m_var_offsets[first_var];
+    std::vector<int>& gids = block_gids[block_idx];
+    gids.resize(end - begin);
+    for(int i = begin; i != end; ++i)
+    {
+#ifdef CF3_ENABLE_64BIT_GLOBAL_INDICES
+      // The Teko blocking only takes int global indices
+      const long long gid = rowmap.GID64(i);
+      if(gid > std::numeric_limits<int>::max())
+        throw common::NotSupported(FromHere(), "Global index " + common::to_str(gid) + " of " + uri().path() + " exceeds the int indices supported by block preconditioning");
+      gids[i-begin] = static_cast<int>(gid);
+#else
+      gids[i-begin] = rowmap.GID(i);
+#endif
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
 void TrilinosCrsMatrix::set_value(const Uint icol, const Uint irow, const Real value)
 {
   cf3_assert(m_is_created);
@@ -426,6 +482,71 @@ void TrilinosCrsMatrix::symmetric_dirichlet(const Uint blockrow, const Uint ieq,
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 
+void TrilinosCrsMatrix::symmetric_dirichlet(const std::vector<Uint>& blockrows, const std::vector<Uint>& ieqs, const std::vector<Real>& values, Vector& rhs)
+{
+  cf3_assert(m_is_created);
+  const Uint nb_bcs = blockrows.size();
+  cf3_assert(ieqs.size() == nb_bcs);
+  cf3_assert(values.size() == nb_bcs);
+  if(nb_bcs == 0)
+    return;
+
+  // For each local column, the index of its boundary condition value or -1 if it is free
+  std::vector<int> bc_idx(m_p2m.size(), -1);
+
+  // Nodes whose rows may contain a constrained column, each one visited once
+  std::vector<int> nodes;
+  for(Uint i = 0; i != nb_bcs; ++i)
+  {
+    bc_idx[m_p2m[blockrows[i]*m_neq+ieqs[i]]] = i;
+    nodes.insert(nodes.end(), m_node_connectivity.begin() + m_starting_indices[blockrows[i]], m_node_connectivity.begin() + m_starting_indices[blockrows[i]+1]);
+  }
+  std::sort(nodes.begin(), nodes.end());
+  nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+
+  int num_entries;
+  Real* extracted_values;
+  int* extracted_indices;
+
+  const Uint nb_nodes = nodes.size();
+  for(Uint node_idx = 0; node_idx != nb_nodes; ++node_idx)
+  {
+    const int node = nodes[node_idx];
+    for(int j = 0; j != m_neq; ++j)
+    {
+      const int row = m_p2m[node*m_neq+j];
+      if(row >= m_num_my_elements)
+        continue;
+
+      TRILINOS_THROW(m_mat->ExtractMyRowView(row, num_entries, extracted_values, extracted_indices));
+      if(bc_idx[row] != -1)
+      {
+        // Constrained row: only the diagonal remains
+        for(int k = 0; k != num_entries; ++k)
+          extracted_values[k] = extracted_indices[k] == row ? 1. : 0.;
+      }
+      else
+      {
+        // Free row: move the constrained columns to the RHS
+        for(int k = 0; k != num_entries; ++k)
+        {
+          const int idx = bc_idx[extracted_indices[k]];
+          if(idx != -1)
+          {
+            rhs.add_value(node, j, -extracted_values[k] * values[idx]);
+            extracted_values[k] = 0;
+          }
+        }
+      }
+    }
+  }
+
+  for(Uint i = 0; i != nb_bcs; ++i)
+    rhs.set_value(blockrows[i], ieqs[i], values[i]);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
 void TrilinosCrsMatrix::tie_blockrow_pairs (const Uint iblockrow_to, const Uint iblockrow_from)
 {
   cf3_assert(m_is_created);
@@ -100,6 +100,7 @@ public:
   void get_column_and_replace_to_zero(const Uint iblockcol, Uint ieq, std::vector<Real>& values);
 
   virtual void symmetric_dirichlet(const Uint blockrow, const Uint ieq, const Real value, Vector& rhs);
+  virtual void symmetric_dirichlet(const std::vector<Uint>& blockrows, const std::vector<Uint>& ieqs, const std::vector<Real>& values, Vector& rhs);
 
   /// Add one line to another and tie to it via dirichlet-style (applying periodicity)
   void tie_blockrow_pairs (const Uint iblockrow_to, const Uint iblockrow_from);
@@ -162,6 +163,14 @@ public:
     return m_p2m[inode*m_neq+ieq];
   }
 
+  /// Number of variables in the VariablesDescriptor used to create the matrix (1 if it was created using create)
+  Uint nb_vars() const { return m_var_offsets.empty() ? 0 : m_var_offsets.size() - 1; }
+
+  /// Get the global row indices owned by this process, grouped in blocks of consecutive variables.
+  /// Block i contains the rows of the next vars_per_block[i] variables, and the sum of vars_per_block must equal nb_vars().
+  /// If vars_per_block is empty, each variable gets its own block.
+  void block_global_indices(const std::vector<Uint>& vars_per_block, std::vector< std::vector<int> >& block_gids) const;
+
   //@} END MISCELLANEOUS
 
   /// @name TEST ONLY
@@ -201,6 +210,9 @@ private:
 
   /// Copy of the connectivity data
   std::vector<int> m_node_connectivity, m_starting_indices;
+
+  /// Offset of each variable in the equations of a node, with the total number of equations appended
+  std::vector<Uint> m_var_offsets;
 }; // end of class Matrix
 
 ////////////////////////////////////////////////////////////////////////////////////////////
@@ -6,9 +6,17 @@
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <limits>
+
+#include <boost/cstdint.hpp>
+
+#include "Epetra_ConfigDefs.h"
+
+#include "common/BasicExceptions.hpp"
 #include "common/PE/Comm.hpp"
 #include "common/PE/CommPattern.hpp"
 #include "common/Log.hpp"
+#include "common/StringConversion.hpp"
 
 #include "math/VariablesDescriptor.hpp"
 
@@ -25,14 +33,38 @@
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 
+#if defined(CF3_ENABLE_64BIT_GLOBAL_INDICES) && defined(EPETRA_NO_64BIT_GLOBAL_INDICES)
+#error "CF3_ENABLE_64BIT_GLOBAL_INDICES requires Trilinos to be built with 64-bit Epetra global indices"
+#endif
+
 namespace cf3 {
 namespace math {
 namespace LSS {
 
-void create_map_data(common::PE::CommPattern& cp, const VariablesDescriptor& variables, std::vector< int >& p2m, std::vector< int >& my_global_elements, int& num_my_elements)
+template<typename GidT>
+void convert_gids(common::PE::CommPattern& cp, std::vector<GidT>& gids)
+{
+  std::vector<Gid> cp_gids;
+  cp.gid()->pack(cp_gids);
+  gids.resize(cp_gids.size());
+  for(Uint i = 0; i != cp_gids.size(); ++i)
+  {
+    if(static_cast<boost::uint64_t>(cp_gids[i]) > static_cast<boost::uint64_t>(std::numeric_limits<GidT>::max()))
+      throw common::BadValue(FromHere(), "Global index " + common::to_str(cp_gids[i]) + " exceeds the range of the Trilinos global indices");
+    gids[i] = static_cast<GidT>(cp_gids[i]);
+  }
+}
+
+template void convert_gids<int>(common::PE::CommPattern& cp, std::vector<int>& gids);
+#ifdef CF3_ENABLE_64BIT_GLOBAL_INDICES
+template void convert_gids<EpetraGid>(common::PE::CommPattern& cp, std::vector<EpetraGid>& gids);
+#endif
+
+void create_map_data(common::PE::CommPattern& cp, const VariablesDescriptor& variables, std::vector< int >& p2m, std::vector< EpetraGid >& my_global_elements, int& num_my_elements)
 {
   // get global ids vector
-  int *gid=(int*)cp.gid()->pack();
+  std::vector<EpetraGid> gid;
+  convert_gids(cp, gid);
   num_my_elements = 0;
 
   const Uint nb_vars = variables.nb_vars();
@@ -42,26 +74,29 @@ void create_map_data(common::PE::CommPattern& cp, const VariablesDescriptor& var
   my_global_elements.reserve(nb_nodes_for_rank*total_nb_eq);
 
   // Get the maximum gid, for per-equation blocked storage
-  int local_max_gid = 0;
-  int global_nb_gid = 0;
+  EpetraGid local_max_gid = 0;
+  EpetraGid global_nb_gid = 0;
   for(Uint i = 0; i != nb_nodes_for_rank; ++i)
     local_max_gid = gid[i] > local_max_gid ? gid[i] : local_max_gid;
 
   common::PE::Comm::instance().all_reduce(common::PE::max(), &local_max_gid, 1, &global_nb_gid);
   ++global_nb_gid; // number of GIDs is the maximum + 1
+  const boost::uint64_t global_nb_eq = static_cast<boost::uint64_t>(global_nb_gid) * total_nb_eq;
+  if(global_nb_eq > static_cast<boost::uint64_t>(std::numeric_limits<EpetraGid>::max()))
+    throw common::BadValue(FromHere(), "Number of equations " + common::to_str(global_nb_eq) + " exceeds the range of the Trilinos global indices");
   CFdebug << "Number of GIDs: " << global_nb_gid << CFendl;
 
   for(Uint var_idx = 0; var_idx != nb_vars; ++var_idx)
   {
     const Uint neq = variables.var_length(var_idx);
     const Uint var_offset = variables.offset(var_idx);
-    const int var_start_gid = var_offset * global_nb_gid;
+    const EpetraGid var_start_gid = var_offset * global_nb_gid;
     for (int i=0; i<nb_nodes_for_rank; i++)
     {
       if (cp.isUpdatable()[i])
       {
         num_my_elements += neq;
-        const int start_gid = var_start_gid + gid[i]*neq;
+        const EpetraGid start_gid = var_start_gid + gid[i]*neq;
         for(int j = 0; j != neq; ++j)
         {
           my_global_elements.push_back(start_gid+j);
@@ -102,19 +137,17 @@ void create_map_data(common::PE::CommPattern& cp, const VariablesDescriptor& var
   {
     const Uint neq = variables.var_length(var_idx);
     const Uint var_offset = variables.offset(var_idx);
-    const int var_start_gid = var_offset * global_nb_gid;
+    const EpetraGid var_start_gid = var_offset * global_nb_gid;
     for (int i=0; i<nb_nodes_for_rank; i++)
     {
       if (!cp.isUpdatable()[i])
       {
-        const int start_gid = var_start_gid + gid[i]*neq;
+        const EpetraGid start_gid = var_start_gid + gid[i]*neq;
         for(int j = 0; j != neq; ++j)
           my_global_elements.push_back(start_gid+j);
       }
     }
   }
-
-  delete[] gid;
 }
 
 
@@ -27,6 +27,22 @@ namespace math {
   class VariablesDescriptor;
 namespace LSS {
 
+/// Type of the global indices in the Epetra maps.
+/// Epetra offers a separate long long interface, which is used when CF3_ENABLE_64BIT_GLOBAL_INDICES is set,
+/// so the number of unknowns is not limited to the range of int.
+#ifdef CF3_ENABLE_64BIT_GLOBAL_INDICES
+typedef long long EpetraGid;
+#else
+typedef int EpetraGid;
+#endif
+
+/// Copy the global node indices of the comm pattern to the index type used by Epetra.
+/// Throws if a global index does not fit in GidT.
+/// @param cp The comm pattern that governs the node distribution
+/// @param gids The global indices, as GidT (int or EpetraGid)
+template<typename GidT>
+void convert_gids(cf3::common::PE::CommPattern& cp, std::vector<GidT>& gids);
+
 /// Create a local node index to matrix local index lookup
 /// @param cp The comm pattern that governs the node distribution
 /// @param variables The variables to use. Equations will be grouped per variable
@@ -36,7 +52,7 @@ namespace LSS {
 void create_map_data(cf3::common::PE::CommPattern& cp,
                       const VariablesDescriptor& variables,
                       std::vector<int>& p2m,
-                      std::vector<int>& my_global_elements,
+                      std::vector<EpetraGid>& my_global_elements,
                       int& num_my_elements);
 
 } // namespace LSS
@@ -6,6 +6,7 @@
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <iostream>
 
 #include <boost/pointer_cast.hpp>
@@ -28,6 +29,7 @@
 #include "common/OptionList.hpp"
 #include "common/OptionT.hpp"
 #include "common/PropertyList.hpp"
+#include "math/LSS/Trilinos/TrilinosDetail.hpp"
 #include "math/LSS/Trilinos/TrilinosFEVbrMatrix.hpp"
 #include "math/LSS/Trilinos/TrilinosVector.hpp"
 
@@ -102,8 +104,9 @@ void TrilinosFEVbrMatrix::create(cf3::common::PE::CommPattern& cp, const Uint ne
 //     }
 //   }
 
-  // get global ids vector
-  int *gid=(int*)cp.gid()->pack();
+  // get global ids vector, Epetra_VbrMatrix only supports int global indices
+  std::vector<int> gid;
+  convert_gids(cp, gid);
 
   // prepare intermediate data
   int nmyglobalelements=0;
@@ -169,7 +172,6 @@ void TrilinosFEVbrMatrix::create(cf3::common::PE::CommPattern& cp, const Uint ne
     }
   TRILINOS_THROW(m_mat->FillComplete());
   //TRILINOS_THROW(m_mat->OptimizeStorage()); // in theory fillcomplete calls optimizestorage from Trilinos 8.x+
-  delete[] gid;
 
   // set class properties
   m_is_created=true;
@@ -598,6 +600,86 @@ void TrilinosFEVbrMatrix::symmetric_dirichlet(const Uint blockrow, const Uint ie
   rhs.set_value(blockrow, ieq, value);
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void TrilinosFEVbrMatrix::symmetric_dirichlet(const std::vector<Uint>& blockrows, const std::vector<Uint>& ieqs, const std::vector<Real>& values, Vector& rhs)
+{
+  cf3_assert(m_is_created);
+  const Uint nb_bcs = blockrows.size();
+  cf3_assert(ieqs.size() == nb_bcs);
+  cf3_assert(values.size() == nb_bcs);
+  if(nb_bcs == 0)
+    return;
+
+  // For each local block column and equation, the index of its boundary condition value or -1 if it is free
+  std::vector<int> bc_idx(m_blockcol_size*m_neq, -1);
+
+  // Nodes whose block rows may contain a constrained column, each one visited once
+  std::vector<int> nodes;
+  for(Uint i = 0; i != nb_bcs; ++i)
+  {
+    bc_idx[m_p2m[blockrows[i]]*m_neq+ieqs[i]] = i;
+    nodes.insert(nodes.end(), m_node_connectivity.begin() + m_starting_indices[blockrows[i]], m_node_connectivity.begin() + m_starting_indices[blockrows[i]+1]);
+  }
+  std::sort(nodes.begin(), nodes.end());
+  nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+
+  Epetra_SerialDenseMatrix **val;
+  int* colindices;
+  int blockrowsize;
+  int dummy_neq;
+
+  const Uint nb_nodes = nodes.size();
+  for(Uint node_idx = 0; node_idx != nb_nodes; ++node_idx)
+  {
+    const int node = nodes[node_idx];
+    const int row = m_p2m[node];
+    if(row >= static_cast<int>(m_blockrow_size))
+      continue;
+
+    TRILINOS_THROW(m_mat->ExtractMyBlockRowView(row,dummy_neq,blockrowsize,colindices,val));
+
+    // Move the constrained columns to the RHS
+    for(int i = 0; i != blockrowsize; ++i)
+    {
+      for(int e = 0; e != m_neq; ++e)
+      {
+        const int idx = bc_idx[colindices[i]*m_neq+e];
+        if(idx == -1)
+          continue;
+
+        for(int j = 0; j != m_neq; ++j)
+        {
+          rhs.add_value(node, j, -val[i][0](j, e) * values[idx]);
+          val[i][0](j, e) = 0;
+        }
+      }
+    }
+
+    // Constrained rows: only the diagonal remains
+    for(int e = 0; e != m_neq; ++e)
+    {
+      if(bc_idx[row*m_neq+e] == -1)
+        continue;
+
+      for(int i = 0; i != blockrowsize; ++i)
+      {
+        for(int j = 0; j != m_neq; ++j)
+        {
+          val[i][0](e, j) = 0;
+        }
+        if(colindices[i] == row)
+        {
+          val[i][0](e, e) = 1.;
+        }
+      }
+    }
+  }
+
+  for(Uint i = 0; i != nb_bcs; ++i)
+    rhs.set_value(blockrows[i], ieqs[i], values[i]);
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -21,12 +21,15 @@
 #include "Thyra_LinearOpWithSolveBase.hpp"
 #include "Thyra_VectorBase.hpp"
 #include "Thyra_MultiVectorStdOps.hpp"
+#include "Thyra_VectorStdOps.hpp"
+#include "Thyra_VectorSpaceBase.hpp"
 
 #include "Stratimikos_DefaultLinearSolverBuilder.hpp"
 
 #include "common/Builder.hpp"
 #include "common/EventHandler.hpp"
 #include "common/OptionList.hpp"
+#include "common/StringConversion.hpp"
 
 #include "ParameterList.hpp"
 #include "ThyraMultiVector.hpp"
@@ -133,6 +136,54 @@ struct TrilinosStratimikosStrategy::Implementation
     if(is_null(m_solution))
       throw common::SetupError(FromHere(), "Null solution vector for " + m_self.uri().path());
 
+    initialize_operator();
+
+    Thyra::SolveStatus<double> status = Thyra::solve<double>(*m_lows, Thyra::NOTRANS, *m_rhs->thyra_vector(m_matrix->thyra_operator()->range()), m_solution->thyra_vector(m_matrix->thyra_operator()->domain()).ptr());
+    CFinfo << "Thyra::solve finished with status " << status.message << CFendl;
+    if(m_self.options().option("compute_residual").value<bool>())
+      CFinfo << "Solver residual: " << compute_residual() << CFendl;
+  }
+
+  void solve(const std::vector< Handle<Vector> >& rhs, const std::vector< Handle<Vector> >& solutions)
+  {
+    if(is_null(m_matrix))
+      throw common::SetupError(FromHere(), "Null matrix for " + m_self.uri().path());
+
+    const Uint nb_rhs = rhs.size();
+    if(solutions.size() != nb_rhs)
+      throw common::BadValue(FromHere(), "Got " + common::to_str(nb_rhs) + " right hand sides but " + common::to_str(solutions.size()) + " solution vectors for " + m_self.uri().path());
+    if(nb_rhs == 0)
+      return;
+
+    initialize_operator();
+
+    const Teuchos::RCP<const Thyra::LinearOpBase<Real> > op = m_matrix->thyra_operator();
+
+    // Gather the vectors as columns of a single multivector, so the solver handles all of them in one block solve
+    const Teuchos::RCP< Thyra::MultiVectorBase<Real> > b = Thyra::createMembers(op->range(), nb_rhs);
+    const Teuchos::RCP< Thyra::MultiVectorBase<Real> > x = Thyra::createMembers(op->domain(), nb_rhs);
+    for(Uint i = 0; i != nb_rhs; ++i)
+    {
+      Handle<ThyraMultiVector> rhs_i(rhs[i]);
+      Handle<ThyraMultiVector> sol_i(solutions[i]);
+      if(is_null(rhs_i) || is_null(sol_i))
+        throw common::SetupError(FromHere(), "Null or non-Thyra vector at position " + common::to_str(i) + " for " + m_self.uri().path());
+      Thyra::assign(b->col(i).ptr(), *rhs_i->thyra_vector(op->range())->col(0));
+      Thyra::assign(x->col(i).ptr(), *sol_i->thyra_vector(op->domain())->col(0));
+    }
+
+    Thyra::SolveStatus<double> status = Thyra::solve<double>(*m_lows, Thyra::NOTRANS, *b, x.ptr());
+    CFinfo << "Thyra::solve for " << nb_rhs << " right hand sides finished with status " << status.message << CFendl;
+
+    for(Uint i = 0; i != nb_rhs; ++i)
+    {
+      Thyra::assign(Handle<ThyraMultiVector>(solutions[i])->thyra_vector(op->domain())->col(0).ptr(), *x->col(i));
+    }
+  }
+
+  /// Create the solve operator if needed and (re)initialize it with the current matrix
+  void initialize_operator()
+  {
     if(m_lows.is_null())
     {
       if(m_self.options().option("print_settings").value<bool>())
@@ -142,11 +193,6 @@ struct TrilinosStratimikosStrategy::Implementation
     }
 
     Thyra::initializeOp(*m_lows_factory, m_matrix->thyra_operator(), m_lows.ptr());
-
-    Thyra::SolveStatus<double> status = Thyra::solve<double>(*m_lows, Thyra::NOTRANS, *m_rhs->thyra_vector(m_matrix->thyra_operator()->range()), m_solution->thyra_vector(m_matrix->thyra_operator()->domain()).ptr());
-    CFinfo << "Thyra::solve finished with status " << status.message << CFendl;
-    if(m_self.options().option("compute_residual").value<bool>())
-      CFinfo << "Solver residual: " << compute_residual() << CFendl;
   }
 
   Real compute_residual()
@@ -237,6 +283,11 @@ void TrilinosStratimikosStrategy::solve()
   m_implementation->solve();
 }
 
+void TrilinosStratimikosStrategy::solve(const std::vector< Handle<Vector> >& rhs, const std::vector< Handle<Vector> >& solutions)
+{
+  m_implementation->solve(rhs, solutions);
+}
+
 Real TrilinosStratimikosStrategy::compute_residual()
 {
   return m_implementation->compute_residual();
@@ -43,6 +43,7 @@ public:
   void set_rhs(const Handle<LSS::Vector>& rhs);
   void set_solution(const Handle<LSS::Vector>& solution);
   void solve();
+  void solve(const std::vector< Handle<LSS::Vector> >& rhs, const std::vector< Handle<LSS::Vector> >& solutions);
   Real compute_residual();
 
   /// Construct default parameters using the builder for a ParameterListDefaults object.
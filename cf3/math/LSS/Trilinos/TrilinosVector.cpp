@@ -73,12 +73,12 @@ void TrilinosVector::create_blocked(common::PE::CommPattern& cp, const Variables
 
   // prepare intermediate data
   int nmyglobalelements=0;
-  std::vector<int> myglobalelements(0);
+  std::vector<EpetraGid> myglobalelements(0);
 
   create_map_data(cp, vars, m_p2m, myglobalelements, nmyglobalelements);
 
   // map (its actually blockmap insteady of rowmap, to involve ghosts)
-  Epetra_Map map(-1,cp.isUpdatable().size()*vars.size(),&myglobalelements[0],0,m_comm);
+  Epetra_Map map(static_cast<EpetraGid>(-1),cp.isUpdatable().size()*vars.size(),&myglobalelements[0],0,m_comm);
 
   // create vector
   m_vec=Teuchos::rcp(new Epetra_Vector(map));
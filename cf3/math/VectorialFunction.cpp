@@ -4,11 +4,14 @@
 // GNU Lesser General Public License version 3 (LGPLv3).
 // See doc/lgpl.txt and doc/gpl.txt for the license text.
 
+#include <cctype>
+
 #include <boost/tokenizer.hpp>
 
 #include "common/Log.hpp"
 #include "common/BasicExceptions.hpp"
 #include "common/StringConversion.hpp"
+#include "common/Table.hpp"
 
 #include "math/VectorialFunction.hpp"
 #include "math/Consts.hpp"
@@ -171,6 +174,9 @@ void VectorialFunction::parse()
       msg += " Vars: ["    + m_vars + "]";
       throw common::ParsingFailed (FromHere(),msg);
     }
+
+    // fold constant sub-expressions and simplify the bytecode
+    ptr->Optimize();
   }
 
   m_result.resize(m_functions.size());
@@ -213,6 +219,59 @@ RealVector& VectorialFunction::operator()( const RealVector& var_values)
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void VectorialFunction::evaluate_batch( const Table<Real>& var_values, Table<Real>& ret_values ) const
+{
+  cf3_assert(m_is_parsed);
+
+  if( var_values.row_size() != m_nbvars )
+    throw BadValue(FromHere(), "Table of variables has " + to_str(var_values.row_size()) +
+                   " columns, while the function has " + to_str(m_nbvars) + " variables");
+
+  const Uint nb_pts = var_values.size();
+  if( ret_values.row_size() != m_parsers.size() )
+    ret_values.set_row_size(m_parsers.size());
+  if( ret_values.size() != nb_pts )
+    ret_values.resize(nb_pts);
+
+  // no variables: the table has no storage to point into
+  const std::vector<Real> no_vars(1, 0.);
+
+  for(Uint i = 0; i != m_parsers.size(); ++i)
+  {
+    FunctionParser& parser = *m_parsers[i];
+    for(Uint pt = 0; pt != nb_pts; ++pt)
+      ret_values[pt][i] = parser.Eval( m_nbvars ? &var_values[pt][0] : &no_vars[0] );
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool VectorialFunction::depends_on( const std::string& var, const Uint func ) const
+{
+  const Uint begin = func == std::numeric_limits<Uint>::max() ? 0 : func;
+  const Uint end = func == std::numeric_limits<Uint>::max() ? m_functions.size() : func+1;
+  cf3_assert(end <= m_functions.size());
+
+  // look for the variable as an identifier, i.e. not as part of a longer name
+  for(Uint i = begin; i != end; ++i)
+  {
+    const std::string& function = m_functions[i];
+    std::string::size_type pos = function.find(var);
+    while( pos != std::string::npos )
+    {
+      const std::string::size_type after = pos + var.size();
+      const bool starts = pos == 0 || !( std::isalnum(function[pos-1]) || function[pos-1] == '_' );
+      const bool ends = after == function.size() || !( std::isalnum(function[after]) || function[after] == '_' );
+      if( starts && ends )
+        return true;
+      pos = function.find(var, pos+1);
+    }
+  }
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 } // math
 } // cf3
 
@@ -9,6 +9,8 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <limits>
+
 #include "fparser/fparser.hh"
 
 #include "common/BasicExceptions.hpp"
@@ -19,6 +21,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace cf3 {
+  namespace common { template <typename ValueT> class Table; }
 
   namespace math {
 
@@ -59,6 +62,15 @@ public: // functions
   template <typename var_t, typename ret_t>
   void evaluate( const var_t& var_values, ret_t& ret_value) const;
 
+  /// Evaluate the Vectorial Function for a batch of points.
+  /// The loop runs over the points for one function at a time, so that the
+  /// bytecode of each function stays in cache.
+  /// @param var_values table with the values of the variables of one point in each row
+  /// @param ret_values table in which the values of the functions of each point are stored,
+  ///                   resized to the number of points and functions if needed
+  /// @throw BadValue if the number of columns of var_values is not the number of variables
+  void evaluate_batch( const common::Table<Real>& var_values, common::Table<Real>& ret_values ) const;
+
   /// Evaluate the Vectorial Function given the values of the variables
   /// and return it in the stored result. This function allows this class to work
   /// as a functor.
@@ -74,6 +86,13 @@ public: // functions
   /// @return if the VectorialFunctionParser has been parsed yet.
   bool is_parsed() const { return m_is_parsed; }
 
+  /// Checks if a function uses a variable, e.g. to know if results can be
+  /// kept when only the time changes.
+  /// @param var name of the variable
+  /// @param func index of the function. If not given, all functions are checked.
+  /// @returns true if the variable appears in the function
+  bool depends_on( const std::string& var, const Uint func = std::numeric_limits<Uint>::max() ) const;
+
   /// sets the function strings to be parsed
   void functions( const std::vector<std::string>& functions );
 
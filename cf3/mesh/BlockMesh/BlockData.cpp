@@ -1704,7 +1704,7 @@ void BlockArrays::create_mesh(Mesh& mesh)
 
   if(PE::Comm::instance().is_active())
   {
-    common::List<Uint>& gids = mesh.geometry_fields().glb_idx(); gids.resize(nb_nodes_local + m_implementation->ghost_counter);
+    common::List<Gid>& gids = mesh.geometry_fields().glb_idx(); gids.resize(nb_nodes_local + m_implementation->ghost_counter);
     common::List<Uint>& ranks = mesh.geometry_fields().rank(); ranks.resize(nb_nodes_local + m_implementation->ghost_counter);
 
     // Local nodes
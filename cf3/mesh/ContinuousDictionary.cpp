@@ -37,6 +37,7 @@
 #include "math/Hilbert.hpp"
 #include "math/BoundingBox.hpp"
 #define UNKNOWN math::Consts::uint_max()
+#define UNKNOWN_GID math::Consts::gid_max()
 
 namespace cf3 {
 namespace mesh {
@@ -144,7 +145,7 @@ void ContinuousDictionary::rebuild_spaces_from_geometry()
         connectivity[elem][node] = idx;
         coordinates.set_row(idx, space_coordinates);
         rank()[idx] = UNKNOWN;
-        glb_idx()[idx] = UNKNOWN;
+        glb_idx()[idx] = UNKNOWN_GID;
       }
     }
   }
@@ -249,9 +250,9 @@ void ContinuousDictionary::rebuild_spaces_from_geometry()
   if( Comm::instance().is_active() )
     Comm::instance().all_gather(nb_owned, nb_owned_per_proc);
 
-  std::vector<Uint> start_id_per_proc(Comm::instance().size());
+  std::vector<Gid> start_id_per_proc(Comm::instance().size());
 
-  Uint start_id=0;
+  Gid start_id=0;
   for (Uint p=0; p<Comm::instance().size(); ++p)
   {
     start_id_per_proc[p] = start_id;
@@ -263,7 +264,7 @@ void ContinuousDictionary::rebuild_spaces_from_geometry()
     if (! is_ghost(i))
       glb_idx()[i] = start_id++;
     else
-      glb_idx()[i] = UNKNOWN;
+      glb_idx()[i] = UNKNOWN_GID;
   }
 
   std::vector< std::vector<boost::uint64_t> > recv_ghosts_hashed(Comm::instance().size());
@@ -273,10 +274,10 @@ void ContinuousDictionary::rebuild_spaces_from_geometry()
     recv_ghosts_hashed[0] = ghosts_hashed;
 
   // - Search this process contains the missing ranks of other processes
-  std::vector< std::vector<Uint> > send_glb_idx_on_rank(Comm::instance().size());
+  std::vector< std::vector<Gid> > send_glb_idx_on_rank(Comm::instance().size());
   for (Uint p=0; p<Comm::instance().size(); ++p)
   {
-    send_glb_idx_on_rank[p].resize(recv_ghosts_hashed[p].size(),UNKNOWN);
+    send_glb_idx_on_rank[p].resize(recv_ghosts_hashed[p].size(),UNKNOWN_GID);
     if (p!=Comm::instance().rank())
     {
       for (Uint h=0; h<recv_ghosts_hashed[p].size(); ++h)
@@ -291,7 +292,7 @@ void ContinuousDictionary::rebuild_spaces_from_geometry()
   }
 
   // - Communicate which processes found the missing ghosts
-  std::vector< std::vector<Uint> > recv_glb_idx_on_rank(Comm::instance().size());
+  std::vector< std::vector<Gid> > recv_glb_idx_on_rank(Comm::instance().size());
   if (Comm::instance().is_active())
     Comm::instance().all_to_all(send_glb_idx_on_rank,recv_glb_idx_on_rank);
   else
@@ -348,3 +349,4 @@ void ContinuousDictionary::rebuild_node_to_element_connectivity()
 } // cf3
 
 #undef UNKNOWN
+#undef UNKNOWN_GID
@@ -63,7 +63,7 @@ Dictionary::Dictionary ( const std::string& name  ) :
   m_rank = create_static_component< common::List<Uint> >("rank");
   m_rank->add_tag("rank");
 
-  m_glb_idx = create_static_component< common::List<Uint> >(mesh::Tags::global_indices());
+  m_glb_idx = create_static_component< common::List<Gid> >(mesh::Tags::global_indices());
   m_glb_idx->add_tag(mesh::Tags::global_indices());
 
   m_glb_to_loc = create_static_component< common::Map<boost::uint64_t,Uint> >(mesh::Tags::map_global_to_local());
@@ -144,6 +144,27 @@ CommPattern& Dictionary::comm_pattern()
 
 //////////////////////////////////////////////////////////////////////////////
 
+void Dictionary::rebuild_comm_pattern()
+{
+  if(is_null(m_comm_pattern))
+    return;
+
+  std::vector< Handle<Field> > parallelized_fields;
+  boost_foreach(Field& field, find_components<Field>(*this))
+  {
+    if(is_not_null(m_comm_pattern->get_child(field.name())))
+      parallelized_fields.push_back(field.handle<Field>());
+  }
+
+  remove_component(*m_comm_pattern);
+  m_comm_pattern.reset();
+
+  boost_foreach(const Handle<Field>& field, parallelized_fields)
+    field->parallelize_with(comm_pattern());
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 bool Dictionary::is_ghost(const Uint idx) const
 {
   cf3_assert_desc(to_str(idx)+">="+to_str(size()),idx < size());
@@ -172,7 +193,7 @@ const Handle< Space const>& Dictionary::space(const Handle<Entities const>& enti
 
 ////////////////////////////////////////////////////////////////////////////////
 
-Field& Dictionary::create_field(const std::string &name, const Uint cols)
+Field& Dictionary::create_field(const std::string &name, const Uint cols, const Uint row_alignment)
 {
   Handle<Field> field = create_component<Field>(name);
   field->set_dict(*this);
@@ -181,6 +202,7 @@ Field& Dictionary::create_field(const std::string &name, const Uint cols)
   // @todo remove next line when ready
   field->create_descriptor(name+"["+to_str(cols)+"]",m_dim);
 
+  field->set_row_alignment(row_alignment);
   field->set_row_size(cols);
   field->resize(size());
 
@@ -191,7 +213,7 @@ Field& Dictionary::create_field(const std::string &name, const Uint cols)
 
 ////////////////////////////////////////////////////////////////////////////////
 
-Field& Dictionary::create_field(const std::string &name, const VarType var_type)
+Field& Dictionary::create_field(const std::string &name, const VarType var_type, const Uint row_alignment)
 {
   if (var_type == ARRAY)
     throw SetupError(FromHere(), "Should not call this for array types. use create_field(name,cols)");
@@ -208,6 +230,7 @@ Field& Dictionary::create_field(const std::string &name, const VarType var_type)
   else if (var_type == TENSOR_2D || var_type == TENSOR_3D)
     field->create_descriptor(name+"[tensor]",m_dim);
 
+  field->set_row_alignment(row_alignment);
   field->set_row_size( (Uint) var_type );
   field->resize(size());
 
@@ -218,7 +241,7 @@ Field& Dictionary::create_field(const std::string &name, const VarType var_type)
 
 ////////////////////////////////////////////////////////////////////////////////
 
-Field& Dictionary::create_field(const std::string &name, const std::string& description)
+Field& Dictionary::create_field(const std::string &name, const std::string& description, const Uint row_alignment)
 {
   Handle<Field> field = create_component<Field>(name);
   field->set_dict(*this);
@@ -226,6 +249,7 @@ Field& Dictionary::create_field(const std::string &name, const std::string& desc
   // @todo remove next line when ready
   field->create_descriptor(description,m_dim);
 
+  field->set_row_alignment(row_alignment);
   field->set_row_size(field->descriptor().size());
   field->resize(size());
 
@@ -237,7 +261,7 @@ Field& Dictionary::create_field(const std::string &name, const std::string& desc
 
 ////////////////////////////////////////////////////////////////////////////////
 
-Field& Dictionary::create_field(const std::string &name, math::VariablesDescriptor& variables_descriptor)
+Field& Dictionary::create_field(const std::string &name, math::VariablesDescriptor& variables_descriptor, const Uint row_alignment)
 {
   CFinfo << "Creating field " << uri()/name << CFendl;
   if (m_dim == 0) throw SetupError(FromHere(), "dimension not configured");
@@ -248,6 +272,7 @@ Field& Dictionary::create_field(const std::string &name, math::VariablesDescript
   {
     field->descriptor().options().set(common::Tags::dimension(),m_dim);
   }
+  field->set_row_alignment(row_alignment);
   field->set_row_size(field->descriptor().size());
   field->resize(size());
 
@@ -275,7 +300,7 @@ bool Dictionary::check_sanity(std::vector<std::string>& messages) const
   if (glb_idx().size() != size())
     messages.push_back(uri().string()+": size() ["+to_str(size())+"] != glb_idx().size() ["+to_str(glb_idx().size())+"]");
 
-  std::set<Uint> unique_gids;
+  std::set<Gid> unique_gids;
   if (Comm::instance().size()>1)
   {
     for (Uint i=0; i<size(); ++i)
@@ -288,7 +313,7 @@ bool Dictionary::check_sanity(std::vector<std::string>& messages) const
     }
     for (Uint i=0; i<size(); ++i)
     {
-      std::pair<std::set<Uint>::iterator, bool > inserted = unique_gids.insert(glb_idx()[i]);
+      std::pair<std::set<Gid>::iterator, bool > inserted = unique_gids.insert(glb_idx()[i]);
       if (inserted.second == false)
       {
         messages.push_back(glb_idx().uri().string()+"["+to_str(i)+"] has non-unique entries.  (entry "+to_str(glb_idx()[i])+" exists more than once, no further checks)");
@@ -510,11 +535,11 @@ Field& Dictionary::create_coordinates()
 
 ////////////////////////////////////////////////////////////////////////////////
 
-DynTable<Uint>& Dictionary::glb_elem_connectivity()
+DynTable<Gid>& Dictionary::glb_elem_connectivity()
 {
   if (is_null(m_glb_elem_connectivity))
   {
-    m_glb_elem_connectivity = create_static_component< DynTable<Uint> >("glb_elem_connectivity");
+    m_glb_elem_connectivity = create_static_component< DynTable<Gid> >("glb_elem_connectivity");
     m_glb_elem_connectivity->add_tag("glb_elem_connectivity");
     m_glb_elem_connectivity->resize(size());
   }
@@ -54,16 +54,18 @@ public: // functions
   static std::string type_name () { return "Dictionary"; }
 
   /// Create a new field in this group
-  Field& create_field(const std::string& name, const Uint cols );
+  /// The optional row_alignment (in bytes) pads the rows of the field so each row starts at that alignment,
+  /// e.g. for aligned vector loads through Field::aligned_row. The number of values in a row is not changed.
+  Field& create_field(const std::string& name, const Uint cols, const Uint row_alignment = 0 );
 
   /// Create a new field in this group
-  Field& create_field( const std::string& name, const VarType var_type = SCALAR );
+  Field& create_field( const std::string& name, const VarType var_type = SCALAR, const Uint row_alignment = 0 );
 
   /// Create a new field in this group
-  Field& create_field( const std::string& name, const std::string& variables_description );
+  Field& create_field( const std::string& name, const std::string& variables_description, const Uint row_alignment = 0 );
 
   /// Create a new field in this group
-  Field& create_field( const std::string& name, math::VariablesDescriptor& variables_descriptor );
+  Field& create_field( const std::string& name, math::VariablesDescriptor& variables_descriptor, const Uint row_alignment = 0 );
 
   /// Number of rows of contained fields
   Uint size() const;
@@ -78,10 +80,10 @@ public: // functions
   const Handle< Space const>& space(const Handle< Entities const>& entities) const;
 
   /// Return the global index of every field row
-  common::List<Uint>& glb_idx() { return *m_glb_idx; }
+  common::List<Gid>& glb_idx() { return *m_glb_idx; }
 
   /// Return the global index of every field row
-  const common::List<Uint>& glb_idx() const { return *m_glb_idx; }
+  const common::List<Gid>& glb_idx() const { return *m_glb_idx; }
 
   /// Return the rank of every field row
   common::List<Uint>& rank() { return *m_rank; }
@@ -101,6 +103,11 @@ public: // functions
   /// Return the comm pattern valid for this field group. Created based on the glb_idx and rank if it didn't exist already
   common::PE::CommPattern& comm_pattern();
 
+  /// Rebuild the comm pattern from the current glb_idx and rank, if it was created before.
+  /// Fields that were parallelized with the old comm pattern are parallelized with the new one.
+  /// @note Collective, to be called after elements and nodes were moved between ranks
+  void rebuild_comm_pattern();
+
   /// Check if a field row is owned by this rank
   bool is_ghost(const Uint idx) const;
 
@@ -120,7 +127,7 @@ public: // functions
 
   const std::vector< Handle<Field> >& fields() const { return m_fields; }
 
-  common::DynTable<Uint>& glb_elem_connectivity();
+  common::DynTable<Gid>& glb_elem_connectivity();
 
   void signal_create_field ( common::SignalArgs& node );
 
@@ -162,10 +169,10 @@ protected: // functions
   Field& create_coordinates();
 
 protected:
-  Handle<common::List<Uint> > m_glb_idx;
+  Handle<common::List<Gid> > m_glb_idx;
   Handle<common::List<Uint> > m_rank;
   Handle<Field> m_coordinates;
-  Handle<common::DynTable<Uint> > m_glb_elem_connectivity;
+  Handle<common::DynTable<Gid> > m_glb_elem_connectivity;
   Handle<common::PE::CommPattern> m_comm_pattern;
   Handle<common::Map<boost::uint64_t,Uint> > m_glb_to_loc;
   bool m_is_continuous;
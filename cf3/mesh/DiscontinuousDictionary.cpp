@@ -34,6 +34,7 @@
 
 #include "math/Consts.hpp"
 #define UNKNOWN math::Consts::uint_max()
+#define UNKNOWN_GID math::Consts::gid_max()
 
 namespace cf3 {
 namespace mesh {
@@ -317,14 +318,14 @@ void DiscontinuousDictionary::rebuild_spaces_from_geometry()
   if (Comm::instance().is_active())
     Comm::instance().all_gather(nb_owned, nb_owned_per_proc);
 
-  std::vector<Uint> start_id_per_proc(Comm::instance().size(),0);
+  std::vector<Gid> start_id_per_proc(Comm::instance().size(),0);
   for (Uint i=0; i<Comm::instance().size(); ++i)
   {
     start_id_per_proc[i] = (i==0? 0 : start_id_per_proc[i-1]+nb_owned_per_proc[i-1]);
   }
 
   // (2)
-  Uint id = start_id_per_proc[Comm::instance().rank()];
+  Gid id = start_id_per_proc[Comm::instance().rank()];
   boost_foreach(const Handle<Entities>& entities_handle, entities_range())
   {
     Entities& entities = *entities_handle;
@@ -339,7 +340,7 @@ void DiscontinuousDictionary::rebuild_spaces_from_geometry()
       else
       {
         boost_foreach(const Uint idx, space_connectivity[e])
-            glb_idx()[idx] = UNKNOWN;
+            glb_idx()[idx] = UNKNOWN_GID;
       }
     }
   }
@@ -385,10 +386,10 @@ void DiscontinuousDictionary::rebuild_spaces_from_geometry()
     recv_ghosts_hashed[0] = ghosts_hashed;
 
   // (5) Search if this process contains the unknown ghosts of other processes
-  std::vector< std::vector<Uint> > send_glb_idx_on_rank(Comm::instance().size());
+  std::vector< std::vector<Gid> > send_glb_idx_on_rank(Comm::instance().size());
   for (Uint p=0; p<Comm::instance().size(); ++p)
   {
-    send_glb_idx_on_rank[p].resize(recv_ghosts_hashed[p].size(),UNKNOWN);
+    send_glb_idx_on_rank[p].resize(recv_ghosts_hashed[p].size(),UNKNOWN_GID);
     if (p!=Comm::instance().rank())
     {
       for (Uint h=0; h<recv_ghosts_hashed[p].size(); ++h)
@@ -406,7 +407,7 @@ void DiscontinuousDictionary::rebuild_spaces_from_geometry()
             cf3_assert_desc(to_str(hash_to_elements_iter->second.idx)+" < "+to_str(entities_space.connectivity().size()),
                             hash_to_elements_iter->second.idx < entities_space.connectivity().size());
             cf3_assert(entities_space.connectivity()[ elem_idx ][0] < glb_idx().size());
-            Uint first_glb_idx = glb_idx()[ entities_space.connectivity()[ elem_idx ][0] ];
+            Gid first_glb_idx = glb_idx()[ entities_space.connectivity()[ elem_idx ][0] ];
             send_glb_idx_on_rank[p][h] = first_glb_idx;
           }
         }
@@ -425,7 +426,7 @@ void DiscontinuousDictionary::rebuild_spaces_from_geometry()
   }
 
   // (6)
-  std::vector< std::vector<Uint> > recv_glb_idx_on_rank(Comm::instance().size());
+  std::vector< std::vector<Gid> > recv_glb_idx_on_rank(Comm::instance().size());
   if (Comm::instance().is_active())
     Comm::instance().all_to_all(send_glb_idx_on_rank,recv_glb_idx_on_rank);
   else
@@ -448,10 +449,10 @@ void DiscontinuousDictionary::rebuild_spaces_from_geometry()
     const Uint first_loc_idx = entities_space.connectivity()[elem_idx][0];
 
     const Uint ghost_rank = rank()[first_loc_idx];
-    const Uint first_glb_idx = recv_glb_idx_on_rank[ ghost_rank ][g];
+    const Gid first_glb_idx = recv_glb_idx_on_rank[ ghost_rank ][g];
 
     cf3_assert(ghost_rank < Comm::instance().size());
-    if (first_glb_idx == UNKNOWN)
+    if (first_glb_idx == UNKNOWN_GID)
       throw ValueNotFound(FromHere(), "Could  not find ghost element "+entities_space.uri().path()+"["+to_str(elem_idx)+"] with hash "+to_str(ghosts_hashed[g])+" on rank "+to_str(ghost_rank));
     for (Uint s=0; s<entities_space.shape_function().nb_nodes(); ++s)
     {
@@ -492,3 +493,4 @@ void DiscontinuousDictionary::rebuild_node_to_element_connectivity()
 } // cf3
 
 #undef UNKNOWN
+#undef UNKNOWN_GID
@@ -51,7 +51,7 @@ Entities::Entities ( const std::string& name ) :
       .pretty_name("Element type")
       .attach_trigger(boost::bind(&Entities::configure_element_type, this));
 
-  m_global_numbering = create_static_component<common::List<Uint> >(mesh::Tags::global_indices());
+  m_global_numbering = create_static_component<common::List<Gid> >(mesh::Tags::global_indices());
   m_global_numbering->add_tag(mesh::Tags::global_indices());
   m_global_numbering->properties()["brief"] = std::string("The global element indices (inter processor)");
 
@@ -206,7 +206,7 @@ bool Entities::is_ghost(const Uint idx) const
 
 
 ElementType& Entity::element_type() const { return comp->element_type(); }
-Uint Entity::glb_idx() const { return comp->glb_idx()[idx]; }
+Gid Entity::glb_idx() const { return comp->glb_idx()[idx]; }
 Uint Entity::rank() const { return comp->rank()[idx]; }
 bool Entity::is_ghost() const { return comp->is_ghost(idx); }
 RealMatrix Entity::get_coordinates() const { return comp->geometry_space().get_coordinates(idx); }
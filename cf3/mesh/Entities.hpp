@@ -63,10 +63,10 @@ public: // functions
   Dictionary& geometry_fields() const { cf3_assert(is_not_null(m_geometry_dict)); return *m_geometry_dict; }
 
   /// Mutable access to the list of nodes
-  common::List<Uint>& glb_idx() { return *m_global_numbering; }
+  common::List<Gid>& glb_idx() { return *m_global_numbering; }
 
   /// Const access to the list of nodes
-  const common::List<Uint>& glb_idx() const { return *m_global_numbering; }
+  const common::List<Gid>& glb_idx() const { return *m_global_numbering; }
 
   common::List<Uint>& rank() { return *m_rank; }
   const common::List<Uint>& rank() const { return *m_rank; }
@@ -105,7 +105,7 @@ protected: // data
 
   Handle<Space> m_geometry_space;
 
-  Handle<common::List<Uint> > m_global_numbering;
+  Handle<common::List<Gid> > m_global_numbering;
 
   Handle<common::Group> m_spaces_group;
   std::vector< Handle<Space> > m_spaces_vector;
@@ -167,7 +167,7 @@ public:
 
   /// return the elementType
   ElementType& element_type() const;
-  Uint glb_idx() const;
+  Gid glb_idx() const;
   Uint rank() const;
   bool is_ghost() const;
   RealMatrix get_coordinates() const;
@@ -4,6 +4,7 @@
 // GNU Lesser General Public License version 3 (LGPLv3).
 // See doc/lgpl.txt and doc/gpl.txt for the license text.
 
+#include <boost/assign/list_of.hpp>
 #include <boost/date_time/gregorian/gregorian.hpp>
 
 #include "common/Signal.hpp"
@@ -44,6 +45,17 @@ Field::Field ( const std::string& name  ) :
   properties()["date"] = boost::gregorian::to_iso_extended_string(boost::gregorian::day_clock::local_day());
   properties()["time"] = 0.;
   properties()["step"] = 0u;
+
+  std::vector<boost::any> precisions = boost::assign::list_of<boost::any>(std::string("double"))(std::string("single"));
+  options().add("output_precision", std::string("double"))
+    .pretty_name("Output Precision")
+    .description("Precision of the values in written files. Use single for diagnostic fields that are only written, to halve their output size.")
+    .restricted_list() = precisions;
+
+  options().add("output_tolerance", 0.)
+    .pretty_name("Output Tolerance")
+    .description("Maximum absolute error on the written values. Values are rounded to a power of two below this, which makes them compress well. 0 writes the exact values. "
+                 "Single precision variables with values too large to meet the tolerance on any process are written in double precision.");
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -195,19 +207,19 @@ void Field::create_descriptor(const std::string& description, const Uint dimensi
 
 Field::View Field::view(const Uint start, const Uint size)
 {
-  return Table<Real>::array()[ boost::indices[range(start,start+size)][range()] ];
+  return Table<Real>::array()[ boost::indices[range(start,start+size)][range(0,row_size())] ];
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 
 Field::View Field::view(common::Table<Uint>::ConstRow& indices)
 {
-  return Table<Real>::array()[ boost::indices[range(indices[0],indices[0]+indices.size())][range()] ];
+  return Table<Real>::array()[ boost::indices[range(indices[0],indices[0]+indices.size())][range(0,row_size())] ];
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 
-common::List<Uint>& Field::glb_idx() const
+common::List<Gid>& Field::glb_idx() const
 {
   return dict().glb_idx();
 }
@@ -264,14 +276,14 @@ Field& Field::coordinates() const
 
 Field::Ref Field::ref()
 {
-  return Ref( &array()[0][0], size(), row_size(), Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>(row_size(),row_size()-1));
+  return Ref( &array()[0][0], size(), row_size(), Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>(row_stride(),row_size()-1));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 Field::Ref  Field::col(const Uint c)
 {
-  return Ref( &array()[0][c], size(), 1, Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>(row_size(),0) );
+  return Ref( &array()[0][c], size(), 1, Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>(row_stride(),0) );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -304,6 +316,22 @@ Field::RowTensorRef Field::tensor(const Uint r)
 
 ////////////////////////////////////////////////////////////////////////////////
 
+Field::AlignedRef Field::aligned_ref()
+{
+  cf3_assert(row_alignment() != 0 && row_alignment() % 16 == 0);
+  return AlignedRef( array().data(), size(), row_size(), Eigen::OuterStride<Eigen::Dynamic>(row_stride()) );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Field::AlignedRowArrayRef Field::aligned_row(const Uint r)
+{
+  cf3_assert(row_alignment() != 0 && row_alignment() % 16 == 0);
+  return AlignedRowArrayRef( &array()[r][0], 1, row_size() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void Field::set_var_type(const VarType var_type)
 {
   m_var_type = var_type;
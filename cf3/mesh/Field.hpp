@@ -52,6 +52,10 @@ public: // typedefs
   typedef Eigen::Matrix<Real,Eigen::Dynamic,Eigen::Dynamic,Eigen::RowMajor> RowTensorStorage ;
   typedef Eigen::Map< RowTensorStorage , Eigen::Unaligned > RowTensorRef ;
 
+  /// Views on fields created with a row alignment, @see Dictionary::create_field
+  typedef Eigen::Map< ArrayStorage , Eigen::Aligned, Eigen::OuterStride<Eigen::Dynamic> > AlignedRef ;
+  typedef Eigen::Map< RowArrayStorage , Eigen::Aligned > AlignedRowArrayRef ;
+
 private: // typedefs
 
   typedef boost::multi_array_types::index_range range;
@@ -98,7 +102,7 @@ public: // functions
 
   View view(common::Table<Uint>::ConstRow& indices);
 
-  common::List<Uint>& glb_idx() const;
+  common::List<Gid>& glb_idx() const;
 
   common::List<Uint>& rank() const;
 
@@ -142,6 +146,12 @@ public: // functions
 
   RowTensorRef tensor(const Uint r);
 
+  /// View on all rows, for fields with rows aligned to at least 16 bytes
+  AlignedRef aligned_ref();
+
+  /// View on one row, for fields with rows aligned to at least 16 bytes
+  AlignedRowArrayRef aligned_row(const Uint r);
+
   void set_var_type(const VarType var_type);
 
   VarType var_type() const ;
@@ -183,7 +193,17 @@ public: // functions
     Field& operator =(const Field& U)
     {
       cf3_assert(size() == U.size());
-      array() = U.array();
+      if (row_stride() == U.row_stride())
+      {
+        array() = U.array();
+      }
+      else // differently padded rows
+      {
+        cf3_assert(row_size() == U.row_size());
+        for (Uint i=0; i<size(); ++i)
+          for (Uint j=0; j<row_size(); ++j)
+            array()[i][j] = U.array()[i][j];
+      }
       return *this;
     }
 
@@ -0,0 +1,185 @@
+// Copyright (C) 2010-2013 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <algorithm>
+
+#include "common/Builder.hpp"
+#include "common/Log.hpp"
+#include "common/OptionList.hpp"
+#include "common/OptionT.hpp"
+#include "common/PE/Comm.hpp"
+
+#include "math/Hilbert.hpp"
+
+#include "mesh/BoundingBox.hpp"
+#include "mesh/ElementType.hpp"
+#include "mesh/HilbertPartitioner.hpp"
+#include "mesh/LibMesh.hpp"
+
+namespace cf3 {
+namespace mesh {
+
+  using namespace common;
+
+////////////////////////////////////////////////////////////////////////////////
+
+common::ComponentBuilder < HilbertPartitioner, MeshTransformer, LibMesh > HilbertPartitioner_Builder;
+
+//////////////////////////////////////////////////////////////////////////////
+
+HilbertPartitioner::HilbertPartitioner ( const std::string& name ) :
+  MeshPartitioner(name)
+{
+  options().add("nb_samples", 64u)
+      .description("Number of samples every rank contributes to find the cuts of the Hilbert curve. "
+                   "The imbalance of the partitions is of the order of 1/nb_samples")
+      .pretty_name("Number of Samples");
+
+  options().add("levels", 20u)
+      .description("Number of levels of the Hilbert curve")
+      .pretty_name("Levels");
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void HilbertPartitioner::compute_keys()
+{
+  const Mesh& mesh = *m_mesh;
+  math::Hilbert hilbert(*mesh.global_bounding_box(), options().value<Uint>("levels"));
+  const Uint dim = mesh.geometry_fields().coordinates().row_size();
+
+  m_keys.assign(mesh.elements().size(), std::vector<boost::uint64_t>());
+  m_weights.assign(mesh.elements().size(), std::vector<Real>());
+  for (Uint comp=0; comp<mesh.elements().size(); ++comp)
+  {
+    const Entities& elements = *mesh.elements()[comp];
+    const ElementType& etype = elements.element_type();
+    RealMatrix element_coordinates(etype.nb_nodes(), dim);
+    RealVector centroid(etype.dimension());
+    m_keys[comp].resize(elements.size());
+    m_weights[comp].resize(elements.size(), 1.);
+    for (Uint elem_idx=0; elem_idx<elements.size(); ++elem_idx)
+    {
+      elements.geometry_space().put_coordinates(element_coordinates,elem_idx);
+      etype.compute_centroid(element_coordinates,centroid);
+      m_keys[comp][elem_idx] = hilbert(centroid);
+    }
+  }
+
+  if (has_object_weights())
+  {
+    std::vector<Gid> owned_objects(nb_objects_owned_by_part(PE::Comm::instance().rank()));
+    list_of_objects_owned_by_part(PE::Comm::instance().rank(),owned_objects);
+    const std::vector<Real>& weights = object_weights();
+    Uint comp, loc_idx;
+    for (Uint i=0; i<owned_objects.size(); ++i)
+    {
+      boost::tie(comp,loc_idx) = location_idx(owned_objects[i]);
+      if (comp != 0) // not a node
+        m_weights[comp-1][loc_idx] = weights[i];
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+std::vector<boost::uint64_t> HilbertPartitioner::compute_splitters() const
+{
+  const Uint nb_parts = options().value<Uint>("nb_parts");
+  const Uint nb_samples = std::max(1u,options().value<Uint>("nb_samples"));
+
+  // Sort the local elements along the curve
+  std::vector< std::pair<boost::uint64_t,Real> > local;
+  for (Uint comp=0; comp<m_keys.size(); ++comp)
+  {
+    for (Uint e=0; e<m_keys[comp].size(); ++e)
+      local.push_back(std::make_pair(m_keys[comp][e],m_weights[comp][e]));
+  }
+  std::sort(local.begin(),local.end());
+
+  Real local_weight = 0.;
+  for (Uint i=0; i<local.size(); ++i)
+    local_weight += local[i].second;
+
+  // Samples at regular weight intervals, each representing an equal part of the local weight
+  std::vector<boost::uint64_t> sample_keys(nb_samples,0);
+  std::vector<Real> sample_weights(nb_samples,local.empty() ? 0. : local_weight/static_cast<Real>(nb_samples));
+  Real cumulative = 0.;
+  Uint i = 0;
+  for (Uint s=0; s<nb_samples && !local.empty(); ++s)
+  {
+    const Real target = (static_cast<Real>(s)+0.5)*local_weight/static_cast<Real>(nb_samples);
+    while (i+1 < local.size() && cumulative + local[i].second < target)
+      cumulative += local[i++].second;
+    sample_keys[s] = local[i].first;
+  }
+
+  // Gather all samples on all ranks, and sort them along the curve
+  std::vector< std::vector<boost::uint64_t> > all_sample_keys;
+  std::vector< std::vector<Real> > all_sample_weights;
+  PE::Comm::instance().all_gather(sample_keys,all_sample_keys);
+  PE::Comm::instance().all_gather(sample_weights,all_sample_weights);
+
+  std::vector< std::pair<boost::uint64_t,Real> > samples;
+  Real total_weight = 0.;
+  for (Uint p=0; p<all_sample_keys.size(); ++p)
+  {
+    for (Uint s=0; s<all_sample_keys[p].size(); ++s)
+    {
+      samples.push_back(std::make_pair(all_sample_keys[p][s],all_sample_weights[p][s]));
+      total_weight += all_sample_weights[p][s];
+    }
+  }
+  std::sort(samples.begin(),samples.end());
+
+  // Cut at the weight quantiles
+  std::vector<boost::uint64_t> splitters;
+  splitters.reserve(nb_parts-1);
+  cumulative = 0.;
+  Uint part = 1;
+  for (Uint s=0; s<samples.size() && part<nb_parts; ++s)
+  {
+    cumulative += samples[s].second;
+    while (part<nb_parts && cumulative >= total_weight*static_cast<Real>(part)/static_cast<Real>(nb_parts))
+    {
+      splitters.push_back(samples[s].first);
+      ++part;
+    }
+  }
+  // Remaining parts are empty
+  while (splitters.size() < nb_parts-1)
+    splitters.push_back(samples.empty() ? 0 : samples.back().first+1);
+
+  return splitters;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void HilbertPartitioner::partition_graph()
+{
+  // Elements can only be migrated in parallel
+  if (PE::Comm::instance().is_active() == false)
+    return;
+
+  compute_keys();
+  const std::vector<boost::uint64_t> splitters = compute_splitters();
+
+  const Uint rank = PE::Comm::instance().rank();
+  for (Uint comp=0; comp<m_keys.size(); ++comp)
+  {
+    for (Uint e=0; e<m_keys[comp].size(); ++e)
+    {
+      const Uint part = std::upper_bound(splitters.begin(),splitters.end(),m_keys[comp][e]) - splitters.begin();
+      if (part != rank)
+        m_elements_to_export[part][comp].push_back(e);
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+} // mesh
+} // cf3
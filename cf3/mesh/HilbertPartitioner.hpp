@@ -0,0 +1,76 @@
+// Copyright (C) 2010-2013 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef cf3_mesh_HilbertPartitioner_hpp
+#define cf3_mesh_HilbertPartitioner_hpp
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <boost/cstdint.hpp>
+
+#include "mesh/MeshPartitioner.hpp"
+
+namespace cf3 {
+namespace mesh {
+
+////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Partitioner along a Hilbert space filling curve, requiring no external library
+///
+/// Every element is assigned the Hilbert key of its centroid. The curve is cut in
+/// nb_parts contiguous pieces of equal weight, using the element weights of MeshPartitioner.
+/// The cuts are found with a parallel sample sort: every rank sorts its own keys, and
+/// contributes "nb_samples" samples at regular weight intervals. All samples are gathered,
+/// and the cuts are placed at the quantiles of the weight of the samples.
+/// The elements are then migrated as in any MeshPartitioner.
+///
+/// The partitions are less optimal in terms of communication volume than the graph partitions
+/// of Zoltan or PT-Scotch, but are computed in O(N log N), without building a graph.
+class Mesh_API HilbertPartitioner : public MeshPartitioner {
+
+public: // functions
+
+  /// Contructor
+  /// @param name of the component
+  HilbertPartitioner ( const std::string& name );
+
+  /// Virtual destructor
+  virtual ~HilbertPartitioner() {}
+
+  /// Get the class name
+  static std::string type_name () { return "HilbertPartitioner"; }
+
+  /// No graph is needed
+  virtual void build_graph() {}
+
+  virtual void partition_graph();
+
+private: // functions
+
+  /// @brief Compute the Hilbert key of the centroid of all elements
+  void compute_keys();
+
+  /// @brief Compute the nb_parts-1 keys cutting the curve in pieces of equal weight
+  std::vector<boost::uint64_t> compute_splitters() const;
+
+private: // data
+
+  /// Hilbert key of every element, per entities of the mesh
+  std::vector< std::vector<boost::uint64_t> > m_keys;
+
+  /// Weight of every element, per entities of the mesh
+  std::vector< std::vector<Real> > m_weights;
+
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // mesh
+} // cf3
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // cf3_mesh_HilbertPartitioner_hpp
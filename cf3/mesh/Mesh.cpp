@@ -415,10 +415,10 @@ bool Mesh::check_sanity(std::vector<std::string>& messages) const
 
   if (Comm::instance().size()>1)
   {
-    std::set<Uint> unique_node_gids;
-    boost_foreach(const Uint gid, geometry_fields().glb_idx().array())
+    std::set<Gid> unique_node_gids;
+    boost_foreach(const Gid gid, geometry_fields().glb_idx().array())
     {
-      std::pair<std::set<Uint>::iterator, bool > inserted = unique_node_gids.insert(gid);
+      std::pair<std::set<Gid>::iterator, bool > inserted = unique_node_gids.insert(gid);
       if (inserted.second == false)
       {
         messages.push_back(geometry_fields().glb_idx().uri().string()+" has non-unique entries.  (entry "+to_str(gid)+" exists more than once, no further checks)");
@@ -427,7 +427,7 @@ bool Mesh::check_sanity(std::vector<std::string>& messages) const
     }
   }
 
-  std::set<Uint> unique_elem_gids;
+  std::set<Gid> unique_elem_gids;
   boost_foreach(const Entities& entities, find_components_recursively<Entities>(*this))
   {
     if (entities.rank().size() != entities.size())
@@ -437,9 +437,9 @@ bool Mesh::check_sanity(std::vector<std::string>& messages) const
 
     if (Comm::instance().size()>1)
     {
-      boost_foreach(const Uint gid, entities.glb_idx().array())
+      boost_foreach(const Gid gid, entities.glb_idx().array())
       {
-        std::pair<std::set<Uint>::iterator, bool > inserted = unique_elem_gids.insert(gid);
+        std::pair<std::set<Gid>::iterator, bool > inserted = unique_elem_gids.insert(gid);
         if (inserted.second == false)
         {
           messages.push_back(entities.glb_idx().uri().string()+" has non-unique entries.  (entry "+to_str(gid)+" exists more than once, no further checks)");
@@ -4,6 +4,7 @@
 // GNU Lesser General Public License version 3 (LGPLv3).
 // See doc/lgpl.txt and doc/gpl.txt for the license text.
 
+#include <algorithm>
 #include <set>
 #include <mpi.h>
 #include <boost/algorithm/string/replace.hpp>
@@ -72,9 +73,11 @@ PackedElement::PackedElement(const mesh::Mesh& mesh, const Uint entities_idx, co
     m_connectivity[space->dict_idx()].resize(nb_nodes);
     for (Uint node=0; node<nb_nodes; ++node)
     {
+      // The local connectivity is used, which remains valid until nodes are flushed
       cf3_assert(m_loc_idx < space->connectivity().size());
       cf3_assert(node<(space->connectivity()[m_loc_idx].size()));
-      m_connectivity[space->dict_idx()][node] = space->connectivity()[m_loc_idx][node];
+      cf3_assert(space->connectivity()[m_loc_idx][node] < space->dict().glb_idx().size());
+      m_connectivity[space->dict_idx()][node] = space->dict().glb_idx()[ space->connectivity()[m_loc_idx][node] ];
     }
   }
 }
@@ -238,9 +241,31 @@ void MeshAdaptor::create_element_buffers()
       }
     }
   }
+  if (is_node_connectivity_global)
+    create_element_glb_connectivity_buffers();
   has_element_buffers = true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+
+void MeshAdaptor::create_element_glb_connectivity_buffers()
+{
+  cf3_assert(is_node_connectivity_global);
+  element_connected_glb_nodes.clear();
+  element_connected_glb_nodes.resize(m_mesh->elements().size());
+  for (Uint ent=0; ent<element_glb_connectivity.size(); ++ent)
+  {
+    element_connected_glb_nodes[ent].resize(element_glb_connectivity[ent].size());
+    for (Uint space_idx=0; space_idx<element_glb_connectivity[ent].size(); ++space_idx)
+    {
+      element_connected_glb_nodes[ent][space_idx] = element_glb_connectivity[ent][space_idx]->create_buffer_ptr();
+      // Elements removed while the connectivity was local are not flushed yet
+      boost_foreach (const Uint elem, removed_elements[ent])
+        element_connected_glb_nodes[ent][space_idx]->rm_row(elem);
+    }
+  }
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -251,10 +276,14 @@ void MeshAdaptor::clear_element_buffers()
   element_glb_idx.clear();
   element_rank.clear();
   element_connected_nodes.clear();
+  element_connected_glb_nodes.clear();
+  removed_elements.clear();
 
   element_glb_idx.resize(m_mesh->elements().size());
   element_rank.resize(m_mesh->elements().size());
   element_connected_nodes.resize(m_mesh->elements().size());
+  element_connected_glb_nodes.resize(m_mesh->elements().size());
+  removed_elements.resize(m_mesh->elements().size());
 
   added_elements.resize(m_mesh->elements().size());
   added_elements.clear();
@@ -314,24 +343,41 @@ void MeshAdaptor::make_element_node_connectivity_global()
   if (!is_node_connectivity_global)
   {
     CFdebug << "MeshAdaptor: make element-node connectivity global" << CFendl;
-    boost_foreach (Entities& elements, find_components_recursively<Entities>(*m_mesh))
+    element_glb_connectivity.clear();
+    element_glb_connectivity.resize(m_mesh->elements().size());
+    for (Uint ent=0; ent<m_mesh->elements().size(); ++ent)
     {
-      boost_foreach(const Handle<Space>& space, elements.spaces())
+      const Handle<Entities>& elements = m_mesh->elements()[ent];
+      if (is_null(elements))
+        continue;
+      element_glb_connectivity[ent].resize(elements->spaces().size());
+      for (Uint space_idx=0; space_idx<elements->spaces().size(); ++space_idx)
       {
-        //PECheckPoint(100,space->dict().uri());
-        //PECheckPoint(100,"local connectivity = \n"<<space->connectivity());
-        //PECheckPoint(100,"global nodes = \n"<<space->dict().glb_idx());
-        boost_foreach ( Connectivity::Row nodes, space->connectivity().array() )
+        const Space& space = *elements->spaces()[space_idx];
+        const Connectivity& connectivity = space.connectivity();
+        const List<Gid>& glb_idx = space.dict().glb_idx();
+        //PECheckPoint(100,space.dict().uri());
+        //PECheckPoint(100,"local connectivity = \n"<<connectivity);
+        //PECheckPoint(100,"global nodes = \n"<<glb_idx);
+        boost::shared_ptr< Table<Gid> > glb_connectivity = allocate_component< Table<Gid> >("glb_connectivity");
+        glb_connectivity->set_row_size(connectivity.row_size());
+        glb_connectivity->resize(connectivity.size());
+        for (Uint elem=0; elem<connectivity.size(); ++elem)
         {
-          boost_foreach ( Uint& node, nodes )
+          for (Uint n=0; n<connectivity.row_size(); ++n)
           {
-            cf3_assert_desc(to_str(node)+"<"+space->dict().glb_idx().uri().string()+".size() "+to_str(space->dict().glb_idx().size()),node<space->dict().glb_idx().size());
-            node = space->dict().glb_idx()[node];
+            const Uint node = connectivity[elem][n];
+            cf3_assert_desc(to_str(node)+"<"+glb_idx.uri().string()+".size() "+to_str(glb_idx.size()),node<glb_idx.size());
+            (*glb_connectivity)[elem][n] = glb_idx[node];
           }
         }
-        //PECheckPoint(100,"global connectivity = \n"<<space->connectivity());
+        element_glb_connectivity[ent][space_idx] = glb_connectivity;
+        //PECheckPoint(100,"global connectivity = \n"<<*glb_connectivity);
       }
     }
+    is_node_connectivity_global = true;
+    if (has_element_buffers)
+      create_element_glb_connectivity_buffers();
   }
   is_node_connectivity_global = true;
 }
@@ -343,26 +389,36 @@ void MeshAdaptor::restore_element_node_connectivity()
   if (is_node_connectivity_global)
   {
     CFdebug << "MeshAdaptor: make element-node connectivity local" << CFendl;
+    // Pending element changes must be in the global connectivity tables before converting them
+    flush_elements();
     rebuild_node_glb_to_loc_map();
-    boost_foreach (Entities& elements, find_components_recursively<Entities>(*m_mesh))
+    for (Uint ent=0; ent<element_glb_connectivity.size(); ++ent)
     {
-      boost_foreach(const Handle<Space>& space, elements.spaces())
+      for (Uint space_idx=0; space_idx<element_glb_connectivity[ent].size(); ++space_idx)
       {
-        //PECheckPoint(100,space->dict().uri());
-        //PECheckPoint(100,"global connectivity = \n"<<space->connectivity());
-        //PECheckPoint(100,"global nodes = \n"<<space->dict().glb_idx());
-        const common::Map<boost::uint64_t,Uint>& glb_to_loc = space->dict().glb_to_loc();
-        boost_foreach ( Connectivity::Row nodes, space->connectivity().array() )
+        Space& space = *m_mesh->elements()[ent]->spaces()[space_idx];
+        const Table<Gid>& glb_connectivity = *element_glb_connectivity[ent][space_idx];
+        //PECheckPoint(100,space.dict().uri());
+        //PECheckPoint(100,"global connectivity = \n"<<glb_connectivity);
+        //PECheckPoint(100,"global nodes = \n"<<space.dict().glb_idx());
+        const common::Map<boost::uint64_t,Uint>& glb_to_loc = space.dict().glb_to_loc();
+        Connectivity& connectivity = space.connectivity();
+        connectivity.resize(glb_connectivity.size());
+        for (Uint elem=0; elem<glb_connectivity.size(); ++elem)
         {
-          boost_foreach ( Uint& node, nodes )
+          for (Uint n=0; n<glb_connectivity.row_size(); ++n)
           {
-            cf3_assert_desc("cannot find glb node "+to_str(node)+" in "+glb_to_loc.uri().string(),glb_to_loc.exists(node));
-            node = glb_to_loc[node];
-            cf3_assert( node < space->dict().size() );
+            const Gid glb_node = glb_connectivity[elem][n];
+            cf3_assert_desc("cannot find glb node "+to_str(glb_node)+" in "+glb_to_loc.uri().string(),glb_to_loc.exists(glb_node));
+            connectivity[elem][n] = glb_to_loc[glb_node];
+            cf3_assert( connectivity[elem][n] < space.dict().size() );
           }
         }
       }
     }
+    element_connected_glb_nodes.clear();
+    element_connected_glb_nodes.resize(m_mesh->elements().size());
+    element_glb_connectivity.clear();
   }
   is_node_connectivity_global = false;
 }
@@ -374,17 +430,20 @@ void MeshAdaptor::add_element(const PackedElement& packed_element)
   if (has_element_buffers == false)
     create_element_buffers();
 
+  // Packed elements have global node indices
+  make_element_node_connectivity_global();
+
   bool not_added_yet = added_elements[packed_element.entities_idx()].insert(packed_element.glb_idx()).second;
   if (not_added_yet)
   {
 //    std::cout << PERank << " adding element " << packed_element.glb_idx() << std::endl;
     element_glb_idx[packed_element.entities_idx()]->add_row(packed_element.glb_idx());
     element_rank[packed_element.entities_idx()]->add_row(packed_element.rank());
-    for (Uint space_idx=0; space_idx<element_connected_nodes[packed_element.entities_idx()].size(); ++space_idx)
+    for (Uint space_idx=0; space_idx<element_connected_glb_nodes[packed_element.entities_idx()].size(); ++space_idx)
     {
       const Uint dict_idx = m_mesh->elements()[packed_element.entities_idx()]->spaces()[space_idx]->dict_idx();
-      cf3_assert(packed_element.connectivity()[dict_idx].size() == element_connected_nodes[packed_element.entities_idx()][space_idx]->get_appointed().shape()[1]);
-      element_connected_nodes[packed_element.entities_idx()][space_idx]->add_row(packed_element.connectivity()[dict_idx]);
+      cf3_assert(packed_element.connectivity()[dict_idx].size() == element_connected_glb_nodes[packed_element.entities_idx()][space_idx]->get_appointed().shape()[1]);
+      element_connected_glb_nodes[packed_element.entities_idx()][space_idx]->add_row(packed_element.connectivity()[dict_idx]);
     }
     elem_flush_required = true;
   }
@@ -410,8 +469,18 @@ void MeshAdaptor::remove_element(const Uint entities_idx, const Uint elem_loc_id
   cf3_assert(elem_loc_idx < element_glb_idx[entities_idx]->total_allocated());
   element_glb_idx[entities_idx]->rm_row(elem_loc_idx);
   element_rank[entities_idx]->rm_row(elem_loc_idx);
-  for (Uint space_idx=0; space_idx<element_connected_nodes[entities_idx].size(); ++space_idx)
-    element_connected_nodes[entities_idx][space_idx]->rm_row(elem_loc_idx);
+  if (is_node_connectivity_global)
+  {
+    for (Uint space_idx=0; space_idx<element_connected_glb_nodes[entities_idx].size(); ++space_idx)
+      element_connected_glb_nodes[entities_idx][space_idx]->rm_row(elem_loc_idx);
+  }
+  else
+  {
+    for (Uint space_idx=0; space_idx<element_connected_nodes[entities_idx].size(); ++space_idx)
+      element_connected_nodes[entities_idx][space_idx]->rm_row(elem_loc_idx);
+    // remembered, in case the connectivity is made global before flushing
+    removed_elements[entities_idx].push_back(elem_loc_idx);
+  }
   added_elements[entities_idx].erase(m_mesh->elements()[entities_idx]->glb_idx()[elem_loc_idx]);
   elem_flush_required = true;
 }
@@ -480,6 +549,12 @@ void MeshAdaptor::flush_elements()
         if (element_connected_nodes[c][s])
           element_connected_nodes[c][s]->flush();
       }
+      for (Uint s=0; s<element_connected_glb_nodes[c].size(); ++s)
+      {
+        if (element_connected_glb_nodes[c][s])
+          element_connected_glb_nodes[c][s]->flush();
+      }
+      removed_elements[c].clear();
     }
     added_elements.clear();
     elem_flush_required = false;
@@ -570,8 +645,9 @@ void MeshAdaptor::find_nodes_to_export(const std::vector< std::vector< std::vect
       boost_foreach (const Uint loc_elem_idx, exported_elements_loc_id[pid][entities_idx])
       {
         // Collect nodes that participate in communication
-        boost_foreach (const Handle<Space>& space, entities.spaces())
+        for (Uint space_idx=0; space_idx<entities.spaces().size(); ++space_idx)
         {
+          const Handle<Space>& space = entities.spaces()[space_idx];
           const Dictionary& dict = space->dict();
 
           const Uint dict_idx = space->dict_idx();
@@ -580,7 +656,7 @@ void MeshAdaptor::find_nodes_to_export(const std::vector< std::vector< std::vect
           if (is_node_connectivity_global)
           {
             cf3_assert(dict.glb_to_loc().size());
-            boost_foreach (const Uint glb_node, space->connectivity()[loc_elem_idx])
+            boost_foreach (const Gid glb_node, (*element_glb_connectivity[entities_idx][space_idx])[loc_elem_idx])
             {
               cf3_assert(dict.glb_to_loc().exists(glb_node));
               nodes_to_send[pid][dict_idx].insert( dict.glb_to_loc()[glb_node] );
@@ -635,9 +711,6 @@ void MeshAdaptor::send_elements(const std::vector< std::vector< std::vector<Uint
   // Declaration of send/receive buffers
   PE::Buffer send_buffer, receive_buffer;
 
-  // Element-node connectivity tables must be GLOBAL
-  make_element_node_connectivity_global();
-
   // 1) Sending elements, and building nodes_to_send change set
   for (Uint pid=0; pid<PE::Comm::instance().size(); ++pid)
   {
@@ -664,6 +737,9 @@ void MeshAdaptor::send_elements(const std::vector< std::vector< std::vector<Uint
   // Send/Receive the elements.
   send_buffer.all_to_all(receive_buffer);
 
+  // Element-node connectivity tables must be GLOBAL to add the received elements
+  make_element_node_connectivity_global();
+
   // 2) Add the elements
 
   std::set< boost::uint64_t > mesh_elems;
@@ -947,16 +1023,20 @@ void MeshAdaptor::move_elements(const std::vector< std::vector< std::vector<Uint
 
     // check in dict.entities_range(), in case perhaps other meshes use the same dictionary (future?)
     cf3_assert(dict.entities_range().size() != 0);
+    cf3_assert(is_node_connectivity_global);
     boost_foreach (const Handle<Entities>& entities, dict.entities_range())
     {
       //std::cout << entities->uri() << std::endl;
-      Space& space = entities->space(dict);
-      for (Uint elem=0; elem<space.size(); ++elem)
+      for (Uint space_idx=0; space_idx<entities->spaces().size(); ++space_idx)
       {
+        if (entities->spaces()[space_idx]->dict_idx() != dict_idx)
+          continue;
         // Element-node connectivity tables must be GLOBAL
-        boost_foreach( Uint glb_node, space.connectivity()[elem] )
+        const Table<Gid>& glb_connectivity = *element_glb_connectivity[entities->entities_idx()][space_idx];
+        boost_foreach( Table<Gid>::ConstRow glb_nodes, glb_connectivity.array() )
         {
-          used_nodes.insert(glb_node);
+          boost_foreach( const Gid glb_node, glb_nodes )
+            used_nodes.insert(glb_node);
         }
       }
     }
@@ -1039,64 +1119,95 @@ void MeshAdaptor::move_elements(const std::vector< std::vector< std::vector<Uint
 
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// @brief Rank holding the entry of a global node index in the distributed node directory
+///
+/// Every global index is assigned to one rank, so that all ranks sharing a node can find
+/// each other through that rank, instead of communicating their nodes to all ranks.
+inline Uint directory_rank(const boost::uint64_t glb_idx)
+{
+  return static_cast<Uint>(glb_idx % PE::Comm::instance().size());
+}
+
+/// @brief Directory entries (global index, rank), received from all ranks, sorted by global index
+void build_directory(const std::vector< std::vector<boost::uint64_t> >& recv_glb_idx,
+                     std::vector< std::pair<boost::uint64_t,Uint> >& entries)
+{
+  entries.clear();
+  for (Uint pid=0; pid<recv_glb_idx.size(); ++pid)
+  {
+    boost_foreach (const boost::uint64_t glb_idx, recv_glb_idx[pid])
+      entries.push_back(std::make_pair(glb_idx,pid));
+  }
+  std::sort(entries.begin(),entries.end());
+}
+
+} // namespace
+
 ////////////////////////////////////////////////////////////////////////////////
 
 void MeshAdaptor::fix_node_ranks()
 {
   CFdebug << "MeshAdaptor: fix node ranks" << CFendl;
-  ////PECheckArrivePoint(100,"fix node ranks");
-  const Uint nb_dicts = m_mesh->dictionaries().size();
 
   flush_nodes();
   rebuild_node_glb_to_loc_map();
+
+  const Uint nb_pids = PE::Comm::instance().size();
   boost_foreach (const Handle<Dictionary>& dict, m_mesh->dictionaries())
   {
-    // nodes to send to other cpu's
-    std::vector<boost::uint64_t> glb_nodes(dict->size());
-    for (Uint n=0; n<glb_nodes.size(); ++n)
+    // assign the rank to be ourself to start with. The rank can only become lower.
+    for (Uint n=0; n<dict->size(); ++n)
     {
-      // fill the nodes to send to other cpu's
-      glb_nodes[n] = dict->glb_idx()[n];
-
-      // assign the rank to be ourself to start with. The rank can only become lower.
       cf3_assert(n<dict->rank().size());
       dict->rank()[n] = PE::Comm::instance().rank();
     }
 
-    // Every cpu broadcasts to cpu's with higher rank
-    for (Uint root=0; root<PE::Comm::instance().size(); ++root)
-    {
-      //    CFinfo << "broadcasting from root " << root << CFendl;
-      PE::Comm::instance().barrier();
-
-      std::vector<boost::uint64_t> glb_nodes_from_root(0);
-      PE::Comm::instance().broadcast(glb_nodes,glb_nodes_from_root,root);
+    if (PE::Comm::instance().is_active() == false)
+      continue;
 
-      // cpu's with higher rank will adapt the ranks of the nodes
-      if (PE::Comm::instance().rank() > root)
+    // Register all nodes in the distributed directory
+    std::vector< std::vector<boost::uint64_t> > send_glb_nodes(nb_pids);
+    for (Uint n=0; n<dict->size(); ++n)
+      send_glb_nodes[directory_rank(dict->glb_idx()[n])].push_back(dict->glb_idx()[n]);
+    std::vector< std::vector<boost::uint64_t> > recv_glb_nodes;
+    PE::Comm::instance().all_to_all(send_glb_nodes,recv_glb_nodes);
+    send_glb_nodes.clear();
+
+    // The lowest rank having a node owns it. Entries are sorted by (glb_idx,rank),
+    // so the owner is the first entry of every global index.
+    // Reply (glb_idx,owner) pairs, only to the ranks that are not the owner.
+    std::vector< std::pair<boost::uint64_t,Uint> > directory;
+    build_directory(recv_glb_nodes,directory);
+    recv_glb_nodes.clear();
+    std::vector< std::vector<boost::uint64_t> > send_owners(nb_pids);
+    for (Uint first=0, last=0; first<directory.size(); first=last)
+    {
+      const Uint owner = directory[first].second;
+      for (last=first+1; last<directory.size() && directory[last].first==directory[first].first; ++last)
       {
+        send_owners[directory[last].second].push_back(directory[last].first);
+        send_owners[directory[last].second].push_back(owner);
+      }
+    }
+    directory.clear();
+    std::vector< std::vector<boost::uint64_t> > recv_owners;
+    PE::Comm::instance().all_to_all(send_owners,recv_owners);
 
-        boost_foreach(const boost::uint64_t& glb_node, glb_nodes_from_root)
-        {
-          if (dict->glb_to_loc().exists(glb_node))
-          {
-            Uint loc_node = dict->glb_to_loc()[glb_node];
-            cf3_assert(dict->glb_idx()[loc_node]==glb_node);
-            cf3_assert(loc_node<dict->rank().size());
-            // if the rank is yourself, it means that the glb_node has not been found
-            // before. Change then the rank to the broacasting cpu.
-            if (dict->rank()[loc_node] == PE::Comm::instance().rank())
-            {
-              dict->rank()[loc_node] = std::min(root,dict->rank()[loc_node]);
-            }
-          }
-        }
+    for (Uint pid=0; pid<recv_owners.size(); ++pid)
+    {
+      for (Uint i=0; i<recv_owners[pid].size(); i+=2)
+      {
+        cf3_assert(dict->glb_to_loc().exists(recv_owners[pid][i]));
+        const Uint loc_node = dict->glb_to_loc()[recv_owners[pid][i]];
+        cf3_assert(loc_node<dict->rank().size());
+        dict->rank()[loc_node] = static_cast<Uint>(recv_owners[pid][i+1]);
       }
     }
   }
-
-//  ////PECheckArrivePoint(100,"fix node ranks done");
-
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1175,13 +1286,21 @@ void MeshAdaptor::fix_node_ranks(const std::vector< std::vector<boost::uint64_t>
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void MeshAdaptor::grow_overlap()
+void MeshAdaptor::grow_overlap(const Uint nb_layers)
+{
+  for (Uint layer=0; layer<nb_layers; ++layer)
+    grow_overlap_layer();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void MeshAdaptor::grow_overlap_layer()
 {
 
   flush_nodes();
   flush_elements();
 
-  const Uint nb_dicts = m_mesh->dictionaries().size();
+  const Uint nb_pids = PE::Comm::instance().size();
 
   CFdebug << "MeshAdaptor: finding bdry nodes" << CFendl;
 
@@ -1192,12 +1311,10 @@ void MeshAdaptor::grow_overlap()
   face2cell->setup(m_mesh->topology());
 
   Dictionary& geometry_dict = m_mesh->geometry_fields();
-//  geometry_dict.rebuild_node_to_element_connectivity();
-//  geometry_dict.rebuild_map_glb_to_loc();
 
   cf3_assert(geometry_dict.connectivity().size() == geometry_dict.size());
 
-  std::set<boost::uint64_t> bdry_nodes;
+  std::vector<boost::uint64_t> glb_boundary_nodes;
   for (Uint f=0; f<face2cell->size(); ++f)
   {
     cf3_assert(f < face2cell->is_bdry_face().size());
@@ -1206,75 +1323,99 @@ void MeshAdaptor::grow_overlap()
       boost_foreach(const Uint node, face2cell->face_nodes(f))
       {
         cf3_assert(node<geometry_dict.glb_idx().size());
-        bdry_nodes.insert(geometry_dict.glb_idx()[node]);
+        glb_boundary_nodes.push_back(geometry_dict.glb_idx()[node]);
       }
     }
   }
   // Remove from memory again, boundary nodes are found
   face2cell.reset();
+  std::sort(glb_boundary_nodes.begin(),glb_boundary_nodes.end());
+  glb_boundary_nodes.erase(std::unique(glb_boundary_nodes.begin(),glb_boundary_nodes.end()),glb_boundary_nodes.end());
 
-  //////PECheckArrivePoint(100, "boundary nodes found");
+  rebuild_node_to_element_connectivity();
+  rebuild_node_glb_to_loc_map();
 
-  // Copy set into vector
-  std::vector<boost::uint64_t> glb_boundary_nodes;
-  glb_boundary_nodes.reserve(bdry_nodes.size());
-  boost_foreach (Uint node, bdry_nodes)
+  // We now have a vector of nodes that lie at the boundary of each pid's mesh.
+  // The pid's having these nodes are found through the distributed node directory:
+  // every pid registers all its nodes, and queries its boundary nodes.
+  // The directory then forwards every query to the other pid's having the node,
+  // which export the elements connected to it. Only neighbouring pid's exchange data.
+
+  std::vector< std::vector<boost::uint64_t> > send_registered_nodes(nb_pids);
+  for (Uint n=0; n<geometry_dict.size(); ++n)
+    send_registered_nodes[directory_rank(geometry_dict.glb_idx()[n])].push_back(geometry_dict.glb_idx()[n]);
+  std::vector< std::vector<boost::uint64_t> > send_queried_nodes(nb_pids);
+  boost_foreach (const boost::uint64_t glb_node, glb_boundary_nodes)
+    send_queried_nodes[directory_rank(glb_node)].push_back(glb_node);
+  glb_boundary_nodes.clear();
+
+  std::vector< std::vector<boost::uint64_t> > recv_registered_nodes, recv_queried_nodes;
+  PE::Comm::instance().all_to_all(send_registered_nodes,recv_registered_nodes);
+  send_registered_nodes.clear();
+  PE::Comm::instance().all_to_all(send_queried_nodes,recv_queried_nodes);
+  send_queried_nodes.clear();
+
+  std::vector< std::pair<boost::uint64_t,Uint> > registered, queried;
+  build_directory(recv_registered_nodes,registered);
+  recv_registered_nodes.clear();
+  build_directory(recv_queried_nodes,queried);
+  recv_queried_nodes.clear();
+
+  // Forward (glb_node, querying pid) pairs to the pid's having the node
+  std::vector< std::vector<boost::uint64_t> > send_requests(nb_pids);
+  std::vector< std::pair<boost::uint64_t,Uint> >::iterator holder = registered.begin();
+  for (Uint q=0; q<queried.size(); ++q)
   {
-    glb_boundary_nodes.push_back(node);
+    const boost::uint64_t glb_node = queried[q].first;
+    const Uint querying_pid = queried[q].second;
+    holder = std::lower_bound(holder,registered.end(),std::make_pair(glb_node,Uint(0)));
+    for (std::vector< std::pair<boost::uint64_t,Uint> >::iterator it=holder; it!=registered.end() && it->first==glb_node; ++it)
+    {
+      if (it->second != querying_pid)
+      {
+        send_requests[it->second].push_back(glb_node);
+        send_requests[it->second].push_back(querying_pid);
+      }
+    }
   }
-  bdry_nodes.clear();
+  registered.clear();
+  queried.clear();
 
-  rebuild_node_to_element_connectivity();
-  //std::cout << PERank << geometry_dict.connectivity() << std::endl;
+  std::vector< std::vector<boost::uint64_t> > recv_requests;
+  PE::Comm::instance().all_to_all(send_requests,recv_requests);
+  send_requests.clear();
 
-
-  // We now have a vector of nodes that lie at the boundary of each pid's mesh
-  // Now find on other pid's the elements that share these nodes, and create
-  // a elements_changeset.
-
-  std::vector< std::vector<boost::uint64_t> > recv_elem_glb_nodes;
-  PE::Comm::instance().all_gather(glb_boundary_nodes, recv_elem_glb_nodes);
-  cf3_assert(recv_elem_glb_nodes.size() == PE::Comm::instance().size());
-
-  //////PECheckArrivePoint(100, "boundary nodes allgathered");
-
-  std::vector< std::vector< std::vector< Uint > > > exported_elements_loc_id (PE::Comm::instance().size(),
+  std::vector< std::vector< std::vector< Uint > > > exported_elements_loc_id (nb_pids,
                                                                               std::vector< std::vector<Uint> > (m_mesh->elements().size()));
 
-  PE::Buffer send_buffer, receive_buffer;
-
-  rebuild_node_glb_to_loc_map();
-
-  for (Uint pid=0; pid<PE::Comm::instance().size(); ++pid)
+  for (Uint pid=0; pid<recv_requests.size(); ++pid)
   {
-    if (pid != PE::Comm::instance().rank())
+    for (Uint i=0; i<recv_requests[pid].size(); i+=2)
     {
-      boost_foreach (const boost::uint64_t& glb_node, recv_elem_glb_nodes[pid])
+      const boost::uint64_t glb_node = recv_requests[pid][i];
+      const Uint to_pid = static_cast<Uint>(recv_requests[pid][i+1]);
+      cf3_assert(geometry_dict.glb_to_loc().exists(glb_node));
+      const Uint loc_node = geometry_dict.glb_to_loc()[glb_node];
+      cf3_assert(loc_node<geometry_dict.size());
+      boost_foreach(const SpaceElem& elem, geometry_dict.connectivity()[loc_node])
       {
-        if (geometry_dict.glb_to_loc().exists(glb_node))
-        {
-          const Uint loc_node = geometry_dict.glb_to_loc()[glb_node];
-          cf3_assert(loc_node<geometry_dict.size());
-//          CFdebug << "[0] found glb_node " << glb_node+1 <<      "   :";
-          boost_foreach(const SpaceElem& elem, geometry_dict.connectivity()[loc_node])
-          {
-//            CFdebug << " " << elem.glb_idx()+1;
-            //if (elem.rank() == PE::Comm::instance().rank())
-            {
-              const Uint entities_idx = elem.comp->support().entities_idx();
-              exported_elements_loc_id[pid][entities_idx].push_back(elem.idx);
-            }
-          }
-//          CFdebug << CFendl;
-        }
+        const Uint entities_idx = elem.comp->support().entities_idx();
+        exported_elements_loc_id[to_pid][entities_idx].push_back(elem.idx);
       }
     }
   }
+  recv_requests.clear();
 
-  //////PECheckArrivePoint(100, "exported_elements_loc_id assembled");
-
-
-
+  // Elements connected to several boundary nodes are exported only once
+  for (Uint pid=0; pid<nb_pids; ++pid)
+  {
+    for (Uint entities_idx=0; entities_idx<exported_elements_loc_id[pid].size(); ++entities_idx)
+    {
+      std::vector<Uint>& elems = exported_elements_loc_id[pid][entities_idx];
+      std::sort(elems.begin(),elems.end());
+      elems.erase(std::unique(elems.begin(),elems.end()),elems.end());
+    }
+  }
 
   std::vector< std::vector< std::vector<Uint> > >            exported_nodes_loc_id;
   find_nodes_to_export(exported_elements_loc_id,exported_nodes_loc_id);
@@ -127,7 +127,9 @@ public:
 
   /// @brief Element-node connectivity is replaced with global indices
   ///
-  /// This is to allow elements from other ranks to be added, in which case local indices are meaningless
+  /// This is to allow elements from other ranks to be added, in which case local indices are meaningless.
+  /// The global connectivity is stored in separate tables of 64-bit capable global indices,
+  /// so the local connectivity tables are meaningless until restore_element_node_connectivity().
   /// @post Mesh is in inconsistent state! Call restore_element_node_connectivity() to fix it,
   ///       after element modifications are done.
   void make_element_node_connectivity_global();
@@ -157,11 +159,14 @@ public:
   ///       Call finish() to notify the mesh of updates.
   void move_elements(const std::vector< std::vector< std::vector<Uint> > >& exported_elements_loc_id);
 
-  /// @brief Create an additional cell-layer of overlap between pid's
+  /// @brief Create additional cell-layers of overlap between pid's
   ///
+  /// The pid's sharing boundary nodes are found through a distributed node directory,
+  /// so that only neighbouring pid's exchange elements and nodes.
+  /// @param [in] nb_layers  number of cell-layers to add
   /// @post nodes and elements are flushed, and node-ranks are uniquely defined in all pid's.
   ///       Call finish() to notify the mesh of updates.
-  void grow_overlap();
+  void grow_overlap(const Uint nb_layers = 1);
 
   /// @brief Add another mesh to this mesh
   void combine_mesh(const Mesh& other_mesh);
@@ -212,6 +217,12 @@ public:
 
 private:
 
+  /// @brief Create one additional cell-layer of overlap between pid's
+  void grow_overlap_layer();
+
+  /// @brief Create buffers for element_glb_connectivity, and mark the removed elements in them
+  void create_element_glb_connectivity_buffers();
+
   /// @brief Handle to the mesh
   Handle<Mesh> m_mesh;
 
@@ -219,7 +230,7 @@ private:
   bool is_node_connectivity_global;
 
   /// @brief Element buffers for global index
-  std::vector< boost::shared_ptr<common::List<Uint>::Buffer> > element_glb_idx;
+  std::vector< boost::shared_ptr<common::List<Gid>::Buffer> > element_glb_idx;
 
   /// @brief Element buffers for rank
   std::vector< boost::shared_ptr<common::List<Uint>::Buffer> > element_rank;
@@ -227,8 +238,20 @@ private:
   /// @brief Element buffers for element-node connectivity
   std::vector< std::vector< boost::shared_ptr<common::Table<Uint>::Buffer> > > element_connected_nodes;
 
+  /// @brief Element-node connectivity in global node indices, per entities and space.
+  ///
+  /// Only exists while is_node_connectivity_global. Global node indices may not fit
+  /// the local connectivity tables, so these temporary tables replace them.
+  std::vector< std::vector< boost::shared_ptr< common::Table<Gid> > > > element_glb_connectivity;
+
+  /// @brief Element buffers for element_glb_connectivity
+  std::vector< std::vector< boost::shared_ptr<common::Table<Gid>::Buffer> > > element_connected_glb_nodes;
+
+  /// @brief Elements removed since the last flush, while the connectivity was local
+  std::vector< std::vector<Uint> > removed_elements;
+
   /// @brief Node buffers for global index
-  std::vector< boost::shared_ptr<common::List<Uint>::Buffer> > node_glb_idx;
+  std::vector< boost::shared_ptr<common::List<Gid>::Buffer> > node_glb_idx;
 
   /// @brief Node buffers for rank
   std::vector< boost::shared_ptr<common::List<Uint>::Buffer> > node_rank;
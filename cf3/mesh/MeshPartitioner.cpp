@@ -10,6 +10,8 @@
 #include "common/Log.hpp"
 #include "common/Signal.hpp"
 #include "common/OptionList.hpp"
+#include "common/OptionArray.hpp"
+#include "common/OptionComponent.hpp"
 #include "common/OptionT.hpp"
 #include "common/OptionURI.hpp"
 #include "common/PE/Comm.hpp"
@@ -26,6 +28,8 @@
 #include "mesh/Mesh.hpp"
 #include "mesh/MeshPartitioner.hpp"
 #include "mesh/Dictionary.hpp"
+#include "mesh/ElementType.hpp"
+#include "mesh/Field.hpp"
 #include "mesh/Region.hpp"
 #include "mesh/MeshAdaptor.hpp"
 #include "mesh/MeshElements.hpp"
@@ -43,7 +47,8 @@ namespace mesh {
 MeshPartitioner::MeshPartitioner ( const std::string& name ) :
     MeshTransformer(name),
     m_base(0),
-    m_nb_parts(PE::Comm::instance().size())
+    m_nb_parts(PE::Comm::instance().size()),
+    m_has_object_weights(false)
 {
   options().add("nb_parts", m_nb_parts)
       .description("Total number of partitions (e.g. number of processors)")
@@ -51,7 +56,21 @@ MeshPartitioner::MeshPartitioner ( const std::string& name ) :
       .link_to(&m_nb_parts)
       .mark_basic();
 
-  m_global_to_local = create_static_component<common::Map<Uint,Uint> >("global_to_local");
+  options().add("element_costs", std::vector<std::string>())
+      .description("Cost per element type, as entries \"<element type>=<cost>\", e.g. \"Hexa3D=1.5\". "
+                   "Element types that are not listed have cost 1")
+      .pretty_name("Element Costs");
+
+  options().add("weights_field", m_weights_field)
+      .description("Field of which the first variable, averaged over every element, multiplies the element cost")
+      .pretty_name("Weights Field")
+      .link_to(&m_weights_field);
+
+  options().add("node_weight", 1.)
+      .description("Weight of the nodes in the partitioned graph, when element weights are used")
+      .pretty_name("Node Weight");
+
+  m_global_to_local = create_static_component<common::Map<Gid,Uint> >("global_to_local");
   m_lookup = create_static_component<UnifiedData >("lookup");
 
   regist_signal( "load_balance" )
@@ -142,7 +161,7 @@ void MeshPartitioner::initialize(Mesh& mesh)
   m_end_node_per_part.resize(PE::Comm::instance().size());
   m_end_elem_per_part.resize(PE::Comm::instance().size());
 
-  Uint start_id(0);
+  Gid start_id(0);
   for (Uint p=0; p<PE::Comm::instance().size(); ++p)
   {
     m_start_id_per_part[p]   = start_id;
@@ -159,6 +178,7 @@ void MeshPartitioner::initialize(Mesh& mesh)
   m_elements_to_export.resize(m_nb_parts,std::vector< std::vector<Uint> >(mesh.elements().size()));
 
   build_global_to_local_index(mesh);
+  build_object_weights();
   build_graph();
 
 //  mesh.update_statistics();
@@ -181,7 +201,7 @@ void MeshPartitioner::build_global_to_local_index(Mesh& mesh)
     m_lookup->add(*elements);
 
   m_nb_owned_obj = 0;
-  common::List<Uint>& node_glb_idx = nodes.glb_idx();
+  common::List<Gid>& node_glb_idx = nodes.glb_idx();
   for (Uint i=0; i<nodes.size(); ++i)
   {
     if (!nodes.is_ghost(i))
@@ -200,7 +220,7 @@ void MeshPartitioner::build_global_to_local_index(Mesh& mesh)
   m_global_to_local->reserve(tot_nb_obj);
   Uint loc_idx=0;
   //CFinfo << "adding nodes to map " << CFendl;
-  boost_foreach (Uint glb_idx, node_glb_idx.array())
+  boost_foreach (Gid glb_idx, node_glb_idx.array())
   {
     //CFinfo << "  adding node with glb " << glb_idx << CFendl;
     if (nodes.is_ghost(loc_idx) == false)
@@ -225,7 +245,7 @@ void MeshPartitioner::build_global_to_local_index(Mesh& mesh)
   //CFinfo << "adding elements " << CFendl;
   boost_foreach ( const Handle<Entities>& elements, mesh.elements() )
   {
-    boost_foreach (Uint glb_idx, elements->glb_idx().array())
+    boost_foreach (Gid glb_idx, elements->glb_idx().array())
     {
       cf3_assert_desc(to_str(glb_idx)+"<"+to_str(m_start_elem_per_part[PE::Comm::instance().rank()]),glb_idx >= m_start_elem_per_part[PE::Comm::instance().rank()]);
       cf3_assert_desc(to_str(glb_idx)+">="+to_str(m_end_elem_per_part[PE::Comm::instance().rank()]),glb_idx < m_end_elem_per_part[PE::Comm::instance().rank()]);
@@ -240,6 +260,82 @@ void MeshPartitioner::build_global_to_local_index(Mesh& mesh)
 
 //////////////////////////////////////////////////////////////////////////////
 
+Real MeshPartitioner::element_type_cost(const Entities& elements) const
+{
+  const std::string builder_name = elements.element_type().derived_type_name();
+  const std::string short_name = builder_name.substr(builder_name.find_last_of('.')+1);
+  Real cost = 1.;
+  bool found_short_name = false;
+  boost_foreach(const std::string& entry, options().value< std::vector<std::string> >("element_costs"))
+  {
+    const std::size_t separator = entry.find('=');
+    if (separator == std::string::npos)
+      throw BadValue(FromHere(), "Entry \""+entry+"\" of option element_costs of "+uri().string()+" is not of the form \"<element type>=<cost>\"");
+    const std::string type = entry.substr(0,separator);
+    if (type == builder_name)
+      return from_str<Real>(entry.substr(separator+1));
+    if (type == short_name && !found_short_name)
+    {
+      cost = from_str<Real>(entry.substr(separator+1));
+      found_short_name = true;
+    }
+  }
+  return cost;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void MeshPartitioner::build_object_weights()
+{
+  m_object_weights.clear();
+  m_has_object_weights = is_not_null(m_weights_field) || !options().value< std::vector<std::string> >("element_costs").empty();
+  if (!m_has_object_weights)
+    return;
+
+  // Cost per component of the lookup, and the space of the weights field, if any
+  const Real node_weight = options().value<Real>("node_weight");
+  std::vector<Real> component_cost(m_lookup->components().size(), node_weight);
+  std::vector< Handle<Space const> > weights_space(m_lookup->components().size());
+  for (Uint c=1; c<m_lookup->components().size(); ++c)
+  {
+    const Entities& elements = *Handle<Entities const>(m_lookup->components()[c]);
+    component_cost[c] = element_type_cost(elements);
+    if (is_not_null(m_weights_field))
+    {
+      boost_foreach(const Handle<Space>& space, m_weights_field->dict().spaces())
+      {
+        if (&space->support() == &elements)
+          weights_space[c] = space;
+      }
+    }
+  }
+
+  // Same iteration order as list_of_objects_owned_by_part()
+  const Uint part = PE::Comm::instance().rank();
+  m_object_weights.reserve(m_nb_owned_obj);
+  Uint c, loc_idx;
+  foreach_container((const Gid glb_obj)(const Uint loc_obj),*m_global_to_local)
+  {
+    if (part_of_obj(glb_obj) != part)
+      continue;
+
+    boost::tie(c,loc_idx) = m_lookup->location_idx(loc_obj);
+    Real weight = component_cost[c];
+    if (is_not_null(weights_space[c]))
+    {
+      const Connectivity::ConstRow points = weights_space[c]->connectivity()[loc_idx];
+      Real mean = 0.;
+      boost_foreach(const Uint pt, points)
+        mean += (*m_weights_field)[pt][0];
+      weight *= mean / static_cast<Real>(points.size());
+    }
+    m_object_weights.push_back(weight);
+  }
+  cf3_assert(m_object_weights.size() == m_nb_owned_obj);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 void MeshPartitioner::show_changes()
 {
   Uint nb_changes(0);
@@ -282,9 +378,9 @@ void MeshPartitioner::show_changes()
 
 //////////////////////////////////////////////////////////////////////////////
 
-boost::tuple<Uint,Uint> MeshPartitioner::location_idx(const Uint glb_obj) const
+boost::tuple<Uint,Uint> MeshPartitioner::location_idx(const Gid glb_obj) const
 {
-  common::Map<Uint,Uint>::const_iterator itr = m_global_to_local->find(glb_obj);
+  common::Map<Gid,Uint>::const_iterator itr = m_global_to_local->find(glb_obj);
   if (itr != m_global_to_local->end() )
   {
     return m_lookup->location_idx(itr->second);
@@ -294,7 +390,7 @@ boost::tuple<Uint,Uint> MeshPartitioner::location_idx(const Uint glb_obj) const
 
 //////////////////////////////////////////////////////////////////////////////
 
-boost::tuple<Handle< Component >,Uint> MeshPartitioner::location(const Uint glb_obj) const
+boost::tuple<Handle< Component >,Uint> MeshPartitioner::location(const Gid glb_obj) const
 {
   return m_lookup->location( (*m_global_to_local)[glb_obj] );
 }
@@ -35,11 +35,20 @@ namespace cf3 {
 namespace mesh {
 
   class Mesh;
+  class Field;
 
 ////////////////////////////////////////////////////////////////////////////////
 
 /// MeshPartitioner component class
 /// This class serves as a component that that will partition the mesh
+///
+/// By default every node and element of the partitioned graph has unit weight,
+/// balancing raw counts. Elements can be given a cost instead, which is the product of
+/// - the cost of their element type, configured in "element_costs" as entries
+///   "<element type>=<cost>", where the element type is either the builder name
+///   (e.g. "cf3.mesh.LagrangeP2.Tetra3D") or the short name (e.g. "Tetra3D"), and
+/// - the mean over the element of the first variable of "weights_field", e.g. a field filled with
+///   the computational cost of extra physics, or with timings measured during previous steps.
 /// @author Willem Deconinck
 class Mesh_API MeshPartitioner : public MeshTransformer {
 
@@ -101,6 +110,12 @@ public: // functions
   template <typename VectorT>
   void list_of_connected_procs_in_part(const Uint part, VectorT& proc_per_neighbor) const;
 
+  /// @brief True if the objects have non-unit weights, through the options "element_costs" or "weights_field"
+  bool has_object_weights() const { return m_has_object_weights; }
+
+  /// @brief Weight of every object owned by this rank, in the order of list_of_objects_owned_by_part()
+  const std::vector<Real>& object_weights() const { return m_object_weights; }
+
 
 public: // functions
 
@@ -110,23 +125,29 @@ public: // functions
 
 protected: // functions
 
-  bool is_node(const Uint glb_obj) const
+  bool is_node(const Gid glb_obj) const
   {
     Uint p = part_of_obj(glb_obj);
     return m_start_node_per_part[p] <= glb_obj && glb_obj < m_end_node_per_part[p];
   }
 
-  bool is_elem(const Uint glb_obj) const
+  bool is_elem(const Gid glb_obj) const
   {
     Uint p = part_of_obj(glb_obj);
     return m_start_node_per_part[p] <= glb_obj && glb_obj < m_end_node_per_part[p];
   }
 
-  boost::tuple<Uint,Uint> location_idx(const Uint glb_obj) const;
+  boost::tuple<Uint,Uint> location_idx(const Gid glb_obj) const;
+
+  boost::tuple<Handle< common::Component >,Uint> location(const Gid glb_obj) const;
+
+  /// @brief Compute the weights of the owned objects, from the options "element_costs" and "weights_field"
+  void build_object_weights();
 
-  boost::tuple<Handle< common::Component >,Uint> location(const Uint glb_obj) const;
+  /// @brief Cost of the element type of given elements, configured in "element_costs"
+  Real element_type_cost(const Entities& elements) const;
 
-  Uint part_of_obj(const Uint obj) const
+  Uint part_of_obj(const Gid obj) const
   {
     for (Uint p=0; p<m_end_id_per_part.size(); ++p)
     {
@@ -154,17 +175,24 @@ private: // data
   Uint m_nb_owned_obj;
 
 
-  Handle< common::Map<Uint,Uint> > m_global_to_local;
+  Handle< common::Map<Gid,Uint> > m_global_to_local;
 
-  std::vector<Uint> m_start_id_per_part;
-  std::vector<Uint> m_end_id_per_part;
-  std::vector<Uint> m_start_node_per_part;
-  std::vector<Uint> m_end_node_per_part;
-  std::vector<Uint> m_start_elem_per_part;
-  std::vector<Uint> m_end_elem_per_part;
+  std::vector<Gid> m_start_id_per_part;
+  std::vector<Gid> m_end_id_per_part;
+  std::vector<Gid> m_start_node_per_part;
+  std::vector<Gid> m_end_node_per_part;
+  std::vector<Gid> m_start_elem_per_part;
+  std::vector<Gid> m_end_elem_per_part;
 
   Handle< UnifiedData > m_lookup;
 
+  /// Field of which the first variable multiplies the element costs
+  Handle< Field > m_weights_field;
+
+  bool m_has_object_weights;
+
+  std::vector<Real> m_object_weights;
+
 };
 
 //////////////////////////////////////////////////////////////////////////////
@@ -180,7 +208,7 @@ template <typename VectorT>
 void MeshPartitioner::list_of_objects_owned_by_part(const Uint part, VectorT& obj_list) const
 {
   Uint idx=0;
-  foreach_container((const Uint glb_obj),*m_global_to_local)
+  foreach_container((const Gid glb_obj),*m_global_to_local)
   {
     if (part_of_obj(glb_obj) == part)
       obj_list[idx++] = glb_obj;
@@ -197,7 +225,7 @@ Uint MeshPartitioner::nb_connected_objects_in_part(const Uint part, VectorT& nb_
   Uint loc_idx;
   Uint size = 0;
   Uint idx = 0;
-  foreach_container((const Uint glb_obj)(const Uint loc_obj),*m_global_to_local)
+  foreach_container((const Gid glb_obj)(const Uint loc_obj),*m_global_to_local)
   {
     if (part_of_obj(glb_obj) == part)
     {
@@ -205,7 +233,7 @@ Uint MeshPartitioner::nb_connected_objects_in_part(const Uint part, VectorT& nb_
 
       if (Handle< Dictionary > nodes = Handle<Dictionary>(comp))
       {
-        const common::DynTable<Uint>& node_to_glb_elm = nodes->glb_elem_connectivity();
+        const common::DynTable<Gid>& node_to_glb_elm = nodes->glb_elem_connectivity();
         nb_connections_per_obj[idx] = node_to_glb_elm.row_size(loc_idx);
       }
       else if (Handle< Elements > elements = Handle<Elements>(comp))
@@ -231,21 +259,21 @@ void MeshPartitioner::list_of_connected_objects_in_part(const Uint part, VectorT
   Uint loc_idx;
 
   Uint idx = 0;
-  foreach_container((const Uint glb_obj)(const Uint loc_obj),*m_global_to_local)
+  foreach_container((const Gid glb_obj)(const Uint loc_obj),*m_global_to_local)
   {
     if (part_of_obj(glb_obj) == part)
     {
       boost::tie(comp,loc_idx) = m_lookup->location(loc_obj);
       if (Handle< Dictionary > nodes = Handle<Dictionary>(comp))
       {
-        const common::DynTable<Uint>& node_to_glb_elm = nodes->glb_elem_connectivity();
-        boost_foreach (const Uint glb_elm , node_to_glb_elm[loc_idx])
+        const common::DynTable<Gid>& node_to_glb_elm = nodes->glb_elem_connectivity();
+        boost_foreach (const Gid glb_elm , node_to_glb_elm[loc_idx])
           connected_objects[idx++] = glb_elm;
       }
       else if (Handle< Elements > elements = Handle<Elements>(comp))
       {
         const Connectivity& connectivity_table = elements->geometry_space().connectivity();
-        const common::List<Uint>& glb_node_indices    = elements->geometry_fields().glb_idx();
+        const common::List<Gid>& glb_node_indices    = elements->geometry_fields().glb_idx();
 
         boost_foreach (const Uint loc_node , connectivity_table[loc_idx])
           connected_objects[idx++] = glb_node_indices[ loc_node ];
@@ -267,21 +295,21 @@ void MeshPartitioner::list_of_connected_procs_in_part(const Uint part, VectorT&
   Uint loc_idx;
 
   Uint idx = 0;
-  foreach_container((const Uint glb_obj)(const Uint loc_obj),*m_global_to_local)
+  foreach_container((const Gid glb_obj)(const Uint loc_obj),*m_global_to_local)
   {
     if (part_of_obj(glb_obj) == part)
     {
       boost::tie(comp,loc_idx) = m_lookup->location(loc_obj);
       if (Handle< Dictionary > nodes = Handle<Dictionary>(comp))
       {
-        const common::DynTable<Uint>& node_to_glb_elm = nodes->glb_elem_connectivity();
-        boost_foreach (const Uint glb_elm , node_to_glb_elm[loc_idx])
+        const common::DynTable<Gid>& node_to_glb_elm = nodes->glb_elem_connectivity();
+        boost_foreach (const Gid glb_elm , node_to_glb_elm[loc_idx])
           connected_procs[idx++] = part_of_obj(glb_elm); /// @todo should be proc of obj, not part!!!
       }
       else if (Handle< Elements > elements = Handle<Elements>(comp))
       {
         const Connectivity& connectivity_table = elements->geometry_space().connectivity();
-        const common::List<Uint>& glb_node_indices    = elements->geometry_fields().glb_idx();
+        const common::List<Gid>& glb_node_indices    = elements->geometry_fields().glb_idx();
         boost_foreach (const Uint loc_node , connectivity_table[loc_idx])
           connected_procs[idx++] = part_of_obj( glb_node_indices[loc_node] ); /// @todo should be proc of obj, not part!!!
       }
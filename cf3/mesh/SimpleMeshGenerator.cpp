@@ -203,7 +203,7 @@ void SimpleMeshGenerator::create_line()
   cells->resize(hash.subhash(ELEMS).nb_objects_in_part(part));
   Connectivity& connectivity = cells->geometry_space().connectivity();
   common::List<Uint>& elem_rank = cells->rank();
-  common::List<Uint>& elem_glb_idx = cells->glb_idx();
+  common::List<Gid>& elem_glb_idx = cells->glb_idx();
 
   Uint glb_elem_start_idx = hash.subhash(ELEMS).start_idx_in_part(part);
   Uint glb_elem_idx;
@@ -396,7 +396,7 @@ void SimpleMeshGenerator::create_rectangle()
   cells->resize(hash.subhash(ELEMS).nb_objects_in_part(part));
   Connectivity& connectivity = cells->geometry_space().connectivity();
   common::List<Uint>& elem_rank = cells->rank();
-  common::List<Uint>& elem_glb_idx = cells->glb_idx();
+  common::List<Gid>& elem_glb_idx = cells->glb_idx();
 
   Uint glb_elem_start_idx = hash.subhash(ELEMS).start_idx_in_part(part);
   Uint glb_elem_idx;
@@ -449,7 +449,7 @@ void SimpleMeshGenerator::create_rectangle()
     left->initialize("cf3.mesh.LagrangeP1.Line"+to_str(m_coord_dim)+"D", nodes);
     Connectivity::Buffer left_connectivity = left->geometry_space().connectivity().create_buffer();
     common::List<Uint>::Buffer left_rank = left->rank().create_buffer();
-    common::List<Uint>::Buffer left_glb_idx = left->glb_idx().create_buffer();
+    common::List<Gid>::Buffer left_glb_idx = left->glb_idx().create_buffer();
     for(Uint j = 0; j < y_segments; ++j)
     {
       if (hash.subhash(ELEMS).part_owns(part,j*x_segments))
@@ -477,7 +477,7 @@ void SimpleMeshGenerator::create_rectangle()
     right->initialize("cf3.mesh.LagrangeP1.Line"+to_str(m_coord_dim)+"D", nodes);
     Connectivity::Buffer right_connectivity = right->geometry_space().connectivity().create_buffer();
     common::List<Uint>::Buffer right_rank = right->rank().create_buffer();
-    common::List<Uint>::Buffer right_glb_idx = right->glb_idx().create_buffer();
+    common::List<Gid>::Buffer right_glb_idx = right->glb_idx().create_buffer();
 
     for(Uint j = 0; j < y_segments; ++j)
     {
@@ -507,7 +507,7 @@ void SimpleMeshGenerator::create_rectangle()
     bottom->initialize("cf3.mesh.LagrangeP1.Line"+to_str(m_coord_dim)+"D", nodes);
     Connectivity::Buffer bottom_connectivity = bottom->geometry_space().connectivity().create_buffer();
     common::List<Uint>::Buffer bottom_rank = bottom->rank().create_buffer();
-    common::List<Uint>::Buffer bottom_glb_idx = bottom->glb_idx().create_buffer();
+    common::List<Gid>::Buffer bottom_glb_idx = bottom->glb_idx().create_buffer();
 
     for(Uint i = 0; i < x_segments; ++i)
     {
@@ -536,7 +536,7 @@ void SimpleMeshGenerator::create_rectangle()
     top->initialize("cf3.mesh.LagrangeP1.Line"+to_str(m_coord_dim)+"D", nodes);
     Connectivity::Buffer top_connectivity = top->geometry_space().connectivity().create_buffer();
     common::List<Uint>::Buffer top_rank = top->rank().create_buffer();
-    common::List<Uint>::Buffer top_glb_idx = top->glb_idx().create_buffer();
+    common::List<Gid>::Buffer top_glb_idx = top->glb_idx().create_buffer();
 
     for(Uint i = 0; i < x_segments; ++i)
     {
@@ -738,7 +738,7 @@ void SimpleMeshGenerator::create_box()
   cells->resize(hash.subhash(ELEMS).nb_objects_in_part(part));
   Connectivity& connectivity = cells->geometry_space().connectivity();
   common::List<Uint>& elem_rank = cells->rank();
-  common::List<Uint>& elem_glb_idx = cells->glb_idx();
+  common::List<Gid>& elem_glb_idx = cells->glb_idx();
 
   Uint glb_elem_start_idx = hash.subhash(ELEMS).start_idx_in_part(part);
   for(Uint k = 0; k < z_segments; ++k)
@@ -819,7 +819,7 @@ void SimpleMeshGenerator::create_box()
       faces->initialize("cf3.mesh.LagrangeP1.Quad"+to_str(m_coord_dim)+"D", nodes);
       Connectivity::Buffer faces_connectivity = faces->geometry_space().connectivity().create_buffer();
       common::List<Uint>::Buffer faces_rank = faces->rank().create_buffer();
-      common::List<Uint>::Buffer faces_glb_idx = faces->glb_idx().create_buffer();
+      common::List<Gid>::Buffer faces_glb_idx = faces->glb_idx().create_buffer();
       const Uint i=0;
       for(Uint k = 0; k < z_segments; ++k)
       {
@@ -866,7 +866,7 @@ void SimpleMeshGenerator::create_box()
       faces->initialize("cf3.mesh.LagrangeP1.Quad"+to_str(m_coord_dim)+"D", nodes);
       Connectivity::Buffer faces_connectivity = faces->geometry_space().connectivity().create_buffer();
       common::List<Uint>::Buffer faces_rank = faces->rank().create_buffer();
-      common::List<Uint>::Buffer faces_glb_idx = faces->glb_idx().create_buffer();
+      common::List<Gid>::Buffer faces_glb_idx = faces->glb_idx().create_buffer();
 
       Uint i=x_segments-1;
       for(Uint k = 0; k < z_segments; ++k)
@@ -915,7 +915,7 @@ void SimpleMeshGenerator::create_box()
       faces->initialize("cf3.mesh.LagrangeP1.Quad"+to_str(m_coord_dim)+"D", nodes);
       Connectivity::Buffer faces_connectivity = faces->geometry_space().connectivity().create_buffer();
       common::List<Uint>::Buffer faces_rank = faces->rank().create_buffer();
-      common::List<Uint>::Buffer faces_glb_idx = faces->glb_idx().create_buffer();
+      common::List<Gid>::Buffer faces_glb_idx = faces->glb_idx().create_buffer();
 
       Uint j=0;
       for(Uint k = 0; k < z_segments; ++k)
@@ -964,7 +964,7 @@ void SimpleMeshGenerator::create_box()
       faces->initialize("cf3.mesh.LagrangeP1.Quad"+to_str(m_coord_dim)+"D", nodes);
       Connectivity::Buffer faces_connectivity = faces->geometry_space().connectivity().create_buffer();
       common::List<Uint>::Buffer faces_rank = faces->rank().create_buffer();
-      common::List<Uint>::Buffer faces_glb_idx = faces->glb_idx().create_buffer();
+      common::List<Gid>::Buffer faces_glb_idx = faces->glb_idx().create_buffer();
 
       Uint j=y_segments-1;
       for(Uint k = 0; k < z_segments; ++k)
@@ -1013,7 +1013,7 @@ void SimpleMeshGenerator::create_box()
       faces->initialize("cf3.mesh.LagrangeP1.Quad"+to_str(m_coord_dim)+"D", nodes);
       Connectivity::Buffer faces_connectivity = faces->geometry_space().connectivity().create_buffer();
       common::List<Uint>::Buffer faces_rank = faces->rank().create_buffer();
-      common::List<Uint>::Buffer faces_glb_idx = faces->glb_idx().create_buffer();
+      common::List<Gid>::Buffer faces_glb_idx = faces->glb_idx().create_buffer();
 
       Uint k=0;
       for(Uint j = 0; j < y_segments; ++j)
@@ -1062,7 +1062,7 @@ void SimpleMeshGenerator::create_box()
       faces->initialize("cf3.mesh.LagrangeP1.Quad"+to_str(m_coord_dim)+"D", nodes);
       Connectivity::Buffer faces_connectivity = faces->geometry_space().connectivity().create_buffer();
       common::List<Uint>::Buffer faces_rank = faces->rank().create_buffer();
-      common::List<Uint>::Buffer faces_glb_idx = faces->glb_idx().create_buffer();
+      common::List<Gid>::Buffer faces_glb_idx = faces->glb_idx().create_buffer();
 
       Uint k=z_segments-1;
       for(Uint j = 0; j < y_segments; ++j)
@@ -231,7 +231,7 @@ const ShapeFunction& SpaceElem::shape_function() const
 
 ////////////////////////////////////////////////////////////////////////////////
 
-Uint SpaceElem::glb_idx() const
+Gid SpaceElem::glb_idx() const
 {
   return comp->support().glb_idx()[idx];
 }
@@ -204,7 +204,7 @@ public:
   /// @name Shortcut functions
   //@{
   const ShapeFunction& shape_function() const;
-  Uint glb_idx() const;
+  Gid glb_idx() const;
   Uint rank() const;
   bool is_ghost() const;
   RealMatrix get_coordinates() const;
@@ -4,14 +4,22 @@
 // GNU Lesser General Public License version 3 (LGPLv3).
 // See doc/lgpl.txt and doc/gpl.txt for the license text.
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <set>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/assign/list_of.hpp>
+#include <boost/bind.hpp>
 #include <boost/cstdint.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
 #include <boost/iostreams/filtering_stream.hpp>
 #include <boost/iostreams/filter/zlib.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
 
 #include "rapidxml/rapidxml.hpp"
 
@@ -19,6 +27,7 @@
 #include "common/Foreach.hpp"
 #include "common/Log.hpp"
 #include "common/PE/Comm.hpp"
+#include "common/PE/all_reduce.hpp"
 #include "common/OptionList.hpp"
 #include "common/OptionT.hpp"
 #include "common/Builder.hpp"
@@ -49,128 +58,304 @@ namespace VTKXML {
 
 namespace detail
 {
-  struct CompressedStreamHeader
+  /// Compresses a range of blocks, each block separately as required by the VTK format
+  struct BlockCompressor
   {
-    CompressedStreamHeader() :
-      nb_blocks(1),
-      blocksize(32768), // Same as in ParaView
-      last_blocksize(0)
+    BlockCompressor(const std::vector<char>& data, std::vector<std::string>& compressed_blocks,
+                    const Uint blocksize, const int level, const Uint first_block, const Uint stride) :
+      m_data(data),
+      m_compressed_blocks(compressed_blocks),
+      m_blocksize(blocksize),
+      m_level(level),
+      m_first_block(first_block),
+      m_stride(stride)
     {
     }
 
-    boost::uint32_t nb_blocks;
-    const boost::uint32_t blocksize;
-    boost::uint32_t last_blocksize;
-    std::vector<boost::uint32_t> compressed_blocksizes;
+    void operator()()
+    {
+      const Uint nb_blocks = m_compressed_blocks.size();
+      for(Uint i = m_first_block; i < nb_blocks; i += m_stride)
+      {
+        const Uint begin = i * m_blocksize;
+        const Uint size = std::min(m_blocksize, static_cast<Uint>(m_data.size()) - begin);
+
+        std::string& compressed = m_compressed_blocks[i];
+        compressed.clear();
+        boost::iostreams::filtering_ostream out;
+        out.push(boost::iostreams::zlib_compressor(boost::iostreams::zlib_params(m_level)));
+        out.push(boost::iostreams::back_inserter(compressed));
+        out.write(&m_data[begin], size);
+        out.reset(); // flushes the compressor
+      }
+    }
+
+    const std::vector<char>& m_data;
+    std::vector<std::string>& m_compressed_blocks;
+    const Uint m_blocksize;
+    const int m_level;
+    const Uint m_first_block;
+    const Uint m_stride;
   };
 
-  struct CompressedStream
+  /// Pool of threads that compress the blocks of each array. The threads are started once and wait for the next array,
+  /// so writing many small arrays does not pay for creating threads each time. The calling thread compresses its share as well.
+  class CompressorPool
   {
-    CompressedStream() :
-      data_stream(std::ios_base::in | std::ios_base::out | std::ios_base::binary),
-      m_current_block(std::ios_base::in | std::ios_base::out | std::ios_base::binary)
+  public:
+    CompressorPool(const Uint nb_threads, const Uint blocksize, const int level) :
+      m_nb_workers(nb_threads),
+      m_blocksize(blocksize),
+      m_level(level),
+      m_data(0),
+      m_compressed_blocks(0),
+      m_job(0),
+      m_nb_busy(0),
+      m_stop(false)
     {
-      // VTK data starts with a _
-      data_stream.write("_", 1);
+      for(Uint i = 1; i != m_nb_workers; ++i)
+        m_threads.create_thread(boost::bind(&CompressorPool::work, this, i));
     }
 
-    /// Start writing a new array
-    void start_array(const Uint nb_elems, const Uint wordsize)
+    ~CompressorPool()
     {
-      m_wordsize = wordsize;
+      {
+        boost::lock_guard<boost::mutex> lock(m_mutex);
+        m_stop = true;
+      }
+      m_job_available.notify_all();
+      m_threads.join_all();
+    }
 
-      const Uint nb_bytes = nb_elems * wordsize;
-      m_header.last_blocksize = nb_bytes % m_header.blocksize;
-      if(m_header.last_blocksize)
+    /// Compress all blocks of data, returning when they are done
+    void compress(const std::vector<char>& data, std::vector<std::string>& compressed_blocks)
+    {
       {
-        m_header.nb_blocks = nb_bytes / m_header.blocksize + 1;
+        boost::lock_guard<boost::mutex> lock(m_mutex);
+        m_data = &data;
+        m_compressed_blocks = &compressed_blocks;
+        m_nb_busy = m_nb_workers - 1;
+        ++m_job;
       }
-      else
+      m_job_available.notify_all();
+
+      BlockCompressor(data, compressed_blocks, m_blocksize, m_level, 0, m_nb_workers)();
+
+      boost::unique_lock<boost::mutex> lock(m_mutex);
+      while(m_nb_busy != 0)
+        m_job_finished.wait(lock);
+    }
+
+  private:
+    void work(const Uint worker_idx)
+    {
+      Uint last_job = 0;
+      while(true)
       {
-        m_header.last_blocksize = m_header.blocksize;
-        m_header.nb_blocks = nb_bytes / m_header.blocksize;
+        const std::vector<char>* data;
+        std::vector<std::string>* compressed_blocks;
+        {
+          boost::unique_lock<boost::mutex> lock(m_mutex);
+          while(!m_stop && m_job == last_job)
+            m_job_available.wait(lock);
+          if(m_stop)
+            return;
+          last_job = m_job;
+          data = m_data;
+          compressed_blocks = m_compressed_blocks;
+        }
+
+        BlockCompressor(*data, *compressed_blocks, m_blocksize, m_level, worker_idx, m_nb_workers)();
+
+        {
+          boost::lock_guard<boost::mutex> lock(m_mutex);
+          --m_nb_busy;
+        }
+        m_job_finished.notify_one();
       }
+    }
 
-      m_header.compressed_blocksizes.clear();
-      m_header.compressed_blocksizes.reserve(m_header.nb_blocks);
+    const Uint m_nb_workers;
+    const Uint m_blocksize;
+    const int m_level;
+
+    boost::thread_group m_threads;
+    boost::mutex m_mutex;
+    boost::condition_variable m_job_available;
+    boost::condition_variable m_job_finished;
+
+    // State of the current job, protected by m_mutex
+    const std::vector<char>* m_data;
+    std::vector<std::string>* m_compressed_blocks;
+    Uint m_job;
+    Uint m_nb_busy;
+    bool m_stop;
+  };
 
-      // Write known header info
-      data_stream.write(reinterpret_cast<const char*>(&m_header.nb_blocks), 4);
-      data_stream.write(reinterpret_cast<const char*>(&m_header.blocksize), 4);
-      data_stream.write(reinterpret_cast<const char*>(&m_header.last_blocksize), 4);
+  /// Builds the appended data section. Each array is buffered completely and then either stored
+  /// as is, prefixed with its size, or split in blocks that are compressed by a pool of threads.
+  struct CompressedStream
+  {
+    CompressedStream(const bool compress, const int level, const Uint nb_threads) :
+      blocksize(32768), // Same as in ParaView
+      m_compress(compress),
+      m_level(level),
+      m_nb_threads(nb_threads == 0 ? std::max(boost::thread::hardware_concurrency(), 1u) : nb_threads)
+    {
+      // VTK data starts with a _
+      data_stream.push_back('_');
 
-      // save filepointer
-      m_compressed_sizes_start = data_stream.tellp();
+      if(m_compress && m_nb_threads > 1)
+        m_pool.reset(new CompressorPool(m_nb_threads, blocksize, m_level));
+    }
 
-      // Reserve space for compressed block sizes
-      for(Uint i = 0; i != m_header.nb_blocks; ++i)
-        data_stream.write(reinterpret_cast<const char*>(&m_header.nb_blocks), 4);
+    /// Start writing a new array
+    void start_array(const Uint nb_elems, const Uint wordsize)
+    {
+      m_wordsize = wordsize;
+      m_array.clear();
+      m_array.reserve(nb_elems * wordsize);
     }
 
     /// Finish writing the current array
     void finish_array()
     {
-      // Write the last block
-      cf3_assert(static_cast<Uint>(m_current_block.tellp()) == static_cast<Uint>(m_header.last_blocksize));
-      compress_block();
+      const boost::uint32_t nb_bytes = m_array.size();
 
-      // go back to the header
-      const Uint stream_end = data_stream.tellp();
-      data_stream.seekp(m_compressed_sizes_start);
+      if(!m_compress)
+      {
+        append(nb_bytes);
+        data_stream.append(m_array.begin(), m_array.end());
+        return;
+      }
 
-      // Write actual compressed block sizes
-      for(Uint i = 0; i != m_header.nb_blocks; ++i)
-        data_stream.write(reinterpret_cast<const char*>(&m_header.compressed_blocksizes[i]), 4);
+      boost::uint32_t last_blocksize = nb_bytes % blocksize;
+      boost::uint32_t nb_blocks = nb_bytes / blocksize;
+      if(last_blocksize)
+        ++nb_blocks;
+      else
+        last_blocksize = blocksize;
+
+      // Compress the blocks, in parallel if there is more than one
+      std::vector<std::string> compressed_blocks(nb_blocks);
+      if(m_pool && nb_blocks > 1)
+      {
+        m_pool->compress(m_array, compressed_blocks);
+      }
+      else
+      {
+        BlockCompressor(m_array, compressed_blocks, blocksize, m_level, 0, 1)();
+      }
 
-      // go back to the stream end
-      data_stream.seekp(stream_end);
+      // Header, followed by the compressed blocks
+      append(nb_blocks);
+      append(blocksize);
+      append(last_blocksize);
+      boost_foreach(const std::string& block, compressed_blocks)
+        append(static_cast<boost::uint32_t>(block.size()));
+      boost_foreach(const std::string& block, compressed_blocks)
+        data_stream.append(block);
     }
 
     /// Append a value to the stream
     template<typename ValueT>
     void push_back(const ValueT& value)
     {
-      // Block is full, write it to the compressed stream
-      if(m_current_block.tellp() == static_cast<std::streampos>(m_header.blocksize))
-        compress_block();
-
-      m_current_block.write(reinterpret_cast<const char*>(&value), m_wordsize);
+      const char* bytes = reinterpret_cast<const char*>(&value);
+      m_array.insert(m_array.end(), bytes, bytes + m_wordsize);
     }
 
     // Offset to put in the VTK XML (= offset after the _)
     Uint offset()
     {
-      return static_cast<Uint>(data_stream.tellp()) - 1u;
+      return static_cast<Uint>(data_stream.size()) - 1u;
     }
 
-    // Compress the current block and append it to the data stream
-    void compress_block()
+    /// Append a header word
+    void append(const boost::uint32_t value)
     {
-      // set up zlib compressor
-      boost::iostreams::filtering_stream<boost::iostreams::input> compressed_stream;
-      compressed_stream.push(boost::iostreams::zlib_compressor());
-      compressed_stream.push(m_current_block);
-
-      // write data and store compressed size
-      const Uint before = data_stream.tellp();
-      data_stream << compressed_stream.rdbuf();
-      m_header.compressed_blocksizes.push_back(static_cast<Uint>(data_stream.tellp()) - before);
-
-      // clear current block
-      m_current_block.str(std::string());
+      data_stream.append(reinterpret_cast<const char*>(&value), 4);
     }
 
-    CompressedStreamHeader m_header;
+    const boost::uint32_t blocksize;
+
+    const bool m_compress;
+
+    /// zlib compression level
+    const int m_level;
 
-    /// File pointer where the compressed sizes start
-    Uint m_compressed_sizes_start;
+    /// Maximum number of threads used to compress the blocks of an array
+    const Uint m_nb_threads;
+
+    /// Threads shared by all arrays, if more than one is used
+    boost::scoped_ptr<CompressorPool> m_pool;
 
     Uint m_wordsize;
 
-    // Uncompressed data for the block that is being appended to
-    std::stringstream m_current_block;
+    // Uncompressed data for the array that is being appended to
+    std::vector<char> m_array;
+
+    std::string data_stream;
+  };
+
+  /// Appends the values of a variable of a field in its output precision, rounded to the output tolerance.
+  /// The rounded values are exact in single precision if the step is at least the float spacing of the largest value,
+  /// which is at most |value|*2^-23. Otherwise the conversion to float could exceed the tolerance, so the variable
+  /// is written in double precision instead.
+  struct FieldValues
+  {
+    FieldValues(const Field& field, const Uint var_begin, const Uint var_end, CompressedStream& stream) :
+      m_stream(stream),
+      m_single(sizeof(Real) == 4 || field.options().value<std::string>("output_precision") == "single"),
+      m_step(0.)
+    {
+      const Real tolerance = field.options().value<Real>("output_tolerance");
+      if(tolerance > 0.)
+      {
+        // Largest power of two not exceeding twice the tolerance, so the rounding error stays below the tolerance
+        // and the low mantissa bits of the written values are zero
+        int exponent;
+        std::frexp(2.*tolerance, &exponent);
+        m_step = std::ldexp(1., exponent - 1);
+
+        if(m_single && sizeof(Real) == 8)
+        {
+          Real max_abs = 0.;
+          const Uint nb_rows = field.size();
+          for(Uint i = 0; i != nb_rows; ++i)
+            for(Uint j = var_begin; j != var_end; ++j)
+              max_abs = std::max(max_abs, std::abs(field[i][j]));
+          // All pieces must use the same type, since the pvtu file declares a single one
+          if(PE::Comm::instance().is_active())
+            PE::Comm::instance().all_reduce(PE::max(), &max_abs, 1, &max_abs);
+          m_single = m_step >= std::ldexp(max_abs, -23);
+        }
+      }
+    }
+
+    std::string vtk_type() const
+    {
+      return m_single ? "Float32" : "Float64";
+    }
+
+    Uint wordsize() const
+    {
+      return m_single ? 4u : 8u;
+    }
+
+    void push_back(Real value)
+    {
+      if(m_step != 0.)
+        value = std::floor(value / m_step + 0.5) * m_step;
+      if(m_single)
+        m_stream.push_back(static_cast<float>(value));
+      else
+        m_stream.push_back(static_cast<double>(value));
+    }
 
-    std::stringstream data_stream;
+    CompressedStream& m_stream;
+    bool m_single;
+    Real m_step;
   };
 
   // Recursively transform nodes to their parallel counterparts
@@ -206,6 +391,20 @@ Writer::Writer( const std::string& name )
     options().add("distributed_files", false)
     .pretty_name("Distributed Files")
     .description("Indicate if the filesystem is local to each note. When true, the pvtu file is written on each node.");
+
+    std::vector<boost::any> compressors = boost::assign::list_of<boost::any>(std::string("zlib"))(std::string("raw"));
+    options().add("compressor", std::string("zlib"))
+    .pretty_name("Compressor")
+    .description("Compression of the appended data: zlib, or raw for uncompressed binary data that is faster to write")
+    .restricted_list() = compressors;
+
+    options().add("compression_level", -1)
+    .pretty_name("Compression Level")
+    .description("zlib compression level, from 1 (fastest) to 9 (smallest file). -1 uses the zlib default.");
+
+    options().add("nb_threads", 1u)
+    .pretty_name("Number of Threads")
+    .description("Number of threads compressing the data blocks of each array. 0 uses all available cores.");
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -235,7 +434,9 @@ void Writer::write()
   vtkfile.set_attribute("type", "UnstructuredGrid");
   vtkfile.set_attribute("version", "0.1");
   vtkfile.set_attribute("byte_order", "LittleEndian");
-  vtkfile.set_attribute("compressor", "vtkZLibDataCompressor");
+  const bool compress = options().value<std::string>("compressor") == "zlib";
+  if(compress)
+    vtkfile.set_attribute("compressor", "vtkZLibDataCompressor");
 
   XmlNode unstructured_grid = vtkfile.add_node("UnstructuredGrid");
 
@@ -268,7 +469,7 @@ void Writer::write()
   piece.set_attribute("NumberOfCells", to_str(nb_elems));
 
   // Points output
-  detail::CompressedStream appended_data;
+  detail::CompressedStream appended_data(compress, options().value<int>("compression_level"), options().value<Uint>("nb_threads"));
 
   XmlNode points_data = piece.add_node("Points").add_node("DataArray");
   points_data.set_attribute("type", sizeof(Real) == 4 ? "Float32" : "Float64");
@@ -381,13 +582,15 @@ void Writer::write()
         ? point_data.add_node("DataArray")
         : cell_data.add_node("DataArray");
 
-      data_array.set_attribute("type", sizeof(Real) == 4 ? "Float32" : "Float64");
+      detail::FieldValues field_values(field, var_begin, var_end, appended_data);
+
+      data_array.set_attribute("type", field_values.vtk_type());
       data_array.set_attribute("NumberOfComponents", to_str(var_size == 2 && dim == 2 ? 3 : var_size));
       data_array.set_attribute("Name", var_name);
       data_array.set_attribute("format", "appended");
       data_array.set_attribute("offset", to_str(appended_data.offset()));
 
-      appended_data.start_array(field_size*(var_size == 2 && dim == 2 ? 3 : var_size), sizeof(Real));
+      appended_data.start_array(field_size*(var_size == 2 && dim == 2 ? 3 : var_size), field_values.wordsize());
 
       if(field.continuous())
       {
@@ -397,16 +600,16 @@ void Writer::write()
           {
             for(Uint j = var_begin; j != var_end; ++j)
             {
-              appended_data.push_back(field[i][j]);
+              field_values.push_back(field[i][j]);
             }
-            appended_data.push_back(0.);
+            field_values.push_back(0.);
           }
         }
         else
         {
           for(Uint i = 0; i != field_size; ++i)
             for(Uint j = var_begin; j != var_end; ++j)
-              appended_data.push_back(field[i][j]);
+              field_values.push_back(field[i][j]);
         }
       }
       else
@@ -424,9 +627,9 @@ void Writer::write()
                 for(Uint j = var_begin; j != var_end; ++j)
                 {
                   /// @bug the field values of the space should be interpolated to the cell-centre, similar to the tecplot writer
-                  appended_data.push_back(field[field_connectivity[i][0]][j]);
+                  field_values.push_back(field[field_connectivity[i][0]][j]);
                 }
-                appended_data.push_back(0.);
+                field_values.push_back(0.);
               }
             }
             else
@@ -436,7 +639,7 @@ void Writer::write()
                 for(Uint j = var_begin; j != var_end; ++j)
                 {
                   /// @bug the field values of the space should be interpolated to the cell-centre, similar to the tecplot writer
-                  appended_data.push_back(field[field_connectivity[i][0]][j]);
+                  field_values.push_back(field[field_connectivity[i][0]][j]);
                 }
               }
             }
@@ -461,9 +664,9 @@ void Writer::write()
   // Write XML meta data
   fout << xml_string;
 
-  // Append  compressed data
+  // Append the binary data
   fout << "\n<AppendedData encoding=\"raw\">\n";
-  fout << appended_data.data_stream.rdbuf();
+  fout.write(appended_data.data_stream.data(), appended_data.data_stream.size());
   fout << "\n</AppendedData>\n</VTKFile>\n";
 
   fout.close();
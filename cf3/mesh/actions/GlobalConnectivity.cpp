@@ -76,7 +76,7 @@ void GlobalConnectivity::execute()
   Mesh& mesh = *m_mesh;
 
   Dictionary& nodes = mesh.geometry_fields();
-  common::List<Uint>& nodes_glb_idx = nodes.glb_idx();
+  common::List<Gid>& nodes_glb_idx = nodes.glb_idx();
   // Undefined behavior if sizeof(Uint) != sizeof(std::size_t)
   // Assert at compile time
   //BOOST_STATIC_ASSERT(sizeof(std::size_t) == sizeof(Uint));
@@ -90,9 +90,9 @@ void GlobalConnectivity::execute()
 
 
   //1)
-  std::map<Uint,Uint> node_glb2loc;
+  std::map<Gid,Uint> node_glb2loc;
   Uint loc_node_idx(0);
-  boost_foreach(Uint glb_node_idx, nodes_glb_idx.array())
+  boost_foreach(Gid glb_node_idx, nodes_glb_idx.array())
     node_glb2loc[glb_node_idx]=loc_node_idx++;
 
   //2)
@@ -111,8 +111,8 @@ void GlobalConnectivity::execute()
     if (nodes.is_ghost(i))
       ++nb_ghost;
 
-  std::vector<Uint> ghostnode_glb_idx(nb_ghost);
-  std::vector<Uint> ghostnode_glb_elem_connectivity;
+  std::vector<Gid> ghostnode_glb_idx(nb_ghost);
+  std::vector<Gid> ghostnode_glb_elem_connectivity;
   std::vector<Uint> ghostnode_glb_elem_connectivity_start(nb_ghost+1);
   ghostnode_glb_elem_connectivity_start[0]=0;
   Handle< Component > elem_comp;
@@ -138,14 +138,14 @@ void GlobalConnectivity::execute()
   }
 
   // 4)
-  std::vector<std::vector<Uint> > glb_elem_connectivity(nodes.size());
+  std::vector<std::vector<Gid> > glb_elem_connectivity(nodes.size());
   nodes_glb_idx.resize(mesh.geometry_fields().size());
 
   for (Uint root=0; root<PE::Comm::instance().size(); ++root)
   {
-    std::vector<Uint> rcv_glb_node_idx(0);//ghostnode_glb_idx.size());
+    std::vector<Gid> rcv_glb_node_idx(0);//ghostnode_glb_idx.size());
     PE::Comm::instance().broadcast(ghostnode_glb_idx,rcv_glb_node_idx,root);
-    std::vector<Uint> rcv_glb_elem_connectivity(0);//ghostnode_glb_elem_connectivity.size());
+    std::vector<Gid> rcv_glb_elem_connectivity(0);//ghostnode_glb_elem_connectivity.size());
     PE::Comm::instance().broadcast(ghostnode_glb_elem_connectivity,rcv_glb_elem_connectivity,root);
     std::vector<Uint> rcv_glb_elem_connectivity_start(0);//ghostnode_glb_elem_connectivity_start.size());
     PE::Comm::instance().broadcast(ghostnode_glb_elem_connectivity_start,rcv_glb_elem_connectivity_start,root);
@@ -157,7 +157,7 @@ void GlobalConnectivity::execute()
         if (p == PE::Comm::instance().rank())
         {
           Uint rcv_idx(0);
-          boost_foreach(const std::size_t glb_node, rcv_glb_node_idx)
+          boost_foreach(const Gid glb_node, rcv_glb_node_idx)
           {
             if (node_glb2loc.find(glb_node) != node_glb2loc.end())
             {
@@ -175,7 +175,7 @@ void GlobalConnectivity::execute()
   }
 
 
-  DynTable<Uint>& nodes_glb_elem_connectivity = mesh.geometry_fields().glb_elem_connectivity();
+  DynTable<Gid>& nodes_glb_elem_connectivity = mesh.geometry_fields().glb_elem_connectivity();
 //  CFinfo << "nodes_glb_elem_connectivity = " << nodes_glb_elem_connectivity.uri() << CFendl;
   nodes_glb_elem_connectivity.resize(glb_elem_connectivity.size());
   for (Uint i=0; i<glb_elem_connectivity.size(); ++i)
@@ -95,7 +95,7 @@ void GlobalNumbering::execute()
 
   if (PE::Comm::instance().size()==1)
   {
-    Uint glb_idx=0;
+    Gid glb_idx=0;
     cf3_assert(mesh.geometry_fields().size() > 0);
     for (Uint n=0; n<mesh.geometry_fields().size(); ++n)
     {
@@ -229,8 +229,8 @@ void GlobalNumbering::execute()
 
   std::vector<Uint> nb_ids_per_proc(PE::Comm::instance().size());
   PE::Comm::instance().all_gather(tot_nb_owned_ids, nb_ids_per_proc);
-  std::vector<Uint> start_id_per_proc(PE::Comm::instance().size());
-  Uint start_id=0;
+  std::vector<Gid> start_id_per_proc(PE::Comm::instance().size());
+  Gid start_id=0;
   for (Uint p=0; p<nb_ids_per_proc.size(); ++p)
   {
     start_id_per_proc[p] = start_id;
@@ -249,11 +249,11 @@ void GlobalNumbering::execute()
   std::vector<boost::uint64_t> node_from(nb_owned_nodes);
   std::vector<boost::uint64_t> node_to(nb_owned_nodes);
 
-  common::List<Uint>& nodes_glb_idx = mesh.geometry_fields().glb_idx();
+  common::List<Gid>& nodes_glb_idx = mesh.geometry_fields().glb_idx();
   nodes_glb_idx.resize(nodes.size());
 
   Uint cnt=0;
-  Uint glb_id = start_id_per_proc[PE::Comm::instance().rank()];
+  Gid glb_id = start_id_per_proc[PE::Comm::instance().rank()];
   for (Uint i=0; i<nodes.size(); ++i)
   {
     cf3_assert(nodes.rank()[i] < PE::Comm::instance().size());
@@ -266,7 +266,7 @@ void GlobalNumbering::execute()
     }
     else
     {
-      nodes_glb_idx[i] = uint_max();
+      nodes_glb_idx[i] = gid_max();
     }
   }
 
@@ -321,7 +321,7 @@ void GlobalNumbering::execute()
     std::cout << "["<<PE::Comm::instance().rank() << "]  checking node validity" << std::endl;
     for (Uint i=0; i<nodes.size(); ++i)
     {
-      cf3_assert(nodes.glb_idx()[i] != uint_max());
+      cf3_assert(nodes.glb_idx()[i] != gid_max());
       if (nodes.is_ghost(i) == false)
       {
         cf3_assert(nodes.glb_idx()[i] >= start_id_per_proc[PE::Comm::instance().rank()]);
@@ -359,7 +359,7 @@ void GlobalNumbering::execute()
     std::vector<boost::uint64_t> send_hash(nb_owned_elems);
     std::vector<boost::uint64_t>   send_id(nb_owned_elems);
 
-    common::List<Uint>& elements_glb_idx = elements.glb_idx();
+    common::List<Gid>& elements_glb_idx = elements.glb_idx();
     elements_glb_idx.resize(elements.size());
     cf3_assert(hilbert_indices.size() == elements.size());
 
@@ -379,7 +379,7 @@ void GlobalNumbering::execute()
       }
       else
       {
-        elements_glb_idx[e] = uint_max();
+        elements_glb_idx[e] = gid_max();
       }
     } // end foreach elem_idx
     cf3_assert(cnt == nb_owned_elems);
@@ -429,18 +429,18 @@ void GlobalNumbering::execute()
     {
       if (hilbert_set.insert(nodes_glb_idx[i]).second == false)  // it was already in the set
         throw ValueExists(FromHere(), "node "+to_str(i)+" is duplicated");
-      if (nodes_glb_idx[i] == uint_max())
+      if (nodes_glb_idx[i] == gid_max())
         throw BadValue(FromHere(), "node " + to_str(i)+" doesn't have glb_idx");
     }
 
     boost_foreach( Entities& elements, find_components_recursively<Entities>(mesh) )
     {
-      common::List<Uint>& elements_glb_idx = elements.glb_idx();
+      common::List<Gid>& elements_glb_idx = elements.glb_idx();
       for (Uint i=0; i<elements.size(); ++i)
       {
         if (hilbert_set.insert(elements_glb_idx[i]).second == false)  // it was already in the set
           throw ValueExists(FromHere(), "elem "+elements.uri().path()+"["+to_str(i)+"] is duplicated");
-        if (elements_glb_idx[i] == uint_max())
+        if (elements_glb_idx[i] == gid_max())
           throw BadValue(FromHere(), "elem "+elements.uri().path()+"["+to_str(i)+"] doesn't have glb_idx");
 
       }
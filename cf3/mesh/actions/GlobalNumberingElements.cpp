@@ -142,8 +142,8 @@ void GlobalNumberingElements::execute()
   //boost::MPI::communicator world;
   //boost::MPI::all_gather(world, tot_nb_owned_ids, nb_ids_per_proc);
   PE::Comm::instance().all_gather(tot_nb_owned_ids, nb_ids_per_proc);
-  std::vector<Uint> start_id_per_proc(PE::Comm::instance().size());
-  Uint start_id=0;
+  std::vector<Gid> start_id_per_proc(PE::Comm::instance().size());
+  Gid start_id=0;
   for (Uint p=0; p<nb_ids_per_proc.size(); ++p)
   {
     start_id_per_proc[p] = start_id;
@@ -154,10 +154,10 @@ void GlobalNumberingElements::execute()
 
   //------------------------------------------------------------------------------
   // give glb idx to elements
-  Uint glb_id=start_id_per_proc[PE::Comm::instance().rank()];
+  Gid glb_id=start_id_per_proc[PE::Comm::instance().rank()];
   boost_foreach( Entities& elements, find_components_recursively<Elements>(mesh) )
   {
-    common::List<Uint>& elements_glb_idx = elements.glb_idx();
+    common::List<Gid>& elements_glb_idx = elements.glb_idx();
     elements_glb_idx.resize(elements.size());
     std::vector<std::size_t>& glb_elem_hash = Handle<CVector_size_t>(elements.get_child("glb_elem_hash"))->data();
     cf3_assert(glb_elem_hash.size() == elements.size());
@@ -174,11 +174,11 @@ void GlobalNumberingElements::execute()
   // In debug mode, check if no hashes are duplicated
   if (m_debug)
   {
-    std::set<Uint> glb_set;
+    std::set<Gid> glb_set;
 
     boost_foreach( Elements& elements, find_components_recursively<Elements>(mesh) )
     {
-      common::List<Uint>& elements_glb_idx = elements.glb_idx();
+      common::List<Gid>& elements_glb_idx = elements.glb_idx();
       for (Uint i=0; i<elements.size(); ++i)
       {
         if (glb_set.insert(elements_glb_idx[i]).second == false)  // it was already in the set
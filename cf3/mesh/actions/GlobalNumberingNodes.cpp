@@ -160,9 +160,9 @@ void GlobalNumberingNodes::execute()
   else
     nb_ids_per_proc[0] = tot_nb_owned_ids;
 
-  std::vector<Uint> start_id_per_proc(PE::Comm::instance().size());
+  std::vector<Gid> start_id_per_proc(PE::Comm::instance().size());
 
-  Uint start_id=0;
+  Gid start_id=0;
   for (Uint p=0; p<nb_ids_per_proc.size(); ++p)
   {
     start_id_per_proc[p] = start_id;
@@ -174,13 +174,13 @@ void GlobalNumberingNodes::execute()
   // add glb_idx to owned nodes, broadcast/receive glb_idx for ghost nodes
 
   std::vector<size_t> node_from(nodes.size()-nb_ghost);
-  std::vector<Uint>   node_to(nodes.size()-nb_ghost);
+  std::vector<Gid>    node_to(nodes.size()-nb_ghost);
 
-  common::List<Uint>& nodes_glb_idx = mesh.geometry_fields().glb_idx();
+  common::List<Gid>& nodes_glb_idx = mesh.geometry_fields().glb_idx();
   nodes_glb_idx.resize(nodes.size());
 
   Uint cnt=0;
-  Uint glb_id = start_id_per_proc[PE::Comm::instance().rank()];
+  Gid glb_id = start_id_per_proc[PE::Comm::instance().rank()];
   for (Uint i=0; i<nodes.size(); ++i)
   {
     if ( ! nodes.is_ghost(i) )
@@ -200,7 +200,7 @@ void GlobalNumberingNodes::execute()
     std::vector<std::size_t> rcv_node_from(0);//node_from.size());
     PE::Comm::instance().broadcast(node_from,rcv_node_from,root);
     //PECheckPoint(100,"002");
-    std::vector<Uint>        rcv_node_to(0);//node_to.size());
+    std::vector<Gid>         rcv_node_to(0);//node_to.size());
     PE::Comm::instance().broadcast(node_to,rcv_node_to,root);
     //PECheckPoint(100,"003");
     if (PE::Comm::instance().rank() != root)
@@ -15,6 +15,7 @@
 #include "common/DynTable.hpp"
 #include "common/List.hpp"
 #include "common/OptionList.hpp"
+#include "common/OptionT.hpp"
 #include "common/PropertyList.hpp"
 
 
@@ -56,11 +57,17 @@ GrowOverlap::GrowOverlap( const std::string& name )
   properties()["brief"] = std::string("Grows the overlap layer of the mesh");
   std::string desc;
   desc =
-      " Boundary nodes of one rank are communicated to other ranks.\n"
-      " Each other rank then communicates all elements that are connected \n"
+      " Boundary nodes of one rank are looked up in a distributed node directory,\n"
+      " to find the neighbouring ranks that have these nodes.\n"
+      " Each neighbouring rank then communicates all elements that are connected \n"
       " to these boundary nodes. \n"
       " Missing nodes are then also communicated to complete the elements";
   properties()["description"] = desc;
+
+  options().add("nb_layers", 1u)
+      .description("Number of cell-layers to add to the overlap")
+      .pretty_name("Number of Layers")
+      .mark_basic();
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -73,7 +80,7 @@ void GrowOverlap::execute()
 
   MeshAdaptor mesh_adaptor(*m_mesh);
   mesh_adaptor.prepare();
-  mesh_adaptor.grow_overlap();
+  mesh_adaptor.grow_overlap(options().value<Uint>("nb_layers"));
   mesh_adaptor.finish();
 
 }
@@ -21,10 +21,11 @@ namespace actions {
 
 //////////////////////////////////////////////////////////////////////////////
 
-/// @brief Grow the overlap of the mesh with one layer
+/// @brief Grow the overlap of the mesh with "nb_layers" layers
 ///
-/// Boundary nodes of one rank are communicated to other ranks.
-/// Each other rank then communicates all elements that are connected
+/// Boundary nodes of one rank are looked up in a distributed node directory,
+/// to find the neighbouring ranks that have these nodes.
+/// Each neighbouring rank then communicates all elements that are connected
 /// to these boundary nodes.
 /// Missing nodes are then also communicated to complete the elements
 ///
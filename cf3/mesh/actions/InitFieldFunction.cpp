@@ -15,9 +15,9 @@
 #include "common/OptionComponent.hpp"
 #include "common/OptionList.hpp"
 #include "common/PropertyList.hpp"
+#include "common/Table.hpp"
 #include "common/Signal.hpp"
 #include "common/XML/SignalOptions.hpp"
-#include "math/AnalyticalFunction.hpp"
 
 #include "mesh/actions/InitFieldFunction.hpp"
 #include "mesh/Elements.hpp"
@@ -185,37 +185,78 @@ void InitFieldFunction::execute()
     }
   }
 
-  // create the functions
-  std::vector<math::AnalyticalFunction> functions(option_functions.size());
-  for (Uint f=0; f<functions.size(); ++f)
+  // check: columns must be of index smaller than index of field
+  for (Uint f=0; f<cols.size(); ++f)
   {
-    // check: columns must be of index smaller than index of field
     if (cols[f] >= m_field->row_size()) throw SetupError(FromHere(), "Specified column ["+to_str(cols[f])+"] doesn't exist. (field has only "+to_str(m_field->row_size())+" cols)");
-    functions[f].parse(option_functions[f],variable_names);
   }
 
-  std::vector<Real> constants;
-  constants.push_back( options().value<Real>("time") );
+  // parse the functions, unless they did not change
+  bool up_to_date = true;
+  if (!m_function.is_parsed() || variable_names != m_parsed_variables || option_functions != m_parsed_functions)
+  {
+    m_function.variables(variable_names);
+    m_function.functions(option_functions);
+    m_function.parse();
+    m_parsed_variables = variable_names;
+    m_parsed_functions = option_functions;
+    up_to_date = false;
+  }
 
-  std::vector<Real> variables(variable_names.size());
+  // only changes in variables that appear in the functions require a new evaluation
+  std::vector<bool> used_variables(variable_names.size());
+  for (Uint v=0; v<variable_names.size(); ++v)
+  {
+    used_variables[v] = m_function.depends_on(variable_names[v]);
+  }
 
+  if (is_null(m_variables))
+  {
+    m_variables = allocate_component< Table<Real> >("variables");
+    m_values = allocate_component< Table<Real> >("values");
+  }
+  Table<Real>& variables = *m_variables;
+  if (variables.row_size() != variable_names.size() || variables.size() != dict.size())
+  {
+    variables.set_row_size(variable_names.size());
+    variables.resize(dict.size());
+    up_to_date = false;
+  }
+
+  // Assemble variables per point, checking if they changed since the last evaluation
+  const Real time = options().value<Real>("time");
+  const Uint time_var = field_comps.size();
   for (Uint pt=0; pt<dict.size(); ++pt)
   {
-    // Assemble variables per point
-    Uint c=0;
-    for (Uint j=0; j<field_comps.size(); ++j, ++c)
+    Table<Real>::Row point_vars = variables[pt];
+    for (Uint j=0; j<field_comps.size(); ++j)
     {
-      variables[c] = field_comps[j]->array()[pt][field_cols[j]];
+      const Real value = field_comps[j]->array()[pt][field_cols[j]];
+      if (point_vars[j] != value)
+      {
+        point_vars[j] = value;
+        if (used_variables[j])
+          up_to_date = false;
+      }
     }
-    for (Uint j=0; j<constants.size(); ++j, ++c)
+    if (point_vars[time_var] != time)
     {
-      variables[c] = constants[j];
+      point_vars[time_var] = time;
+      if (used_variables[time_var])
+        up_to_date = false;
     }
+  }
 
-    // Evaluate functions
+  // Evaluate functions for all points at once
+  if (!up_to_date)
+    m_function.evaluate_batch(variables, *m_values);
+
+  const Table<Real>& values = *m_values;
+  for (Uint pt=0; pt<dict.size(); ++pt)
+  {
     for (Uint f=0; f<cols.size(); ++f)
     {
-      m_field->array()[pt][f] = functions[f](variables);
+      m_field->array()[pt][cols[f]] = values[pt][f];
     }
   }
 }
@@ -9,6 +9,8 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <boost/shared_ptr.hpp>
+
 #include "math/VectorialFunction.hpp"
 
 #include "mesh/MeshTransformer.hpp"
@@ -18,6 +20,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace cf3 {
+namespace common { template <typename T> class Table; }
 namespace mesh { 
   class Field;
 namespace actions {
@@ -32,6 +35,8 @@ namespace actions {
 /// Append tensor-field variables with "xx", "xy", "xz", "yx", ...
 /// Append array-field variables with "[0]", "[1]", "[2]", ...
 /// The coordinate field can just be used as "x", "y", "z".
+/// The functions are evaluated for all points at once. If none of the variables used in the
+/// functions changed since the previous execution, the previous results are reused.
 class mesh_actions_API InitFieldFunction : public MeshTransformer
 {
 public: // functions
@@ -67,6 +72,16 @@ private: // data
   math::VectorialFunction  m_function;
   
   Handle<Field> m_field;
+
+  /// Variable names and functions m_function was parsed with
+  std::vector<std::string> m_parsed_variables;
+  std::vector<std::string> m_parsed_functions;
+
+  /// Variable values of each point, as used in the last evaluation
+  boost::shared_ptr< common::Table<Real> > m_variables;
+
+  /// Function values of each point from the last evaluation
+  boost::shared_ptr< common::Table<Real> > m_values;
   
 }; // end InitFieldFunction
 
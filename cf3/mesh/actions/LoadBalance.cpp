@@ -38,18 +38,17 @@ LoadBalance::LoadBalance( const std::string& name ) :
   ,m_partitioner(create_component("partitioner", "cf3.mesh.ptscotch.Partitioner"))
 #elif (defined CF3_HAVE_ZOLTAN)
   ,m_partitioner(create_component("partitioner", "cf3.mesh.zoltan.Partitioner"))
-#endif
-
-#if ( !defined CF3_HAVE_PTSCOTCH ) && ( !defined CF3_HAVE_ZOLTAN )
-#warning "There is no partitioner available (Zoltan or PT-Scotch). Load-balancing will not be possible."
-#define CF3_MESH_LOADBALANCE_PARTITIONER_UNAVAILABLE
+#else
+  // No graph partitioner available (Zoltan or PT-Scotch), fall back to the space filling curve
+  ,m_partitioner(create_component("partitioner", "cf3.mesh.HilbertPartitioner"))
 #endif
 {
 
   properties()["brief"] = std::string("Construct global node and element numbering based on coordinates hash values");
   std::string desc;
   desc =
-    "  Usage: LoadBalance Regions:array[uri]=region1,region2\n\n";
+    "  Usage: LoadBalance Regions:array[uri]=region1,region2\n\n"
+    "  Element costs (options element_costs and weights_field) are configured in the child component \"partitioner\"\n";
   properties()["description"] = desc;
 
 #if (defined CF3_HAVE_PTSCOTCH)
@@ -88,13 +87,9 @@ void LoadBalance::execute()
     CFinfo << "  + building global node-element connectivity ... done" << CFendl;
     Comm::instance().barrier();
 
-#ifdef CF3_MESH_LOADBALANCE_PARTITIONER_UNAVAILABLE
-    CFwarn << "  Skipping mesh partitioning. (No partitioner available)" << CFendl;
-#else
     CFinfo << "  + partitioning and migrating ..." << CFendl;
     m_partitioner->transform(mesh);
     CFinfo << "  + partitioning and migrating ... done" << CFendl;
-#endif
     Comm::instance().barrier();
     CFinfo << "  + growing overlap layer ..." << CFendl;
     build_component_abstract_type<MeshTransformer>("cf3.mesh.actions.GrowOverlap","grow_overlap")->transform(mesh);
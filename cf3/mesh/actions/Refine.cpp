@@ -0,0 +1,538 @@
+// Copyright (C) 2010-2013 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <algorithm>
+
+#include <boost/array.hpp>
+#include <boost/functional/hash.hpp>
+
+#include "common/Log.hpp"
+#include "common/Builder.hpp"
+
+#include "common/BasicExceptions.hpp"
+#include "common/FindComponents.hpp"
+#include "common/Foreach.hpp"
+#include "common/List.hpp"
+#include "common/OptionList.hpp"
+#include "common/OptionT.hpp"
+#include "common/PropertyList.hpp"
+
+#include "common/PE/Comm.hpp"
+
+#include "mesh/actions/Refine.hpp"
+#include "mesh/Connectivity.hpp"
+#include "mesh/Dictionary.hpp"
+#include "mesh/ElementType.hpp"
+#include "mesh/Entities.hpp"
+#include "mesh/Field.hpp"
+#include "mesh/GeoShape.hpp"
+#include "mesh/Mesh.hpp"
+#include "mesh/Space.hpp"
+
+//////////////////////////////////////////////////////////////////////////////
+
+namespace cf3 {
+namespace mesh {
+namespace actions {
+
+  using namespace common;
+
+////////////////////////////////////////////////////////////////////////////////
+
+common::ComponentBuilder < Refine, MeshTransformer, mesh::actions::LibActions> Refine_Builder;
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// Identification of an entity shared among ranks
+typedef boost::array<boost::uint64_t,3> Key;
+
+/// @brief Splitting of a LagrangeP1 shape in its children
+struct Pattern
+{
+  /// Number of vertices of the shape
+  Uint nb_vertices;
+  /// Vertices defining every new point, in cyclic order for faces.
+  /// The new point is the average of these vertices
+  std::vector< std::vector<Uint> > points;
+  /// Nodes of every child. Indices from nb_vertices on refer to the new points
+  std::vector< std::vector<Uint> > children;
+};
+
+std::vector< std::vector<Uint> > make_rows(const Uint* data, const Uint nb_rows, const Uint row_size)
+{
+  std::vector< std::vector<Uint> > rows(nb_rows);
+  for (Uint r=0; r<nb_rows; ++r)
+    rows[r].assign(data+r*row_size, data+(r+1)*row_size);
+  return rows;
+}
+
+Pattern make_pattern(const GeoShape::Type shape)
+{
+  static const Uint line_points[]     = { 0,1 };
+  static const Uint line_children[]   = { 0,2,  2,1 };
+
+  static const Uint triag_points[]    = { 0,1,  1,2,  2,0 };
+  static const Uint triag_children[]  = { 0,3,5,  3,1,4,  5,4,2,  3,4,5 };
+
+  static const Uint quad_edges[]      = { 0,1,  1,2,  2,3,  3,0 };
+  static const Uint quad_face[]       = { 0,1,2,3 };
+  static const Uint quad_children[]   = { 0,4,8,7,  4,1,5,8,  8,5,2,6,  7,8,6,3 };
+
+  static const Uint tetra_points[]    = { 0,1,  1,2,  0,2,  0,3,  1,3,  2,3 };
+  // 4 corner children, and the remaining octahedron split along its diagonal 6-8
+  static const Uint tetra_children[]  = { 0,4,6,7,  4,1,5,8,  6,5,2,9,  7,8,9,3,
+                                          6,8,4,5,  6,8,5,9,  6,8,9,7,  6,8,7,4 };
+
+  static const Uint hexa_edges[]      = { 0,1,  1,2,  2,3,  3,0,  0,4,  1,5,  2,6,  3,7,  4,5,  5,6,  6,7,  7,4 };
+  static const Uint hexa_faces[]      = { 0,1,2,3,  0,1,5,4,  1,2,6,5,  2,3,7,6,  3,0,4,7,  4,5,6,7 };
+  static const Uint hexa_cell[]       = { 0,1,2,3,4,5,6,7 };
+  static const Uint hexa_children[]   = {  0, 8,20,11,12,21,26,24,
+                                           8, 1, 9,20,21,13,22,26,
+                                          20, 9, 2,10,26,22,14,23,
+                                          11,20,10, 3,24,26,23,15,
+                                          12,21,26,24, 4,16,25,19,
+                                          21,13,22,26,16, 5,17,25,
+                                          26,22,14,23,25,17, 6,18,
+                                          24,26,23,15,19,25,18, 7 };
+
+  Pattern pattern;
+  switch (shape)
+  {
+    case GeoShape::POINT:
+      pattern.nb_vertices = 1;
+      pattern.children.assign(1, std::vector<Uint>(1,0u));
+      break;
+    case GeoShape::LINE:
+      pattern.nb_vertices = 2;
+      pattern.points   = make_rows(line_points,1,2);
+      pattern.children = make_rows(line_children,2,2);
+      break;
+    case GeoShape::TRIAG:
+      pattern.nb_vertices = 3;
+      pattern.points   = make_rows(triag_points,3,2);
+      pattern.children = make_rows(triag_children,4,3);
+      break;
+    case GeoShape::QUAD:
+      pattern.nb_vertices = 4;
+      pattern.points   = make_rows(quad_edges,4,2);
+      pattern.points.push_back(make_rows(quad_face,1,4)[0]);
+      pattern.children = make_rows(quad_children,4,4);
+      break;
+    case GeoShape::TETRA:
+      pattern.nb_vertices = 4;
+      pattern.points   = make_rows(tetra_points,6,2);
+      pattern.children = make_rows(tetra_children,8,4);
+      break;
+    case GeoShape::HEXA:
+    {
+      pattern.nb_vertices = 8;
+      pattern.points   = make_rows(hexa_edges,12,2);
+      const std::vector< std::vector<Uint> > faces = make_rows(hexa_faces,6,4);
+      pattern.points.insert(pattern.points.end(),faces.begin(),faces.end());
+      pattern.points.push_back(make_rows(hexa_cell,1,8)[0]);
+      pattern.children = make_rows(hexa_children,8,8);
+      break;
+    }
+    default:
+      throw NotSupported(FromHere(), "Refinement of shape "+GeoShape::Convert::instance().to_str(shape)+" is not supported");
+  }
+  return pattern;
+}
+
+/// @brief Key of a new point, from the global indices of the vertices of its element
+///
+/// Edges are identified by their 2 vertices. Faces and cells are identified by their
+/// lowest vertex, and the vertex diagonally opposite to it, which is unique in a conforming mesh.
+Key point_key(const std::vector<Uint>& point, const std::vector<boost::uint64_t>& vertex_glb_idx)
+{
+  static const Uint hexa_opposite[] = { 6,7,4,5,2,3,0,1 };
+
+  Uint min_k = 0;
+  for (Uint k=1; k<point.size(); ++k)
+  {
+    if (vertex_glb_idx[point[k]] < vertex_glb_idx[point[min_k]])
+      min_k = k;
+  }
+  Uint opposite_k;
+  Key key;
+  switch (point.size())
+  {
+    case 2: key[0] = 0; opposite_k = 1-min_k;             break;
+    case 4: key[0] = 1; opposite_k = (min_k+2)%4;         break;
+    case 8: key[0] = 2; opposite_k = hexa_opposite[min_k]; break;
+    default:
+      throw NotSupported(FromHere(), "Points defined by "+to_str(point.size())+" vertices are not supported");
+  }
+  key[1] = vertex_glb_idx[point[min_k]];
+  key[2] = vertex_glb_idx[point[opposite_k]];
+  return key;
+}
+
+/// @brief Exchange data with all ranks, or copy it in serial
+void exchange(const std::vector< std::vector<boost::uint64_t> >& send, std::vector< std::vector<boost::uint64_t> >& recv)
+{
+  if (PE::Comm::instance().is_active())
+    PE::Comm::instance().all_to_all(send,recv);
+  else
+    recv = send;
+}
+
+/// Entity registered at its home rank
+struct DirectoryEntry
+{
+  Key key;
+  Uint not_preferred;
+  Uint pid;
+  Uint position;
+  Uint size;
+
+  bool operator<(const DirectoryEntry& other) const
+  {
+    if (key != other.key)
+      return key < other.key;
+    if (not_preferred != other.not_preferred)
+      return not_preferred < other.not_preferred;
+    return pid < other.pid;
+  }
+};
+
+/// @brief Assign ranges of global indices to entities that can be present on several ranks
+///
+/// Every entity is sent to a home rank, determined by its key. The home ranks number
+/// their unique keys contiguously, starting from first_glb_idx, and reply the start of the
+/// range, and the owner of the entity. The owner is the lowest rank having the entity
+/// as preferred, e.g. because it owns an element containing it, or else the lowest rank having it.
+/// @return total number of global indices assigned over all ranks
+Gid number_entities(const std::vector<Key>& keys, const std::vector<Uint>& sizes, const std::vector<bool>& preferred,
+                    const Gid first_glb_idx, std::vector<Gid>& glb_idx, std::vector<Uint>& owner)
+{
+  PE::Comm& comm = PE::Comm::instance();
+  const Uint nb_pids = comm.is_active() ? comm.size() : 1u;
+  const Uint my_rank = comm.is_active() ? comm.rank() : 0u;
+
+  // Send the keys to their home rank
+  std::vector< std::vector<boost::uint64_t> > send(nb_pids);
+  std::vector< std::vector<Uint> > sent_entities(nb_pids);
+  for (Uint i=0; i<keys.size(); ++i)
+  {
+    const Uint home = boost::hash_range(keys[i].begin(),keys[i].end()) % nb_pids;
+    send[home].insert(send[home].end(),keys[i].begin(),keys[i].end());
+    send[home].push_back(sizes[i]);
+    send[home].push_back(preferred[i] ? 0u : 1u);
+    sent_entities[home].push_back(i);
+  }
+  std::vector< std::vector<boost::uint64_t> > recv;
+  exchange(send,recv);
+  send.clear();
+
+  // Number the unique keys at the home rank
+  const Uint entry_size = 5;
+  std::vector<DirectoryEntry> entries;
+  for (Uint pid=0; pid<recv.size(); ++pid)
+  {
+    for (Uint pos=0; pos<recv[pid].size()/entry_size; ++pos)
+    {
+      const boost::uint64_t* data = &recv[pid][pos*entry_size];
+      DirectoryEntry entry;
+      std::copy(data,data+3,entry.key.begin());
+      entry.size = data[3];
+      entry.not_preferred = data[4];
+      entry.pid = pid;
+      entry.position = pos;
+      entries.push_back(entry);
+    }
+  }
+  std::sort(entries.begin(),entries.end());
+
+  Uint nb_home_glb_idx = 0;
+  for (Uint e=0; e<entries.size(); ++e)
+  {
+    if (e == 0 || entries[e].key != entries[e-1].key)
+      nb_home_glb_idx += entries[e].size;
+  }
+  std::vector<Uint> nb_glb_idx_per_pid(1,nb_home_glb_idx);
+  if (comm.is_active())
+    comm.all_gather(nb_home_glb_idx,nb_glb_idx_per_pid);
+  Gid start = first_glb_idx;
+  Gid nb_glb_idx = 0;
+  for (Uint pid=0; pid<nb_glb_idx_per_pid.size(); ++pid)
+  {
+    if (pid < my_rank)
+      start += nb_glb_idx_per_pid[pid];
+    nb_glb_idx += nb_glb_idx_per_pid[pid];
+  }
+
+  std::vector< std::vector<boost::uint64_t> > reply(nb_pids);
+  for (Uint pid=0; pid<recv.size(); ++pid)
+    reply[pid].resize(2*(recv[pid].size()/entry_size));
+  recv.clear();
+  for (Uint first=0, last=0; first<entries.size(); first=last)
+  {
+    for (last=first; last<entries.size() && entries[last].key==entries[first].key; ++last)
+    {
+      reply[entries[last].pid][2*entries[last].position]   = start;
+      reply[entries[last].pid][2*entries[last].position+1] = entries[first].pid;
+    }
+    start += entries[first].size;
+  }
+  entries.clear();
+
+  // Receive the numbering of the own entities
+  std::vector< std::vector<boost::uint64_t> > recv_reply;
+  exchange(reply,recv_reply);
+  glb_idx.resize(keys.size());
+  owner.resize(keys.size());
+  for (Uint home=0; home<recv_reply.size(); ++home)
+  {
+    cf3_assert(recv_reply[home].size() == 2*sent_entities[home].size());
+    for (Uint pos=0; pos<sent_entities[home].size(); ++pos)
+    {
+      glb_idx[sent_entities[home][pos]] = recv_reply[home][2*pos];
+      owner[sent_entities[home][pos]]   = recv_reply[home][2*pos+1];
+    }
+  }
+  return nb_glb_idx;
+}
+
+/// New node, created on an edge, face or cell
+struct NewNode
+{
+  Key key;
+  bool owned;
+  Uint nb_vertices;
+  boost::array<Uint,8> vertices;
+
+  bool operator<(const NewNode& other) const { return key < other.key; }
+};
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+
+Refine::Refine( const std::string& name )
+: MeshTransformer(name)
+{
+  properties()["brief"] = std::string("Uniformly refine the mesh");
+  std::string desc;
+  desc =
+    "  Every LagrangeP1 element is split in 2^dim children, including the boundary elements.\n"
+    "  Nodes created on edges, faces and cells shared among ranks get consistent\n"
+    "  global indices and ranks, and the fields of the geometry dictionary are interpolated.";
+  properties()["description"] = desc;
+
+  options().add("nb_refinements", 1u)
+      .description("Number of times the mesh is refined")
+      .pretty_name("Number of Refinements")
+      .mark_basic();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+void Refine::execute()
+{
+  Mesh& mesh = *m_mesh;
+
+  const Uint nb_refinements = options().value<Uint>("nb_refinements");
+  for (Uint r=0; r<nb_refinements; ++r)
+    refine();
+
+  if (PE::Comm::instance().is_active())
+    mesh.geometry_fields().rebuild_comm_pattern();
+
+  mesh.raise_mesh_changed();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+void Refine::refine()
+{
+  Mesh& mesh = *m_mesh;
+  Dictionary& geometry = mesh.geometry_fields();
+  const bool parallel = PE::Comm::instance().is_active();
+  const Uint rank = PE::Comm::instance().rank();
+
+  boost_foreach (const Handle<Dictionary>& dict, mesh.dictionaries())
+  {
+    if (dict.get() != &geometry)
+      throw SetupError(FromHere(), "Mesh "+mesh.uri().string()+" can only be refined if it contains no other dictionary than the geometry, "
+                                   "but contains "+dict->uri().string()+". Create it after refinement.");
+  }
+
+  std::vector<Pattern> patterns(mesh.elements().size());
+  for (Uint entities_idx=0; entities_idx<mesh.elements().size(); ++entities_idx)
+  {
+    const ElementType& etype = mesh.elements()[entities_idx]->element_type();
+    if (etype.order() != 1)
+      throw NotSupported(FromHere(), "Refinement of "+mesh.elements()[entities_idx]->uri().string()+" is not supported, only LagrangeP1 elements can be refined");
+    patterns[entities_idx] = make_pattern(etype.shape());
+  }
+
+  const common::List<Gid>& node_glb_idx = geometry.glb_idx();
+
+  // Collect the new nodes of all elements
+  std::vector<NewNode> new_nodes;
+  std::vector<boost::uint64_t> vertex_glb_idx;
+  for (Uint entities_idx=0; entities_idx<mesh.elements().size(); ++entities_idx)
+  {
+    const Entities& entities = *mesh.elements()[entities_idx];
+    const Pattern& pattern = patterns[entities_idx];
+    const Connectivity& connectivity = entities.geometry_space().connectivity();
+    vertex_glb_idx.resize(pattern.nb_vertices);
+    for (Uint e=0; e<entities.size(); ++e)
+    {
+      for (Uint v=0; v<pattern.nb_vertices; ++v)
+        vertex_glb_idx[v] = node_glb_idx[connectivity[e][v]];
+      for (Uint p=0; p<pattern.points.size(); ++p)
+      {
+        NewNode new_node;
+        new_node.key = point_key(pattern.points[p],vertex_glb_idx);
+        new_node.owned = entities.rank()[e] == rank;
+        new_node.nb_vertices = pattern.points[p].size();
+        for (Uint k=0; k<new_node.nb_vertices; ++k)
+          new_node.vertices[k] = connectivity[e][pattern.points[p][k]];
+        new_nodes.push_back(new_node);
+      }
+    }
+  }
+
+  // Keep every new node once, owned if any owned element contains it
+  std::sort(new_nodes.begin(),new_nodes.end());
+  Uint nb_new_nodes = 0;
+  for (Uint n=0; n<new_nodes.size(); ++n)
+  {
+    if (nb_new_nodes != 0 && new_nodes[nb_new_nodes-1].key == new_nodes[n].key)
+      new_nodes[nb_new_nodes-1].owned = new_nodes[nb_new_nodes-1].owned || new_nodes[n].owned;
+    else
+      new_nodes[nb_new_nodes++] = new_nodes[n];
+  }
+  new_nodes.resize(nb_new_nodes);
+
+  std::vector<Key> new_node_keys(nb_new_nodes);
+  std::vector<bool> new_node_owned(nb_new_nodes);
+  for (Uint n=0; n<nb_new_nodes; ++n)
+  {
+    new_node_keys[n] = new_nodes[n].key;
+    new_node_owned[n] = new_nodes[n].owned;
+  }
+
+  // Number the new nodes after the existing ones
+  Gid nb_old_glb_nodes = 0;
+  for (Uint n=0; n<node_glb_idx.size(); ++n)
+    nb_old_glb_nodes = std::max(nb_old_glb_nodes,node_glb_idx[n]+1);
+  if (parallel)
+    PE::Comm::instance().all_reduce(PE::max(),&nb_old_glb_nodes,1,&nb_old_glb_nodes);
+  std::vector<Gid> new_node_glb_idx;
+  std::vector<Uint> new_node_rank;
+  const Gid nb_new_glb_nodes = number_entities(new_node_keys,std::vector<Uint>(nb_new_nodes,1u),new_node_owned,
+                                               nb_old_glb_nodes,new_node_glb_idx,new_node_rank);
+
+  // Create the new nodes, interpolating all fields
+  const Uint nb_old_nodes = geometry.size();
+  geometry.resize(nb_old_nodes+nb_new_nodes);
+  boost_foreach (Field& field, find_components<Field>(geometry))
+  {
+    for (Uint n=0; n<nb_new_nodes; ++n)
+    {
+      const NewNode& new_node = new_nodes[n];
+      for (Uint var=0; var<field.row_size(); ++var)
+      {
+        Real value = 0.;
+        for (Uint k=0; k<new_node.nb_vertices; ++k)
+          value += field[new_node.vertices[k]][var];
+        field[nb_old_nodes+n][var] = value / static_cast<Real>(new_node.nb_vertices);
+      }
+    }
+  }
+  for (Uint n=0; n<nb_new_nodes; ++n)
+  {
+    geometry.glb_idx()[nb_old_nodes+n] = new_node_glb_idx[n];
+    geometry.rank()[nb_old_nodes+n] = new_node_rank[n];
+  }
+  new_nodes.clear();
+
+  // Number the children of the elements after the nodes. In serial, element global
+  // indices may not be set, so the local position identifies the elements.
+  std::vector<Key> elem_keys;
+  std::vector<Uint> elem_nb_children;
+  std::vector<bool> elem_owned;
+  for (Uint entities_idx=0; entities_idx<mesh.elements().size(); ++entities_idx)
+  {
+    const Entities& entities = *mesh.elements()[entities_idx];
+    for (Uint e=0; e<entities.size(); ++e)
+    {
+      Key key;
+      key[0] = 3;
+      key[1] = parallel ? entities.glb_idx()[e] : entities_idx;
+      key[2] = parallel ? 0u : e;
+      elem_keys.push_back(key);
+      elem_nb_children.push_back(patterns[entities_idx].children.size());
+      elem_owned.push_back(entities.rank()[e] == rank);
+    }
+  }
+  std::vector<Gid> elem_glb_idx;
+  std::vector<Uint> elem_owner;
+  number_entities(elem_keys,elem_nb_children,elem_owned,nb_old_glb_nodes+nb_new_glb_nodes,elem_glb_idx,elem_owner);
+  elem_keys.clear();
+
+  // Replace the elements by their children
+  Uint elem_counter = 0;
+  for (Uint entities_idx=0; entities_idx<mesh.elements().size(); ++entities_idx)
+  {
+    Entities& entities = *mesh.elements()[entities_idx];
+    const Pattern& pattern = patterns[entities_idx];
+    const Uint nb_elems = entities.size();
+    const Uint nb_children = pattern.children.size();
+    const Uint nb_vertices = pattern.nb_vertices;
+
+    std::vector<Uint> old_connectivity(nb_elems*nb_vertices);
+    std::vector<Uint> old_rank(nb_elems);
+    for (Uint e=0; e<nb_elems; ++e)
+    {
+      for (Uint v=0; v<nb_vertices; ++v)
+        old_connectivity[e*nb_vertices+v] = entities.geometry_space().connectivity()[e][v];
+      old_rank[e] = entities.rank()[e];
+    }
+
+    entities.resize(nb_elems*nb_children);
+    Connectivity& connectivity = entities.geometry_space().connectivity();
+    vertex_glb_idx.resize(nb_vertices);
+    std::vector<Uint> point_nodes(pattern.points.size());
+    for (Uint e=0; e<nb_elems; ++e, ++elem_counter)
+    {
+      for (Uint v=0; v<nb_vertices; ++v)
+        vertex_glb_idx[v] = node_glb_idx[old_connectivity[e*nb_vertices+v]];
+      for (Uint p=0; p<pattern.points.size(); ++p)
+      {
+        const Key key = point_key(pattern.points[p],vertex_glb_idx);
+        const std::vector<Key>::const_iterator it = std::lower_bound(new_node_keys.begin(),new_node_keys.end(),key);
+        cf3_assert(it != new_node_keys.end() && *it == key);
+        point_nodes[p] = nb_old_nodes + (it - new_node_keys.begin());
+      }
+
+      for (Uint c=0; c<nb_children; ++c)
+      {
+        const Uint child = e*nb_children+c;
+        for (Uint j=0; j<nb_vertices; ++j)
+        {
+          const Uint node = pattern.children[c][j];
+          connectivity[child][j] = node < nb_vertices ? old_connectivity[e*nb_vertices+node] : point_nodes[node-nb_vertices];
+        }
+        entities.glb_idx()[child] = elem_glb_idx[elem_counter]+c;
+        entities.rank()[child] = old_rank[e];
+      }
+    }
+  }
+
+  CFdebug << "Refined mesh " << mesh.uri().string() << ": " << nb_new_glb_nodes << " new nodes" << CFendl;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+} // actions
+} // mesh
+} // cf3
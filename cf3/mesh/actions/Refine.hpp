@@ -0,0 +1,69 @@
+// Copyright (C) 2010-2013 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef cf3_mesh_actions_Refine_hpp
+#define cf3_mesh_actions_Refine_hpp
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "mesh/MeshTransformer.hpp"
+
+#include "mesh/actions/LibActions.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace cf3 {
+namespace mesh {
+namespace actions {
+
+//////////////////////////////////////////////////////////////////////////////
+
+/// @brief Uniformly refine a (partitioned) mesh
+///
+/// Every LagrangeP1 element is split in 2^dim children, including the boundary elements:
+/// - Line in 2 lines, through the midpoint
+/// - Triag in 4 triangles, through the edge midpoints
+/// - Quad in 4 quads, through the edge midpoints and the center
+/// - Tetra in 8 tetrahedra, through the edge midpoints
+/// - Hexa in 8 hexahedra, through the edge midpoints, face centers and the center
+///
+/// New nodes are identified by the global indices of the nodes of the edge, face or cell
+/// they are created on, so that ranks sharing them create the same node. Their global
+/// indices and ranks are assigned through a distributed directory, so no rank
+/// needs the new nodes of all other ranks. Children of an element keep its rank.
+/// All fields of the geometry dictionary are linearly interpolated to the new nodes.
+///
+/// The mesh may only contain the geometry dictionary, and element global indices
+/// must be unique over the mesh in parallel, as created by GlobalNumbering.
+class mesh_actions_API Refine : public MeshTransformer
+{
+public: // functions
+
+  /// constructor
+  Refine( const std::string& name );
+
+  /// Gets the Class name
+  static std::string type_name() { return "Refine"; }
+
+  virtual void execute();
+
+private: // functions
+
+  /// @brief Refine every element of the mesh once
+  void refine();
+
+}; // end Refine
+
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // actions
+} // mesh
+} // cf3
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // cf3_mesh_actions_Refine_hpp
@@ -5,7 +5,13 @@
 // See doc/lgpl.txt and doc/gpl.txt for the license text.
 
 // coolfluid
+#include <algorithm>
+#include <limits>
+
+#include <boost/static_assert.hpp>
+
 #include "common/Builder.hpp"
+#include "common/Foreach.hpp"
 #include "common/OptionList.hpp"
 #include "common/OptionT.hpp"
 #include "common/Log.hpp"
@@ -24,6 +30,10 @@ namespace ptscotch {
 
 cf3::common::ComponentBuilder < Partitioner, MeshTransformer, LibPTScotch > ptscotch_partitioner_builder;
 
+// Global object ids are stored in the edge arrays as SCOTCH_Num
+BOOST_STATIC_ASSERT_MSG( sizeof(SCOTCH_Num) >= sizeof(Gid),
+  "PT-Scotch must be built with 64-bit integers (-DINTSIZE64) when CF3_ENABLE_64BIT_GLOBAL_INDICES is set" );
+
 //////////////////////////////////////////////////////////////////////////////
 
 Partitioner::Partitioner ( const std::string& name ) :
@@ -85,13 +95,35 @@ void Partitioner::build_graph()
 
   list_of_connected_objects_in_part(Comm::instance().rank(),edgeloctab);
 
+  // Scotch takes integer vertex loads: scale the weights such that the lightest object
+  // gets a load of 10, keeping the heaviest load below 1000
+  veloloctab.clear();
+  if (has_object_weights())
+  {
+    const std::vector<Real>& weights = object_weights();
+    Real min_weight = std::numeric_limits<Real>::max();
+    Real max_weight = 0.;
+    boost_foreach(const Real w, weights)
+    {
+      if (w > 0.)
+        min_weight = std::min(min_weight, w);
+      max_weight = std::max(max_weight, w);
+    }
+    Comm::instance().all_reduce(PE::min(), &min_weight, 1, &min_weight);
+    Comm::instance().all_reduce(PE::max(), &max_weight, 1, &max_weight);
+    const Real scale = max_weight > 0. ? std::min(10./min_weight, 1000./max_weight) : 1.;
+    veloloctab.resize(weights.size());
+    for (Uint i=0; i<weights.size(); ++i)
+      veloloctab[i] = std::max(static_cast<SCOTCH_Num>(1), static_cast<SCOTCH_Num>(weights[i]*scale + 0.5));
+  }
+
   if (SCOTCH_dgraphBuild(&graph,
                          baseval,
                          vertlocnbr,      // number of local vertices (for creation of proccnttab)
                          vertlocmax,          // max number of local vertices to be created (for creation of procvrttab)
                          &vertloctab[0],  // local adjacency index array (size = vertlocnbr+1 if vendloctab matches or is null)
                          &vertloctab[1],  //   (optional) local adjacency end index array
-                         NULL, //veloloctab,  //   (optional) local vertex load array
+                         veloloctab.empty() ? NULL : &veloloctab[0], //   (optional) local vertex load array
                          NULL,  //vlblocltab,  //   (optional) local vertex label array (size = vertlocnbr+1)
                          edgelocnbr,      // total number of arcs (twice number of edges)
                          edgelocsiz,      // minimum size of the edge array required to encompass all used adjacency values (at least equal to the max of vendloctab entries)
@@ -117,7 +149,7 @@ void Partitioner::build_graph()
 
     CF3_DEBUG_POINT;
 
-    Uint cnt=0;
+    Gid cnt=0;
     for (Uint p=0; p<proccnttab.size(); ++p)
     {
       procvrttab[p] = cnt;
@@ -169,7 +201,7 @@ void Partitioner::partition_graph()
   SCOTCH_stratExit(&stradat);
   CF3_DEBUG_POINT;
 
-  std::vector<Uint> owned_objects(vertlocnbr);
+  std::vector<Gid> owned_objects(vertlocnbr);
   list_of_objects_owned_by_part(Comm::instance().rank(),owned_objects);
 
 //  Uint nb_changes = 0;
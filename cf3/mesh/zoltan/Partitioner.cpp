@@ -6,6 +6,8 @@
 
 #include <set>
 
+#include <boost/static_assert.hpp>
+
 #include "common/Builder.hpp"
 #include "common/PropertyList.hpp"
 #include "common/OptionList.hpp"
@@ -32,6 +34,10 @@ namespace zoltan {
 
 cf3::common::ComponentBuilder < Partitioner, MeshTransformer, LibZoltan > zoltan_partitioner_transformer_builder;
 
+// Global object ids are passed to zoltan as ZOLTAN_ID_TYPE
+BOOST_STATIC_ASSERT_MSG( sizeof(ZOLTAN_ID_TYPE) >= sizeof(Gid),
+  "Zoltan must be configured with 64-bit ids (--with-id-type=ullong) when CF3_ENABLE_64BIT_GLOBAL_INDICES is set" );
+
 //////////////////////////////////////////////////////////////////////////////
 
 Partitioner::Partitioner ( const std::string& name ) :
@@ -44,6 +50,11 @@ Partitioner::Partitioner ( const std::string& name ) :
       .pretty_name("Graph Package")
       .mark_basic();
 
+  options().add("lb_approach", std::string("PARTITION"))
+      .description("Zoltan load balancing approach: PARTITION (from scratch), "
+                   "REPARTITION (keep data migration low, for dynamic load balancing) or REFINE")
+      .pretty_name("Load Balancing Approach");
+
   options().add("debug_level", 0u)
       .description("Internal zoltan debug level (0 to 10)")
       .pretty_name("Debug Level");
@@ -153,7 +164,7 @@ void Partitioner::set_partitioning_params()
   // HIER (for hybrid hierarchical partitioning)
   // NONE (for no load balancing).
 
-  zoltan_handle().Set_Param( "LB_APPROACH", "PARTITION");
+  zoltan_handle().Set_Param( "LB_APPROACH", options()["lb_approach"].value<std::string>());
   // The desired load balancing approach. Only LB_METHOD = HYPERGRAPH or GRAPH
   // uses the LB_APPROACH parameter. Valid values are
   //   PARTITION (Partition "from scratch," not taking into account the current data distribution;
@@ -180,6 +191,10 @@ void Partitioner::set_partitioning_params()
   zoltan_handle().Set_Param( "NUM_GLOBAL_PARTS", to_str( options()["nb_parts"].value<Uint>() ));
   // The total number of parts to be generated by a call to Zoltan_LB_Partition.
 
+  zoltan_handle().Set_Param( "OBJ_WEIGHT_DIM", has_object_weights() ? "1" : "0");
+  // The number of weights (to be supplied by the user in a query function) associated with an object.
+  // If this parameter is zero, all objects have equal weight.
+
 
   /// zoltan graph parameters
 
@@ -242,14 +257,20 @@ void Partitioner::query_list_of_objects(void *data, int sizeGID, int sizeLID,
 
   p.list_of_objects_owned_by_part(PE::Comm::instance().rank(),globalID);
 
+  if (wgt_dim > 0)
+  {
+    const std::vector<Real>& weights = p.object_weights();
+    for (Uint i=0; i<weights.size(); ++i)
+      obj_wgts[i] = static_cast<float>(weights[i]);
+  }
 
   // for debugging
 #if 0
-  std::vector<Uint> glbID(p.nb_objects_owned_by_part(PE::Comm::instance().rank()));
+  std::vector<Gid> glbID(p.nb_objects_owned_by_part(PE::Comm::instance().rank()));
   p.list_of_objects_owned_by_part(PE::Comm::instance().rank(),glbID);
 
   CFdebug << RANK << "glbID =";
-  boost_foreach(const Uint g, glbID)
+  boost_foreach(const Gid g, glbID)
     CFdebug << " " << g;
   CFdebug << CFendl;
 #endif
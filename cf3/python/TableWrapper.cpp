@@ -6,6 +6,7 @@
 
 #include "python/BoostPython.hpp"
 
+#include <map>
 #include <sstream>
 
 #include <boost/weak_ptr.hpp>
@@ -13,6 +14,7 @@
 #include "common/Log.hpp"
 #include "common/StreamHelpers.hpp"
 
+#include "common/List.hpp"
 #include "common/Table.hpp"
 
 #include "python/ComponentWrapper.hpp"
@@ -24,6 +26,190 @@ namespace python {
 
 using namespace boost::python;
 
+/// Number of exported views on the storage of each Table or List. Storage with views on it may not be resized
+/// from python, since that would leave the views dangling.
+std::map<const common::Component*, Uint>& exported_views()
+{
+  static std::map<const common::Component*, Uint> views;
+  return views;
+}
+
+void check_no_views(const common::Component& component)
+{
+  if(exported_views().count(&component))
+    throw common::SetupError(FromHere(), "Storage of " + component.uri().string() + " can not be resized while array views on it exist");
+}
+
+/// Format character of the python struct module for each value type
+template<typename ValueT> struct BufferFormat;
+template<> struct BufferFormat<double>        { static char* value() { return const_cast<char*>("d"); } };
+template<> struct BufferFormat<long double>   { static char* value() { return const_cast<char*>("g"); } };
+template<> struct BufferFormat<float>         { static char* value() { return const_cast<char*>("f"); } };
+template<> struct BufferFormat<int>           { static char* value() { return const_cast<char*>("i"); } };
+template<> struct BufferFormat<unsigned int>  { static char* value() { return const_cast<char*>("I"); } };
+template<> struct BufferFormat<unsigned long> { static char* value() { return const_cast<char*>("L"); } };
+
+/// Python object exporting the storage of a Table or List through the buffer protocol, without copy
+struct ArrayBuffer
+{
+  PyObject_HEAD
+  /// The component owning the storage, which may be removed while the python object lives
+  Handle<common::Component>* component;
+  /// Key of the component in the exported views, valid after the component is removed
+  const common::Component* key;
+  /// Describes the storage of the component in the buffer
+  void (*describe)(common::Component&, ArrayBuffer&);
+  void* data;
+  char* format;
+  Py_ssize_t itemsize;
+  int ndim;
+  Py_ssize_t shape[2];
+  Py_ssize_t strides[2];
+};
+
+template<typename ValueT>
+void describe_table(common::Component& component, ArrayBuffer& buffer)
+{
+  common::Table<ValueT>& table = static_cast<common::Table<ValueT>&>(component);
+  buffer.data = table.array().data();
+  buffer.format = BufferFormat<ValueT>::value();
+  buffer.itemsize = sizeof(ValueT);
+  buffer.ndim = 2;
+  buffer.shape[0] = table.size();
+  buffer.shape[1] = table.row_size();
+  // Padded rows are longer than the number of columns
+  buffer.strides[0] = table.row_stride() * sizeof(ValueT);
+  buffer.strides[1] = sizeof(ValueT);
+}
+
+template<typename ValueT>
+void describe_list(common::Component& component, ArrayBuffer& buffer)
+{
+  common::List<ValueT>& list = static_cast<common::List<ValueT>&>(component);
+  buffer.data = list.array().data();
+  buffer.format = BufferFormat<ValueT>::value();
+  buffer.itemsize = sizeof(ValueT);
+  buffer.ndim = 1;
+  buffer.shape[0] = list.size();
+  buffer.strides[0] = sizeof(ValueT);
+}
+
+int array_buffer_get(PyObject* obj, Py_buffer* view, int flags)
+{
+  ArrayBuffer& buffer = *reinterpret_cast<ArrayBuffer*>(obj);
+  if(is_null(*buffer.component))
+  {
+    view->obj = NULL;
+    PyErr_SetString(PyExc_BufferError, "The component of this array view was removed");
+    return -1;
+  }
+
+  common::Component& component = **buffer.component;
+  buffer.describe(component, buffer);
+
+  // The rows of padded tables are not contiguous, so the consumer has to use the strides
+  const bool contiguous = buffer.ndim == 1 || buffer.strides[0] == buffer.shape[1] * buffer.itemsize;
+  if(!contiguous && ((flags & PyBUF_STRIDES) != PyBUF_STRIDES
+                     || (flags & PyBUF_C_CONTIGUOUS) == PyBUF_C_CONTIGUOUS
+                     || (flags & PyBUF_F_CONTIGUOUS) == PyBUF_F_CONTIGUOUS
+                     || (flags & PyBUF_ANY_CONTIGUOUS) == PyBUF_ANY_CONTIGUOUS))
+  {
+    view->obj = NULL;
+    PyErr_SetString(PyExc_BufferError, "The rows of this table are padded, so its storage is not contiguous");
+    return -1;
+  }
+
+  view->obj = obj;
+  Py_INCREF(obj);
+  view->buf = buffer.data;
+  view->len = buffer.itemsize;
+  for(int i = 0; i != buffer.ndim; ++i)
+    view->len *= buffer.shape[i];
+  view->readonly = 0;
+  view->itemsize = buffer.itemsize;
+  view->format = (flags & PyBUF_FORMAT) ? buffer.format : NULL;
+  view->ndim = buffer.ndim;
+  view->shape = (flags & PyBUF_ND) ? buffer.shape : NULL;
+  view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? buffer.strides : NULL;
+  view->suboffsets = NULL;
+  view->internal = NULL;
+
+  ++exported_views()[&component];
+  return 0;
+}
+
+void array_buffer_release(PyObject* obj, Py_buffer*)
+{
+  ArrayBuffer& buffer = *reinterpret_cast<ArrayBuffer*>(obj);
+  std::map<const common::Component*, Uint>::iterator it = exported_views().find(buffer.key);
+  if(it != exported_views().end() && --it->second == 0)
+    exported_views().erase(it);
+}
+
+void array_buffer_dealloc(PyObject* obj)
+{
+  delete reinterpret_cast<ArrayBuffer*>(obj)->component;
+  PyObject_Del(obj);
+}
+
+PyTypeObject& array_buffer_type()
+{
+  static PyBufferProcs buffer_procs;
+  static PyTypeObject type = { PyVarObject_HEAD_INIT(NULL, 0) };
+  if(is_null(type.tp_name))
+  {
+    buffer_procs.bf_getbuffer = array_buffer_get;
+    buffer_procs.bf_releasebuffer = array_buffer_release;
+
+    type.tp_name = "coolfluid.ArrayBuffer";
+    type.tp_basicsize = sizeof(ArrayBuffer);
+    type.tp_dealloc = array_buffer_dealloc;
+    type.tp_as_buffer = &buffer_procs;
+#ifdef Py_TPFLAGS_HAVE_NEWBUFFER
+    type.tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_NEWBUFFER;
+#else
+    type.tp_flags = Py_TPFLAGS_DEFAULT;
+#endif
+    type.tp_doc = "Exports the storage of a Table or List";
+    if(PyType_Ready(&type) < 0)
+      throw_error_already_set();
+  }
+  return type;
+}
+
+/// Methods giving zero-copy views on the storage of a Table or List
+template<void (*DescribeT)(common::Component&, ArrayBuffer&)>
+struct ArrayViewMethods
+{
+  /// memoryview on the storage, with the shape and strides of the array
+  static object buffer(ComponentWrapper& wrapped)
+  {
+    ArrayBuffer* exporter = PyObject_New(ArrayBuffer, &array_buffer_type());
+    if(is_null(exporter))
+      throw_error_already_set();
+    exporter->component = new Handle<common::Component>(wrapped.component().handle());
+    exporter->key = &wrapped.component();
+    exporter->describe = DescribeT;
+
+    handle<> exporter_handle(reinterpret_cast<PyObject*>(exporter));
+    return object(handle<>(PyMemoryView_FromObject(exporter_handle.get())));
+  }
+
+  /// numpy array sharing the storage
+  static object array(ComponentWrapper& wrapped)
+  {
+    return import("numpy").attr("asarray")(buffer(wrapped));
+  }
+};
+
+template<void (*DescribeT)(common::Component&, ArrayBuffer&)>
+void add_array_view_methods(boost::python::api::object& py_obj)
+{
+  typedef ArrayViewMethods<DescribeT> ViewMethodsT;
+  add_function(py_obj, ViewMethodsT::buffer, "buffer", "Return a memoryview on the data, without copy. The storage can not be resized from python while views on it exist");
+  add_function(py_obj, ViewMethodsT::array, "array", "Return a numpy array sharing the data. The storage can not be resized from python while the array exists");
+}
+
 /// Functions exposed to python dealing with table rows
 template<typename ValueT>
 struct TableRowWrapper
@@ -118,11 +304,13 @@ struct TableMethods
 
   static void resize(ComponentWrapper& wrapped, const Uint nb_rows)
   {
+    check_no_views(wrapped.component());
     wrapped.component< common::Table<ValueT> >().resize(nb_rows);
   }
 
   static void set_row_size(ComponentWrapper& wrapped, const Uint nb_cols)
   {
+    check_no_views(wrapped.component());
     wrapped.component< common::Table<ValueT> >().set_row_size(nb_cols);
   }
 };
@@ -141,6 +329,12 @@ void add_ctable_methods(ComponentWrapper& wrapped, boost::python::api::object& p
     add_function(py_obj, ExtraMethodsT::row_size, "row_size", "Return the number of columns the table can hold");
     add_function(py_obj, ExtraMethodsT::resize, "resize", "Set the size of the table, i.e. the number of rows");
     add_function(py_obj, ExtraMethodsT::set_row_size, "set_row_size", "Set the size of a row, i.e. the number of columns in the table");
+
+    add_array_view_methods< describe_table<ValueT> >(py_obj);
+  }
+  else if(dynamic_cast<const common::List<ValueT>*>(&wrapped.component()))
+  {
+    add_array_view_methods< describe_list<ValueT> >(py_obj);
   }
 }
 
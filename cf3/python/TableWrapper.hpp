@@ -15,7 +15,8 @@ namespace python {
 
 class ComponentWrapper;
 
-/// Python wrapping for the Table class
+/// Python wrapping for the Table class. Tables and Lists (including Fields) also get zero-copy
+/// array views on their storage, through the buffer protocol.
 void add_ctable_methods(ComponentWrapper& wrapped, boost::python::api::object& py_obj);
 
 void def_ctable_types();
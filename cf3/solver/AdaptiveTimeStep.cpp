@@ -0,0 +1,251 @@
+// Copyright (C) 2010-2013 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <cmath>
+
+#include <boost/bind.hpp>
+
+#include "common/Builder.hpp"
+#include "common/FindComponents.hpp"
+#include "common/Foreach.hpp"
+#include "common/Log.hpp"
+#include "common/OptionArray.hpp"
+#include "common/OptionComponent.hpp"
+#include "common/OptionList.hpp"
+#include "common/OptionT.hpp"
+#include "common/PropertyList.hpp"
+#include "common/PE/Comm.hpp"
+
+#include "mesh/Field.hpp"
+
+#include "solver/AdaptiveTimeStep.hpp"
+
+using namespace cf3::common;
+using namespace cf3::mesh;
+
+namespace cf3 {
+namespace solver {
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+common::ComponentBuilder < AdaptiveTimeStep, common::Component, LibSolver > AdaptiveTimeStep_Builder;
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+AdaptiveTimeStep::AdaptiveTimeStep ( const std::string& name ) :
+  common::Component(name),
+  m_error(0.),
+  m_previous_error(1.),
+  m_nb_rejections(0)
+{
+  properties()["brief"] = std::string("Adaptive time step controller");
+  properties()["description"] = std::string(
+    "PI controller adapting the time step of TimeStepping to a normalized error estimate,\n"
+    "rejecting steps and restoring the fields if the error is too large");
+
+  std::vector<URI> dummy;
+  options().add("fields", dummy)
+      .description("Fields of which the change is the error estimate, and which are restored on step rejection")
+      .attach_trigger ( boost::bind ( &AdaptiveTimeStep::config_fields, this ) )
+      .mark_basic();
+
+  options().add("error_field", m_error_field)
+      .description("Optional embedded error estimate, with the same layout as the first of \"fields\"")
+      .link_to(&m_error_field);
+
+  options().add("abs_tolerance", 1e-6)
+      .description("Absolute tolerance of the error estimate")
+      .mark_basic();
+
+  options().add("rel_tolerance", 1e-3)
+      .description("Relative tolerance of the error estimate")
+      .mark_basic();
+
+  options().add("order", 1u)
+      .description("Order of the error estimate");
+
+  options().add("safety", 0.9)
+      .description("Safety factor applied to the proposed time step");
+
+  options().add("k_i", 0.3)
+      .description("Integral gain of the PI controller");
+
+  options().add("k_p", 0.4)
+      .description("Proportional gain of the PI controller");
+
+  options().add("min_factor", 0.2)
+      .description("Minimal factor by which the time step can change");
+
+  options().add("max_factor", 5.)
+      .description("Maximal factor by which the time step can change");
+
+  options().add("min_time_step", 0.)
+      .description("Minimal time step. Steps with this time step are always accepted");
+
+  options().add("max_time_step", 0.)
+      .description("Maximal time step (0 = unbounded)");
+
+  options().add("max_rejections", 10u)
+      .description("Maximal number of consecutive rejections, after which the step is accepted anyway");
+
+  properties().add("nb_rejected_steps", 0u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void AdaptiveTimeStep::config_fields()
+{
+  m_fields.clear();
+  boost_foreach(const URI& field_path, options().value< std::vector<URI> >("fields"))
+  {
+    Handle<Field> field(access_component(field_path));
+    if (is_null(field))
+      throw ValueNotFound ( FromHere(), "Could not find field with path [" + field_path.path() +"]" );
+    m_fields.push_back(field);
+  }
+  m_backup.resize(m_fields.size());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void AdaptiveTimeStep::begin_step()
+{
+  if (m_fields.empty())
+    throw SetupError(FromHere(), "Option \"fields\" was not configured in "+uri().string());
+
+  for (Uint f=0; f<m_fields.size(); ++f)
+  {
+    // Copied row by row, since the rows of the field may be padded
+    const Field& field = *m_fields[f];
+    m_backup[f].resize(boost::extents[field.size()][field.row_size()]);
+    for (Uint i=0; i<field.size(); ++i)
+    {
+      for (Uint v=0; v<field.row_size(); ++v)
+        m_backup[f][i][v] = field[i][v];
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void AdaptiveTimeStep::restore_fields()
+{
+  for (Uint f=0; f<m_fields.size(); ++f)
+  {
+    Field& field = *m_fields[f];
+    for (Uint i=0; i<field.size(); ++i)
+    {
+      for (Uint v=0; v<field.row_size(); ++v)
+        field[i][v] = m_backup[f][i][v];
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Real AdaptiveTimeStep::compute_error() const
+{
+  const Real atol = options().value<Real>("abs_tolerance");
+  const Real rtol = options().value<Real>("rel_tolerance");
+
+  Real error = 0.;
+  if (is_not_null(m_error_field))
+  {
+    const Field& estimate = *m_error_field;
+    const Field& u = *m_fields.front();
+    if (estimate.size() != u.size() || estimate.row_size() != u.row_size())
+      throw SetupError(FromHere(), "error_field "+estimate.uri().string()+" does not match the layout of "+u.uri().string());
+    for (Uint i=0; i<u.size(); ++i)
+    {
+      for (Uint v=0; v<u.row_size(); ++v)
+        error = std::max(error, std::abs(estimate[i][v]) / (atol + rtol*std::abs(u[i][v])));
+    }
+  }
+  else
+  {
+    for (Uint f=0; f<m_fields.size(); ++f)
+    {
+      const Field& u = *m_fields[f];
+      const Table<Real>::ArrayT& u_old = m_backup[f];
+      for (Uint i=0; i<u.size(); ++i)
+      {
+        for (Uint v=0; v<u.row_size(); ++v)
+        {
+          const Real scale = atol + rtol*std::max(std::abs(u[i][v]),std::abs(u_old[i][v]));
+          error = std::max(error, std::abs(u[i][v]-u_old[i][v]) / scale);
+        }
+      }
+    }
+  }
+
+  if (PE::Comm::instance().is_active())
+    PE::Comm::instance().all_reduce(PE::max(), &error, 1, &error);
+
+  return error;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+Real AdaptiveTimeStep::limit_time_step(const Real time_step) const
+{
+  const Real min_dt = options().value<Real>("min_time_step");
+  const Real max_dt = options().value<Real>("max_time_step");
+  Real dt = std::max(time_step,min_dt);
+  if (max_dt > 0.)
+    dt = std::min(dt,max_dt);
+  return dt;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+bool AdaptiveTimeStep::end_step(Real& time_step)
+{
+  const Real exponent   = 1./static_cast<Real>(options().value<Uint>("order")+1);
+  const Real safety     = options().value<Real>("safety");
+  const Real min_factor = options().value<Real>("min_factor");
+  const Real max_factor = options().value<Real>("max_factor");
+  const Real min_dt     = options().value<Real>("min_time_step");
+
+  m_error = compute_error();
+
+  const bool at_min_dt = time_step <= min_dt;
+  const bool too_many_rejections = m_nb_rejections >= options().value<Uint>("max_rejections");
+  if (m_error > 1. && !at_min_dt && !too_many_rejections)
+  {
+    // Reject: restore the fields, and retry with a smaller time step
+    const Real factor = std::max(min_factor, safety * std::pow(m_error,-exponent));
+    restore_fields();
+    time_step = limit_time_step(time_step * std::min(factor,1.));
+    ++m_nb_rejections;
+    properties()["nb_rejected_steps"] = properties().value<Uint>("nb_rejected_steps") + 1u;
+    return false;
+  }
+
+  if (m_error > 1.)
+    CFwarn << uri().string() << ": accepting step with error " << m_error << " above tolerance" << CFendl;
+
+  // Accept: PI control of the next time step
+  Real factor = max_factor;
+  if (m_error > 0.)
+  {
+    factor = safety * std::pow(m_error, -options().value<Real>("k_i")*exponent)
+                    * std::pow(m_previous_error/m_error, options().value<Real>("k_p")*exponent);
+  }
+  factor = std::min(max_factor, std::max(min_factor, factor));
+  // Right after a rejection, do not increase the time step
+  if (m_nb_rejections)
+    factor = std::min(factor,1.);
+
+  time_step = limit_time_step(time_step * factor);
+  m_previous_error = std::max(m_error, 1e-10);
+  m_nb_rejections = 0;
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // solver
+} // cf3
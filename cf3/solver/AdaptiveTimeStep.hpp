@@ -0,0 +1,97 @@
+// Copyright (C) 2010-2013 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef cf3_solver_AdaptiveTimeStep_hpp
+#define cf3_solver_AdaptiveTimeStep_hpp
+
+#include "common/Component.hpp"
+#include "common/Table.hpp"
+
+#include "solver/LibSolver.hpp"
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+namespace cf3 {
+namespace mesh { class Field; }
+namespace solver {
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Adaptive time step controller, to be plugged into TimeStepping
+///
+/// A PI controller adapts the time step based on a normalized error estimate
+/// of every step. The error estimate is either
+/// - an embedded error estimate, computed by the time integration scheme in the
+///   field configured as "error_field", having the same layout as the first of "fields", or
+/// - the change of the configured "fields" during the step.
+///
+/// Every component is normalized with abs_tolerance + rel_tolerance * |u|, and the
+/// maximum over all components and all ranks is the error @f$ e_n @f$ of the step.
+/// A step is accepted if @f$ e_n \le 1 @f$, and the time step for the next step is
+/// @f[ \Delta t_{n+1} = \Delta t_n \; s \; e_n^{-k_I/(p+1)} \; \left(\frac{e_{n-1}}{e_n}\right)^{k_P/(p+1)} @f]
+/// with safety factor s, and order p of the error estimate.
+/// A rejected step restores the configured fields to their state at the beginning of the step,
+/// and is retried with a time step reduced by @f$ s \; e_n^{-1/(p+1)} @f$.
+/// The change factor is limited by min_factor and max_factor, and the time step
+/// by min_time_step and max_time_step.
+class solver_API AdaptiveTimeStep : public common::Component
+{
+public: // functions
+
+  /// Contructor
+  /// @param name of the component
+  AdaptiveTimeStep ( const std::string& name );
+
+  /// Virtual destructor
+  virtual ~AdaptiveTimeStep() {}
+
+  /// Get the class name
+  static std::string type_name () { return "AdaptiveTimeStep"; }
+
+  /// @brief Save the state of the configured fields, before a step is attempted
+  void begin_step();
+
+  /// @brief Estimate the error of the step that was just computed, and propose a new time step
+  /// @param [in,out] time_step  time step of the attempted step, on output the
+  ///                            time step for the next attempt or the next step
+  /// @return true if the step is accepted. If not, the fields are restored to
+  ///         their state at begin_step()
+  bool end_step(Real& time_step);
+
+  /// @brief Restore the configured fields to their state at begin_step()
+  void restore_fields();
+
+  /// @brief Normalized error estimate of the last attempted step
+  Real error() const { return m_error; }
+
+private: // functions
+
+  /// @brief Resolve the option "fields"
+  void config_fields();
+
+  /// @brief Compute the normalized error estimate of the attempted step
+  Real compute_error() const;
+
+  /// @brief Limit the time step to the configured bounds
+  Real limit_time_step(const Real time_step) const;
+
+private: // data
+
+  std::vector< Handle<mesh::Field> > m_fields;            ///< fields monitored and restored
+  Handle<mesh::Field>                m_error_field;       ///< optional embedded error estimate
+  std::vector< common::Table<Real>::ArrayT > m_backup;    ///< state of m_fields at begin_step()
+
+  Real m_error;            ///< normalized error of the last attempted step
+  Real m_previous_error;   ///< normalized error of the last accepted step
+  Uint m_nb_rejections;    ///< number of consecutive rejections of the current step
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // solver
+} // cf3
+
+#endif // cf3_solver_AdaptiveTimeStep_hpp
@@ -6,6 +6,8 @@
 
 #include <cmath>
 
+#include <boost/bind.hpp>
+
 #include "cf3/common/PE/Comm.hpp"
 #include "cf3/common/Builder.hpp"
 #include "cf3/common/Log.hpp"
@@ -27,102 +29,25 @@ namespace solver {
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 
-void compute_L2( const Field& field, std::vector<Real>& norms )
+namespace detail
 {
 
-  std::vector<Real> loc_norm(norms.size(),0.); // norm on local processor
-  std::vector<Real> glb_norm(norms.size(),0.); // norm summed over all processors
-
-  if (field.discontinuous())
-  {
-    // loop over all elements
-    boost_foreach (const Handle<Space>& space, field.spaces() )
-    {
-      // only if the elements are volume elements
-      if (space->support().element_type().dimension() == space->support().element_type().dimensionality())
-      {
-        for (Uint e=0; e<space->size(); ++e)
-        {
-          if (!space->support().is_ghost(e))
-          {
-            // compute norm for these nodes
-            boost_foreach( const Uint node, space->connectivity()[e] )
-            {
-              for (Uint i=0; i<norms.size(); ++i)
-                loc_norm[i] += field[node][i]*field[node][i];
-            }
-          }
-        }
-      }
-    }
-  }
-  else if (field.continuous())
-  {
-    for (Uint n=0; n<field.size(); ++n)
-    {
-      if (!field.is_ghost(n))
-      {
-        for (Uint i=0; i<norms.size(); ++i)
-          loc_norm[i] += field[n][i]*field[n][i];
-      }
-    }
-  }
-
-  PE::Comm::instance().all_reduce( PE::plus(), &loc_norm[0], norms.size(), &glb_norm[0] );
-
-  for (Uint i=0; i<norms.size(); ++i)
-    norms[i] = std::sqrt(glb_norm[i]);
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-void compute_L1( const Field& field, std::vector<Real>& norms )
+/// Local contributions to the different norms, combined entry by entry
+struct L1Op   { Real operator()(const Real acc, const Real x) const { return acc + std::abs(x); } };
+struct L2Op   { Real operator()(const Real acc, const Real x) const { return acc + x*x; } };
+struct LinfOp { Real operator()(const Real acc, const Real x) const { return std::max(std::abs(x), acc); } };
+struct LpOp
 {
-  std::vector<Real> loc_norm(norms.size(),0.); // norm on local processor
-
-  if (field.discontinuous())
-  {
-    // loop over all elements
-    boost_foreach (const Handle<Space>& space, field.spaces() )
-    {
-      // only if the elements are volume elements
-      if (space->support().element_type().dimension() == space->support().element_type().dimensionality())
-      {
-        for (Uint e=0; e<space->size(); ++e)
-        {
-          if (!space->support().is_ghost(e))
-          {
-            // compute norm for these nodes
-            boost_foreach( const Uint node, space->connectivity()[e] )
-            {
-              for (Uint i=0; i<norms.size(); ++i)
-                 loc_norm[i] += std::abs( field[node][i] );
-            }
-          }
-        }
-      }
-    }
-  }
-  else if (field.continuous())
-  {
-    for (Uint n=0; n<field.size(); ++n)
-    {
-      if (!field.is_ghost(n))
-      {
-        for (Uint i=0; i<norms.size(); ++i)
-          loc_norm[i] += std::abs( field[n][i] );
-      }
-    }
-  }
-
-  PE::Comm::instance().all_reduce( PE::plus(), &loc_norm[0], norms.size(), &norms[0] );
-}
-
-////////////////////////////////////////////////////////////////////////////////
-
-void compute_Linf( const Field& field, std::vector<Real>& norms )
+  LpOp(const Uint order) : m_order(order) {}
+  Real operator()(const Real acc, const Real x) const { return acc + std::pow(std::abs(x), (int)m_order); }
+  Uint m_order;
+};
+
+/// Accumulate the local contribution to the norm of each column of the field in loc_norm, in a single pass over the non-ghost rows
+template<typename OpT>
+void accumulate_norm( const Field& field, const OpT& op, Real* loc_norm )
 {
-  std::vector<Real> loc_norm(norms.size(),0.); // norm on local processor
+  const Uint row_size = field.row_size();
 
   if (field.discontinuous())
   {
@@ -139,8 +64,9 @@ void compute_Linf( const Field& field, std::vector<Real>& norms )
             // compute norm for these nodes
             boost_foreach( const Uint node, space->connectivity()[e] )
             {
-              for (Uint i=0; i<norms.size(); ++i)
-                loc_norm[i] = std::max( std::abs(field[node][i]), loc_norm[i] );
+              Field::ConstRow row = field[node];
+              for (Uint i=0; i<row_size; ++i)
+                loc_norm[i] = op(loc_norm[i], row[i]);
             }
           }
         }
@@ -153,65 +79,27 @@ void compute_Linf( const Field& field, std::vector<Real>& norms )
     {
       if (!field.is_ghost(n))
       {
-        for (Uint i=0; i<norms.size(); ++i)
-          loc_norm[i] = std::max( std::abs(field[n][i]), loc_norm[i] );
+        Field::ConstRow row = field[n];
+        for (Uint i=0; i<row_size; ++i)
+          loc_norm[i] = op(loc_norm[i], row[i]);
       }
     }
   }
-
-  PE::Comm::instance().all_reduce( PE::max(), &loc_norm[0], norms.size(), &norms[0] );
 }
 
-////////////////////////////////////////////////////////////////////////////////
-
-void compute_Lp( const Field& field, std::vector<Real>& norms, Uint order )
+template<typename OpT>
+void accumulate_norms( const std::vector< Handle<Field> >& fields, const OpT& op, std::vector<Real>& loc_norms )
 {
-  const int size = 1; // sum 1 value in each processor
-
-  std::vector<Real> loc_norm(norms.size(),0.); // norm on local processor
-  std::vector<Real> glb_norm(norms.size(),0.); // norm summed over all processors
-
-  if (field.discontinuous())
-  {
-    // loop over all elements
-    boost_foreach (const Handle<Space>& space, field.spaces() )
-    {
-      // only if the elements are volume elements
-      if (space->support().element_type().dimension() == space->support().element_type().dimensionality())
-      {
-        for (Uint e=0; e<space->size(); ++e)
-        {
-          if (!space->support().is_ghost(e))
-          {
-            // compute norm for these nodes
-            boost_foreach( const Uint node, space->connectivity()[e] )
-            {
-              for (Uint i=0; i<norms.size(); ++i)
-                loc_norm[i] += std::pow( std::abs(field[node][i]), (int)order ) ;
-            }
-          }
-        }
-      }
-    }
-  }
-  else if (field.continuous())
+  Uint offset = 0;
+  boost_foreach(const Handle<Field>& field, fields)
   {
-    for (Uint n=0; n<field.size(); ++n)
-    {
-      if (!field.is_ghost(n))
-      {
-        for (Uint i=0; i<norms.size(); ++i)
-          loc_norm[i] += std::pow( std::abs(field[n][i]), (int)order ) ;
-      }
-    }
+    accumulate_norm(*field, op, &loc_norms[offset]);
+    offset += field->row_size();
   }
-
-  PE::Comm::instance().all_reduce( PE::plus(), &loc_norm[0], norms.size(), &glb_norm[0] );
-
-  for (Uint i=0; i<norms.size(); ++i)
-    norms[i] = std::pow(glb_norm[i], 1./order );
 }
 
+} // detail
+
 ////////////////////////////////////////////////////////////////////////////////////////////
 
 common::ComponentBuilder < ComputeLNorm, Action, LibSolver > ComputeLNorm_Builder;
@@ -236,6 +124,13 @@ ComputeLNorm::ComputeLNorm ( const std::string& name ) : Action(name)
       .pretty_name("Field")
       .description("Field to compute norm of");
 
+  std::vector<URI> dummy;
+  options().add("fields", dummy)
+      .pretty_name("Fields")
+      .description("Additional fields to compute the norm of, together with 'field' and using a single reduction")
+      .attach_trigger ( boost::bind ( &ComputeLNorm::config_fields, this ) )
+      .mark_basic();
+
   options().add("history", m_history).link_to(&m_history);
  }
 
@@ -266,67 +161,160 @@ Uint ComputeLNorm::compute_nb_rows(const Field& field) const
 
 std::vector<Real> ComputeLNorm::compute_norm(Field& field) const
 {
+  std::vector< Handle<Field> > fields(1, field.handle<Field>());
+  std::vector< std::vector<Real> > norms;
+  compute_norms(fields, norms);
+  return norms.front();
+}
 
-  const Uint loc_nb_rows = compute_nb_rows(field); // table size on local processor
-  Uint nb_rows = 0;                                // table size over all processors
-
-  PE::Comm::instance().all_reduce( PE::plus(), &loc_nb_rows, 1u, &nb_rows );
+////////////////////////////////////////////////////////////////////////////////
 
-  if ( !nb_rows ) throw SetupError(FromHere(), "Table is empty");
+void ComputeLNorm::compute_norms(const std::vector< Handle<Field> >& fields, std::vector< std::vector<Real> >& norms) const
+{
+  const Uint nb_fields = fields.size();
+  const Uint order = options().value<Uint>("order");
 
-  std::vector<Real> norm(field.row_size(), 0.);
+  // Packed layout: the columns of all fields, followed by the number of rows of each field
+  Uint nb_columns = 0;
+  boost_foreach(const Handle<Field>& field, fields)
+    nb_columns += field->row_size();
 
-  const Uint order = options().value<Uint>("order");
+  std::vector<Real> loc_norms(nb_columns + nb_fields, 0.);
+  std::vector<Real> glb_norms(nb_columns + nb_fields, 0.);
 
-  // sum of all processors
+  for (Uint f=0; f<nb_fields; ++f)
+    loc_norms[nb_columns+f] = static_cast<Real>(compute_nb_rows(*fields[f]));
 
   switch(order) {
 
-    case 2:  compute_L2( field, norm );    break;
+    case 2:  detail::accumulate_norms( fields, detail::L2Op(), loc_norms );    break;
 
-    case 1:  compute_L1( field, norm );    break;
+    case 1:  detail::accumulate_norms( fields, detail::L1Op(), loc_norms );    break;
 
-    case 0:  compute_Linf( field, norm );  break; // consider order 0 as Linf
+    case 0:  detail::accumulate_norms( fields, detail::LinfOp(), loc_norms );  break; // consider order 0 as Linf
 
-    default: compute_Lp( field, norm, order );  break;
+    default: detail::accumulate_norms( fields, detail::LpOp(order), loc_norms );  break;
 
   }
 
-  if( options().value<bool>("scale") && order )
+  // Single reduction for all fields. For Linf the row counts are only checked for zero, so the maximum is good enough.
+  if (order)
+    PE::Comm::instance().all_reduce( PE::plus(), &loc_norms[0], loc_norms.size(), &glb_norms[0] );
+  else
+    PE::Comm::instance().all_reduce( PE::max(), &loc_norms[0], loc_norms.size(), &glb_norms[0] );
+
+  const bool scale = options().value<bool>("scale");
+
+  norms.resize(nb_fields);
+  Uint offset = 0;
+  for (Uint f=0; f<nb_fields; ++f)
+  {
+    const Uint nb_rows = static_cast<Uint>(glb_norms[nb_columns+f]);
+    if ( !nb_rows ) throw SetupError(FromHere(), "Table is empty");
+
+    const Uint row_size = fields[f]->row_size();
+    std::vector<Real>& norm = norms[f];
+    norm.assign(glb_norms.begin()+offset, glb_norms.begin()+offset+row_size);
+    offset += row_size;
+
+    if (order == 2)
+    {
+      for (Uint i=0; i<row_size; ++i)
+        norm[i] = std::sqrt(norm[i]);
+    }
+    else if (order > 2)
+    {
+      for (Uint i=0; i<row_size; ++i)
+        norm[i] = std::pow(norm[i], 1./order);
+    }
+
+    if( scale && order )
+    {
+      for (Uint i=0; i<row_size; ++i)
+        norm[i] /= nb_rows;
+    }
+
+    fields[f]->properties()["norm"] = norm;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ComputeLNorm::config_fields()
+{
+  m_fields.clear();
+  boost_foreach(const URI& field_path, options().value< std::vector<URI> >("fields"))
   {
-    for (Uint i=0; i<norm.size(); ++i)
-      norm[i] /= nb_rows;
+    Handle<Field> field(access_component(field_path));
+    if (is_null(field))
+      throw ValueNotFound ( FromHere(), "Could not find field with path [" + field_path.path() +"]" );
+    m_fields.push_back(field);
   }
+}
 
-  field.properties()["norm"] = norm;
+////////////////////////////////////////////////////////////////////////////////
 
-  return norm;
+std::vector< Handle<Field> > ComputeLNorm::monitored_fields()
+{
+  std::vector< Handle<Field> > fields;
+  if (is_not_null(m_field))
+    fields.push_back(m_field);
+  boost_foreach(const Handle<Field>& field, m_fields)
+  {
+    if (is_null(field))
+      throw SetupError( FromHere(), "Field from option 'fields' was removed in "+uri().string());
+    fields.push_back(field);
+  }
+  return fields;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 void ComputeLNorm::execute()
 {
-  if (is_null(m_field)) throw SetupError( FromHere(), "Option 'field' not configured in "+uri().string());
-  std::vector<Real> norm = compute_norm(*m_field);
-  properties()["norm"] = norm;
+  const std::vector< Handle<Field> > fields = monitored_fields();
+  if (fields.empty()) throw SetupError( FromHere(), "Option 'field' not configured in "+uri().string());
+
+  std::vector< std::vector<Real> > norms;
+  compute_norms(fields, norms);
+  properties()["norm"] = norms.front();
+
   if (m_history)
   {
-    for (Uint v=0; v<m_field->nb_vars(); ++v)
+    // The variable names only change with the fields, so they are built once instead of at every iteration
+    if (fields != m_history_fields)
     {
-      for (Uint j=0; j<m_field->var_length(v); ++j)
+      m_history_fields = fields;
+      m_history_names.clear();
+      boost_foreach(const Handle<Field>& field, fields)
       {
-        if (m_field->var_length(v) > 1)
+        for (Uint v=0; v<field->nb_vars(); ++v)
         {
-          m_history->set("L2("+m_field->descriptor().user_variable_name(v)+"["+to_str(j)+"])",norm[m_field->var_offset(v)+j]);
-        }
-        else
-        {
-          m_history->set("L2("+m_field->descriptor().user_variable_name(v)+")",norm[m_field->var_offset(v)+j]);
+          const std::string var_name = field->descriptor().user_variable_name(v);
+          const Uint var_length = field->var_length(v);
+          for (Uint j=0; j<var_length; ++j)
+          {
+            if (var_length > 1)
+              m_history_names.push_back("L2("+var_name+"["+to_str(j)+"])");
+            else
+              m_history_names.push_back("L2("+var_name+")");
+          }
         }
       }
     }
-//    m_history->set("L2("+m_field->name()+")",norm);
+
+    m_history_values.clear();
+    for (Uint f=0; f<fields.size(); ++f)
+    {
+      const Field& field = *fields[f];
+      for (Uint v=0; v<field.nb_vars(); ++v)
+      {
+        for (Uint j=0; j<field.var_length(v); ++j)
+          m_history_values.push_back(norms[f][field.var_offset(v)+j]);
+      }
+    }
+
+    m_history->set(m_history_names, m_history_values);
   }
 }
 
@@ -40,13 +40,35 @@ public: // functions
 
   std::vector<Real> compute_norm( mesh::Field& field) const;
 
+  /// Compute the norms of all columns of several fields in a single pass over each field,
+  /// followed by a single collective operation for all of them. norms[i] contains the norms for fields[i].
+  void compute_norms( const std::vector< Handle<mesh::Field> >& fields, std::vector< std::vector<Real> >& norms ) const;
+
 private:
 
   Uint compute_nb_rows(const mesh::Field& field) const;
 
+  /// Look up the fields given in the fields option
+  void config_fields();
+
+  /// All fields that are monitored: the field option followed by the fields option
+  std::vector< Handle<mesh::Field> > monitored_fields();
+
   Handle<mesh::Field> m_field;
 
+  /// Additional fields, set through the fields option
+  std::vector< Handle<mesh::Field> > m_fields;
+
   Handle<solver::History> m_history;
+
+  /// Fields for which m_history_names was built
+  std::vector< Handle<mesh::Field> > m_history_fields;
+
+  /// History variable names for each column of the monitored fields
+  std::vector<std::string> m_history_names;
+
+  /// Norms of all monitored fields, in the order of m_history_names
+  std::vector<Real> m_history_values;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -6,6 +6,7 @@
 
 #include "common/Builder.hpp"
 #include "common/FindComponents.hpp"
+#include "common/Instrumentation.hpp"
 #include "common/OptionList.hpp"
 
 #include "mesh/Cells.hpp"
@@ -106,7 +107,6 @@ void ComputeRHS::compute_rhs(const Uint elem_idx, std::vector<RealVector>& rhs,
 
 void ComputeRHS::compute_rhs(mesh::Field& rhs, mesh::Field& wave_speed)
 {
-  const Uint nb_eqs = rhs.row_size();
   mesh::Dictionary& dict = rhs.dict();
   boost_foreach(const Handle<mesh::Entities>& cells, dict.entities_range() )
   {
@@ -114,30 +114,53 @@ void ComputeRHS::compute_rhs(mesh::Field& rhs, mesh::Field& wave_speed)
     {
       const Space& space = dict.space(*cells);
 
-      // Element-loop
+      // Element-loop over contiguous ranges of non-ghost elements
       const Uint nb_elems = cells->size();
-      const Uint nb_sol_pts = space.shape_function().nb_nodes();
+      Uint begin = 0;
+      while (begin<nb_elems)
+      {
+        while (begin<nb_elems && cells->is_ghost(begin))
+          ++begin;
+        Uint end = begin;
+        while (end<nb_elems && cells->is_ghost(end)==false)
+          ++end;
+        if (end>begin)
+          compute_rhs(space,begin,end,rhs,wave_speed);
+        begin = end;
+      }
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ComputeRHS::compute_rhs(const mesh::Space& space, const Uint begin, const Uint end,
+                             mesh::Field& rhs, mesh::Field& wave_speed)
+{
+  const Uint nb_eqs = rhs.row_size();
+  const Uint nb_sol_pts = space.shape_function().nb_nodes();
+  const mesh::Connectivity& connectivity = space.connectivity();
 
-      std::vector<RealVector> elem_rhs(nb_sol_pts,RealVector(nb_eqs));
-      std::vector<Real> elem_wave_speed(nb_sol_pts);
+  common::Instrumentation::instance().add_counter("elements_looped", end-begin);
 
-      for (Uint elem_idx=0; elem_idx<nb_elems; ++elem_idx)
+  for (Uint elem_idx=begin; elem_idx<end; ++elem_idx)
+  {
+    mesh::Connectivity::ConstRow nodes = connectivity[elem_idx];
+    for (Uint sol_pt=0; sol_pt<nb_sol_pts; ++sol_pt)
+    {
+      for (Uint eq=0; eq<nb_eqs; ++eq)
       {
-        if (cells->is_ghost(elem_idx)==false)
-        {
-          compute_rhs(elem_idx,elem_rhs,elem_wave_speed);
-
-          mesh::Connectivity::ConstRow nodes = space.connectivity()[elem_idx];
-          for (Uint sol_pt=0; sol_pt<nb_sol_pts; ++sol_pt)
-          {
-            for (Uint eq=0; eq<nb_eqs; ++eq)
-            {
-              rhs[nodes[sol_pt]][eq] = elem_rhs[sol_pt][eq];
-            }
-            wave_speed[nodes[sol_pt]][0] = elem_wave_speed[sol_pt];
-          }
-        }
+        rhs[nodes[sol_pt]][eq] = 0.;
       }
+      wave_speed[nodes[sol_pt]][0] = 0.;
+    }
+  }
+
+  for (Uint t=0; t<m_term_computers.size(); ++t)
+  {
+    if (m_loop_cells[t])
+    {
+      m_term_computers[t]->compute_term(space,begin,end,rhs,wave_speed);
     }
   }
 }
@@ -19,6 +19,7 @@ namespace cf3 {
     class Entities;
     class Field;
     class Dictionary;
+    class Space;
   }
   namespace solver {
     class TermComputer;
@@ -61,6 +62,15 @@ public:
   /// @brief Compute the complete rhs in a field, as well as wave speeds
   virtual void compute_rhs(mesh::Field& rhs, mesh::Field& wave_speed);
 
+  /// @brief Compute the complete rhs and wave speeds for the element range [begin,end[ of a space,
+  /// directly in given fields
+  ///
+  /// Rows of the elements are reset, after which every term computer adds its contribution
+  /// through its element-range interface, i.e. with one virtual call per term and range.
+  /// loop_cells() must have been called for the cells supporting @p space.
+  virtual void compute_rhs(const mesh::Space& space, const Uint begin, const Uint end,
+                           mesh::Field& rhs, mesh::Field& wave_speed);
+
 private:
 
   Handle< mesh::Field > m_rhs;  ///! Right hand side field
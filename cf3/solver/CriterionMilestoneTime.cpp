@@ -4,6 +4,8 @@
 // GNU Lesser General Public License version 3 (LGPLv3).
 // See doc/lgpl.txt and doc/gpl.txt for the license text.
 
+#include <cmath>
+
 #include "common/Builder.hpp"
 #include "common/OptionComponent.hpp"
 #include "common/OptionList.hpp"
@@ -38,6 +40,10 @@ CriterionMilestoneTime::CriterionMilestoneTime( const std::string& name  ) :
       .mark_basic()
       .link_to(&m_time)
       .add_tag("time");
+
+  options().add("interval", 0.)
+      .description("Time between milestones. If 0, the time step of the time component is used")
+      .pretty_name("Interval");
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -48,9 +54,17 @@ CriterionMilestoneTime::~CriterionMilestoneTime()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+Real CriterionMilestoneTime::interval() const
+{
+  const Real interval = options().value<Real>("interval");
+  return interval > 0. ? interval : m_time->options().value<Real>("time_step");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 bool CriterionMilestoneTime::operator()()
 {
-  const Real dt = m_time->options().value<Real>("time_step");
+  const Real dt = interval();
   if ( dt == 0. )
     return true;
 
@@ -61,5 +75,16 @@ bool CriterionMilestoneTime::operator()()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+Real CriterionMilestoneTime::next_milestone(const Real time) const
+{
+  const Real dt = interval();
+  if ( dt == 0. )
+    return time;
+  // Times within tolerance of a milestone count as having reached it
+  return ( std::floor(time/dt + m_tolerance) + 1. ) * dt;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 } // solver
 } // cf3
@@ -35,8 +35,16 @@ public: // functions
   /// Simulates this model
   virtual bool operator()();
 
+  /// @brief First milestone strictly after a given time
+  ///
+  /// Used by TimeStepping to bound variable time steps so that milestones are reached exactly
+  Real next_milestone(const Real time) const;
+
 private:
 
+  /// @brief Time between milestones: option "interval", or the time step of the time component if 0
+  Real interval() const;
+
   Handle<Time> m_time;
 
   Real m_tolerance;
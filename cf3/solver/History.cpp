@@ -6,7 +6,12 @@
 
 #include <iomanip>
 
+#include <boost/cstdint.hpp>
+
 #include "common/BoostFilesystem.hpp"
+#include "common/BasicExceptions.hpp"
+#include "common/Foreach.hpp"
+#include "common/Log.hpp"
 #include "common/PropertyList.hpp"
 #include "common/OptionList.hpp"
 #include "common/OptionT.hpp"
@@ -26,7 +31,11 @@ common::ComponentBuilder < History , Component, LibSolver > History_Builder;
 ////////////////////////////////////////////////////////////////////////////////
 
 History::History ( const std::string& name ) :
-  Component(name)
+  Component(name),
+  m_nb_rows_on_file(0),
+  m_nb_pending_entries(0),
+  m_file_needs_header(false),
+  m_file_format("tsv")
 {
   m_table_needs_resize = false;
   m_table = create_static_component< Table<Real> >("table");
@@ -44,19 +53,57 @@ History::History ( const std::string& name ) :
   // Extension TSV for "Tab Separated Values"
   options().add("file",URI("history.tsv"))
       .description("Log file for history")
+      .attach_trigger( boost::bind( &History::trigger_file, this ) )
       .mark_basic();
 
+  std::vector<boost::any> formats;
+  formats.push_back(std::string("tsv"));
+  formats.push_back(std::string("binary"));
+  options().add("format",std::string("tsv"))
+      .description("Format of the log file: tsv (Tab Separated Values) or binary")
+      .attach_trigger( boost::bind( &History::trigger_file, this ) )
+      .restricted_list() = formats;
+
+  options().add("flush_entries",1u)
+      .description("Write buffered entries to the log file every flush_entries entries");
+
+  options().add("flush_interval",0.)
+      .description("Write buffered entries to the log file if this many seconds passed since the last write (0 = disabled)");
+
   regist_signal ( "write" )
       .description( "Write history" )
       .pretty_name("Write" )
       .connect   ( boost::bind ( &History::signal_write,    this, _1 ) )
       .signature ( boost::bind ( &History::signature_write, this, _1 ) );
+
+  regist_signal ( "flush_file" )
+      .description( "Write buffered history entries to the log file" )
+      .pretty_name("Flush File" )
+      .connect   ( boost::bind ( &History::signal_flush_file, this, _1 ) );
+
+  regist_signal ( "convert_to_tsv" )
+      .description( "Convert a binary history file to Tab Separated Values" )
+      .pretty_name("Convert to TSV" )
+      .connect   ( boost::bind ( &History::signal_convert_to_tsv,    this, _1 ) )
+      .signature ( boost::bind ( &History::signature_convert_to_tsv, this, _1 ) );
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 History::~History()
 {
+  // m_nb_pending_entries is only non-zero on the writing rank
+  if (m_nb_pending_entries)
+  {
+    try
+    {
+      write_pending_entries();
+    }
+    catch (std::exception& e)
+    {
+      CFerror << "History " << uri().string() << " could not be written: " << e.what() << CFendl;
+    }
+  }
   if (m_file)
   {
     m_file.close();
@@ -95,6 +142,17 @@ void History::set(const std::string& var_name, const std::vector<Real>& var_valu
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void History::set(const std::vector<std::string>& var_names, const std::vector<Real>& var_values)
+{
+  cf3_assert(var_names.size() == var_values.size());
+  for (Uint i=0; i<var_names.size(); ++i)
+  {
+    set(var_names[i],var_values[i]);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 bool History::resize_if_necessary()
 {
   if (m_table_needs_resize)
@@ -130,19 +188,15 @@ void History::save_entry()
     if (PE::Comm::instance().rank() == 0)
     {
       if (resized)
-        m_file.close();
+        m_file_needs_header = true;
 
-      if (!m_file)
-      {
-        flush();
-        open_file(m_file,options().value<URI>("file"));
-        write_file(m_file);
-        m_file.flush();
-      }
-      else
+      ++m_nb_pending_entries;
+
+      const Real flush_interval = options().value<Real>("flush_interval");
+      if ( m_nb_pending_entries >= options().value<Uint>("flush_entries")
+        || ( flush_interval > 0. && m_flush_timer.elapsed() >= flush_interval ) )
       {
-        m_file << this_entry << "\n";
-        m_file.flush();
+        write_pending_entries();
       }
     }
   }
@@ -150,6 +204,114 @@ void History::save_entry()
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void History::flush_file()
+{
+  if (m_logging && PE::Comm::instance().rank() == 0)
+    write_pending_entries();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void History::write_pending_entries()
+{
+  flush();
+  if (!m_file)
+    m_file_format = options().value<std::string>("format");
+  if (m_file_format == "binary")
+    write_pending_binary();
+  else
+    write_pending_tsv();
+  m_file.flush();
+
+  m_nb_rows_on_file = m_table->size();
+  m_nb_pending_entries = 0;
+  m_file_needs_header = false;
+  m_flush_timer.restart();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void History::write_pending_tsv()
+{
+  if (m_file_needs_header)
+    m_file.close();
+
+  if (!m_file)
+  {
+    open_file(m_file,options().value<URI>("file"));
+    write_file(m_file);
+    return;
+  }
+
+  const Uint row_size = m_table->row_size();
+  for (Uint row=m_nb_rows_on_file; row<m_table->size(); ++row)
+  {
+    for (Uint i=0; i<row_size; ++i)
+      m_file << "\t" <<std::scientific << std::setw(16) << (*m_table)[row][i];
+    m_file << "\n";
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void History::write_pending_binary()
+{
+  if (!m_file)
+  {
+    open_file(m_file,options().value<URI>("file"),std::ios_base::out | std::ios_base::binary);
+    m_file.write("cf3hist1",8);
+    m_nb_rows_on_file = 0;
+    m_file_needs_header = true;
+  }
+
+  if (m_file_needs_header)
+  {
+    const std::vector<std::string> names = column_names();
+    const boost::uint32_t nb_columns = names.size();
+    m_file.put('H');
+    m_file.write(reinterpret_cast<const char*>(&nb_columns),sizeof(boost::uint32_t));
+    boost_foreach(const std::string& name, names)
+    {
+      const boost::uint32_t name_length = name.size();
+      m_file.write(reinterpret_cast<const char*>(&name_length),sizeof(boost::uint32_t));
+      m_file.write(name.data(),name_length);
+    }
+  }
+
+  const boost::uint32_t nb_rows = m_table->size() - m_nb_rows_on_file;
+  if (nb_rows == 0)
+    return;
+
+  const Uint row_size = m_table->row_size();
+  m_file.put('R');
+  m_file.write(reinterpret_cast<const char*>(&nb_rows),sizeof(boost::uint32_t));
+  for (Uint row=m_nb_rows_on_file; row<m_table->size(); ++row)
+  {
+    for (Uint i=0; i<row_size; ++i)
+    {
+      const double value = (*m_table)[row][i];
+      m_file.write(reinterpret_cast<const char*>(&value),sizeof(double));
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void History::trigger_file()
+{
+  if (m_file)
+  {
+    if (m_nb_pending_entries)
+      write_pending_entries();
+    m_file.close();
+  }
+  // Only now the old file is complete, switch to the format for the next file
+  m_file_format = options().value<std::string>("format");
+  m_nb_rows_on_file = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 void History::flush()
 {
   if(is_not_null(m_buffer))
@@ -197,12 +359,117 @@ void History::signal_write(common::SignalArgs& args)
   }
 }
 
+void History::signal_flush_file(common::SignalArgs& args)
+{
+  flush_file();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void History::signature_convert_to_tsv(common::SignalArgs& args)
+{
+  SignalOptions opts(args);
+  opts.add("binary_file",URI("history.bin"))
+      .description("Binary history file to convert");
+  opts.add("file",URI("history.tsv"))
+      .description("Tab Separated Value output file");
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
-void History::open_file(boost::filesystem::fstream& file, const common::URI& file_uri)
+void History::signal_convert_to_tsv(common::SignalArgs& args)
+{
+  if (PE::Comm::instance().rank()==0)
+  {
+    SignalOptions opts(args);
+    convert_to_tsv(opts.option("binary_file").value<URI>(),opts.option("file").value<URI>());
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void History::convert_to_tsv(const URI& binary_file, const URI& tsv_file)
+{
+  boost::filesystem::path path (binary_file.path());
+  boost::filesystem::fstream in;
+  in.open(path,std::ios_base::in | std::ios_base::binary);
+  if (!in) // didn't open so throw exception
+  {
+    throw boost::filesystem::filesystem_error( path.string() + " failed to open",
+                                               boost::system::error_code() );
+  }
+
+  char magic[8];
+  in.read(magic,8);
+  if (!in || std::string(magic,8) != "cf3hist1")
+    throw common::FileFormatError(FromHere(), path.string()+" is not a binary history file");
+
+  // Columns are only ever appended, so the last header contains all columns
+  std::vector<std::string> names;
+  std::vector< std::vector<Real> > rows;
+  boost::uint32_t nb_columns = 0;
+  char segment;
+  while (in.get(segment))
+  {
+    if (segment == 'H')
+    {
+      in.read(reinterpret_cast<char*>(&nb_columns),sizeof(boost::uint32_t));
+      names.resize(nb_columns);
+      for (Uint c=0; c<nb_columns; ++c)
+      {
+        boost::uint32_t name_length;
+        in.read(reinterpret_cast<char*>(&name_length),sizeof(boost::uint32_t));
+        names[c].resize(name_length);
+        if (name_length)
+          in.read(&names[c][0],name_length);
+      }
+    }
+    else if (segment == 'R')
+    {
+      boost::uint32_t nb_rows;
+      in.read(reinterpret_cast<char*>(&nb_rows),sizeof(boost::uint32_t));
+      for (Uint r=0; r<nb_rows; ++r)
+      {
+        rows.push_back(std::vector<Real>(nb_columns));
+        for (Uint c=0; c<nb_columns; ++c)
+        {
+          double value;
+          in.read(reinterpret_cast<char*>(&value),sizeof(double));
+          rows.back()[c] = value;
+        }
+      }
+    }
+    else
+    {
+      throw common::FileFormatError(FromHere(), path.string()+" contains an unknown segment");
+    }
+    if (!in)
+      throw common::FileFormatError(FromHere(), path.string()+" is truncated");
+  }
+  in.close();
+
+  boost::filesystem::fstream out;
+  open_file(out,tsv_file);
+  out << "#";
+  boost_foreach(const std::string& name, names)
+    out << "\t" << std::setw(16) << name;
+  out << "\n";
+  boost_foreach(const std::vector<Real>& row, rows)
+  {
+    for (Uint c=0; c<names.size(); ++c)
+      out << "\t" <<std::scientific << std::setw(16) << (c<row.size() ? row[c] : 0.);
+    out << "\n";
+  }
+  out.close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void History::open_file(boost::filesystem::fstream& file, const common::URI& file_uri,
+                        const std::ios_base::openmode mode)
 {
   boost::filesystem::path path (file_uri.path());
-  file.open(path,std::ios_base::out);
+  file.open(path,mode);
   if (!file) // didn't open so throw exception
   {
     throw boost::filesystem::filesystem_error( path.string() + " failed to open",
@@ -213,24 +480,36 @@ void History::open_file(boost::filesystem::fstream& file, const common::URI& fil
 
 ////////////////////////////////////////////////////////////////////////////////
 
-std::string History::file_header() const
+std::vector<std::string> History::column_names() const
 {
-  std::stringstream ss;
-
-  ss << "#";
+  std::vector<std::string> names;
+  names.reserve(m_variables->size());
   for (Uint var_idx=0; var_idx<m_variables->nb_vars(); ++var_idx)
   {
     const Uint var_length = m_variables->var_length(var_idx);
     if (var_length == 1)
     {
-      ss << "\t" << std::setw(16) << m_variables->user_variable_name(var_idx);
+      names.push_back(m_variables->user_variable_name(var_idx));
     }
     else
     {
       for (Uint i=0; i<var_length; ++i)
-        ss << "\t" << std::setw(16) << m_variables->user_variable_name(var_idx)<<"["<<i<<"]";
+        names.push_back(m_variables->user_variable_name(var_idx)+"["+to_str(i)+"]");
     }
+  }
+  return names;
+}
 
+////////////////////////////////////////////////////////////////////////////////
+
+std::string History::file_header() const
+{
+  std::stringstream ss;
+
+  ss << "#";
+  boost_foreach(const std::string& name, column_names())
+  {
+    ss << "\t" << std::setw(16) << name;
   }
   ss << "\n";
   return ss.str();
@@ -10,6 +10,7 @@
 #include "common/BoostFilesystem.hpp"
 
 #include "common/Table.hpp"
+#include "common/Timer.hpp"
 
 #include "math/VariablesDescriptor.hpp"
 
@@ -32,12 +33,23 @@ class HistoryEntry;
 ///
 /// History is stored internally using a common::Table<Real> .
 /// An optional (default=ON) logging facility is provided to log the history to
-/// file at every new entry.
-/// The file format is Tab Separated Values (extension tsv)
+/// file. Entries are buffered in memory, and written to file every
+/// "flush_entries" entries, when "flush_interval" seconds have passed since
+/// the last write, when the signal "flush_file" is received, or on destruction.
 ///
-/// Any number of variables can be added after logging started. This will cause
-/// The history file to be rewritten, including the new variables, putting zero's
-/// for the non-existent past entries.
+/// Two file formats are available through the option "format":
+/// - "tsv": Tab Separated Values (extension tsv).
+///   Any number of variables can be added after logging started. This will cause
+///   The history file to be rewritten, including the new variables, putting zero's
+///   for the non-existent past entries.
+/// - "binary": a stream of segments, appended to the file without ever rewriting it.
+///   The file starts with the 8 characters "cf3hist1", followed by segments:
+///   - header segment: char 'H', uint32 nb_columns, and for every column
+///     uint32 name_length followed by the name characters
+///   - rows segment: char 'R', uint32 nb_rows, followed by nb_rows x nb_columns
+///     doubles in native byte order, with nb_columns of the last header segment.
+///   Adding variables appends a new header segment.
+///   convert_to_tsv() (or the signal "convert_to_tsv") converts it to the tsv layout.
 ///
 /// Example:\n
 /// @code
@@ -83,6 +95,11 @@ public:
   /// This function can be called multiple times per entry.
   void set(const std::string& var_name, const std::vector<Real>& var_values);
 
+  /// @brief Set in the current entry each of the given variables to the value with the same index
+  ///
+  /// Equivalent to calling set() for each variable, useful when the names can be reused between entries.
+  void set(const std::vector<std::string>& var_names, const std::vector<Real>& var_values);
+
   /// @brief Finalize an entry in history, save it, and write it optionally (default=ON) to file
   ///
   /// - The entry is assembled from the properties that are set using the function set().
@@ -101,8 +118,27 @@ public:
 
   /// @brief Write the history to file, signature
   void signature_write(common::SignalArgs& args);
+
+  /// @brief Write all buffered entries to the log file, signal
+  void signal_flush_file(common::SignalArgs& args);
+
+  /// @brief Convert a binary history file to tab separated values, signal
+  void signal_convert_to_tsv(common::SignalArgs& args);
+
+  /// @brief Convert a binary history file to tab separated values, signature
+  void signature_convert_to_tsv(common::SignalArgs& args);
   //@}
 
+  /// @brief Write all buffered entries to the log file
+  /// @note Only rank 0 writes, and only if logging is enabled
+  void flush_file();
+
+  /// @brief Convert a file written with format "binary" to the "tsv" layout
+  ///
+  /// Columns that did not exist yet for past entries are filled with zero's,
+  /// as would be the case when logging in the "tsv" format.
+  static void convert_to_tsv(const common::URI& binary_file, const common::URI& tsv_file);
+
   /// @brief Write the history to file
   void write_file(boost::filesystem::fstream& file);
 
@@ -123,7 +159,23 @@ public:
 private: // functions
 
   /// @brief open a file with given URI
-  static void open_file(boost::filesystem::fstream& file, const common::URI& file_uri);
+  static void open_file(boost::filesystem::fstream& file, const common::URI& file_uri,
+                        const std::ios_base::openmode mode = std::ios_base::out);
+
+  /// @brief write the buffered entries to the log file, opening it if needed
+  void write_pending_entries();
+
+  /// @brief write the buffered entries in tsv format
+  void write_pending_tsv();
+
+  /// @brief write the buffered entries in binary format
+  void write_pending_binary();
+
+  /// @brief close the log file, so that it is recreated at the next write
+  void trigger_file();
+
+  /// @brief names of every column in the table, vector components expanded as "var[i]"
+  std::vector<std::string> column_names() const;
 
   /// @brief resize table and rebuild buffer if needed
   bool resize_if_necessary();
@@ -139,6 +191,22 @@ private: // data
   /// Log file handle
   boost::filesystem::fstream m_file;
 
+  /// Number of table rows already written to the log file
+  Uint m_nb_rows_on_file;
+
+  /// Number of entries saved since the last write to the log file
+  Uint m_nb_pending_entries;
+
+  /// Flag to check if the columns changed since the last write to the log file
+  bool m_file_needs_header;
+
+  /// Format of the open log file, which may differ from the "format" option
+  /// until the file is closed by trigger_file()
+  std::string m_file_format;
+
+  /// Timer measuring the time since the last write to the log file
+  common::Timer m_flush_timer;
+
   /// Handle to the table
   Handle< common::Table<Real> > m_table;
 
@@ -70,7 +70,8 @@ void PlotXY::convergence_history( SignalArgs & args )
     std::vector<std::string> labels =
         list_of<std::string>("x")("y")("z")("u")("v")("w")("p")("t");
 
-    add_multi_array_in(options.main_map, "Table", m_data->array(), ";", labels);
+    // the table may be large: its values are sent as a binary payload
+    add_multi_array_in(options.main_map, "Table", m_data->array(), ";", labels, true);
 
 //    for(Uint row = 0 ; row < 1000 ; ++row)
 //    {
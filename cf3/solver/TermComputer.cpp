@@ -10,6 +10,7 @@
 #include "mesh/Field.hpp"
 #include "mesh/Space.hpp"
 #include "mesh/Connectivity.hpp"
+#include "mesh/ShapeFunction.hpp"
 #include "solver/TermComputer.hpp"
 
 /////////////////////////////////////////////////////////////////////////////////////
@@ -45,26 +46,36 @@ void TermComputer::execute()
 void TermComputer::compute_term(mesh::Field& term, mesh::Field& wave_speed)
 {
   term = 0.;
+  wave_speed = 0.;
   boost_foreach( const Handle<mesh::Entities const>& cells, term.entities_range() )
   {
     if (loop_cells(cells))
     {
       const mesh::Space& space = term.space(*cells);
-      const Uint nb_elems = space.size();
-      const Uint nb_nodes_per_elem = space.shape_function().nb_nodes();
-      for (Uint e=0; e<nb_elems; ++e)
+      compute_term(space,0,space.size(),term,wave_speed);
+    }
+  }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+void TermComputer::compute_term(const mesh::Space& space, const Uint begin, const Uint end,
+                                mesh::Field& term, mesh::Field& wave_speed)
+{
+  const Uint nb_nodes_per_elem = space.shape_function().nb_nodes();
+  const mesh::Connectivity& connectivity = space.connectivity();
+  for (Uint e=begin; e<end; ++e)
+  {
+    compute_term(e,m_tmp_term,m_tmp_ws);
+    mesh::Connectivity::ConstRow nodes = connectivity[e];
+    for (Uint s=0; s<nb_nodes_per_elem; ++s)
+    {
+      const Uint p=nodes[s];
+      for (Uint eq=0; eq<m_tmp_term[s].size(); ++eq)
       {
-        compute_term(e,m_tmp_term,m_tmp_ws);
-        for (Uint s=0; s<nb_nodes_per_elem; ++s)
-        {
-          const Uint p=space.connectivity()[e][s];
-          for (Uint eq=0; eq<m_tmp_term[s].size(); ++eq)
-          {
-            term[p][eq] += m_tmp_term[s][eq];
-          }
-          wave_speed[p][0] = m_tmp_ws[s]; 
-        }
+        term[p][eq] += m_tmp_term[s][eq];
       }
+      wave_speed[p][0] = std::max(wave_speed[p][0],m_tmp_ws[s]);
     }
   }
 }
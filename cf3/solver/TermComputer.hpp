@@ -18,6 +18,7 @@ namespace cf3
   { 
     class Entities; 
     class Field; 
+    class Space; 
   } 
 }
 
@@ -47,6 +48,10 @@ public:
   virtual void execute();
 
   /// @brief Compute the term in given fields
+  ///
+  /// Both fields are reset to zero first. In a point shared by several elements, the terms
+  /// of the elements are summed, and the wave speed is the maximum of the element wave speeds,
+  /// instead of the wave speed of the last element visited.
   virtual void compute_term(mesh::Field& term, mesh::Field& wave_speed);
 
   /// @brief Initialize the term computer for cells component
@@ -55,6 +60,17 @@ public:
   /// @brief Compute the term for given element in given vectors
   virtual void compute_term(const Uint elem_idx, std::vector<RealVector>& term, std::vector<Real>& wave_speed) = 0;
 
+  /// @brief Compute the term for the element range [begin,end[ of a space, directly in given fields
+  ///
+  /// The term is added to the rows of @p term belonging to the elements,
+  /// and @p wave_speed is set to the maximum of its current value and the term wave speed.
+  /// loop_cells() must have been called for the cells supporting @p space.
+  /// The default implementation calls the per-element compute_term() for every element;
+  /// derived classes can override it, or derive from TermComputerT (solver/TermComputerT.hpp), to avoid
+  /// a virtual call per element.
+  virtual void compute_term(const mesh::Space& space, const Uint begin, const Uint end,
+                            mesh::Field& term, mesh::Field& wave_speed);
+
  private:
 
   Handle<mesh::Field> m_term_field;
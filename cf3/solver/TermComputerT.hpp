@@ -0,0 +1,93 @@
+// Copyright (C) 2010-2013 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef cf3_solver_TermComputerT_hpp
+#define cf3_solver_TermComputerT_hpp
+
+#include <algorithm>
+
+#include "mesh/Field.hpp"
+#include "mesh/Space.hpp"
+#include "mesh/Connectivity.hpp"
+#include "mesh/ShapeFunction.hpp"
+#include "solver/TermComputer.hpp"
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+namespace cf3 {
+namespace solver {
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Static (CRTP) base for term computers whose element kernel is known at compile time
+///
+/// DERIVED must implement the non-virtual function
+/// @code
+/// void compute_element(const Uint elem_idx, std::vector<RealVector>& term, std::vector<Real>& wave_speed);
+/// @endcode
+/// which is inlined in the element-range loop, so that only one virtual call is made
+/// per element range instead of one per element.
+template <typename DERIVED>
+class TermComputerT : public TermComputer
+{
+public:
+
+  /// @brief Constructor
+  TermComputerT ( const std::string& name ) : TermComputer(name) {}
+
+  /// Virtual destructor
+  virtual ~TermComputerT() {}
+
+  /// @brief Compute the term for given element in given vectors
+  virtual void compute_term(const Uint elem_idx, std::vector<RealVector>& term, std::vector<Real>& wave_speed)
+  {
+    derived().compute_element(elem_idx,term,wave_speed);
+  }
+
+  /// @brief Compute the term for the element range [begin,end[ of a space, directly in given fields
+  virtual void compute_term(const mesh::Space& space, const Uint begin, const Uint end,
+                            mesh::Field& term, mesh::Field& wave_speed)
+  {
+    const Uint nb_nodes_per_elem = space.shape_function().nb_nodes();
+    const Uint nb_eqs = term.row_size();
+    const mesh::Connectivity& connectivity = space.connectivity();
+    m_elem_term.resize(nb_nodes_per_elem,RealVector(nb_eqs));
+    m_elem_ws.resize(nb_nodes_per_elem);
+    for (Uint e=begin; e<end; ++e)
+    {
+      derived().compute_element(e,m_elem_term,m_elem_ws);
+      mesh::Connectivity::ConstRow nodes = connectivity[e];
+      for (Uint s=0; s<nb_nodes_per_elem; ++s)
+      {
+        mesh::Field::Row term_row = term[nodes[s]];
+        const RealVector& elem_term = m_elem_term[s];
+        for (Uint eq=0; eq<nb_eqs; ++eq)
+        {
+          term_row[eq] += elem_term[eq];
+        }
+        Real& ws = wave_speed[nodes[s]][0];
+        ws = std::max(ws,m_elem_ws[s]);
+      }
+    }
+  }
+
+  // make the field-level compute_term visible next to the overloads above
+  using TermComputer::compute_term;
+
+private:
+
+  DERIVED& derived() { return static_cast<DERIVED&>(*this); }
+
+  std::vector<RealVector> m_elem_term;
+  std::vector<Real>       m_elem_ws;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // solver
+} // cf3
+
+#endif // cf3_solver_TermComputerT_hpp
@@ -25,6 +25,8 @@
 #include "solver/Time.hpp"
 #include "solver/History.hpp"
 #include "solver/Criterion.hpp"
+#include "solver/CriterionMilestoneTime.hpp"
+#include "solver/AdaptiveTimeStep.hpp"
 
 #include "solver/TimeStepping.hpp"
 #include "solver/Tags.hpp"
@@ -74,6 +76,10 @@ TimeStepping::TimeStepping ( const std::string& name ) :
   options().add("max_steps",math::Consts::uint_max());
   options().add("time_accurate",true).mark_basic();
 
+  options().add("time_step_controller",m_time_step_controller)
+      .description("Optional adaptive time step controller. If not set, the time_step is fixed")
+      .link_to(&m_time_step_controller);
+
   // static components
 
   m_pre_actions  = create_static_component<ActionDirector>("pre_actions");
@@ -202,27 +208,86 @@ void TimeStepping::do_step()
   Uint step = options().value<Uint>("step");
   Real time = options().value<Real>("time");
   Real time_step = options().value<Real>("time_step");
-  time_step = std::min(time_step,options().value<Real>("end_time")-time);
 
-  // Configure end_time of this step
-  boost_foreach( const Handle<Time>& time_comp, m_times)
+  // Bound the time step to reach end_time, and milestones for adaptive time steps, exactly
+  const Real time_bound = next_time_bound(time);
+  bool reaches_bound = (time + time_step >= time_bound);
+  if (reaches_bound)
+    time_step = time_bound - time;
+
+  // Save time components, to restore them for a rejected step
+  std::vector<Real> times_current_time(m_times.size());
+  std::vector<Uint> times_iteration(m_times.size());
+  for (Uint t=0; t<m_times.size(); ++t)
   {
-    if (is_not_null(time_comp)) time_comp->options().set("end_time",time + time_step);
+    if (is_not_null(m_times[t]))
+    {
+      times_current_time[t] = m_times[t]->current_time();
+      times_iteration[t] = m_times[t]->iter();
+    }
   }
-  /// (1) the pre actions - pre-process, user defined actions, etc
-
-  m_pre_actions->execute();
 
-  /// (2) the registered actions that solve one time step
-
-  ActionDirector::execute();
+  Real next_time_step = options().value<Real>("time_step");
+  bool accepted = false;
+  while (!accepted)
+  {
+    if (is_not_null(m_time_step_controller))
+    {
+      m_time_step_controller->begin_step();
+      boost_foreach( const Handle<Time>& time_comp, m_times)
+      {
+        if (is_not_null(time_comp)) time_comp->options().set("time_step",time_step);
+      }
+    }
+
+    // Configure end_time of this step
+    boost_foreach( const Handle<Time>& time_comp, m_times)
+    {
+      if (is_not_null(time_comp)) time_comp->options().set("end_time",time + time_step);
+    }
+
+    /// (1) the pre actions - pre-process, user defined actions, etc
+    m_pre_actions->execute();
+
+    /// (2) the registered actions that solve one time step
+    ActionDirector::execute();
+
+    accepted = true;
+    if (is_not_null(m_time_step_controller))
+    {
+      Real proposed_time_step = time_step;
+      accepted = m_time_step_controller->end_step(proposed_time_step);
+      if (accepted)
+      {
+        next_time_step = proposed_time_step;
+      }
+      else
+      {
+        CFinfo << "Step rejected with error " << m_time_step_controller->error()
+               << ", retrying with time_step " << proposed_time_step << CFendl;
+        for (Uint t=0; t<m_times.size(); ++t)
+        {
+          if (is_not_null(m_times[t]))
+          {
+            m_times[t]->options().set("current_time",times_current_time[t]);
+            m_times[t]->options().set("iteration",times_iteration[t]);
+          }
+        }
+        time_step = proposed_time_step;
+        reaches_bound = (time + time_step >= time_bound);
+        if (reaches_bound)
+          time_step = time_bound - time;
+      }
+    }
+  }
 
   /// (3) advance time & iteration
-
   ++step;
-  time += time_step;
+  time = reaches_bound ? time_bound : time + time_step;
   options().set("time",time);
   options().set("step",step);
+  if (is_not_null(m_time_step_controller))
+    options().set("time_step",next_time_step);
 
   /// (4) the post actions - compute norm, post-process something, etc
 
@@ -275,6 +340,24 @@ void TimeStepping::do_step()
 
 ///////////////////////////////////////////////////////////////////////////////////////
 
+Real TimeStepping::next_time_bound(const Real time)
+{
+  Real bound = options().value<Real>("end_time");
+  // With a fixed time_step, milestones are reached by construction
+  if (is_null(m_time_step_controller))
+    return bound;
+  boost_foreach(const CriterionMilestoneTime& milestone, find_components_recursively<CriterionMilestoneTime>(*this))
+  {
+    // Without an interval, the milestone falls on every step, and would only keep the time step from growing
+    if (milestone.options().value<Real>("interval") == 0.)
+      continue;
+    bound = std::min(bound, milestone.next_milestone(time));
+  }
+  return bound;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////
+
 void TimeStepping::raise_timestep_done()
 {
   SignalOptions opts;
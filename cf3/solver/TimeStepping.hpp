@@ -15,6 +15,7 @@ namespace solver {
 
   class Time;
   class History;
+  class AdaptiveTimeStep;
 
 /////////////////////////////////////////////////////////////////////////////////////
 
@@ -27,7 +28,12 @@ namespace solver {
 /// before and after the time-step execution. \n
 /// A history file by default called "timestepping.tsv" is written every
 /// step, containing timing and memory information per step.
-/// This information is also given in the info stream.
+/// This information is also given in the info stream. \n
+/// If an AdaptiveTimeStep component is configured as "time_step_controller",
+/// the time_step is adapted after every step, and steps whose error is too large
+/// are rejected and recomputed. Time steps are then bounded so that end_time,
+/// and the milestones of all CriterionMilestoneTime components below this one
+/// (also those inside child action directors), are reached exactly.
 class solver_API TimeStepping : public common::ActionDirector {
 
 public: // functions
@@ -83,12 +89,18 @@ private: // functions
   /// raises event when timestep is done
   void raise_timestep_done();
 
+  /// @brief first time after the given time at which a step has to end exactly
+  ///
+  /// Milestones with an interval of 0 fall on every step and do not bound the time step
+  Real next_time_bound(const Real time);
+
 private: // data
 
   std::vector< Handle< solver::Time > > m_times;           ///< component tracking time
   Handle< common::ActionDirector > m_pre_actions;    ///< set of actions before non-linear solve
   Handle< common::ActionDirector > m_post_actions;   ///< set of actions after non-linear solve
   Handle< solver::History >        m_history;        ///< Component tracking history of several variables
+  Handle< solver::AdaptiveTimeStep > m_time_step_controller; ///< Optional adaptive time step controller
 };
 
 /////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,150 @@
+// Copyright (C) 2010-2013 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include "common/Builder.hpp"
+#include "common/FindComponents.hpp"
+#include "common/Foreach.hpp"
+#include "common/Log.hpp"
+#include "common/OptionList.hpp"
+#include "common/OptionT.hpp"
+#include "common/PropertyList.hpp"
+#include "common/PE/Comm.hpp"
+
+#include "mesh/Dictionary.hpp"
+#include "mesh/Mesh.hpp"
+#include "mesh/MeshAdaptor.hpp"
+#include "mesh/MeshTransformer.hpp"
+
+#include "solver/actions/DynamicLoadBalance.hpp"
+
+using namespace cf3::common;
+using namespace cf3::mesh;
+
+namespace cf3 {
+namespace solver {
+namespace actions {
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+common::ComponentBuilder < DynamicLoadBalance, common::Action, LibActions > DynamicLoadBalance_Builder;
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+DynamicLoadBalance::DynamicLoadBalance ( const std::string& name ) : solver::Action(name),
+  m_work_time(0.),
+  m_nb_executions(0),
+  m_imbalance(1.)
+{
+  properties()["brief"] = std::string("Repartition the mesh when the load imbalance is too large");
+  properties()["description"] = std::string(
+    "Times the child actions on every rank, and repartitions the mesh when the ratio\n"
+    "of the maximal over the average time exceeds imbalance_threshold");
+
+  options().add("check_interval", 10u)
+      .pretty_name("Check Interval")
+      .description("Number of executions between two measurements of the imbalance")
+      .mark_basic();
+
+  options().add("imbalance_threshold", 1.2)
+      .pretty_name("Imbalance Threshold")
+      .description("Maximal ratio of the maximal over the average time of the ranks before repartitioning")
+      .mark_basic();
+
+  properties().add("imbalance", m_imbalance);
+  properties().add("nb_repartitions", 0u);
+
+  m_load_balance = Handle<MeshTransformer>(create_component("load_balance", "cf3.mesh.actions.LoadBalance"));
+  Handle<Component> partitioner = m_load_balance->get_child("partitioner");
+  if (is_not_null(partitioner) && partitioner->options().check("lb_approach"))
+    partitioner->options().set("lb_approach", std::string("REPARTITION"));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void DynamicLoadBalance::execute()
+{
+  Timer timer;
+  boost_foreach (common::Action& action, find_components<common::Action>(*this))
+  {
+    if (&action != m_load_balance.get())
+      action.execute();
+  }
+  m_work_time += timer.elapsed();
+  ++m_nb_executions;
+
+  const Uint check_interval = options().value<Uint>("check_interval");
+  if (check_interval != 0 && m_nb_executions >= check_interval)
+    check_imbalance();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void DynamicLoadBalance::check_imbalance()
+{
+  PE::Comm& comm = PE::Comm::instance();
+  Real max_time = m_work_time;
+  Real sum_time = m_work_time;
+  if (comm.is_active())
+  {
+    comm.all_reduce(PE::max(), &m_work_time, 1, &max_time);
+    comm.all_reduce(PE::plus(), &m_work_time, 1, &sum_time);
+  }
+  const Uint nb_ranks = comm.is_active() ? comm.size() : 1u;
+  const Real avg_time = sum_time / static_cast<Real>(nb_ranks);
+
+  m_imbalance = avg_time > 0. ? max_time / avg_time : 1.;
+  properties()["imbalance"] = m_imbalance;
+  m_work_time = 0.;
+  m_nb_executions = 0;
+
+  if (nb_ranks > 1 && m_imbalance > options().value<Real>("imbalance_threshold"))
+  {
+    CFinfo << uri().string() << ": load imbalance " << m_imbalance << ", repartitioning mesh " << mesh().uri().string() << CFendl;
+    repartition();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void DynamicLoadBalance::remove_overlap()
+{
+  Mesh& mesh = this->mesh();
+  MeshAdaptor mesh_adaptor(mesh);
+  mesh_adaptor.prepare();
+  mesh_adaptor.remove_ghost_elements();
+  // Moving no elements flushes the removed elements, removes the nodes that are no longer used,
+  // and fixes the node ranks
+  const std::vector< std::vector< std::vector<Uint> > > no_exports(PE::Comm::instance().size(),
+                                                                     std::vector< std::vector<Uint> >(mesh.elements().size()));
+  mesh_adaptor.move_elements(no_exports);
+  mesh_adaptor.finish();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void DynamicLoadBalance::repartition()
+{
+  Mesh& mesh = this->mesh();
+
+  remove_overlap();
+
+  // Numbering, partitioning, migration of elements, nodes and fields, and growing the overlap again
+  m_load_balance->transform(mesh);
+
+  boost_foreach(const Handle<Dictionary>& dict, mesh.dictionaries())
+    dict->rebuild_comm_pattern();
+
+  // Solvers rebuild their linear systems and other mesh-dependent data
+  mesh.raise_mesh_changed();
+
+  properties()["nb_repartitions"] = properties().value<Uint>("nb_repartitions") + 1u;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // actions
+} // solver
+} // cf3
@@ -0,0 +1,84 @@
+// Copyright (C) 2010-2013 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef cf3_solver_actions_DynamicLoadBalance_hpp
+#define cf3_solver_actions_DynamicLoadBalance_hpp
+
+#include "common/Timer.hpp"
+
+#include "solver/actions/LibActions.hpp"
+#include "solver/Action.hpp"
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+namespace cf3 {
+namespace mesh   { class MeshTransformer; }
+namespace solver {
+namespace actions {
+
+/// @brief Repartition the mesh during the run, when the measured load imbalance is too large
+///
+/// The child actions of this action are executed and timed on every rank. They should
+/// contain the work that depends on the partitioning, such as the assembly or the computation
+/// of the right hand side. Every "check_interval" executions, the imbalance, i.e. the ratio
+/// of the maximal over the average accumulated time of the ranks, is computed.
+/// If it exceeds "imbalance_threshold", the mesh is repartitioned:
+/// - the overlap layer is removed
+/// - the mesh is partitioned again by a mesh::actions::LoadBalance, using the
+///   Zoltan REPARTITION approach if available, to keep the migration low.
+///   The elements, nodes and all fields are migrated with mesh::MeshAdaptor::move_elements().
+/// - the comm patterns of the dictionaries are rebuilt
+/// - the "mesh_changed" event is raised, so the solvers can rebuild their linear systems
+///
+/// The element weights used by the partitioner can be configured on the component
+/// "load_balance/partitioner", e.g. to use measured timings stored in a field.
+class solver_actions_API DynamicLoadBalance : public solver::Action {
+
+public: // functions
+  /// Contructor
+  /// @param name of the component
+  DynamicLoadBalance ( const std::string& name );
+
+  /// Virtual destructor
+  virtual ~DynamicLoadBalance() {}
+
+  /// Get the class name
+  static std::string type_name () { return "DynamicLoadBalance"; }
+
+  /// execute the child actions, and repartition if needed
+  virtual void execute ();
+
+  /// @brief Remove the overlap, repartition the mesh and rebuild the parallel data structures
+  void repartition();
+
+  /// @brief Ratio of the maximal and the average time of the ranks, over the last check interval
+  Real imbalance() const { return m_imbalance; }
+
+private: // functions
+
+  /// @brief Measure the imbalance, and repartition if it is too large
+  void check_imbalance();
+
+  /// @brief Remove the ghost elements, and the nodes that are no longer used
+  void remove_overlap();
+
+private: // data
+
+  Handle<mesh::MeshTransformer> m_load_balance;  ///< load balancer performing the repartitioning
+
+  Real m_work_time;          ///< time spent in the child actions since the last check
+  Uint m_nb_executions;      ///< number of executions since the last check
+  Real m_imbalance;          ///< imbalance measured at the last check
+
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // actions
+} // solver
+} // cf3
+
+#endif // cf3_solver_actions_DynamicLoadBalance_hpp
@@ -0,0 +1,389 @@
+// Copyright (C) 2010-2013 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <algorithm>
+#include <iomanip>
+
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
+
+#include "common/Builder.hpp"
+#include "common/Log.hpp"
+#include "common/PropertyList.hpp"
+#include "common/OptionList.hpp"
+#include "common/OptionT.hpp"
+#include "common/OptionComponent.hpp"
+#include "common/OptionURI.hpp"
+#include "common/FindComponents.hpp"
+#include "common/Table.hpp"
+
+#include "common/Signal.hpp"
+
+#include "common/PE/Comm.hpp"
+
+#include "math/MatrixTypes.hpp"
+#include "math/VariablesDescriptor.hpp"
+
+#include "mesh/Field.hpp"
+#include "mesh/Dictionary.hpp"
+#include "mesh/Space.hpp"
+#include "mesh/PointInterpolator.hpp"
+
+#include "solver/actions/ProbeSet.hpp"
+
+namespace cf3 {
+namespace solver {
+namespace actions {
+
+using namespace common;
+using namespace mesh;
+
+common::ComponentBuilder < ProbeSet, common::Action, solver::actions::LibActions > ProbeSet_Builder;
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+ProbeSet::ProbeSet( const std::string& name  ) :
+  common::Action(name),
+  m_setup_needed(true),
+  m_coordinates_changed(false),
+  m_nb_probes_setup(0)
+{
+  mark_basic(); // by default probes are visible
+
+  properties()["brief"] = std::string("Set of probes to interpolate field values to many coordinates");
+  std::string description =
+      "Configure coordinates and dictionary, and the probe set will interpolate the requested variables\n"
+      "to all coordinates, gathering the values on rank 0";
+  properties()["description"] = description;
+
+  options().add("coordinates",std::vector<Real>())
+    .pretty_name("Coordinates")
+    .description("Coordinates to interpolate fields to, as a flat list x0 y0 z0 x1 y1 z1 ... They replace the coordinates table at the next setup")
+    .attach_trigger( boost::bind( &ProbeSet::configure_coordinates, this ) )
+    .mark_basic();
+
+  options().add("dict",m_dict)
+    .description("Dictionary that will be probed")
+    .link_to(&m_dict)
+    .attach_trigger( boost::bind( &ProbeSet::configure_dict, this ) );
+
+  options().add("variables",std::vector<std::string>())
+    .description("Variables to probe. All variables of the dictionary are probed if empty")
+    .attach_trigger( boost::bind( &ProbeSet::trigger_setup, this ) )
+    .mark_basic();
+
+  options().add("file",URI())
+    .description("File to which every execution appends one line with all probed values (none if empty)")
+    .attach_trigger( boost::bind( &ProbeSet::trigger_setup, this ) );
+
+  regist_signal ( "setup" )
+      .description( "Locate the probes again, e.g. after the mesh changed" )
+      .pretty_name("Setup" )
+      .connect   ( boost::bind ( &ProbeSet::signal_setup, this, _1 ) );
+
+  m_point_interpolator = create_static_component<PointInterpolator>("point_interpolator");
+  m_coordinates = create_static_component< Table<Real> >("coordinates");
+  m_values = create_static_component< Table<Real> >("values");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+ProbeSet::~ProbeSet()
+{
+  if (m_file)
+    m_file.close();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ProbeSet::configure_coordinates()
+{
+  // The dimension is only known once the dictionary is set, so the copy is done at setup
+  m_coordinates_changed = true;
+  m_setup_needed = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ProbeSet::copy_coordinates()
+{
+  const std::vector<Real> coords = options().value< std::vector<Real> >("coordinates");
+  const Uint dim = m_dict->coordinates().row_size();
+  if (coords.size() % dim != 0)
+    throw SetupError(FromHere(), "Number of values in \"coordinates\" is not a multiple of the dimension "+to_str(dim));
+
+  m_coordinates->set_row_size(dim);
+  m_coordinates->resize(coords.size()/dim);
+  for (Uint p=0; p<m_coordinates->size(); ++p)
+  {
+    for (Uint d=0; d<dim; ++d)
+      (*m_coordinates)[p][d] = coords[p*dim+d];
+  }
+  m_coordinates_changed = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ProbeSet::configure_dict()
+{
+  m_point_interpolator->options().set("dict",m_dict);
+  m_setup_needed = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ProbeSet::trigger_setup()
+{
+  m_setup_needed = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ProbeSet::setup()
+{
+  if ( is_null(m_dict) )
+    throw SetupError(FromHere(), "Option \"dict\" was not configured in "+uri().string());
+
+  if (m_coordinates_changed)
+    copy_coordinates();
+
+  PE::Comm& comm = PE::Comm::instance();
+  const int rank = comm.rank();
+
+  // 1) Columns: every component of every requested variable
+  const std::vector<std::string> variables = options().value< std::vector<std::string> >("variables");
+  std::vector<bool> variable_found(variables.size(),false);
+  m_columns.clear();
+  m_column_field.clear();
+  m_column_var.clear();
+  const std::vector< Handle<Field> >& fields = m_dict->fields();
+  for (Uint f=0; f<fields.size(); ++f)
+  {
+    const math::VariablesDescriptor& descriptor = fields[f]->descriptor();
+    for (Uint var_idx=0; var_idx<descriptor.nb_vars(); ++var_idx)
+    {
+      const std::string var_name = descriptor.user_variable_name(var_idx);
+      if (variables.size())
+      {
+        const std::vector<std::string>::const_iterator it = std::find(variables.begin(),variables.end(),var_name);
+        if (it == variables.end())
+          continue;
+        variable_found[it-variables.begin()] = true;
+      }
+      const Uint var_begin  = descriptor.offset(var_idx);
+      const Uint var_length = descriptor.var_length(var_idx);
+      for (Uint i=0; i<var_length; ++i)
+      {
+        m_columns.push_back( var_length == 1 ? var_name : var_name+"["+to_str(i)+"]" );
+        m_column_field.push_back(f);
+        m_column_var.push_back(var_begin+i);
+      }
+    }
+  }
+  for (Uint v=0; v<variables.size(); ++v)
+  {
+    if (!variable_found[v])
+      throw SetupError(FromHere(),"Variable "+variables[v]+" not found in "+m_dict->uri().string());
+  }
+
+  // 2) Locate every probe, storing interpolation points and weights of found probes
+  const Uint nb_probes = m_coordinates->size();
+  const Uint dim = m_coordinates->row_size();
+  std::vector<int> owner(nb_probes,-1);
+  std::vector<Uint> found_offsets(1,0);
+  std::vector<Uint> found_points;
+  std::vector<Real> found_weights;
+
+  RealVector coord(dim);
+  SpaceElem element;
+  std::vector<SpaceElem> stencil;
+  std::vector<Uint> points;
+  std::vector<Real> weights;
+  for (Uint p=0; p<nb_probes; ++p)
+  {
+    for (Uint d=0; d<dim; ++d)
+      coord[d] = (*m_coordinates)[p][d];
+    if ( m_point_interpolator->compute_storage(coord,element,stencil,points,weights) )
+    {
+      owner[p] = rank;
+      found_points.insert(found_points.end(),points.begin(),points.end());
+      found_weights.insert(found_weights.end(),weights.begin(),weights.end());
+    }
+    found_offsets.push_back(found_points.size());
+  }
+
+  // 3) Probes found on multiple ranks (e.g. in overlap) are owned by the highest rank
+  if (comm.is_active())
+    comm.all_reduce(PE::max(), owner, owner);
+
+  std::vector<int> local_probes;
+  m_stencil_offsets.assign(1,0);
+  m_points.clear();
+  m_weights.clear();
+  Uint nb_lost = 0;
+  for (Uint p=0; p<nb_probes; ++p)
+  {
+    if (owner[p] < 0)
+      ++nb_lost;
+    if (owner[p] != rank)
+      continue;
+    local_probes.push_back(p);
+    m_points.insert(m_points.end(),found_points.begin()+found_offsets[p],found_points.begin()+found_offsets[p+1]);
+    m_weights.insert(m_weights.end(),found_weights.begin()+found_offsets[p],found_weights.begin()+found_offsets[p+1]);
+    m_stencil_offsets.push_back(m_points.size());
+  }
+  if (nb_lost && rank == 0)
+    CFwarn << uri().string() << ": " << nb_lost << " probes lie outside the domain, and are ignored" << CFendl;
+
+  // 4) Gather once the probe index of all local probes on rank 0
+  if (comm.is_active())
+  {
+    m_recv_counts.assign(comm.size(),-1);
+    m_recv_map.clear();
+    comm.gather(local_probes,local_probes.size(),m_recv_map,m_recv_counts,0);
+    // Only rank 0 received the counts. Counts left at -1 would make every later gather
+    // communicate them again on the other ranks only, so the collectives would not match
+    if (rank != 0)
+      m_recv_counts.assign(comm.size(),0);
+  }
+  else
+  {
+    m_recv_counts.assign(1,local_probes.size());
+    m_recv_map = local_probes;
+  }
+
+  const Uint nb_cols = m_columns.size();
+  m_values->set_row_size(nb_cols);
+  m_values->resize(rank == 0 ? nb_probes : 0);
+  m_gathered_values.assign(rank == 0 ? nb_probes*nb_cols : 0, 0.);
+  for (Uint p=0; p<m_values->size(); ++p)
+  {
+    for (Uint c=0; c<nb_cols; ++c)
+      (*m_values)[p][c] = 0.;
+  }
+
+  if (m_file)
+    m_file.close();
+
+  m_nb_probes_setup = nb_probes;
+  m_setup_needed = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ProbeSet::execute()
+{
+  if (m_setup_needed || m_coordinates->size() != m_nb_probes_setup)
+    setup();
+
+  PE::Comm& comm = PE::Comm::instance();
+  const Uint nb_cols = m_columns.size();
+  const Uint nb_local_probes = m_stencil_offsets.size()-1;
+
+  // Interpolate all columns of all local probes in one pass
+  const std::vector< Handle<Field> >& fields = m_dict->fields();
+  m_local_values.resize(nb_local_probes*nb_cols);
+  for (Uint lp=0; lp<nb_local_probes; ++lp)
+  {
+    for (Uint c=0; c<nb_cols; ++c)
+    {
+      const Field& field = *fields[m_column_field[c]];
+      const Uint v = m_column_var[c];
+      Real interpolated = 0.;
+      for (Uint i=m_stencil_offsets[lp]; i<m_stencil_offsets[lp+1]; ++i)
+      {
+        interpolated += field[m_points[i]][v] * m_weights[i];
+      }
+      m_local_values[lp*nb_cols+c] = interpolated;
+    }
+  }
+
+  // Single gather on rank 0, directly ordered by probe index
+  if (comm.is_active())
+  {
+    const std::vector<int> no_send_map;
+    comm.gather(m_local_values,nb_local_probes,no_send_map,m_gathered_values,m_recv_counts,m_recv_map,0,nb_cols);
+  }
+  else
+  {
+    for (Uint lp=0; lp<nb_local_probes; ++lp)
+    {
+      for (Uint c=0; c<nb_cols; ++c)
+        m_gathered_values[m_recv_map[lp]*nb_cols+c] = m_local_values[lp*nb_cols+c];
+    }
+  }
+
+  if (comm.rank() == 0)
+  {
+    for (Uint p=0; p<m_values->size(); ++p)
+    {
+      for (Uint c=0; c<nb_cols; ++c)
+        (*m_values)[p][c] = m_gathered_values[p*nb_cols+c];
+    }
+    if ( options().value<URI>("file").empty() == false )
+      write_values();
+  }
+
+  // Do all post-processing actions
+  boost_foreach (common::Action& action, find_components<common::Action>(*this))
+  {
+    action.execute();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ProbeSet::write_values()
+{
+  if (!m_file)
+  {
+    boost::filesystem::path path (options().value<URI>("file").path());
+    m_file.open(path,std::ios_base::out);
+    if (!m_file) // didn't open so throw exception
+    {
+      throw boost::filesystem::filesystem_error( path.string() + " failed to open",
+                                                 boost::system::error_code() );
+    }
+    m_file.precision(10);
+
+    // Header: one column per probe and variable, with probe coordinates listed first
+    for (Uint p=0; p<m_coordinates->size(); ++p)
+    {
+      m_file << "# probe_" << p << " (";
+      for (Uint d=0; d<m_coordinates->row_size(); ++d)
+        m_file << (d ? " " : "") << (*m_coordinates)[p][d];
+      m_file << ")\n";
+    }
+    m_file << "#";
+    for (Uint p=0; p<m_values->size(); ++p)
+    {
+      boost_foreach(const std::string& column, m_columns)
+        m_file << "\t" << std::setw(16) << "probe_"+to_str(p)+"_"+column;
+    }
+    m_file << "\n";
+  }
+
+  for (Uint p=0; p<m_values->size(); ++p)
+  {
+    for (Uint c=0; c<m_columns.size(); ++c)
+      m_file << "\t" << std::scientific << std::setw(16) << (*m_values)[p][c];
+  }
+  m_file << "\n";
+  m_file.flush();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+void ProbeSet::signal_setup(SignalArgs &args)
+{
+  setup();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // actions
+} // solver
+} // cf3
@@ -0,0 +1,128 @@
+// Copyright (C) 2010-2013 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#ifndef cf3_solver_actions_ProbeSet_hpp
+#define cf3_solver_actions_ProbeSet_hpp
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include "common/Action.hpp"
+#include "common/BoostFilesystem.hpp"
+#include "common/Table_fwd.hpp"
+
+#include "solver/actions/LibActions.hpp"
+
+namespace cf3 {
+namespace mesh { class Dictionary; class PointInterpolator; }
+namespace solver {
+namespace actions {
+
+////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Set of probes interpolating field values to many coordinates at once
+///
+/// As opposed to Probe, which interpolates all fields to one coordinate and
+/// communicates per field, a ProbeSet:
+/// - locates the elements of all its probe coordinates once, at setup,
+///   keeping the interpolation points and weights computed by a mesh::PointInterpolator
+/// - interpolates all requested variables for all locally owned probes in one pass
+/// - collects the values on rank 0 with a single gather per execution
+///
+/// The probe coordinates are stored in the table "coordinates" (one row per probe),
+/// which can be filled directly, or through the option "coordinates". The options can be
+/// configured in any order, as the coordinates are only copied at setup.
+/// The interpolated values are stored on rank 0 in the table "values",
+/// with one row per probe, and columns described by columns().
+/// Setup is redone automatically when the dictionary, the requested variables or the number of
+/// probes change. After a change of the mesh, setup() must be called explicitly.
+///
+/// Actions can be added as child to the probe set, and will be executed after
+/// the probe set is executed.
+class solver_actions_API ProbeSet : public common::Action {
+public: // functions
+
+  /// Contructor
+  /// @param name of the component
+  ProbeSet ( const std::string& name );
+
+  /// Virtual destructor
+  virtual ~ProbeSet();
+
+  /// Get the class name
+  static std::string type_name () { return "ProbeSet"; }
+
+  virtual void execute();
+
+  /// @brief Locate all probes, and gather the probe ownership on rank 0
+  void setup();
+
+  /// @brief Coordinates of the probes, one row per probe
+  common::Table<Real>& coordinates() { return *m_coordinates; }
+
+  /// @brief Interpolated values, one row per probe (only filled on rank 0)
+  const common::Table<Real>& values() const { return *m_values; }
+
+  /// @brief Names of the columns of values()
+  const std::vector<std::string>& columns() const { return m_columns; }
+
+  /// @name SIGNALS
+  //@{
+  void signal_setup(common::SignalArgs& args);
+  //@}
+
+private: // functions
+
+  /// @brief Flag the option "coordinates" to be copied in the coordinates table at the next setup
+  void configure_coordinates();
+
+  /// @brief Copy the option "coordinates" in the coordinates table, using the dimension of the dictionary
+  void copy_coordinates();
+
+  /// @brief Configure the point interpolator, and flag the need for setup
+  void configure_dict();
+
+  /// @brief Flag the need for setup
+  void trigger_setup();
+
+  /// @brief Write the values as one line in the output file
+  void write_values();
+
+private: // data
+
+  Handle<mesh::Dictionary>          m_dict;                ///< Dictionary to interpolate
+  Handle<mesh::PointInterpolator>   m_point_interpolator;  ///< Interpolator used to locate the probes
+  Handle< common::Table<Real> >     m_coordinates;         ///< Probe coordinates
+  Handle< common::Table<Real> >     m_values;              ///< Interpolated values, on rank 0
+
+  bool m_setup_needed;                          ///< Flag to redo setup at next execution
+  bool m_coordinates_changed;                   ///< Flag to copy the option "coordinates" at next setup
+  Uint m_nb_probes_setup;                       ///< Number of probes at last setup
+
+  std::vector<std::string> m_columns;           ///< Names of the columns of m_values
+  std::vector<Uint> m_column_field;             ///< Field index in the dictionary, per column
+  std::vector<Uint> m_column_var;               ///< Index in the field row, per column
+
+  std::vector<Uint> m_stencil_offsets;          ///< Offsets in m_points and m_weights, per local probe
+  std::vector<Uint> m_points;                   ///< Interpolation points of all local probes
+  std::vector<Real> m_weights;                  ///< Interpolation weights of all local probes
+
+  std::vector<int>  m_recv_counts;              ///< Number of local probes of every rank on rank 0, zeros on the other ranks
+  std::vector<int>  m_recv_map;                 ///< Probe index of every gathered probe, on rank 0
+  std::vector<Real> m_local_values;             ///< Send buffer with values of local probes
+  std::vector<Real> m_gathered_values;          ///< Receive buffer, ordered by probe index
+
+  boost::filesystem::fstream m_file;            ///< Output file
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+} // actions
+} // solver
+} // cf3
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // cf3_solver_actions_ProbeSet_hpp
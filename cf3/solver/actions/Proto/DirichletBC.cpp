@@ -0,0 +1,65 @@
+// Copyright (C) 2010-2011 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include "mesh/LibMesh.hpp"
+
+#include "DirichletBC.hpp"
+
+namespace cf3 {
+namespace solver {
+namespace actions {
+namespace Proto {
+
+DirichletBCCollector::DirichletBCCollector()
+{
+}
+
+DirichletBCCollector& DirichletBCCollector::instance()
+{
+  static DirichletBCCollector instance;
+  return instance;
+}
+
+void DirichletBCCollector::insert(math::LSS::System& lss, const Uint node_idx, const Uint eq, const Real value)
+{
+  // There are only a few systems per loop, so a linear search is fine
+  Batch* batch = nullptr;
+  for(std::vector<Batch>::iterator batch_it = m_batches.begin(); batch_it != m_batches.end(); ++batch_it)
+  {
+    if(batch_it->lss.get() == &lss)
+    {
+      batch = &(*batch_it);
+      break;
+    }
+  }
+
+  if(is_null(batch))
+  {
+    m_batches.push_back(Batch());
+    batch = &m_batches.back();
+    batch->lss = lss.handle<math::LSS::System>();
+  }
+
+  batch->blockrows.push_back(node_idx);
+  batch->eqs.push_back(eq);
+  batch->values.push_back(value);
+}
+
+void DirichletBCCollector::apply()
+{
+  for(std::vector<Batch>::iterator batch_it = m_batches.begin(); batch_it != m_batches.end(); ++batch_it)
+  {
+    if(is_not_null(batch_it->lss))
+      batch_it->lss->dirichlet(batch_it->blockrows, batch_it->eqs, batch_it->values, true);
+  }
+
+  m_batches.clear();
+}
+
+} // namespace Proto
+} // namespace actions
+} // namespace solver
+} // namespace cf3
@@ -7,6 +7,7 @@
 #ifndef cf3_solver_actions_Proto_DirichletBC_hpp
 #define cf3_solver_actions_Proto_DirichletBC_hpp
 
+#include <boost/noncopyable.hpp>
 #include <boost/proto/core.hpp>
 
 #include "math/MatrixTypes.hpp"
@@ -30,10 +31,39 @@ struct DirichletBCTag
 /// Used to create placeholders for a Dirichlet condition
 typedef LSSWrapper<DirichletBCTag> DirichletBC;
 
+/// Helper struct to collect the Dirichlet conditions set during a loop, so they can be applied to each system at once at the end of the loop
+class DirichletBCCollector : public boost::noncopyable
+{
+public:
+
+  /// Singleton implementation
+  static DirichletBCCollector& instance();
+
+  /// Add a condition for the given system
+  void insert(math::LSS::System& lss, const Uint node_idx, const Uint eq, const Real value);
+
+  /// Apply the conditions to their system and clear the list
+  void apply();
+
+private:
+  DirichletBCCollector();
+
+  /// Conditions for a single system
+  struct Batch
+  {
+    Handle<math::LSS::System> lss;
+    std::vector<Uint> blockrows;
+    std::vector<Uint> eqs;
+    std::vector<Real> values;
+  };
+
+  std::vector<Batch> m_batches;
+};
+
 /// Helper function for assignment
 inline void assign_dirichlet(math::LSS::System& lss, const Real new_value, const Real old_value, const Uint node_idx, const Uint offset)
 {
-  lss.dirichlet(node_idx, offset, new_value - old_value, true);
+  DirichletBCCollector::instance().insert(lss, node_idx, offset, new_value - old_value);
 }
 
 /// Overload for vector types
@@ -41,7 +71,7 @@ template<typename NewT, typename OldT>
 inline void assign_dirichlet(math::LSS::System& lss, const NewT& new_value, const OldT& old_value, const Uint node_idx, const Uint offset)
 {
   for(Uint i = 0; i != OldT::RowsAtCompileTime; ++i)
-    lss.dirichlet(node_idx, offset+i, new_value[i] - old_value[i], true);
+    DirichletBCCollector::instance().insert(lss, node_idx, offset+i, new_value[i] - old_value[i]);
 }
 
 /// Sets whole-variable dirichlet BC, allowing the use of a complete vector as value
@@ -0,0 +1,120 @@
+// Copyright (C) 2010-2011 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#include <algorithm>
+#include <limits>
+
+#include "Functions.hpp"
+
+namespace cf3 {
+namespace solver {
+namespace actions {
+namespace Proto {
+
+BatchVectorFunction::BatchVectorFunction() :
+  m_time(0.),
+  m_depends_on_time(false),
+  m_current(0),
+  m_nb_batch_evaluations(0)
+{
+}
+
+void BatchVectorFunction::parse()
+{
+  math::VectorialFunction::parse();
+  m_depends_on_time = depends_on("t");
+  m_node_values.clear();
+}
+
+void BatchVectorFunction::set_time(const Real time)
+{
+  m_time = time;
+}
+
+void BatchVectorFunction::prepare(const common::Component& region, const common::Table<Real>& coordinates, const common::List<Uint>& nodes) const
+{
+  cf3_assert(is_parsed());
+  cf3_assert(nbvars() > 0);
+
+  const Uint nb_nodes = nodes.size();
+  const Uint nb_coords = nbvars() - 1;
+  cf3_assert(coordinates.row_size() >= nb_coords);
+
+  // Discard the results of removed regions
+  for(Uint i = 0; i != m_node_values.size();)
+  {
+    if(is_null(m_node_values[i].region))
+      m_node_values.erase(m_node_values.begin() + i);
+    else
+      ++i;
+  }
+
+  // Look for stored results for the same region
+  bool up_to_date = true;
+  for(m_current = 0; m_current != m_node_values.size(); ++m_current)
+  {
+    if(m_node_values[m_current].region.get() == &region)
+      break;
+  }
+
+  if(m_current == m_node_values.size())
+  {
+    m_node_values.push_back(NodeValues());
+    m_node_values.back().region = region.handle();
+  }
+
+  // Replace the results if the nodes of the region changed, e.g. after a repartitioning or refinement
+  NodeValues& node_values = m_node_values[m_current];
+  const std::vector<Uint>& stored_nodes = node_values.nodes;
+  if(is_null(node_values.values)
+     || node_values.rows.size() != coordinates.size()
+     || stored_nodes.size() != nb_nodes
+     || !std::equal(stored_nodes.begin(), stored_nodes.end(), nodes.array().begin()))
+  {
+    node_values.nodes.assign(nodes.array().begin(), nodes.array().end());
+    node_values.rows.assign(coordinates.size(), std::numeric_limits<Uint>::max());
+    for(Uint i = 0; i != nb_nodes; ++i)
+      node_values.rows[nodes[i]] = i;
+    node_values.variables = common::allocate_component< common::Table<Real> >("variables");
+    node_values.variables->set_row_size(nbvars());
+    node_values.variables->resize(nb_nodes);
+    node_values.values = common::allocate_component< common::Table<Real> >("values");
+    up_to_date = false;
+  }
+
+  // Copy the variables, checking if they changed since the last evaluation
+  common::Table<Real>& variables = *node_values.variables;
+  for(Uint i = 0; i != nb_nodes; ++i)
+  {
+    const common::Table<Real>::ConstRow coords = coordinates[nodes[i]];
+    common::Table<Real>::Row vars = variables[i];
+    for(Uint j = 0; j != nb_coords; ++j)
+    {
+      if(vars[j] != coords[j])
+      {
+        vars[j] = coords[j];
+        up_to_date = false;
+      }
+    }
+    if(vars[nb_coords] != m_time)
+    {
+      vars[nb_coords] = m_time;
+      if(m_depends_on_time)
+        up_to_date = false;
+    }
+  }
+
+  if(up_to_date)
+    return;
+
+  evaluate_batch(variables, *node_values.values);
+  ++m_nb_batch_evaluations;
+}
+
+} // namespace Proto
+} // namespace actions
+} // namespace solver
+} // namespace cf3
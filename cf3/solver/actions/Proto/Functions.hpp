@@ -7,11 +7,19 @@
 #ifndef cf3_solver_actions_Proto_Functions_hpp
 #define cf3_solver_actions_Proto_Functions_hpp
 
+#include <vector>
+
 #include <boost/proto/core.hpp>
+#include <boost/shared_ptr.hpp>
 
 #include "common/CF.hpp"
+#include "common/List.hpp"
+#include "common/Table.hpp"
+
 #include "math/VectorialFunction.hpp"
 
+#include "solver/actions/LibActions.hpp"
+
 namespace cf3 {
 namespace solver {
 namespace actions {
@@ -88,6 +96,108 @@ struct ScalarFunction : math::VectorialFunction
 {
 };
 
+/// Parsed function that is evaluated for all nodes of a node loop at once, using VectorialFunction::evaluate_batch.
+/// The variables are the coordinates, followed by the time, which must be the last variable.
+/// The results are kept for each region, and only evaluated again if the nodes or coordinates change,
+/// or if the time changes and the functions depend on the time.
+class solver_actions_API BatchVectorFunction : public math::VectorialFunction
+{
+public:
+  BatchVectorFunction();
+
+  /// Parse the functions, discarding the stored results
+  void parse();
+
+  /// Set the value of the time variable
+  void set_time(const Real time);
+
+  /// Evaluate the functions for the given nodes, unless the stored results are still valid
+  /// @param region Region the nodes belong to. The results of one set of nodes are stored per region,
+  ///               replacing those of previous nodes of the region, e.g. after a repartitioning
+  /// @param coordinates Coordinates of all nodes of the dictionary the nodes belong to
+  /// @param nodes Nodes for which the functions are evaluated
+  void prepare(const common::Component& region, const common::Table<Real>& coordinates, const common::List<Uint>& nodes) const;
+
+  /// Values of the functions in the given node, for the nodes passed to the last call of prepare
+  common::Table<Real>::ConstRow node_values(const Uint node_idx) const
+  {
+    cf3_assert(m_current < m_node_values.size());
+    const NodeValues& node_values = m_node_values[m_current];
+    cf3_assert(node_idx < node_values.rows.size());
+    return (*node_values.values)[node_values.rows[node_idx]];
+  }
+
+  /// Number of times the functions were evaluated for a set of nodes
+  Uint nb_batch_evaluations() const
+  {
+    return m_nb_batch_evaluations;
+  }
+
+private:
+  /// Results for the nodes of one region
+  struct NodeValues
+  {
+    /// Region of the nodes, null once the region is removed
+    Handle<common::Component const> region;
+    /// Nodes for which the results are stored
+    std::vector<Uint> nodes;
+    /// Row in the values for each node index
+    std::vector<Uint> rows;
+    /// Variables used for the evaluation, one row per node
+    boost::shared_ptr< common::Table<Real> > variables;
+    /// Function values, one row per node
+    boost::shared_ptr< common::Table<Real> > values;
+  };
+
+  Real m_time;
+  bool m_depends_on_time;
+  mutable std::vector<NodeValues> m_node_values;
+  mutable Uint m_current;
+  mutable Uint m_nb_batch_evaluations;
+};
+
+/// Scalar version of BatchVectorFunction
+class solver_actions_API BatchScalarFunction : public BatchVectorFunction
+{
+};
+
+/// Primitive transform to get the values of a BatchVectorFunction in the current node
+struct BatchVectorFunctionTransform :
+  boost::proto::transform< BatchVectorFunctionTransform >
+{
+  template<typename ExprT, typename StateT, typename DataT>
+  struct impl : boost::proto::transform_impl<ExprT, StateT, DataT>
+  {
+    typedef typename boost::remove_reference<DataT>::type::CoordsT result_type;
+
+    result_type operator()(typename impl::expr_param expr, typename impl::state_param state, typename impl::data_param data) const
+    {
+      const common::Table<Real>::ConstRow values = boost::proto::value(expr).node_values(data.node_idx);
+      result_type result;
+      cf3_assert(values.size() == result.size());
+      for(Uint i = 0; i != result.size(); ++i)
+        result[i] = values[i];
+      return result;
+    }
+  };
+};
+
+/// Primitive transform to get the value of a BatchScalarFunction in the current node
+struct BatchScalarFunctionTransform :
+  boost::proto::transform< BatchScalarFunctionTransform >
+{
+  template<typename ExprT, typename StateT, typename DataT>
+  struct impl : boost::proto::transform_impl<ExprT, StateT, DataT>
+  {
+    typedef Real result_type;
+
+    Real operator()(typename impl::expr_param expr, typename impl::state_param state, typename impl::data_param data) const
+    {
+      return boost::proto::value(expr).node_values(data.node_idx)[0];
+    }
+  };
+};
+
 struct ParsedFunctionGrammar :
   boost::proto::or_
   <
@@ -100,6 +210,66 @@ struct ParsedFunctionGrammar :
     <
       boost::proto::terminal<ScalarFunction>,
       ParsedScalarFunctionTransform
+    >,
+    boost::proto::when
+    <
+      boost::proto::terminal<BatchVectorFunction>,
+      BatchVectorFunctionTransform
+    >,
+    boost::proto::when
+    <
+      boost::proto::terminal<BatchScalarFunction>,
+      BatchScalarFunctionTransform
+    >
+  >
+{
+};
+
+/// Nodes and coordinates used to evaluate the batch functions before a node loop
+struct BatchFunctionNodes
+{
+  BatchFunctionNodes(const common::Component& node_region, const common::Table<Real>& coords, const common::List<Uint>& nodes_list) :
+    region(node_region),
+    coordinates(coords),
+    nodes(nodes_list)
+  {
+  }
+
+  const common::Component& region;
+  const common::Table<Real>& coordinates;
+  const common::List<Uint>& nodes;
+};
+
+/// Evaluate a BatchVectorFunction for the nodes of a loop, passing on the (unused) state
+struct PrepareBatchFunction : boost::proto::callable
+{
+  typedef int result_type;
+
+  int operator()(const BatchVectorFunction& function, const int state, const BatchFunctionNodes& nodes) const
+  {
+    function.prepare(nodes.region, nodes.coordinates, nodes.nodes);
+    return state;
+  }
+};
+
+/// Calls prepare on all batch functions in an expression. The data must be a BatchFunctionNodes
+struct PrepareBatchFunctions :
+  boost::proto::or_
+  <
+    boost::proto::when
+    <
+      boost::proto::or_< boost::proto::terminal<BatchVectorFunction>, boost::proto::terminal<BatchScalarFunction> >,
+      PrepareBatchFunction(boost::proto::_value, boost::proto::_state, boost::proto::_data)
+    >,
+    boost::proto::when
+    <
+      boost::proto::terminal<boost::proto::_>,
+      boost::proto::_state
+    >,
+    boost::proto::when
+    <
+      boost::proto::nary_expr< boost::proto::_, boost::proto::vararg<boost::proto::_> >,
+      boost::proto::fold< boost::proto::_, boost::proto::_state, PrepareBatchFunctions >
     >
   >
 {
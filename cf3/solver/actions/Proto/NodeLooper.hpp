@@ -151,6 +151,11 @@ private:
 
     const common::List<Uint>& nodes = *used_nodes_ptr;
     const Uint nb_nodes = nodes.size();
+
+    // Evaluate the parsed functions for all nodes at once
+    BatchFunctionNodes batch_nodes(m_region, dict.coordinates(), nodes);
+    PrepareBatchFunctions()(expr, 0, batch_nodes);
+
     for(Uint i = 0; i != nb_nodes; ++i)
     {
       data.set_node(nodes[i]);
@@ -215,7 +220,8 @@ struct NodeLooper
 
     // Execute with known dimension
     NodeLooperDim<ExprT, NbDimsT>(m_expr, m_region, m_variables)();
-    
+
+    DirichletBCCollector::instance().apply();
     FieldSynchronizer::instance().synchronize();
   }
 
@@ -389,6 +389,14 @@ boost::shared_ptr< CNode > CNode::create_from_xml( XmlNode args )
 
 ////////////////////////////////////////////////////////////////////////////
 
+boost::shared_ptr< CNode > CNode::create_from_xml( XmlNode args,
+                         QMap<boost::shared_ptr<NLink>, URI> & link_targets )
+{
+  return create_from_xml_recursive(args, link_targets);
+}
+
+////////////////////////////////////////////////////////////////////////////
+
 Handle< CNode > CNode::child(cf3::Uint index)
 {
   QMutexLocker locker(m_mutex);
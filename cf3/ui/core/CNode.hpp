@@ -237,6 +237,17 @@ namespace core {
     /// @throw XmlError If the tree could not be built.
     static boost::shared_ptr< CNode > create_from_xml( common::XML::XmlNode node );
 
+    /// Creates an object tree from a given node, without resolving link targets
+
+    /// Absolute target paths can only be resolved once the tree is attached
+    /// at its place, which is then up to the calling code.
+    /// @param node Node to convert
+    /// @param link_targets Map where the target path of each link is added
+    /// @return Retuns a shared pointer to the created node.
+    /// @throw XmlError If the tree could not be built.
+    static boost::shared_ptr< CNode > create_from_xml( common::XML::XmlNode node,
+                         QMap<boost::shared_ptr<NLink>, common::URI> & link_targets );
+
     /// Casts this node to a constant component of type TYPE.
     /// @return Returns the cast pointer
     /// @throw CastingFailed if the casting failed.
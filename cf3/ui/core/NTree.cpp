@@ -4,15 +4,21 @@
 // GNU Lesser General Public License version 3 (LGPLv3).
 // See doc/lgpl.txt and doc/gpl.txt for the license text.
 
+#include <map>
+#include <vector>
+
 #include <QMutex>
 
 #include "rapidxml/rapidxml.hpp"
 
+#include "common/Foreach.hpp"
 #include "common/Signal.hpp"
 #include "common/FindComponents.hpp"
+#include "common/StringConversion.hpp"
 
 #include "ui/core/TreeThread.hpp"
 #include "ui/core/NetworkQueue.hpp"
+#include "ui/core/NLink.hpp"
 #include "ui/core/NLog.hpp"
 #include "ui/core/NRoot.hpp"
 #include "ui/core/ThreadManager.hpp"
@@ -36,7 +42,8 @@ namespace core {
 NTree::NTree(Handle< NRoot > rootNode)
   : CNode(CLIENT_TREE, "NTree", CNode::DEBUG_NODE),
     m_advanced_mode(false),
-    m_debug_mode_enabled(false)
+    m_debug_mode_enabled(false),
+    m_tree_revision(0)
 {
 
   m_root_node = new TreeNode(rootNode, nullptr, 0);
@@ -50,6 +57,12 @@ NTree::NTree(Handle< NRoot > rootNode)
   regist_signal( "list_tree" )
     .description("New tree")
     .pretty_name("").connect(boost::bind(&NTree::list_tree_reply, this, _1));
+
+  unregist_signal("list_tree_changes"); // unregister base class signal
+
+  regist_signal( "list_tree_changes" )
+    .description("Changes of the tree")
+    .pretty_name("").connect(boost::bind(&NTree::list_tree_changes_reply, this, _1));
 }
 
 ////////////////////////////////////////////////////////////////////////////
@@ -655,6 +668,10 @@ void NTree::list_tree_reply(SignalArgs & args)
       m_current_index = this->index_from_path(currentIndexPath);
 
 
+    // servers that do not give the revision are always listed in full
+    const std::string revision = args.main_map.content.attribute_value("revision");
+    m_tree_revision = revision.empty() ? 0 : from_str<Uint>(revision);
+
     NLog::global()->add_message("Tree updated.");
   }
   catch(XmlError & xe)
@@ -673,10 +690,177 @@ void NTree::list_tree_reply(SignalArgs & args)
 
 ////////////////////////////////////////////////////////////////////////////
 
+void NTree::list_tree_changes_reply(SignalArgs & args)
+{
+  XmlNode changes( args.main_map.content.content->first_node() );
+
+  // the root itself changed, the reply is a full listing
+  if( changes.is_valid() && changes.attribute_value("partial").empty() )
+  {
+    list_tree_reply(args);
+    return;
+  }
+
+  // nothing changed since the last listing
+  if( !changes.is_valid() )
+  {
+    m_tree_revision = from_str<Uint>( args.main_map.content.attribute_value("revision") );
+    return;
+  }
+
+  emit begin_update_tree();
+  beginResetModel();
+
+  bool success = false;
+
+  try
+  {
+    Handle< NRoot > tree_root = m_root_node->node()->castTo<NRoot>();
+    URI currentIndexPath;
+
+    if(m_current_index.isValid())
+    {
+      currentIndexPath = index_to_tree_node(m_current_index)->node()->uri();
+    }
+
+    // links may point into subtrees that are replaced: remember their targets
+    std::vector< std::pair< Handle<NLink>, URI > > old_targets;
+    boost_foreach( NLink& link, find_components_recursively<NLink>(*tree_root) )
+    {
+      if( !link.target_path().empty() )
+        old_targets.push_back( std::make_pair( link.handle<NLink>(), link.target_path() ) );
+    }
+
+    QMap<boost::shared_ptr< NLink >, URI> link_targets;
+    apply_tree_changes(*tree_root, changes, link_targets);
+
+    // targets of the new links
+    QMap<boost::shared_ptr< NLink >, URI>::iterator it = link_targets.begin();
+    for( ; it != link_targets.end() ; ++it)
+      it.key()->set_target_path(it.value());
+
+    // targets of the old links that were not replaced
+    for( Uint i = 0 ; i < old_targets.size() ; ++i )
+    {
+      if( is_null(old_targets[i].first) || is_null(old_targets[i].first->parent()) )
+        continue;
+
+      try
+      {
+        old_targets[i].first->set_target_path(old_targets[i].second);
+      }
+      catch(Exception &) // the target was removed
+      {
+        old_targets[i].first->set_target_node( Handle<CNode>() );
+      }
+    }
+
+    // child count may have changed, ask the root TreeNode to update its internal data
+    m_root_node->update_child_list();
+
+    // retrieve the previous index, if it still exists
+    if(!currentIndexPath.path().empty())
+      m_current_index = this->index_from_path(currentIndexPath);
+
+    m_tree_revision = from_str<Uint>( args.main_map.content.attribute_value("revision") );
+    success = true;
+  }
+  catch(Exception & e)
+  {
+    NLog::global()->add_exception(e.what());
+  }
+
+  // tell the view to update the whole thing
+  endResetModel();
+
+  emit end_update_tree();
+
+  emit current_index_changed(m_current_index, QModelIndex());
+
+  // the client tree is out of sync: list it in full
+  if( !success )
+  {
+    m_tree_revision = 0;
+    update_tree();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////
+
+void NTree::apply_tree_changes(CNode & node, XmlNode changes,
+                               QMap<boost::shared_ptr<NLink>, URI> & link_targets)
+{
+  // children listed by the server, in their order
+  std::vector<XmlNode> listed;
+  std::map<std::string, XmlNode> listed_by_name;
+  for( XmlNode child( changes.content->first_node("node") ) ; child.is_valid() ;
+       child.content = child.content->next_sibling("node") )
+  {
+    listed.push_back(child);
+    listed_by_name[child.attribute_value("name")] = child;
+  }
+
+  //
+  // remove the nodes that do not exist anymore, or that are replaced
+  //
+  std::vector<std::string> list_to_remove;
+  boost_foreach( CNode& child, find_components<CNode>(node) )
+  {
+    if( child.is_local_component() )
+      continue;
+
+    std::map<std::string, XmlNode>::iterator it = listed_by_name.find(child.name());
+
+    if( it == listed_by_name.end() || ( it->second.attribute_value("unchanged").empty() &&
+                                        it->second.attribute_value("partial").empty() ) )
+      list_to_remove.push_back(child.name());
+  }
+
+  boost_foreach( const std::string & name, list_to_remove )
+  {
+    node.access_component_checked(name)->handle<CNode>()->about_to_be_removed();
+    node.remove_component(name);
+  }
+
+  //
+  // update the changed nodes and add the new ones
+  //
+  boost_foreach( XmlNode& child, listed )
+  {
+    const std::string name = child.attribute_value("name");
+
+    // the server core has no client node (see CNode::create_from_xml())
+    if( child.attribute_value("atype") == "CCore" )
+      continue;
+
+    if( child.attribute_value("unchanged").empty() && child.attribute_value("partial").empty() )
+    {
+      boost::shared_ptr< CNode > child_node = CNode::create_from_xml(child, link_targets);
+
+      if( is_not_null(child_node) )
+        node.add_component(child_node);
+
+      continue;
+    }
+
+    Handle< CNode > child_node( node.get_child(name) );
+
+    if( is_null(child_node) )
+      throw ValueNotFound(FromHere(), "Node " + name + " was not found in " + node.uri().string() + ".");
+
+    if( !child.attribute_value("partial").empty() )
+      apply_tree_changes(*child_node, child, link_targets);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////
+
 void NTree::clear_tree()
 {
   beginResetModel();
 
+  m_tree_revision = 0; // the tree has to be listed in full again
+
   //QMutexLocker locker(m_mutex);
 
   Handle< NRoot > treeRoot = m_root_node->node()->castTo<NRoot>();
@@ -741,8 +925,19 @@ void NTree::content_listed(Handle< Component > node)
 
 void NTree::update_tree()
 {
-  SignalFrame frame("list_tree", CLIENT_TREE_PATH, SERVER_ROOT_PATH);
-  NetworkQueue::global()->send( frame );
+  // after the first listing, only the changes are listed
+  if( m_tree_revision == 0 )
+  {
+    SignalFrame frame("list_tree", CLIENT_TREE_PATH, SERVER_ROOT_PATH);
+    NetworkQueue::global()->send( frame );
+  }
+  else
+  {
+    SignalFrame frame("list_tree_changes", CLIENT_TREE_PATH, SERVER_ROOT_PATH);
+    frame.options().add( "revision", m_tree_revision );
+    frame.options().flush();
+    NetworkQueue::global()->send( frame );
+  }
 }
 
 /*============================================================================
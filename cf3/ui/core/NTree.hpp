@@ -300,6 +300,13 @@ namespace core {
     /// @param node New tree
     void list_tree_reply(cf3::common::SignalArgs & node);
 
+    /// @brief Signal called when the tree changes since the last listing arrive
+
+    /// Only the added, removed or changed subtrees are replaced. If the
+    /// changes can not be applied, the whole tree is listed again.
+    /// @param node Changes of the tree
+    void list_tree_changes_reply(cf3::common::SignalArgs & node);
+
     /// @} END Signals
 
     void content_listed(Handle< Component > node);
@@ -361,6 +368,19 @@ namespace core {
     /// @brief Mutex to control concurrent access.
     QMutex * m_mutex;
 
+    /// @brief Revision of the server tree at the last listing, or 0 if the
+    /// tree has to be listed in full.
+    Uint m_tree_revision;
+
+    /// @brief Applies the changes of a subtree to a node
+
+    /// @param node The node to update
+    /// @param changes The partial subtree, as written by the server
+    /// @param link_targets Map where the target path of each new link is added
+    /// @throw ValueNotFound If a node to update does not exist.
+    void apply_tree_changes(CNode & node, common::XML::XmlNode changes,
+                            QMap<boost::shared_ptr<NLink>, common::URI> & link_targets);
+
     /// @brief Converts an index to a tree node
 
     /// @param index Node index to convert
@@ -11,6 +11,7 @@
 
 #include "common/StringConversion.hpp"
 
+#include "common/XML/BinaryPayload.hpp"
 #include "common/XML/SignalFrame.hpp"
 #include "common/XML/FileOperations.hpp"
 
@@ -60,10 +61,11 @@ void TCPConnection::prepare_write_buffers( SignalArgs & args,
 {
   cf3_assert( args.node.is_valid() );
 
-  // prepare the outgoing data: flush to XML and convert to string
+  // prepare the outgoing data: flush to XML and convert to a frame
+  // (the XML text, followed by the binary payloads, if any)
   args.flush_maps();
 
-  XML::to_string( *args.xml_doc.get(), m_outgoing_data );
+  XML::to_frame( *args.xml_doc.get(), m_outgoing_data );
 
   // create the header on HEADER_LENGTH characters
   std::ostringstream header_stream;
@@ -122,9 +124,7 @@ void TCPConnection::parse_frame_data( SignalFrame & args, boost::system::error_c
 {
   try
   {
-    std::string frame( m_incoming_data, m_incoming_data_size );
-
-    args = SignalFrame( cf3::common::XML::parse_string( frame ) );
+    args = SignalFrame( cf3::common::XML::parse_frame( m_incoming_data, m_incoming_data_size ) );
   }
 
   catch ( cf3::common::Exception & cfe )
@@ -51,7 +51,8 @@ class ErrorHandler;
 /// Frames handled by this class have two main parts:
 /// @li A size-fixed header (8 bytes): contains the size in bytes of the frame
 /// data.
-/// @li Frame data: actual data that is sent, in XML format.@n@n
+/// @li Frame data: actual data that is sent, in XML format, followed by the
+/// binary payloads of the signal, if any (see @c XML::to_frame()).@n@n
 ///
 /// The header is completely tansparent to the calling code and is used as a
 /// safeguard to check that all data has arrived and allocate the correct buffer
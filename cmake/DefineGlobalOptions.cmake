@@ -33,6 +33,10 @@ set( CF3_EXTRA_DEFINES "" CACHE STRING "Extra defines or undefines to pass (exam
 
 set( CF3_USER_PRECISION "DOUBLE" CACHE STRING "Precision for floating point numbers" )
 
+# size of global indices
+
+option( CF3_ENABLE_64BIT_GLOBAL_INDICES "Use 64-bit global indices, for meshes with more than 4 billion nodes or unknowns" OFF )
+
 # code analysis options
 
 option( CF3_ENABLE_CODECOVERAGE       "Enable code coverage"           OFF ) # note that it turns off optimization
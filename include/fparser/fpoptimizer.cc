@@ -11808,7 +11808,7 @@ xF
 std::complex<long
 double>nF1
 #endif
-//FUNCTIONPARSER_INSTANTIATE_TYPES
+FUNCTIONPARSER_INSTANTIATE_TYPES
 #endif
 
 #endif
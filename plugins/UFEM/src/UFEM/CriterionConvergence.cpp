@@ -8,6 +8,7 @@
 #include "common/OptionComponent.hpp"
 #include "common/OptionList.hpp"
 #include "common/OptionT.hpp"
+#include "common/PE/Comm.hpp"
 #include "common/PropertyList.hpp"
 
 #include "solver/actions/Proto/ProtoAction.hpp"
@@ -59,18 +60,14 @@ CriterionConvergence::CriterionConvergence( const std::string& name  ) :
   FieldVariable<0, ScalarField> conduction_temperature("Temperature", "heat_conduction_solution");
   FieldVariable<1, ScalarField> Phi("Temperature", "scalar_advection_solution");
 
-add_component(create_proto_action("ComputeMinError", nodes_expression(
-          lit(m_min_error) = _min(_abs(Phi - conduction_temperature), m_min_error)
-       )));
-add_component(create_proto_action("ComputeMaxError", nodes_expression(
-        lit(m_max_error) = _max(_abs(Phi - conduction_temperature), m_max_error)
-     )));
-add_component(create_proto_action("GetMaxCondTemperature", nodes_expression(
-        lit(m_cond_temperature) = _max(conduction_temperature, m_cond_temperature)
-     )));
-add_component(create_proto_action("GetMaxFluidTemperature", nodes_expression (
-        lit(m_fluid_temperature) = _max(Phi, m_fluid_temperature)
-     )));
+  // All quantities are gathered in a single pass over the nodes
+  add_component(create_proto_action("ComputeErrors", nodes_expression(group
+  (
+    lit(m_min_error) = _min(_abs(Phi - conduction_temperature), m_min_error),
+    lit(m_max_error) = _max(_abs(Phi - conduction_temperature), m_max_error),
+    lit(m_cond_temperature) = _max(conduction_temperature, m_cond_temperature),
+    lit(m_fluid_temperature) = _max(Phi, m_fluid_temperature)
+  ))));
 }
 
 CriterionConvergence::~CriterionConvergence() {}
@@ -91,10 +88,20 @@ bool CriterionConvergence::operator()()
   Handle<Iterate> iterate(m_iter_comp);
 
 
-  Handle<common::Action>(get_child("ComputeMinError"))->execute();
-  Handle<common::Action>(get_child("ComputeMaxError"))->execute();
-  Handle<common::Action>(get_child("GetMaxFluidTemperature"))->execute();
-  Handle<common::Action>(get_child("GetMaxCondTemperature"))->execute();
+  Handle<common::Action>(get_child("ComputeErrors"))->execute();
+
+  // Combine the results of all processes in one reduction, the minimum is reduced as the maximum of its opposite
+  if(common::PE::Comm::instance().is_active())
+  {
+    Real loc_values[4] = { m_max_error, m_cond_temperature, m_fluid_temperature, -m_min_error };
+    Real glb_values[4];
+    common::PE::Comm::instance().all_reduce(common::PE::max(), loc_values, 4, glb_values);
+    m_max_error = glb_values[0];
+    m_cond_temperature = glb_values[1];
+    m_fluid_temperature = glb_values[2];
+    m_min_error = -glb_values[3];
+  }
+
  /* std::cout << "min error is " << m_min_error << std::endl;
   std::cout << "max error is " << m_max_error << std::endl;
   std::cout << "max conduction temperature is " << m_cond_temperature << std::endl;
@@ -190,7 +190,7 @@ void LSSAction::on_regions_set()
   {
     VariablesDescriptor& descriptor = find_component_with_tag<VariablesDescriptor>(physical_model().variable_manager(), solution_tag());
 
-    Handle< List<Uint> > gids = m_implementation->m_lss->create_component< List<Uint> >("GIDs");
+    Handle< List<Gid> > gids = m_implementation->m_lss->create_component< List<Gid> >("GIDs");
     Handle< List<Uint> > ranks = m_implementation->m_lss->create_component< List<Uint> >("Ranks");
     Handle< List<Uint> > used_node_map = m_implementation->m_lss->create_component< List<Uint> >("used_node_map");
 
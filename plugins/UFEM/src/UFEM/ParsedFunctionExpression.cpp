@@ -13,6 +13,8 @@
 #include "mesh/Mesh.hpp"
 #include "mesh/Region.hpp"
 
+#include "solver/Tags.hpp"
+#include "solver/Time.hpp"
 
 #include "UFEM/ParsedFunctionExpression.hpp"
 
@@ -34,6 +36,11 @@ ParsedFunctionExpression::ParsedFunctionExpression(const std::string& name) : Pr
     .mark_basic();
   
   options().option("regions").attach_trigger(boost::bind(&ParsedFunctionExpression::trigger_value, this));
+
+  options().add(solver::Tags::time(), m_time)
+    .pretty_name("Time")
+    .description("Component that keeps track of time for this simulation, used for the variable t")
+    .link_to(&m_time);
 }
 
 void ParsedFunctionExpression::trigger_value()
@@ -53,13 +60,14 @@ void ParsedFunctionExpression::trigger_value()
     vars.push_back("y");
   if(dim > 2)
     vars.push_back("z");
+  vars.push_back("t");
 
   m_function.variables(vars);
   m_function.functions(functions);
   m_function.parse();
 }
 
-const solver::actions::Proto::ScalarFunction& ParsedFunctionExpression::scalar_function()
+const solver::actions::Proto::BatchScalarFunction& ParsedFunctionExpression::scalar_function()
 {
   if(options().option("value").value< std::vector<std::string> >().size() > 1)
     throw BadValue(FromHere(), "Value option for ParsedFunctionExpression " + uri().path() + " has more than one component, can't use as scalar");
@@ -67,6 +75,12 @@ const solver::actions::Proto::ScalarFunction& ParsedFunctionExpression::scalar_f
   return m_function;
 }
 
+void ParsedFunctionExpression::execute()
+{
+  m_function.set_time(is_null(m_time) ? 0. : m_time->current_time());
+  ProtoAction::execute();
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 
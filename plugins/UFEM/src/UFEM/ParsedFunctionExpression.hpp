@@ -15,10 +15,14 @@
 #include "solver/actions/Proto/ProtoAction.hpp"
 
 namespace cf3 {
+namespace solver { class Time; }
 namespace UFEM {
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 
+/// Action that sets variables using parsed functions of the coordinates and the time "t".
+/// The functions are evaluated for all nodes of a region at once, and values that do not depend
+/// on the time are reused in the next time steps.
 class UFEM_API ParsedFunctionExpression : public solver::actions::Proto::ProtoAction
 {
 public:
@@ -27,19 +31,24 @@ public:
   static std::string type_name() { return "ParsedFunctionExpression"; }
 
   /// Get the held function as a vector
-  const math::VectorialFunction& vector_function()
+  const solver::actions::Proto::BatchVectorFunction& vector_function()
   {
     return m_function;
   }
 
   /// Get the stored function as a scalar. This requires that the values option has exactly one element
-  const solver::actions::Proto::ScalarFunction& scalar_function();
+  const solver::actions::Proto::BatchScalarFunction& scalar_function();
+
+  /// Evaluate the functions at the current time and run the expression
+  virtual void execute();
 
 private:
   void trigger_value();
 
   // Can also represent a vector function
-  solver::actions::Proto::ScalarFunction m_function;
+  solver::actions::Proto::BatchScalarFunction m_function;
+
+  Handle<solver::Time> m_time;
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////
@@ -28,11 +28,11 @@ using namespace mesh;
 
 ////////////////////////////////////////////////////////////////////////////////
 
-boost::shared_ptr< List<Uint> > build_sparsity(const std::vector< Handle<Region> >& regions, const Dictionary& dictionary, std::vector<Uint>& node_connectivity, std::vector<Uint>& start_indices, List<Uint>& gids, List<Uint>& ranks, List<Uint>& used_node_map)
+boost::shared_ptr< List<Uint> > build_sparsity(const std::vector< Handle<Region> >& regions, const Dictionary& dictionary, std::vector<Uint>& node_connectivity, std::vector<Uint>& start_indices, List<Gid>& gids, List<Uint>& ranks, List<Uint>& used_node_map)
 {
   // Get some data from the dictionary
   const Uint nb_global_nodes = dictionary.size();
-  const List<Uint>& dict_gid = dictionary.glb_idx();
+  const List<Gid>& dict_gid = dictionary.glb_idx();
   const List<Uint>& dict_rank = dictionary.rank();
 
   const Uint my_rank = PE::Comm::instance().rank();
@@ -55,7 +55,7 @@ boost::shared_ptr< List<Uint> > build_sparsity(const std::vector< Handle<Region>
   gids.resize(nb_used_nodes);
   ranks.resize(nb_used_nodes);
   used_node_map.resize(nb_global_nodes);
-  Uint nb_local_nodes = 0;
+  Gid nb_local_nodes = 0;
   for(Uint i = 0; i != nb_used_nodes; ++i)
   {
     const Uint node_idx = used_nodes[i];
@@ -68,7 +68,7 @@ boost::shared_ptr< List<Uint> > build_sparsity(const std::vector< Handle<Region>
   }
 
   // Get the layout of the new GIDs across CPUs
-  std::vector<Uint> gid_distribution; gid_distribution.reserve(nb_procs);
+  std::vector<Gid> gid_distribution; gid_distribution.reserve(nb_procs);
   if(PE::Comm::instance().is_active())
   {
     // Get the total number of elements on each rank
@@ -83,14 +83,14 @@ boost::shared_ptr< List<Uint> > build_sparsity(const std::vector< Handle<Region>
     gid_distribution[i] += gid_distribution[i-1];
 
   // first gid on this rank
-  Uint gid_counter = my_rank == 0 ? 0 : gid_distribution[my_rank-1];
+  Gid gid_counter = my_rank == 0 ? 0 : gid_distribution[my_rank-1];
   // copy of the GIDs, where the used node GID will be replaced by the new GID
-  std::vector<Uint> replaced_gids(dict_gid.array().begin(), dict_gid.array().end());
+  std::vector<Gid> replaced_gids(dict_gid.array().begin(), dict_gid.array().end());
 
   // For each rank, the indices that need to be received from the GID list
-  std::vector< std::vector<Uint> > gids_to_receive(nb_procs);
+  std::vector< std::vector<Gid> > gids_to_receive(nb_procs);
   std::vector< std::vector<Uint> > lids_to_receive(nb_procs);
-  std::vector< std::vector<Uint> > gids_to_send(nb_procs);
+  std::vector< std::vector<Gid> > gids_to_send(nb_procs);
 
   // Fill gid list
   for(Uint i = 0; i != nb_used_nodes; ++i)
@@ -128,14 +128,14 @@ boost::shared_ptr< List<Uint> > build_sparsity(const std::vector< Handle<Region>
     std::vector<int> recv_map; recv_map.reserve(recv_size);
     std::vector<int> send_map; send_map.reserve(send_size);
     
-    std::map<Uint, Uint> gids_reverse_map;
+    std::map<Gid, Uint> gids_reverse_map;
     for(Uint i = 0; i != nb_global_nodes; ++i)
       gids_reverse_map[dict_gid[i]] = i;
 
     for(Uint i = 0; i != nb_procs; ++i)
     {
       recv_map.insert(recv_map.end(), lids_to_receive[i].begin(), lids_to_receive[i].end());
-      const std::vector<Uint> send_gids_i = gids_to_send[i];
+      const std::vector<Gid> send_gids_i = gids_to_send[i];
       const Uint len_send_gids_i = send_gids_i.size();
       for(Uint j = 0; j != len_send_gids_i; ++j)
         send_map.push_back(gids_reverse_map[send_gids_i[j]]);
@@ -90,7 +90,7 @@ BOOST_AUTO_TEST_CASE( Sparsity1D )
 
   // Setup sparsity
   std::vector<Uint> node_connectivity, starting_indices;
-  Handle< List<Uint> > gids = domain.create_component< List<Uint> >("GIDs");
+  Handle< List<Gid> > gids = domain.create_component< List<Gid> >("GIDs");
   Handle< List<Uint> > ranks = domain.create_component< List<Uint> >("Ranks");
   Handle< List<Uint> > used_node_map = domain.create_component< List<Uint> >("used_node_map");
   UFEM::build_sparsity(std::vector< Handle<Region> >(1, mesh.topology().handle<Region>()), mesh.geometry_fields(), node_connectivity, starting_indices, *gids, *ranks, *used_node_map);
@@ -134,7 +134,7 @@ BOOST_AUTO_TEST_CASE( Sparsity2DQuads )
 
   // Setup sparsity
   std::vector<Uint> node_connectivity, starting_indices;
-  Handle< List<Uint> > gids = domain.create_component< List<Uint> >("GIDs");
+  Handle< List<Gid> > gids = domain.create_component< List<Gid> >("GIDs");
   Handle< List<Uint> > ranks = domain.create_component< List<Uint> >("Ranks");
   Handle< List<Uint> > used_node_map = domain.create_component< List<Uint> >("used_node_map");
   UFEM::build_sparsity(std::vector< Handle<Region> >(1, mesh.topology().handle<Region>()), mesh.geometry_fields(), node_connectivity, starting_indices, *gids, *ranks, *used_node_map);
@@ -173,7 +173,7 @@ BOOST_AUTO_TEST_CASE( Sparsity2DTris )
 
   // Setup sparsity
   std::vector<Uint> node_connectivity, starting_indices;
-  Handle< List<Uint> > gids = domain.create_component< List<Uint> >("GIDs");
+  Handle< List<Gid> > gids = domain.create_component< List<Gid> >("GIDs");
   Handle< List<Uint> > ranks = domain.create_component< List<Uint> >("Ranks");
   Handle< List<Uint> > used_node_map = domain.create_component< List<Uint> >("used_node_map");
   UFEM::build_sparsity(std::vector< Handle<Region> >(1, mesh.topology().handle<Region>()), mesh.geometry_fields(), node_connectivity, starting_indices, *gids, *ranks, *used_node_map);
@@ -238,7 +238,7 @@ BOOST_AUTO_TEST_CASE( Sparsity3DHexaBlock )
 
   // Setup sparsity
   std::vector<Uint> node_connectivity, starting_indices;
-  Handle< List<Uint> > gids = domain.create_component< List<Uint> >("GIDs");
+  Handle< List<Gid> > gids = domain.create_component< List<Gid> >("GIDs");
   Handle< List<Uint> > ranks = domain.create_component< List<Uint> >("Ranks");
   Handle< List<Uint> > used_node_map = domain.create_component< List<Uint> >("used_node_map");
   UFEM::build_sparsity(std::vector< Handle<Region> >(1, mesh.topology().handle<Region>()), mesh.geometry_fields(), node_connectivity, starting_indices, *gids, *ranks, *used_node_map);
@@ -281,7 +281,7 @@ BOOST_AUTO_TEST_CASE( Sparsity3DHexaChannel )
 
   // Setup sparsity
   std::vector<Uint> node_connectivity, starting_indices;
-  Handle< List<Uint> > gids = domain.create_component< List<Uint> >("GIDs");
+  Handle< List<Gid> > gids = domain.create_component< List<Gid> >("GIDs");
   Handle< List<Uint> > ranks = domain.create_component< List<Uint> >("Ranks");
   Handle< List<Uint> > used_node_map = domain.create_component< List<Uint> >("used_node_map");
   UFEM::build_sparsity(std::vector< Handle<Region> >(1, mesh.topology().handle<Region>()), mesh.geometry_fields(), node_connectivity, starting_indices, *gids, *ranks, *used_node_map);
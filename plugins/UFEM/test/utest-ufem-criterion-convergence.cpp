@@ -0,0 +1,114 @@
+// Copyright (C) 2010-2011 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test module for the UFEM convergence criterion"
+
+#include <boost/test/unit_test.hpp>
+
+#include "common/Core.hpp"
+#include "common/OptionList.hpp"
+
+#include "common/PE/Comm.hpp"
+
+#include "mesh/Dictionary.hpp"
+#include "mesh/Field.hpp"
+#include "mesh/Mesh.hpp"
+#include "mesh/MeshGenerator.hpp"
+#include "mesh/Region.hpp"
+
+#include "solver/actions/Iterate.hpp"
+
+#include "UFEM/CriterionConvergence.hpp"
+
+using namespace cf3;
+using namespace cf3::common;
+using namespace cf3::mesh;
+using namespace cf3::solver::actions;
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct CriterionConvergenceFixture
+{
+  CriterionConvergenceFixture() :
+    root( Core::instance().root() )
+  {
+  }
+
+  /// Iterate at most 10 times, stopping when the convergence criterion is met
+  Handle<Iterate> create_iterate(const std::string& name, Mesh& mesh)
+  {
+    Handle<Iterate> iterate = root.create_component<Iterate>(name);
+    iterate->options().set("max_iter", 10u);
+    Handle<UFEM::CriterionConvergence> criterion = iterate->create_component<UFEM::CriterionConvergence>("convergence");
+    criterion->options().set("iterator", iterate);
+    criterion->get_child("ComputeErrors")->options().set("regions", std::vector<URI>(1, mesh.topology().uri()));
+    return iterate;
+  }
+
+  Component& root;
+};
+
+BOOST_FIXTURE_TEST_SUITE( CriterionConvergenceSuite, CriterionConvergenceFixture )
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( InitMPI )
+{
+  common::PE::Comm::instance().init(boost::unit_test::framework::master_test_suite().argc, boost::unit_test::framework::master_test_suite().argv);
+  BOOST_CHECK_EQUAL(common::PE::Comm::instance().size(), 2);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( MaximalError )
+{
+  // Line of 10 cells, distributed over the 2 processes
+  boost::shared_ptr<MeshGenerator> create_line = build_component_abstract_type<MeshGenerator>("cf3.mesh.SimpleMeshGenerator","create_line");
+  create_line->options().set("mesh",URI("//line"));
+  create_line->options().set("lengths",std::vector<Real>(1, 10.));
+  create_line->options().set("nb_cells",std::vector<Uint>(1, 10u));
+  Mesh& mesh = create_line->generate();
+
+  Dictionary& nodes = mesh.geometry_fields();
+  Field& conduction = nodes.create_field("heat_conduction_solution", "Temperature");
+  conduction.add_tag("heat_conduction_solution");
+  Field& advection = nodes.create_field("scalar_advection_solution", "Temperature");
+  advection.add_tag("scalar_advection_solution");
+
+  // The temperatures differ by 0.5 in every node: converged as soon as the second iteration
+  for (Uint n=0; n<nodes.size(); ++n)
+  {
+    conduction[n][0] = nodes.coordinates()[n][XX];
+    advection[n][0] = nodes.coordinates()[n][XX] + 0.5;
+  }
+  Handle<Iterate> converged = create_iterate("converged", mesh);
+  converged->execute();
+  BOOST_CHECK_EQUAL(converged->iter(), 2u);
+
+  // A difference of 1.5 in the node at x = 9, owned by the second process only, prevents convergence on all processes
+  for (Uint n=0; n<nodes.size(); ++n)
+  {
+    if (nodes.coordinates()[n][XX] == 9.)
+      advection[n][0] = 10.5;
+  }
+  Handle<Iterate> not_converged = create_iterate("not_converged", mesh);
+  not_converged->execute();
+  BOOST_CHECK_EQUAL(not_converged->iter(), 10u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( FinalizeMPI )
+{
+  common::PE::Comm::instance().finalize();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,108 @@
+// Copyright (C) 2010-2013 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test module for cf3::common::Instrumentation"
+
+#include <sstream>
+
+#include <boost/test/unit_test.hpp>
+
+#include "common/Instrumentation.hpp"
+
+using namespace cf3;
+using namespace cf3::common;
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( InstrumentationSuite )
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( Disabled )
+{
+  Instrumentation::instance().reset();
+  {
+    ScopedRegion region("disabled_region");
+    Instrumentation::instance().add_counter("elements_looped", 10);
+  }
+
+  std::stringstream report;
+  Instrumentation::instance().print_report(report);
+  BOOST_CHECK(report.str().find("disabled_region") == std::string::npos);
+  BOOST_CHECK(report.str().find("elements_looped") == std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE( NestedRegions )
+{
+  Instrumentation::instance().reset();
+  Instrumentation::instance().enable();
+  for(Uint i = 0; i != 3; ++i)
+  {
+    ScopedRegion outer("outer");
+    {
+      ScopedRegion inner("inner");
+      ScopedTimer timer("mpi_wait");
+      Instrumentation::instance().add_counter("elements_looped", 10);
+    }
+  }
+  Instrumentation::instance().enable(false);
+
+  std::stringstream report;
+  Instrumentation::instance().print_report(report);
+  BOOST_TEST_MESSAGE(report.str());
+
+  const std::string str = report.str();
+  BOOST_CHECK(str.find("\nouter\n") != std::string::npos);
+  BOOST_CHECK(str.find("\nouter/inner\n") != std::string::npos);
+  BOOST_CHECK(str.find("\nouter\n") < str.find("\nouter/inner\n"));
+  BOOST_CHECK(str.find("mpi_wait [s]") != std::string::npos);
+  BOOST_CHECK(str.find("elements_looped") != std::string::npos);
+  BOOST_CHECK(str.find("30") != std::string::npos);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( CounterIds )
+{
+  // The same name gives the same identifier, and both ways of adding accumulate in one counter
+  const Uint id = Instrumentation::instance().counter_id("entries_inserted");
+  BOOST_CHECK_EQUAL(Instrumentation::instance().counter_id("entries_inserted"), id);
+  BOOST_CHECK(Instrumentation::instance().counter_id("other_entries") != id);
+
+  Instrumentation::instance().reset();
+  Instrumentation::instance().enable();
+  {
+    ScopedRegion region("assembly");
+    for(Uint i = 0; i != 4; ++i)
+      Instrumentation::instance().add_counter(id, 16);
+    Instrumentation::instance().add_counter("entries_inserted", 36);
+  }
+  Instrumentation::instance().add_counter(id, 7);
+  Instrumentation::instance().enable(false);
+
+  std::stringstream report;
+  Instrumentation::instance().print_report(report);
+  BOOST_TEST_MESSAGE(report.str());
+
+  const std::string str = report.str();
+  const std::size_t assembly = str.find("\nassembly\n");
+  const std::size_t root = str.find("\n<root>\n");
+  BOOST_REQUIRE(assembly != std::string::npos);
+  BOOST_REQUIRE(root != std::string::npos);
+  // Metrics outside of any region are reported first
+  BOOST_REQUIRE(root < assembly);
+  BOOST_CHECK(str.substr(root, assembly - root).find(" 7 ") != std::string::npos);
+  BOOST_CHECK(str.find(" 100 ", assembly) != std::string::npos);
+  // Counters that were never added are not reported
+  BOOST_CHECK(str.find("other_entries") == std::string::npos);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
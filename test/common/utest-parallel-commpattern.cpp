@@ -51,7 +51,7 @@ struct CommPatternFixture
   }
 
   /// function for setting up a gid & rank combo (with size of 6*nproc on each process)
-  void setupGidAndRank(std::vector<Uint>& gid, std::vector<Uint>& rank)
+  void setupGidAndRank(std::vector<Gid>& gid, std::vector<Uint>& rank)
   {
     // global indices and ranks, ordering: 0 1 2 ... 0 0 1 1 2 2 ... 0 0 0 1 1 1 2 2 2 ...
     int nproc=PE::Comm::instance().size();
@@ -167,7 +167,7 @@ BOOST_AUTO_TEST_CASE( commpattern_mainstream )
   CommPattern& pecp = *pecp_ptr;
 
   // setup gid & rank
-  std::vector<Uint> gid;
+  std::vector<Gid> gid;
   std::vector<Uint> rank;
   setupGidAndRank(gid,rank);
   const int stride=1;
@@ -57,6 +57,7 @@ struct CommWrapperFixture
 
     BOOST_CHECK_EQUAL( w1->is_data_type_Uint() , true );
     BOOST_CHECK_EQUAL( w2->is_data_type_Uint() , false );
+    BOOST_CHECK_EQUAL( w2->is_data_type_Gid() , false );
 
     BOOST_CHECK_EQUAL( w1->size() , 16 );
     BOOST_CHECK_EQUAL( w2->size() , 8 );
@@ -379,7 +380,7 @@ BOOST_AUTO_TEST_CASE( ObjectWrapperMultiArray )
 {
   int i,j;
   boost::multi_array<Uint,1> i1;
-  boost::multi_array<double,2> d2;
+  TableArray<double>::type d2;
   std::vector<int> map(4);
   i1.resize(boost::extents[16]);
   d2.resize(boost::extents[8][3]);
@@ -15,6 +15,8 @@
 #include "common/Log.hpp"
 #include "common/OptionT.hpp"
 #include "common/Group.hpp"
+#include "common/Link.hpp"
+#include "common/StringConversion.hpp"
 
 #include "common/XML/SignalOptions.hpp"
 
@@ -122,6 +124,106 @@ BOOST_AUTO_TEST_CASE( simple_signal )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+BOOST_AUTO_TEST_CASE( list_tree_changes )
+{
+  boost::shared_ptr<Group> root = allocate_component<Group>("root");
+  Group& a = *root->create_component<Group>("a");
+  a.create_component<Group>("a1");
+  Group& b = *root->create_component<Group>("b");
+
+  // the full listing gives the tree revision
+  SignalOptions list_options;
+  SignalFrame list_frame = list_options.create_frame("list_tree", "/", "/");
+  root->call_signal( "list_tree", list_frame );
+  const std::string revision = list_frame.get_reply().main_map.content.attribute_value("revision");
+  BOOST_REQUIRE( !revision.empty() );
+
+  // nothing changed
+  SignalOptions changes_options;
+  changes_options.add("revision", from_str<Uint>(revision));
+  SignalFrame changes_frame = changes_options.create_frame("list_tree_changes", "/", "/");
+  root->call_signal( "list_tree_changes", changes_frame );
+  BOOST_CHECK( is_null( changes_frame.get_reply().main_map.content.content->first_node() ) );
+
+  // only the changed subtrees are listed
+  b.create_component<Group>("b1");
+  a.remove_component("a1");
+
+  changes_frame = changes_options.create_frame("list_tree_changes", "/", "/");
+  root->call_signal( "list_tree_changes", changes_frame );
+  SignalFrame reply = changes_frame.get_reply();
+  BOOST_CHECK( from_str<Uint>(reply.main_map.content.attribute_value("revision")) > from_str<Uint>(revision) );
+
+  XmlNode root_node( reply.main_map.content.content->first_node() );
+  BOOST_REQUIRE( root_node.is_valid() );
+  BOOST_CHECK_EQUAL( root_node.attribute_value("partial"), to_str(true) );
+
+  XmlNode a_node( root_node.content->first_node() );
+  BOOST_REQUIRE( a_node.is_valid() );
+  BOOST_CHECK_EQUAL( a_node.attribute_value("name"), "a" );
+  BOOST_CHECK_EQUAL( a_node.attribute_value("partial"), to_str(true) );
+  BOOST_CHECK( is_null( a_node.content->first_node() ) ); // a1 was removed
+
+  XmlNode b_node( a_node.content->next_sibling() );
+  BOOST_REQUIRE( b_node.is_valid() );
+  BOOST_CHECK_EQUAL( b_node.attribute_value("partial"), to_str(true) );
+
+  XmlNode b1_node( b_node.content->first_node() );
+  BOOST_REQUIRE( b1_node.is_valid() );
+  BOOST_CHECK_EQUAL( b1_node.attribute_value("name"), "b1" );
+  BOOST_CHECK( b1_node.attribute_value("partial").empty() ); // new nodes are listed in full
+  BOOST_CHECK( b1_node.attribute_value("unchanged").empty() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( list_tree_changes_relink )
+{
+  boost::shared_ptr<Group> root = allocate_component<Group>("root");
+  Group& a = *root->create_component<Group>("a");
+  Group& b = *root->create_component<Group>("b");
+  Link& lnk = *root->create_component<Link>("lnk");
+  lnk.link_to(a);
+
+  SignalOptions list_options;
+  SignalFrame list_frame = list_options.create_frame("list_tree", "/", "/");
+  root->call_signal( "list_tree", list_frame );
+  const std::string revision = list_frame.get_reply().main_map.content.attribute_value("revision");
+  BOOST_REQUIRE( !revision.empty() );
+
+  // changing the target of the link is a change of its entry
+  lnk.link_to(b);
+
+  SignalOptions changes_options;
+  changes_options.add("revision", from_str<Uint>(revision));
+  SignalFrame changes_frame = changes_options.create_frame("list_tree_changes", "/", "/");
+  root->call_signal( "list_tree_changes", changes_frame );
+  SignalFrame reply = changes_frame.get_reply();
+  BOOST_CHECK( from_str<Uint>(reply.main_map.content.attribute_value("revision")) > from_str<Uint>(revision) );
+
+  XmlNode root_node( reply.main_map.content.content->first_node() );
+  BOOST_REQUIRE( root_node.is_valid() );
+  BOOST_CHECK_EQUAL( root_node.attribute_value("partial"), to_str(true) );
+
+  XmlNode a_node( root_node.content->first_node() );
+  BOOST_REQUIRE( a_node.is_valid() );
+  BOOST_CHECK_EQUAL( a_node.attribute_value("unchanged"), to_str(true) );
+
+  XmlNode b_node( a_node.content->next_sibling() );
+  BOOST_REQUIRE( b_node.is_valid() );
+  BOOST_CHECK_EQUAL( b_node.attribute_value("unchanged"), to_str(true) );
+
+  // the link is listed in full, with its new target
+  XmlNode lnk_node( b_node.content->next_sibling() );
+  BOOST_REQUIRE( lnk_node.is_valid() );
+  BOOST_CHECK_EQUAL( lnk_node.attribute_value("name"), "lnk" );
+  BOOST_CHECK( lnk_node.attribute_value("unchanged").empty() );
+  BOOST_CHECK( lnk_node.attribute_value("partial").empty() );
+  BOOST_CHECK_EQUAL( std::string(lnk_node.content->value()), b.uri().string() );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 BOOST_AUTO_TEST_SUITE_END()
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,154 @@
+// Copyright (C) 2010-2013 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test module for binary payloads in XML signals"
+
+#include <cstring>
+
+#include <boost/test/unit_test.hpp>
+
+#include "rapidxml/rapidxml.hpp"
+
+#include "common/BasicExceptions.hpp"
+#include "common/Core.hpp"
+#include "common/Environment.hpp"
+#include "common/OptionList.hpp"
+
+#include "common/XML/BinaryPayload.hpp"
+#include "common/XML/FileOperations.hpp"
+#include "common/XML/MultiArray.hpp"
+#include "common/XML/Protocol.hpp"
+#include "common/XML/SignalFrame.hpp"
+
+using namespace cf3;
+using namespace cf3::common;
+using namespace cf3::common::XML;
+
+/////////////////////////////////////////////////////////////////////////////
+
+struct BinaryPayloadFixture
+{
+  BinaryPayloadFixture()
+  {
+    Core::instance().environment().options().set("exception_backtrace", false);
+    Core::instance().environment().options().set("exception_outputs", false);
+
+    // bytes including null characters, which cannot be sent as XML text
+    for(Uint i = 0 ; i < 1000 ; ++i)
+      bytes.push_back( static_cast<char>(i % 7) );
+  }
+
+  std::vector<char> bytes;
+};
+
+BOOST_FIXTURE_TEST_SUITE( BinaryPayload_TestSuite, BinaryPayloadFixture )
+
+/////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE ( frame_round_trip )
+{
+  SignalFrame frame( "target", "cpath:/sender", "cpath:/receiver" );
+  add_binary_payload( frame.node, &bytes[0], bytes.size() );
+  add_binary_payload( frame.node, &bytes[0], 10, true );
+
+  std::string str;
+  to_frame( *frame.xml_doc, str );
+
+  // the payloads follow the XML text
+  BOOST_CHECK( std::strlen( str.c_str() ) + 1 + bytes.size() < str.size() );
+
+  SignalFrame parsed( parse_frame( str.data(), str.size() ) );
+  XmlNode payload( parsed.node.content->first_node( Protocol::Tags::node_binary() ) );
+  BOOST_REQUIRE( payload.is_valid() );
+
+  std::vector<char> data;
+  get_binary_payload( payload, data );
+  BOOST_CHECK( data == bytes );
+
+  payload.content = payload.content->next_sibling( Protocol::Tags::node_binary() );
+  BOOST_REQUIRE( payload.is_valid() );
+  get_binary_payload( payload, data );
+  BOOST_CHECK( data == std::vector<char>( bytes.begin(), bytes.begin() + 10 ) );
+
+  // the payloads of the original frame are left untouched
+  get_binary_payload( XmlNode( frame.node.content->first_node( Protocol::Tags::node_binary() ) ), data );
+  BOOST_CHECK( data == bytes );
+
+  // plain XML is a valid frame
+  SignalFrame plain_frame( "target", "cpath:/sender", "cpath:/receiver" );
+  to_string( *plain_frame.xml_doc, str );
+  boost::shared_ptr<XmlDoc> doc = parse_frame( str.c_str(), str.size() + 1 );
+  BOOST_CHECK( doc->content->first_node() != nullptr );
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE ( truncated_frame )
+{
+  SignalFrame frame( "target", "cpath:/sender", "cpath:/receiver" );
+  add_binary_payload( frame.node, &bytes[0], bytes.size() );
+
+  std::string str;
+  to_frame( *frame.xml_doc, str );
+
+  BOOST_CHECK_THROW( parse_frame( str.data(), str.size() - 1 ), XmlError );
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE ( deep_copy )
+{
+  SignalFrame frame( "target", "cpath:/sender", "cpath:/receiver" );
+  add_binary_payload( frame.node, &bytes[0], bytes.size() );
+
+  XmlDoc doc;
+  XmlNode copy = doc.add_node( "copy" );
+  frame.node.deep_copy( copy );
+
+  std::vector<char> data;
+  get_binary_payload( XmlNode( copy.content->first_node( Protocol::Tags::node_binary() ) ), data );
+  BOOST_CHECK( data == bytes );
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE ( binary_multi_array )
+{
+  boost::multi_array<Real, 2> array( boost::extents[50][3] );
+  for(Uint row = 0 ; row < 50 ; ++row)
+    for(Uint col = 0 ; col < 3 ; ++col)
+      array[row][col] = 1. / ( 1. + row + 0.1 * col );
+
+  std::vector<std::string> labels;
+  labels.push_back("x");
+  labels.push_back("y");
+  labels.push_back("z");
+
+  SignalFrame frame( "target", "cpath:/sender", "cpath:/receiver" );
+  SignalFrame& options = frame.map( Protocol::Tags::key_options() );
+  add_multi_array_in( options.main_map, "Table", array, ";", labels, true );
+
+  std::string str;
+  to_frame( *frame.xml_doc, str );
+
+  SignalFrame parsed( parse_frame( str.data(), str.size() ) );
+  SignalFrame& parsed_options = parsed.map( Protocol::Tags::key_options() );
+
+  boost::multi_array<Real, 2> result;
+  std::vector<std::string> result_labels;
+  get_multi_array( parsed_options.main_map, "Table", result, result_labels );
+
+  // values are exact, since they are not converted to text
+  BOOST_CHECK( result == array );
+  BOOST_CHECK( result_labels == labels );
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////
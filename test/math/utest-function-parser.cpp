@@ -11,6 +11,8 @@
 
 #include <boost/assign/list_of.hpp>
 
+#include "common/Table.hpp"
+
 #include "math/VectorialFunction.hpp"
 
 using namespace std;
@@ -81,7 +83,49 @@ BOOST_AUTO_TEST_CASE( function_2 )
 
 }
 
+BOOST_AUTO_TEST_CASE( evaluate_batch )
+{
+  cf3::math::VectorialFunction f ("[x+y][2*pi*z][3*4]","x,y,z");
+
+  boost::shared_ptr< Table<Real> > vars = allocate_component< Table<Real> >("vars");
+  boost::shared_ptr< Table<Real> > values = allocate_component< Table<Real> >("values");
+  vars->set_row_size(3);
+  vars->resize(100);
+  for(Uint pt = 0; pt != vars->size(); ++pt)
+  {
+    (*vars)[pt][0] = pt;
+    (*vars)[pt][1] = 0.5*pt;
+    (*vars)[pt][2] = 1./(1.+pt);
+  }
+
+  f.evaluate_batch(*vars, *values);
+
+  BOOST_CHECK_EQUAL( values->size(), 100u );
+  BOOST_CHECK_EQUAL( values->row_size(), 3u );
+  RealVector r(3);
+  for(Uint pt = 0; pt != vars->size(); ++pt)
+  {
+    const cf3::math::VectorialFunction::VariablesT u = boost::assign::list_of((*vars)[pt][0])((*vars)[pt][1])((*vars)[pt][2]);
+    r = f(u);
+    for(Uint i = 0; i != 3; ++i)
+      BOOST_CHECK_EQUAL( (*values)[pt][i], r[i] );
+  }
+
+  // the number of variables must match
+  vars->set_row_size(2);
+  BOOST_CHECK_THROW( f.evaluate_batch(*vars, *values), BadValue );
+}
+
+BOOST_AUTO_TEST_CASE( depends_on )
+{
+  cf3::math::VectorialFunction f ("[x+xt][sin(t)*y]","x,y,t,xt");
 
+  BOOST_CHECK( f.depends_on("x") );
+  BOOST_CHECK( f.depends_on("t") );
+  BOOST_CHECK( !f.depends_on("t", 0) ); // only as part of xt
+  BOOST_CHECK( f.depends_on("t", 1) );
+  BOOST_CHECK( !f.depends_on("y", 0) );
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -113,7 +113,7 @@ struct LSSAtomicFixture
   char** m_argv;
 
   /// commpattern builds
-  std::vector<Uint> gid;
+  std::vector<Gid> gid;
   std::vector<Uint> rank_updatable;
 
   /// system builds
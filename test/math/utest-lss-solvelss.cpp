@@ -7,10 +7,14 @@
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MODULE "Test module for the SolveLSS action"
 
+#include <cmath>
+
 #include <boost/assign/std/vector.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include "common/Builder.hpp"
 #include "common/Core.hpp"
+#include "common/OptionList.hpp"
 
 #include "common/PE/CommPattern.hpp"
 #include "common/PE/CommWrapper.hpp"
@@ -18,6 +22,8 @@
 #include "math/MatrixTypes.hpp"
 #include "math/LSS/SolveLSS.hpp"
 #include "math/LSS/System.hpp"
+#include "math/LSS/EmptyLSS/EmptyLSSVector.hpp"
+#include "math/LSS/EmptyLSS/EmptyStrategy.hpp"
 
 using namespace boost::assign;
 
@@ -26,6 +32,125 @@ using namespace cf3::common;
 using namespace cf3::common::PE;
 using namespace cf3::math;
 
+////////////////////////////////////////////////////////////////////////////////
+
+typedef boost::multi_array<Real, 2> VectorDataT;
+
+/// Vector that stores its values, used to check the initial guess without a real solver
+class StoredTestVector : public LSS::EmptyLSSVector
+{
+public:
+  StoredTestVector(const std::string& name) : LSS::EmptyLSSVector(name)
+  {
+  }
+
+  static std::string type_name () { return "StoredTestVector"; }
+
+  void reset(Real reset_to=0.)
+  {
+    m_data.resize(boost::extents[blockrow_size()][neq()]);
+    std::fill(m_data.data(), m_data.data() + m_data.num_elements(), reset_to);
+  }
+
+  void get(VectorDataT& data)
+  {
+    if(m_data.num_elements() == 0)
+      reset();
+    data = m_data;
+  }
+
+  void set(VectorDataT& data)
+  {
+    m_data.resize(boost::extents[data.shape()[0]][data.shape()[1]]);
+    m_data = data;
+  }
+
+private:
+  VectorDataT m_data;
+};
+
+common::ComponentBuilder<StoredTestVector, LSS::Vector, LSS::LibLSS> StoredTestVector_builder;
+
+/// Solves a system with a diagonal matrix exactly, recording the initial guess it was given
+class DiagonalTestStrategy : public LSS::EmptyStrategy
+{
+public:
+  DiagonalTestStrategy(const std::string& name) : LSS::EmptyStrategy(name)
+  {
+  }
+
+  static std::string type_name () { return "DiagonalTestStrategy"; }
+
+  /// Diagonal of the matrix
+  static Real diagonal(const Uint i, const Uint j)
+  {
+    return 1. + i + 0.5*j;
+  }
+
+  void set_rhs(const Handle<LSS::Vector>& rhs) { m_rhs = rhs; }
+  void set_solution(const Handle<LSS::Vector>& solution) { m_solution = solution; }
+
+  void solve()
+  {
+    VectorDataT rhs(boost::extents[m_rhs->blockrow_size()][m_rhs->neq()]);
+    m_rhs->get(rhs);
+    initial_guess.resize(boost::extents[rhs.shape()[0]][rhs.shape()[1]]);
+    m_solution->get(initial_guess);
+
+    for(Uint i = 0; i != rhs.shape()[0]; ++i)
+      for(Uint j = 0; j != rhs.shape()[1]; ++j)
+        rhs[i][j] /= diagonal(i, j);
+    m_solution->set(rhs);
+  }
+
+  /// Contents of the solution vector at the start of the last solve
+  VectorDataT initial_guess;
+
+private:
+  Handle<LSS::Vector> m_rhs;
+  Handle<LSS::Vector> m_solution;
+};
+
+common::ComponentBuilder<DiagonalTestStrategy, LSS::SolutionStrategy, LSS::LibLSS> DiagonalTestStrategy_builder;
+
+/// Set the RHS so the solution of the diagonal test system is the given vector
+void set_solution(LSS::System& lss, const VectorDataT& solution)
+{
+  VectorDataT rhs(solution);
+  for(Uint i = 0; i != rhs.shape()[0]; ++i)
+    for(Uint j = 0; j != rhs.shape()[1]; ++j)
+      rhs[i][j] *= DiagonalTestStrategy::diagonal(i, j);
+  lss.rhs()->set(rhs);
+}
+
+/// Create a system with the diagonal test strategy. The comm pattern refers to gid, which must outlive it.
+void create_diagonal_system(LSS::System& lss, CommPattern& cp, std::vector<Gid>& gid)
+{
+  std::vector<Uint> conn, startidx, rnk;
+  gid += 0,1,2,3,4,5,6,7,8,9;
+  rnk += 0,0,0,0,0,0,0,0,0,0;
+  conn += 0,2,1,2,2,7,3,8,4,5,5,2,6,0,7,1,8,7,9,8;
+  startidx += 0,2,4,6,8,10,12,14,16,18,20;
+  cp.insert("gid",gid,1,false);
+  cp.setup(cp.get_child("gid")->handle<common::PE::CommWrapper>(),rnk);
+
+  lss.options().set("matrix_builder", std::string("cf3.math.LSS.EmptyLSSMatrix"));
+  lss.options().set("vector_builder", std::string("cf3.math.LSS.StoredTestVector"));
+  lss.options().set("solution_strategy", std::string("cf3.math.LSS.DiagonalTestStrategy"));
+  lss.create(cp, 2u, conn, startidx);
+}
+
+void check_close(const VectorDataT& a, const VectorDataT& b)
+{
+  BOOST_REQUIRE_EQUAL(a.shape()[0], b.shape()[0]);
+  BOOST_REQUIRE_EQUAL(a.shape()[1], b.shape()[1]);
+  for(Uint i = 0; i != a.shape()[0]; ++i)
+    for(Uint j = 0; j != a.shape()[1]; ++j)
+      BOOST_CHECK_CLOSE(a[i][j], b[i][j], 1e-8);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 BOOST_AUTO_TEST_SUITE( SolveSystemSuite )
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -39,7 +164,8 @@ BOOST_AUTO_TEST_CASE( TestSolveSystem )
   Handle<LSS::System> lss = root.create_component<LSS::System>("LSS");
   CommPattern& cp = *root.create_component<CommPattern>("commpattern");
 
-  std::vector<Uint> gid, conn, startidx, rnk;
+  std::vector<Gid> gid;
+  std::vector<Uint> conn, startidx, rnk;
   gid += 0,1,2,3,4,5,6,7,8,9;
   rnk += 0,0,0,0,0,0,0,0,0,0;
   conn += 0,2,1,2,2,7,3,8,4,5,5,2,6,0,7,1,8,7,9,8;
@@ -57,6 +183,144 @@ BOOST_AUTO_TEST_CASE( TestSolveSystem )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+BOOST_AUTO_TEST_CASE( TestInitialGuess )
+{
+  Component& root = Core::instance().root();
+  LSS::SolveLSS& solve_action = *Handle<LSS::SolveLSS>(root.get_child("solve_action"));
+
+  // Run a few solves in each mode, more than the number of stored solutions
+  solve_action.options().set("nb_previous_solutions", 2u);
+
+  solve_action.options().set("initial_guess", std::string("extrapolation"));
+  for(Uint i = 0; i != 4; ++i)
+    solve_action.execute();
+
+  solve_action.options().set("initial_guess", std::string("projection"));
+  for(Uint i = 0; i != 4; ++i)
+    solve_action.execute();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( TestExtrapolation )
+{
+  Component& root = Core::instance().root();
+  LSS::SolveLSS& solve_action = *root.create_component<LSS::SolveLSS>("extrapolation_action");
+  Handle<LSS::System> lss = root.create_component<LSS::System>("ExtrapolationLSS");
+  CommPattern& cp = *root.create_component<CommPattern>("extrapolation_commpattern");
+  std::vector<Gid> gid;
+  create_diagonal_system(*lss, cp, gid);
+  DiagonalTestStrategy& strategy = dynamic_cast<DiagonalTestStrategy&>(*lss->solution_strategy());
+
+  solve_action.options().set("lss", lss);
+  solve_action.options().set("initial_guess", std::string("extrapolation"));
+  solve_action.options().set("nb_previous_solutions", 2u);
+
+  // Solution that is linear in time, so linear extrapolation from the last two solutions is exact
+  const Uint nb_rows = lss->solution()->blockrow_size();
+  VectorDataT solution(boost::extents[nb_rows][2]);
+  for(Uint step = 0; step != 5; ++step)
+  {
+    for(Uint i = 0; i != nb_rows; ++i)
+      for(Uint j = 0; j != 2; ++j)
+        solution[i][j] = 3. + i - 2.*j + (0.5 + 0.1*i) * step;
+
+    set_solution(*lss, solution);
+    solve_action.execute();
+    if(step > 1)
+      check_close(strategy.initial_guess, solution);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( TestProjection )
+{
+  Component& root = Core::instance().root();
+  LSS::SolveLSS& solve_action = *root.create_component<LSS::SolveLSS>("projection_action");
+  Handle<LSS::System> lss = root.create_component<LSS::System>("ProjectionLSS");
+  CommPattern& cp = *root.create_component<CommPattern>("projection_commpattern");
+  std::vector<Gid> gid;
+  create_diagonal_system(*lss, cp, gid);
+  DiagonalTestStrategy& strategy = dynamic_cast<DiagonalTestStrategy&>(*lss->solution_strategy());
+
+  solve_action.options().set("lss", lss);
+  solve_action.options().set("initial_guess", std::string("projection"));
+  solve_action.options().set("nb_previous_solutions", 3u);
+
+  const Uint nb_rows = lss->solution()->blockrow_size();
+  VectorDataT solution1(boost::extents[nb_rows][2]), solution2(boost::extents[nb_rows][2]), combined(boost::extents[nb_rows][2]);
+  for(Uint i = 0; i != nb_rows; ++i)
+  {
+    for(Uint j = 0; j != 2; ++j)
+    {
+      solution1[i][j] = 1. + i + j;
+      solution2[i][j] = std::sin(1. + i) - j;
+      combined[i][j] = 2.*solution1[i][j] - 3.*solution2[i][j];
+    }
+  }
+
+  set_solution(*lss, solution1);
+  solve_action.execute();
+
+  // A repeated RHS gives the exact solution as initial guess
+  set_solution(*lss, solution1);
+  solve_action.execute();
+  check_close(strategy.initial_guess, solution1);
+
+  set_solution(*lss, solution2);
+  solve_action.execute();
+
+  // The same holds for any RHS in the span of the previous ones
+  set_solution(*lss, combined);
+  solve_action.execute();
+  check_close(strategy.initial_guess, combined);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( TestMultipleRHS )
+{
+  Component& root = Core::instance().root();
+  Handle<LSS::System> lss = root.create_component<LSS::System>("MultiRHSLSS");
+  CommPattern& cp = *root.create_component<CommPattern>("multi_rhs_commpattern");
+
+  std::vector<Gid> gid;
+  std::vector<Uint> conn, startidx, rnk;
+  gid += 0,1,2,3;
+  rnk += 0,0,0,0;
+  conn += 0,1,0,1,2,1,2,3,2,3;
+  startidx += 0,2,5,8,10;
+  cp.insert("gid",gid,1,false);
+  cp.setup(cp.get_child("gid")->handle<common::PE::CommWrapper>(),rnk);
+
+  lss->options().set("matrix_builder", std::string("cf3.math.LSS.EmptyLSSMatrix"));
+  lss->options().set("solution_strategy", std::string("cf3.math.LSS.EmptyStrategy"));
+  lss->create(cp, 2u, conn, startidx);
+
+  std::vector< Handle<LSS::Vector> > rhs, solutions;
+  rhs.push_back(lss->rhs());
+  solutions.push_back(lss->solution());
+  rhs.push_back(lss->create_vector("ExtraRHS"));
+  solutions.push_back(lss->create_vector("ExtraSolution"));
+
+  BOOST_CHECK_EQUAL(rhs.back()->neq(), 2u);
+  BOOST_CHECK_EQUAL(rhs.back()->blockrow_size(), lss->rhs()->blockrow_size());
+  BOOST_CHECK_EQUAL(solutions.back()->solvertype(), lss->solution()->solvertype());
+
+  lss->solve(rhs, solutions);
+
+  solutions.pop_back();
+  BOOST_CHECK_THROW(lss->solve(rhs, solutions), BadValue);
+
+  // Extra vectors go away with the system
+  lss->destroy();
+  BOOST_CHECK(is_null(lss->get_child("ExtraRHS")));
+  BOOST_CHECK(is_null(lss->get_child("ExtraSolution")));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 BOOST_AUTO_TEST_SUITE_END()
 
 ////////////////////////////////////////////////////////////////////////////////
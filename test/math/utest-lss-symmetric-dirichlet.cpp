@@ -113,7 +113,7 @@ struct LSSSymmetricDirichletFixture
   char** m_argv;
 
   /// commpattern builds
-  std::vector<Uint> gid;
+  std::vector<Gid> gid;
   std::vector<Uint> rank_updatable;
 
   /// system builds
@@ -209,6 +209,72 @@ BOOST_AUTO_TEST_CASE( test_complete_system )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+BOOST_AUTO_TEST_CASE( test_batched_dirichlet )
+{
+  // same as above, using the batched version through the system
+  boost::shared_ptr<common::PE::CommPattern> cp_ptr = common::allocate_component<common::PE::CommPattern>("commpattern");
+  common::PE::CommPattern& cp = *cp_ptr;
+  build_commpattern(cp);
+  boost::shared_ptr<LSS::System> sys(common::allocate_component<LSS::System>("sys"));
+  sys->options().option("matrix_builder").change_value(matrix_builder);
+  build_system(*sys,cp);
+
+  sys->matrix()->set_row(0, 0, 2, 1);
+  sys->matrix()->set_row(1, 0, 2, 1);
+  sys->matrix()->set_row(2, 0, 2, 1);
+
+  std::vector<Uint> bc_rows(1, irank == 0 ? 1 : 0);
+  std::vector<Uint> bc_eqs(1, 0);
+  std::vector<Real> bc_values(1, 10.);
+  sys->dirichlet(bc_rows, bc_eqs, bc_values, true);
+
+  Real val;
+  if(irank == 0)
+  {
+    sys->matrix()->get_value(0, 0, val);
+    BOOST_CHECK_EQUAL(val, 2.);
+    sys->matrix()->get_value(1, 0, val);
+    BOOST_CHECK_EQUAL(val, 0.);
+    sys->matrix()->get_value(0, 1, val);
+    BOOST_CHECK_EQUAL(val, 0.);
+    sys->matrix()->get_value(1, 1, val);
+    BOOST_CHECK_EQUAL(val, 1.);
+    sys->matrix()->get_value(2, 1, val);
+    BOOST_CHECK_EQUAL(val, 0.);
+
+    sys->rhs()->get_value(0, val);
+    BOOST_CHECK_EQUAL(val, -10.);
+    sys->rhs()->get_value(1, val);
+    BOOST_CHECK_EQUAL(val, 10.);
+    sys->solution()->get_value(1, val);
+    BOOST_CHECK_EQUAL(val, 10.);
+  }
+  else
+  {
+    sys->matrix()->get_value(0, 1, val);
+    BOOST_CHECK_EQUAL(val, 0.);
+    sys->matrix()->get_value(1, 1, val);
+    BOOST_CHECK_EQUAL(val, 2.);
+    sys->matrix()->get_value(2, 1, val);
+    BOOST_CHECK_EQUAL(val, 1.);
+    sys->matrix()->get_value(1, 2, val);
+    BOOST_CHECK_EQUAL(val, 1.);
+    sys->matrix()->get_value(2, 2, val);
+    BOOST_CHECK_EQUAL(val, 2.);
+
+    sys->rhs()->get_value(0, val);
+    BOOST_CHECK_EQUAL(val, 10.);
+    sys->rhs()->get_value(1, val);
+    BOOST_CHECK_EQUAL(val, -10.);
+    sys->rhs()->get_value(2, val);
+    BOOST_CHECK_EQUAL(val, 0.);
+    sys->solution()->get_value(0, val);
+    BOOST_CHECK_EQUAL(val, 10.);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 BOOST_AUTO_TEST_CASE( finalize_mpi )
 {
   CFinfo.setFilterRankZero(true);
@@ -53,7 +53,7 @@ struct LSSSystem_EmptyLSSFixture
     cp->insert("gid",gid,1,false);
     cp->setup(Handle<common::PE::CommWrapper>(cp->get_child("gid")),rnk);
   }
-  std::vector<Uint> gid;
+  std::vector<Gid> gid;
   std::vector<Uint> conn;
   std::vector<Uint> startidx;
   std::vector<Uint> rnk;
@@ -195,6 +195,15 @@ BOOST_AUTO_TEST_CASE( check_emptylss_implementations )
   BOOST_TEST_CHECKPOINT( "dirichlet" );
   sys->dirichlet(0,0,0.,true);
 
+  BOOST_TEST_CHECKPOINT( "batched dirichlet" );
+  std::vector<Uint> bc_rows(2,0), bc_eqs(2,0);
+  bc_eqs[1]=1;
+  std::vector<Real> bc_values(2,0.);
+  sys->dirichlet(bc_rows,bc_eqs,bc_values,true);
+  sys->dirichlet(bc_rows,bc_eqs,bc_values,false);
+  bc_values.resize(1);
+  BOOST_CHECK_THROW(sys->dirichlet(bc_rows,bc_eqs,bc_values,true),common::BadValue);
+
   BOOST_TEST_CHECKPOINT( "periodicity" );
   sys->periodicity (0,0);
 
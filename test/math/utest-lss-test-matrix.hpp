@@ -748,7 +748,7 @@ class test_matrix {
     std::vector<cf3::Uint> rowstart_positions;
 
     /// global numbering of the nodes (without extension by nbeqs sub-matrix)
-    std::vector<cf3::Uint> global_numbering;
+    std::vector<cf3::Gid> global_numbering;
 
     /// rank where the node is updatable (without extension by nbeqs sub-matrix)
     std::vector<cf3::Uint> irank_updatable;
@@ -0,0 +1,243 @@
+// Copyright (C) 2010-2013 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+//
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test module for the Trilinos solution strategies, solving a Poisson problem"
+
+////////////////////////////////////////////////////////////////////////////////
+
+#include <boost/test/unit_test.hpp>
+#include <boost/assign/std/vector.hpp>
+
+#include "common/Core.hpp"
+#include "common/Environment.hpp"
+#include "common/Log.hpp"
+#include "common/OptionList.hpp"
+
+#include "common/PE/Comm.hpp"
+#include "common/PE/CommPattern.hpp"
+
+#include "math/LSS/System.hpp"
+#include "math/LSS/SolutionStrategy.hpp"
+#include "math/VariablesDescriptor.hpp"
+
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace boost::assign;
+
+using namespace cf3;
+using namespace cf3::math;
+using namespace cf3::math::LSS;
+
+////////////////////////////////////////////////////////////////////////////////
+
+/// Solves the 1D Poisson problem -u'' = 0 on 10 nodes, distributed over 2 processes, for 2 uncoupled variables.
+/// The first and last node have a Dirichlet condition, so the exact solution is linear.
+struct StrategyFixture
+{
+  StrategyFixture() :
+    irank(0),
+    nproc(1)
+  {
+    if (common::PE::Comm::instance().is_initialized())
+    {
+      nproc=common::PE::Comm::instance().size();
+      irank=common::PE::Comm::instance().rank();
+      BOOST_CHECK_EQUAL(nproc,2);
+    }
+    m_argc = boost::unit_test::framework::master_test_suite().argc;
+    m_argv = boost::unit_test::framework::master_test_suite().argv;
+
+    if(m_argc != 2)
+      throw common::ParsingFailed(FromHere(), "Failed to parse command line arguments: expected one argument: builder name for the solution strategy");
+    strategy_builder = m_argv[1];
+
+    // same node distribution as the solve_system test of utest-lss-atomic
+    if (irank==0)
+    {
+      gid += 0,1,2,3,4;
+      rank_updatable += 0,0,0,0,1;
+      node_connectivity += 0,1,0,1,2,1,2,3,2,3,4,3,4;
+      starting_indices += 0,2,5,8,11,13;
+    } else {
+      gid += 3,4,5,6,7,8,9;
+      rank_updatable += 0,1,1,1,1,1,1;
+      node_connectivity += 0,1,0,1,2,1,2,3,2,3,4,3,4,5,4,5,6,5,6;
+      starting_indices +=  0,2,5,8,11,14,17,19;
+    }
+  }
+
+  void build_system()
+  {
+    cp = common::allocate_component<common::PE::CommPattern>("commpattern");
+    cp->insert("gid",gid,1,false);
+    cp->setup(Handle<common::PE::CommWrapper>(cp->get_child("gid")),rank_updatable);
+
+    vars = common::allocate_component<math::VariablesDescriptor>("vars");
+    vars->options().set("dimension", 1u);
+    vars->push_back("u", cf3::math::VariablesDescriptor::Dimensionalities::SCALAR);
+    vars->push_back("v", cf3::math::VariablesDescriptor::Dimensionalities::SCALAR);
+
+    sys = common::allocate_component<System>("sys");
+    sys->options().set("matrix_builder", std::string("cf3.math.LSS.TrilinosCrsMatrix"));
+    sys->options().set("solution_strategy", strategy_builder);
+    sys->create_blocked(*cp,*vars,node_connectivity,starting_indices);
+
+    // one block per variable, so the two uncoupled equations are solved by the sub-block inverses
+    if(strategy_builder == "cf3.math.LSS.BlockPreconditionerStrategy")
+    {
+      std::vector<Uint> vars_per_block;
+      vars_per_block += 1,1;
+      sys->solution_strategy()->options().set("vars_per_block", vars_per_block);
+      sys->solution_strategy()->options().set("block_preconditioner", std::string("Block Gauss-Seidel"));
+    }
+  }
+
+  /// Fill the Laplacian in the rows owned by this process, and apply the boundary conditions
+  void assemble(const Real left, const Real right)
+  {
+    sys->reset(0.);
+    for (Uint i=0; i<gid.size(); ++i)
+    {
+      if (!cp->isUpdatable()[i])
+        continue;
+      for (Uint j=starting_indices[i]; j<starting_indices[i+1]; ++j)
+      {
+        const Uint node = node_connectivity[j];
+        for (Uint eq=0; eq<neq; ++eq)
+          sys->matrix()->set_value(node*neq+eq, i*neq+eq, node == i ? 2. : -1.);
+      }
+    }
+
+    for (Uint eq=0; eq<neq; ++eq)
+    {
+      if (irank==0)
+        sys->dirichlet(0,eq,(eq+1)*left);
+      else
+        sys->dirichlet(6,eq,(eq+1)*right);
+    }
+  }
+
+  /// Check a solution of the problem assembled with the given boundary values
+  void check_solution(LSS::Vector& solution, const Real left, const Real right)
+  {
+    for (Uint i=0; i<gid.size(); ++i)
+    {
+      if (!cp->isUpdatable()[i])
+        continue;
+      for (Uint eq=0; eq<neq; ++eq)
+      {
+        Real value;
+        solution.get_value(i,eq,value);
+        const Real exact = (eq+1) * (left + (right-left)*static_cast<Real>(gid[i])/9.);
+        BOOST_CHECK_CLOSE(value, exact, 1e-4);
+      }
+    }
+  }
+
+  int irank;
+  int nproc;
+  int m_argc;
+  char** m_argv;
+  std::string strategy_builder;
+
+  static const Uint neq = 2;
+
+  std::vector<Gid> gid;
+  std::vector<Uint> rank_updatable;
+  std::vector<Uint> node_connectivity;
+  std::vector<Uint> starting_indices;
+
+  static boost::shared_ptr<common::PE::CommPattern> cp;
+  static boost::shared_ptr<math::VariablesDescriptor> vars;
+  static boost::shared_ptr<System> sys;
+};
+
+boost::shared_ptr<common::PE::CommPattern> StrategyFixture::cp;
+boost::shared_ptr<math::VariablesDescriptor> StrategyFixture::vars;
+boost::shared_ptr<System> StrategyFixture::sys;
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( TrilinosStrategiesSuite, StrategyFixture )
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( init_mpi )
+{
+  common::PE::Comm::instance().init(m_argc,m_argv);
+  BOOST_CHECK_EQUAL(common::PE::Comm::instance().is_active(),true);
+  common::Core::instance().environment().options().set("exception_backtrace", false);
+  common::Core::instance().environment().options().set("exception_outputs", false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( solve_poisson )
+{
+  build_system();
+  BOOST_CHECK_EQUAL(sys->solution_strategy()->derived_type_name(), strategy_builder.substr(strategy_builder.rfind('.')+1));
+
+  assemble(1., 10.);
+  sys->solve();
+  check_solution(*sys->solution(), 1., 10.);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( solve_again )
+{
+  // new matrix values and right hand side, reusing the setup from the first solve
+  assemble(-1., 4.);
+  sys->solve();
+  check_solution(*sys->solution(), -1., 4.);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( solve_multiple_rhs )
+{
+  assemble(3., 1.);
+
+  // the second right hand side has the boundary values swapped
+  Handle<LSS::Vector> extra_rhs = sys->create_vector("ExtraRHS");
+  Handle<LSS::Vector> extra_solution = sys->create_vector("ExtraSolution");
+  for (Uint eq=0; eq<neq; ++eq)
+  {
+    if (irank==0)
+      extra_rhs->set_value(0,eq,(eq+1)*1.);
+    else
+      extra_rhs->set_value(6,eq,(eq+1)*3.);
+  }
+
+  std::vector< Handle<LSS::Vector> > rhs, solutions;
+  rhs.push_back(sys->rhs());
+  solutions.push_back(sys->solution());
+  rhs.push_back(extra_rhs);
+  solutions.push_back(extra_solution);
+
+  sys->solve(rhs, solutions);
+  check_solution(*sys->solution(), 3., 1.);
+  check_solution(*extra_solution, 1., 3.);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( finalize_mpi )
+{
+  sys.reset();
+  vars.reset();
+  cp.reset();
+  common::PE::Comm::instance().finalize();
+  BOOST_CHECK_EQUAL(common::PE::Comm::instance().is_active(),false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,132 @@
+// Copyright (C) 2010-2013 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Tests mesh::actions::Refine"
+
+#include <cmath>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/assign/list_of.hpp>
+
+#include "common/Log.hpp"
+#include "common/OptionList.hpp"
+#include "common/Core.hpp"
+#include "common/FindComponents.hpp"
+#include "common/Foreach.hpp"
+#include "common/List.hpp"
+#include "common/PE/Comm.hpp"
+
+#include "mesh/actions/Refine.hpp"
+
+#include "mesh/Cells.hpp"
+#include "mesh/Dictionary.hpp"
+#include "mesh/Field.hpp"
+#include "mesh/Mesh.hpp"
+#include "mesh/Region.hpp"
+#include "mesh/SimpleMeshGenerator.hpp"
+
+using namespace cf3;
+using namespace cf3::common;
+using namespace cf3::mesh;
+using namespace cf3::mesh::actions;
+using namespace boost::assign;
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct TestRefine_Fixture
+{
+  /// common setup for each test case
+  TestRefine_Fixture()
+  {
+    m_argc = boost::unit_test::framework::master_test_suite().argc;
+    m_argv = boost::unit_test::framework::master_test_suite().argv;
+  }
+
+  /// Number of nodes and cells owned by all ranks
+  void count_owned(const Mesh& mesh, Uint& nb_nodes, Uint& nb_cells)
+  {
+    Uint owned[2] = {0,0};
+    const Dictionary& geometry = mesh.geometry_fields();
+    for (Uint n=0; n<geometry.size(); ++n)
+    {
+      if (!geometry.is_ghost(n))
+        ++owned[0];
+    }
+    boost_foreach(const Cells& cells, find_components_recursively<Cells>(mesh.topology()))
+    {
+      for (Uint e=0; e<cells.size(); ++e)
+      {
+        if (cells.rank()[e] == PE::Comm::instance().rank())
+          ++owned[1];
+      }
+    }
+    PE::Comm::instance().all_reduce(PE::plus(),owned,2,owned);
+    nb_nodes = owned[0];
+    nb_cells = owned[1];
+  }
+
+  int m_argc;
+  char** m_argv;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( TestRefine_TestSuite, TestRefine_Fixture )
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( Init )
+{
+  Core::instance().initiate(m_argc,m_argv);
+  PE::Comm::instance().init(m_argc,m_argv);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( refine_quads )
+{
+  Handle<MeshGenerator> mesh_generator = Core::instance().root().create_component<SimpleMeshGenerator>("mesh_generator");
+  mesh_generator->options().set("mesh",Core::instance().root().uri()/"rect");
+  mesh_generator->options().set("lengths",std::vector<Real>(2,4.));
+  std::vector<Uint> nb_cells = list_of(4)(4);
+  mesh_generator->options().set("nb_cells",nb_cells);
+  Mesh& mesh = mesh_generator->generate();
+
+  boost::shared_ptr<MeshTransformer> refine = boost::dynamic_pointer_cast<MeshTransformer>(build_component("cf3.mesh.actions.Refine","refine"));
+  refine->options().set("nb_refinements",2u);
+  refine->transform(mesh);
+
+  // Every node and cell is owned by exactly one rank
+  Uint nb_owned_nodes, nb_owned_cells;
+  count_owned(mesh,nb_owned_nodes,nb_owned_cells);
+  BOOST_CHECK_EQUAL(nb_owned_nodes, 17u*17u);
+  BOOST_CHECK_EQUAL(nb_owned_cells, 16u*16u);
+
+  // New nodes lie on the lattice of the refined mesh
+  const Field& coordinates = mesh.geometry_fields().coordinates();
+  for (Uint n=0; n<coordinates.size(); ++n)
+  {
+    for (Uint d=0; d<2; ++d)
+    {
+      const Real lattice = coordinates[n][d]*4.;
+      BOOST_CHECK_SMALL(lattice - std::floor(lattice+0.5), 1e-10);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( finalize )
+{
+  PE::Comm::instance().finalize();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
@@ -338,6 +338,45 @@ BOOST_AUTO_TEST_CASE( Table_Real_Test )
 
 //////////////////////////////////////////////////////////////////////////////
 
+BOOST_AUTO_TEST_CASE( Table_Real_Alignment )
+{
+  boost::shared_ptr< Table<Real> > table (allocate_component< Table<Real> >("table")) ;
+
+  // tables are not padded by default
+  table->set_row_size(3);
+  table->resize(7);
+  BOOST_CHECK_EQUAL(table->row_alignment(), 0u);
+  BOOST_CHECK_EQUAL(table->row_stride(), 3u);
+  for(Uint i = 0; i != 7; ++i)
+    for(Uint j = 0; j != 3; ++j)
+      (*table)[i][j] = 10.*i + j;
+
+  // padding keeps the values and the row size, every row starts at a 32 byte boundary
+  table->set_row_alignment(32);
+  BOOST_CHECK_EQUAL(table->size(), 7u);
+  BOOST_CHECK_EQUAL(table->row_size(), 3u);
+  BOOST_CHECK_EQUAL(table->row_stride(), 4u);
+  BOOST_CHECK_EQUAL((*table)[6].size(), 3u);
+  BOOST_CHECK_EQUAL((*table)[6][2], 62.);
+  for(Uint i = 0; i != 7; ++i)
+    BOOST_CHECK_EQUAL(reinterpret_cast<std::size_t>(&(*table)[i][0]) % 32, 0u);
+
+  // reallocation through a buffer keeps the alignment and the values
+  Table<Real>::Buffer buffer = table->create_buffer(2);
+  for(Uint i = 0; i != 5; ++i)
+    buffer.add_row(std::vector<Real>(3, static_cast<Real>(i)));
+  buffer.flush();
+  BOOST_CHECK_EQUAL(table->size(), 12u);
+  BOOST_CHECK_EQUAL(table->row_size(), 3u);
+  BOOST_CHECK_EQUAL(reinterpret_cast<std::size_t>(table->array().data()) % 32, 0u);
+  BOOST_CHECK_EQUAL((*table)[6][2], 62.);
+  BOOST_CHECK_EQUAL((*table)[11][2], 4.);
+  Table<Real>::Row last_row = (*table)[11];
+  BOOST_CHECK_EQUAL(to_vector(last_row).size(), 3u);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 
 
 BOOST_AUTO_TEST_CASE( Table_Real_Templates )
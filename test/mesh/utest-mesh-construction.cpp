@@ -122,7 +122,7 @@ struct Mesh_API SpaceElement
   Entity support() const { return Entity(comp->support(),idx); }
 
   Connectivity::ConstRow field_indices() const { return comp->connectivity()[idx]; }
-  Uint glb_idx() const { return comp->support().glb_idx()[idx]; }
+  Gid glb_idx() const { return comp->support().glb_idx()[idx]; }
   Uint rank() const { return comp->support().rank()[idx]; }
   bool is_ghost() const { return comp->support().is_ghost(idx); }
   RealMatrix get_coordinates() const { return comp->get_coordinates(idx); }
@@ -309,6 +309,55 @@ BOOST_AUTO_TEST_CASE( FieldVariables )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+BOOST_AUTO_TEST_CASE( AlignedField )
+{
+  Handle<Dictionary> elems_P0(m_mesh->get_child("elems_P0"));
+  Field& velocity = elems_P0->create_field("U_aligned",VECTOR_3D,32u);
+
+  // the rows are padded in storage only
+  BOOST_CHECK_EQUAL( velocity.row_size() , 3u );
+  BOOST_CHECK_EQUAL( velocity.row_stride() , 4u );
+  BOOST_CHECK_EQUAL( velocity.size() , elems_P0->size() );
+  BOOST_REQUIRE( velocity.size() > 1u );
+
+  for (Uint i=0; i<velocity.size(); ++i)
+  {
+    BOOST_CHECK_EQUAL( reinterpret_cast<std::size_t>(&velocity[i][0]) % 32 , 0u );
+    for (Uint j=0; j<velocity.row_size(); ++j)
+      velocity[i][j] = 10.*i + j;
+  }
+
+  Field::AlignedRowArrayRef row = velocity.aligned_row(1);
+  BOOST_CHECK_EQUAL( row.size() , 3 );
+  BOOST_CHECK_EQUAL( row[2] , 12. );
+
+  Field::AlignedRef all = velocity.aligned_ref();
+  BOOST_CHECK_EQUAL( all.rows() , static_cast<int>(velocity.size()) );
+  BOOST_CHECK_EQUAL( all(1,2) , 12. );
+  all.col(0) = 1.;
+  BOOST_CHECK_EQUAL( velocity[1][0] , 1. );
+  BOOST_CHECK_EQUAL( velocity[1][1] , 11. );
+  BOOST_CHECK_EQUAL( velocity.col(2)(1,0) , 12. );
+
+  // views and assignment only see the columns
+  Field::View view = velocity.view(1,1);
+  BOOST_CHECK_EQUAL( view.shape()[1] , 3u );
+  BOOST_CHECK_EQUAL( view[0][2] , 12. );
+
+  Field& unpadded = elems_P0->create_field("U_unpadded",VECTOR_3D);
+  unpadded = velocity;
+  BOOST_CHECK_EQUAL( unpadded[1][1] , 11. );
+  unpadded[1][1] = 5.;
+  velocity = unpadded;
+  BOOST_CHECK_EQUAL( velocity[1][1] , 5. );
+  BOOST_CHECK_EQUAL( velocity[1][2] , 12. );
+
+  elems_P0->remove_component(unpadded);
+  elems_P0->remove_component(velocity);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 BOOST_AUTO_TEST_SUITE_END()
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,270 @@
+// Copyright (C) 2010-2013 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test module for the Hilbert space filling curve partitioner"
+
+#include <boost/test/unit_test.hpp>
+
+#include "common/OptionList.hpp"
+#include "common/Core.hpp"
+#include "common/Foreach.hpp"
+#include "common/FindComponents.hpp"
+
+#include "common/PE/Comm.hpp"
+#include "common/PE/all_reduce.hpp"
+
+#include "math/MatrixTypes.hpp"
+
+#include "mesh/Mesh.hpp"
+#include "mesh/Dictionary.hpp"
+#include "mesh/Field.hpp"
+#include "mesh/Elements.hpp"
+#include "mesh/Space.hpp"
+#include "mesh/Connectivity.hpp"
+#include "mesh/MeshGenerator.hpp"
+#include "mesh/MeshTransformer.hpp"
+#include "mesh/MeshPartitioner.hpp"
+
+using namespace boost;
+using namespace cf3;
+using namespace cf3::mesh;
+using namespace cf3::common;
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct HilbertPartitionerTests_Fixture
+{
+  /// common setup for each test case
+  HilbertPartitionerTests_Fixture()
+  {
+    m_argc = boost::unit_test::framework::master_test_suite().argc;
+    m_argv = boost::unit_test::framework::master_test_suite().argv;
+  }
+
+  /// common tear-down for each test case
+  ~HilbertPartitionerTests_Fixture()
+  {
+  }
+
+  /// Generate a rectangle of 16x8 quads without boundary elements, distributed in rows over the ranks,
+  /// and build the global numbering and connectivity needed by the partitioner
+  Mesh& generate_rectangle(const std::string& name)
+  {
+    boost::shared_ptr< MeshGenerator > meshgenerator = build_component_abstract_type<MeshGenerator>("cf3.mesh.SimpleMeshGenerator","generator");
+    meshgenerator->options().set("mesh",URI("//"+name));
+    std::vector<Uint> nb_cells(2);
+    nb_cells[0] = 16;
+    nb_cells[1] = 8;
+    std::vector<Real> lengths(2);
+    lengths[0] = 2.;
+    lengths[1] = 1.;
+    meshgenerator->options().set("nb_cells",nb_cells);
+    meshgenerator->options().set("lengths",lengths);
+    meshgenerator->options().set("bdry",false);
+    Mesh& mesh = meshgenerator->generate();
+
+    build_component_abstract_type<MeshTransformer>("cf3.mesh.actions.GlobalNumbering","glb_numbering")->transform(mesh);
+    build_component_abstract_type<MeshTransformer>("cf3.mesh.actions.GlobalConnectivity","glb_connectivity")->transform(mesh);
+    return mesh;
+  }
+
+  /// Number of cells on this rank. There is no overlap, so all of them are owned
+  Uint count_cells(const Mesh& mesh)
+  {
+    Uint nb_cells = 0;
+    boost_foreach(const Elements& elements, find_components_recursively<Elements>(mesh))
+      nb_cells += elements.size();
+    return nb_cells;
+  }
+
+  /// Weight of an element: the lower left quarter of the rectangle is three times as expensive.
+  /// The Hilbert curve traverses this quarter in one piece, so the parts with the same
+  /// number of cells are not balanced in weight
+  Real element_weight(const Entities& elements, const Uint elem_idx)
+  {
+    RealMatrix coordinates;
+    elements.geometry_space().allocate_coordinates(coordinates);
+    elements.geometry_space().put_coordinates(coordinates,elem_idx);
+    return coordinates.col(XX).mean() < 1. && coordinates.col(YY).mean() < 0.5 ? 3. : 1.;
+  }
+
+  /// Create an element based field with the weight of every element
+  Field& create_weights_field(Mesh& mesh)
+  {
+    Dictionary& elems_P0 = mesh.create_discontinuous_space("elems_P0","cf3.mesh.LagrangeP0");
+    Field& weights = elems_P0.create_field("weights");
+    boost_foreach(const Handle<Space>& space, elems_P0.spaces())
+    {
+      for (Uint e=0; e<space->support().size(); ++e)
+      {
+        boost_foreach(const Uint pt, space->connectivity()[e])
+          weights[pt][0] = element_weight(space->support(),e);
+      }
+    }
+    return weights;
+  }
+
+  /// Sum of the weights of the cells on this rank
+  Real local_weight(const Mesh& mesh)
+  {
+    Real weight = 0.;
+    boost_foreach(const Elements& elements, find_components_recursively<Elements>(mesh))
+    {
+      for (Uint e=0; e<elements.size(); ++e)
+        weight += element_weight(elements,e);
+    }
+    return weight;
+  }
+
+  /// common values accessed by all tests goes here
+  int    m_argc;
+  char** m_argv;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( HilbertPartitionerTests_TestSuite, HilbertPartitionerTests_Fixture )
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( init_mpi )
+{
+  PE::Comm::instance().init(m_argc,m_argv);
+  BOOST_CHECK_EQUAL(PE::Comm::instance().size(), 2u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( balanced_part_sizes )
+{
+  Mesh& mesh = generate_rectangle("rectangle");
+
+  boost::shared_ptr< MeshTransformer > partitioner = build_component_abstract_type<MeshTransformer>("cf3.mesh.HilbertPartitioner","partitioner");
+  partitioner->transform(mesh);
+
+  // No cell is lost, and every part has half of the cells. With one sample per cell, the cuts are exact
+  Uint nb_local_cells = count_cells(mesh);
+  Uint total_nb_cells = 0;
+  PE::Comm::instance().all_reduce(PE::plus(),&nb_local_cells,1,&total_nb_cells);
+  BOOST_CHECK_EQUAL(total_nb_cells, 128u);
+  BOOST_CHECK_EQUAL(nb_local_cells, 64u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( balanced_part_sizes_few_samples )
+{
+  Mesh& mesh = generate_rectangle("rectangle_few_samples");
+
+  // Every sample represents 16 cells, so the cuts are at most one sample off
+  boost::shared_ptr< MeshTransformer > partitioner = build_component_abstract_type<MeshTransformer>("cf3.mesh.HilbertPartitioner","partitioner");
+  partitioner->options().set("nb_samples",4u);
+  partitioner->transform(mesh);
+
+  Uint nb_local_cells = count_cells(mesh);
+  Uint total_nb_cells = 0;
+  PE::Comm::instance().all_reduce(PE::plus(),&nb_local_cells,1,&total_nb_cells);
+  BOOST_CHECK_EQUAL(total_nb_cells, 128u);
+  BOOST_CHECK(nb_local_cells >= 48u);
+  BOOST_CHECK(nb_local_cells <= 80u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( object_weights )
+{
+  Mesh& mesh = generate_rectangle("rectangle_weights");
+  Field& weights = create_weights_field(mesh);
+
+  Uint nb_owned_nodes = 0;
+  for (Uint n=0; n<mesh.geometry_fields().size(); ++n)
+  {
+    if (!mesh.geometry_fields().is_ghost(n))
+      ++nb_owned_nodes;
+  }
+  const Uint nb_local_cells = count_cells(mesh);
+
+  // Without costs all objects have unit weight, and no weights are stored
+  boost::shared_ptr< MeshPartitioner > unit_partitioner = build_component_abstract_type<MeshPartitioner>("cf3.mesh.HilbertPartitioner","unit_partitioner");
+  unit_partitioner->initialize(mesh);
+  BOOST_CHECK( !unit_partitioner->has_object_weights() );
+  BOOST_CHECK( unit_partitioner->object_weights().empty() );
+
+  // Cost of the element type, by short name, and the weight of the nodes
+  boost::shared_ptr< MeshPartitioner > cost_partitioner = build_component_abstract_type<MeshPartitioner>("cf3.mesh.HilbertPartitioner","cost_partitioner");
+  cost_partitioner->options().set("element_costs",std::vector<std::string>(1,"Quad2D=2"));
+  cost_partitioner->options().set("node_weight",0.5);
+  cost_partitioner->initialize(mesh);
+  BOOST_CHECK( cost_partitioner->has_object_weights() );
+  BOOST_REQUIRE_EQUAL( cost_partitioner->object_weights().size(), nb_owned_nodes+nb_local_cells );
+  // The owned nodes come first
+  for (Uint i=0; i<nb_owned_nodes; ++i)
+    BOOST_CHECK_EQUAL( cost_partitioner->object_weights()[i], 0.5 );
+  for (Uint i=nb_owned_nodes; i<cost_partitioner->object_weights().size(); ++i)
+    BOOST_CHECK_EQUAL( cost_partitioner->object_weights()[i], 2. );
+
+  // The builder name takes precedence over the short name, and the cost multiplies the weights field
+  std::vector<std::string> element_costs;
+  element_costs.push_back("Quad2D=5");
+  element_costs.push_back("cf3.mesh.LagrangeP1.Quad2D=2");
+  boost::shared_ptr< MeshPartitioner > field_partitioner = build_component_abstract_type<MeshPartitioner>("cf3.mesh.HilbertPartitioner","field_partitioner");
+  field_partitioner->options().set("element_costs",element_costs);
+  field_partitioner->options().set("weights_field",weights.handle<Field>());
+  field_partitioner->initialize(mesh);
+  BOOST_CHECK( field_partitioner->has_object_weights() );
+  BOOST_REQUIRE_EQUAL( field_partitioner->object_weights().size(), nb_owned_nodes+nb_local_cells );
+  Real cells_weight = 0.;
+  for (Uint i=0; i<nb_owned_nodes; ++i)
+    BOOST_CHECK_EQUAL( field_partitioner->object_weights()[i], 1. );
+  for (Uint i=nb_owned_nodes; i<field_partitioner->object_weights().size(); ++i)
+    cells_weight += field_partitioner->object_weights()[i];
+  BOOST_CHECK_CLOSE( cells_weight, 2.*local_weight(mesh), 1e-10 );
+
+  // Malformed entries are reported
+  boost::shared_ptr< MeshPartitioner > bad_partitioner = build_component_abstract_type<MeshPartitioner>("cf3.mesh.HilbertPartitioner","bad_partitioner");
+  bad_partitioner->options().set("element_costs",std::vector<std::string>(1,"Quad2D"));
+  BOOST_CHECK_THROW( bad_partitioner->initialize(mesh), BadValue );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( weighted_part_sizes )
+{
+  Mesh& mesh = generate_rectangle("rectangle_weighted_parts");
+  Field& weights = create_weights_field(mesh);
+
+  boost::shared_ptr< MeshTransformer > partitioner = build_component_abstract_type<MeshTransformer>("cf3.mesh.HilbertPartitioner","partitioner");
+  partitioner->options().set("weights_field",weights.handle<Field>());
+  partitioner->transform(mesh);
+
+  // The weight is balanced instead of the number of cells. A sample weighs at most 2,
+  // so the cuts are at most a few cells off
+  Uint nb_local_cells = count_cells(mesh);
+  Uint total_nb_cells = 0;
+  PE::Comm::instance().all_reduce(PE::plus(),&nb_local_cells,1,&total_nb_cells);
+  BOOST_CHECK_EQUAL(total_nb_cells, 128u);
+  BOOST_CHECK(nb_local_cells != 64u);
+
+  Real weight = local_weight(mesh);
+  Real total_weight = 0.;
+  PE::Comm::instance().all_reduce(PE::plus(),&weight,1,&total_weight);
+  BOOST_CHECK_EQUAL(total_weight, 192.);
+  BOOST_CHECK_SMALL(weight - 96., 6.);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( finalize_mpi )
+{
+  PE::Comm::instance().finalize();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
@@ -7,6 +7,10 @@
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MODULE "Test module for Mesh Manipulations"
 
+#include <algorithm>
+#include <cmath>
+#include <set>
+
 #include <boost/test/unit_test.hpp>
 
 #include "common/Log.hpp"
@@ -30,6 +34,10 @@
 #include "common/List.hpp"
 #include "common/Table.hpp"
 #include "mesh/Dictionary.hpp"
+#include "mesh/Entities.hpp"
+#include "mesh/ShapeFunction.hpp"
+#include "common/Foreach.hpp"
+#include "common/PE/all_reduce.hpp"
 
 using namespace std;
 using namespace boost;
@@ -169,6 +177,90 @@ BOOST_AUTO_TEST_CASE( test_move_elements )
   BOOST_CHECK_NO_THROW(  mesh_adaptor.finish()  );
 }
 
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( test_move_elements_large_glb_idx )
+{
+  // Generate a simple 1D line-mesh of 10 cells
+  boost::shared_ptr< MeshGenerator > meshgenerator = build_component_abstract_type<MeshGenerator>("cf3.mesh.SimpleMeshGenerator","1Dgenerator");
+  meshgenerator->options().set("mesh",URI("//line_large_glb_idx"));
+  meshgenerator->options().set("nb_cells",std::vector<Uint>(1,10));
+  meshgenerator->options().set("lengths",std::vector<Real>(1,10.));
+  Mesh& mesh = meshgenerator->generate();
+
+  // Shift all global indices beyond the range of Uint (or close to it without 64-bit global indices)
+#ifdef CF3_ENABLE_64BIT_GLOBAL_INDICES
+  const Gid offset = Gid(1) << 33;
+#else
+  const Gid offset = Gid(1) << 30;
+#endif
+  Dictionary& geometry = mesh.geometry_fields();
+  for (Uint n=0; n<geometry.size(); ++n)
+    geometry.glb_idx()[n] += offset;
+  geometry.rebuild_map_glb_to_loc();
+  boost_foreach(const Handle<Entities>& entities, mesh.elements())
+  {
+    for (Uint e=0; e<entities->size(); ++e)
+      entities->glb_idx()[e] += offset;
+  }
+
+  std::vector< std::vector<std::vector<Uint> > > change_set(PE::Comm::instance().size(),
+                                                            std::vector<std::vector<Uint> >(mesh.elements().size()));
+  if (PE::Comm::instance().size() == 2)
+  {
+    // Each rank sends its last cell to the other rank
+    const Uint last_elem = mesh.elements()[0]->size()-1;
+    change_set[1-PE::Comm::instance().rank()][0].push_back(last_elem);
+  }
+
+  // Remember the global node indices of every cell, to compare after migration
+  std::vector<Gid> my_elem_glb_idx;
+  std::vector<Gid> my_elem_node_glb_idx;
+  const Entities& cells = *mesh.elements()[0];
+  for (Uint e=0; e<cells.size(); ++e)
+  {
+    my_elem_glb_idx.push_back(cells.glb_idx()[e]);
+    boost_foreach(const Uint node, cells.geometry_space().connectivity()[e])
+      my_elem_node_glb_idx.push_back(geometry.glb_idx()[node]);
+  }
+
+  MeshAdaptor mesh_adaptor(mesh);
+  BOOST_CHECK_NO_THROW( mesh_adaptor.prepare() );
+  BOOST_CHECK_NO_THROW( mesh_adaptor.move_elements(change_set) );
+  BOOST_CHECK_NO_THROW( mesh_adaptor.finish() );
+
+  // The total number of cells is unchanged
+  Uint nb_cells = cells.size();
+  Uint total_nb_cells = nb_cells;
+  if (PE::Comm::instance().is_active())
+    PE::Comm::instance().all_reduce(PE::plus(),&nb_cells,1,&total_nb_cells);
+  BOOST_CHECK_EQUAL(total_nb_cells, 10u);
+
+  // The connectivity is local again and every global index is still beyond the offset
+  for (Uint n=0; n<geometry.size(); ++n)
+    BOOST_CHECK(geometry.glb_idx()[n] >= offset);
+  for (Uint e=0; e<cells.size(); ++e)
+  {
+    BOOST_CHECK(cells.glb_idx()[e] >= offset);
+    boost_foreach(const Uint node, cells.geometry_space().connectivity()[e])
+    {
+      BOOST_CHECK(node < geometry.size());
+      BOOST_CHECK(geometry.glb_idx()[node] >= offset);
+    }
+  }
+
+  // Cells that stayed on this rank keep their global nodes
+  const Uint nodes_per_cell = cells.geometry_space().shape_function().nb_nodes();
+  for (Uint e=0; e<cells.size(); ++e)
+  {
+    const std::vector<Gid>::const_iterator it = std::find(my_elem_glb_idx.begin(),my_elem_glb_idx.end(),cells.glb_idx()[e]);
+    if (it == my_elem_glb_idx.end())
+      continue;
+    const Uint old_e = it - my_elem_glb_idx.begin();
+    for (Uint n=0; n<nodes_per_cell; ++n)
+      BOOST_CHECK_EQUAL(geometry.glb_idx()[cells.geometry_space().connectivity()[e][n]], my_elem_node_glb_idx[old_e*nodes_per_cell+n]);
+  }
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -288,6 +380,81 @@ BOOST_AUTO_TEST_CASE( test_element_node_connectivity_rebuilding )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+BOOST_AUTO_TEST_CASE( test_grow_overlap_two_layers )
+{
+  // 4x6 cells of size 1, each of 2 ranks owns 3 rows of cells
+  boost::shared_ptr< MeshGenerator > meshgenerator = build_component_abstract_type<MeshGenerator>("cf3.mesh.SimpleMeshGenerator","2Dgenerator");
+  meshgenerator->options().set("mesh",URI("//rect_overlap"));
+  std::vector<Uint> nb_cells(2);
+  nb_cells[XX] = 4;
+  nb_cells[YY] = 6;
+  std::vector<Real> lengths(2);
+  lengths[XX] = 4.;
+  lengths[YY] = 6.;
+  meshgenerator->options().set("nb_cells",nb_cells);
+  meshgenerator->options().set("lengths",lengths);
+  meshgenerator->options().set("bdry",false);
+  Mesh& mesh = meshgenerator->generate();
+
+  build_component_abstract_type<MeshTransformer>("cf3.mesh.actions.GlobalConnectivity","glb_connectivity")->transform(mesh);
+
+  boost::shared_ptr< MeshTransformer > grow_overlap = build_component_abstract_type<MeshTransformer>("cf3.mesh.actions.GrowOverlap","grow_overlap");
+  grow_overlap->options().set("nb_layers",2u);
+  grow_overlap->transform(mesh);
+
+  if (PE::Comm::instance().size() == 2)
+  {
+    const Uint rank = PE::Comm::instance().rank();
+    Dictionary& nodes = mesh.geometry_fields();
+    BOOST_REQUIRE_EQUAL(mesh.elements().size(), 1u);
+    Entities& cells = *mesh.elements()[0];
+
+    // count the owned and ghost cells in each row, using the cell centroids
+    std::vector<Uint> owned_per_row(6,0u);
+    std::vector<Uint> ghosts_per_row(6,0u);
+    std::set<Gid> glb_elems;
+    for (Uint e=0; e<cells.size(); ++e)
+    {
+      Real y = 0.;
+      boost_foreach(const Uint node, cells.geometry_space().connectivity()[e])
+      {
+        BOOST_REQUIRE(node < nodes.size());
+        y += nodes.coordinates()[node][YY];
+      }
+      const Uint row = static_cast<Uint>(std::floor(y / cells.geometry_space().connectivity().row_size()));
+      BOOST_REQUIRE(row < 6u);
+      if (cells.rank()[e] == rank)
+        ++owned_per_row[row];
+      else
+        ++ghosts_per_row[row];
+      glb_elems.insert(cells.glb_idx()[e]);
+    }
+    BOOST_CHECK_EQUAL(glb_elems.size(), cells.size());
+
+    // the first layer is the row next to the part, the second layer the row beyond it
+    const Uint first_owned_row = rank == 0 ? 0u : 3u;
+    const Uint first_layer_row = rank == 0 ? 3u : 2u;
+    const Uint second_layer_row = rank == 0 ? 4u : 1u;
+    for (Uint row=0; row<6; ++row)
+    {
+      const bool owned = row >= first_owned_row && row < first_owned_row+3;
+      const bool ghost = row == first_layer_row || row == second_layer_row;
+      BOOST_CHECK_EQUAL(owned_per_row[row], owned ? 4u : 0u);
+      BOOST_CHECK_EQUAL(ghosts_per_row[row], ghost ? 4u : 0u);
+    }
+    BOOST_CHECK_EQUAL(cells.size(), 20u);
+
+    // all nodes of the 5 rows of cells are present, once
+    std::set<Gid> glb_nodes;
+    for (Uint n=0; n<nodes.size(); ++n)
+      glb_nodes.insert(nodes.glb_idx()[n]);
+    BOOST_CHECK_EQUAL(glb_nodes.size(), nodes.size());
+    BOOST_CHECK_EQUAL(nodes.size(), 30u);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 BOOST_AUTO_TEST_CASE( finalize_mpi )
 {
   PE::Comm::instance().finalize();
@@ -114,8 +114,8 @@ void my_all_to_all(const PE::Buffer& send, std::vector<int>& send_strides, PE::B
 bool check_nodes_sanity(Dictionary& nodes)
 {
   bool sane = true;
-  std::map<Uint,Uint> glb_node_2_loc_node;
-  std::map<Uint,Uint>::iterator glb_node_not_found = glb_node_2_loc_node.end();
+  std::map<Gid,Uint> glb_node_2_loc_node;
+  std::map<Gid,Uint>::iterator glb_node_not_found = glb_node_2_loc_node.end();
   for (Uint n=0; n<nodes.size(); ++n)
   {
     if ( glb_node_2_loc_node.find(nodes.glb_idx()[n]) == glb_node_not_found )
@@ -159,8 +159,8 @@ bool check_element_nodes_sanity(Mesh& mesh)
 bool check_elements_sanity(Entities& entities)
 {
   bool sane = true;
-  std::map<Uint,Uint> glb_elem_2_loc_elem;
-  std::map<Uint,Uint>::iterator glb_elem_not_found = glb_elem_2_loc_elem.end();
+  std::map<Gid,Uint> glb_elem_2_loc_elem;
+  std::map<Gid,Uint>::iterator glb_elem_not_found = glb_elem_2_loc_elem.end();
   for (Uint e=0; e<entities.size(); ++e)
   {
     if ( glb_elem_2_loc_elem.find(entities.glb_idx()[e]) == glb_elem_not_found )
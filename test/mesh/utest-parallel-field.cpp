@@ -185,7 +185,7 @@ build_component_abstract_type<MeshTransformer>("cf3.mesh.actions.LoadBalance","l
   // Create a field with glb node numbers
   Field& glb_node_idx = mesh.geometry_fields().create_field("glb_node_idx");
 
-  List<Uint>& glb_idx = mesh.geometry_fields().glb_idx();
+  List<Gid>& glb_idx = mesh.geometry_fields().glb_idx();
   {
     for (Uint n=0; n<glb_node_idx.size(); ++n)
       glb_node_idx[n][0] = glb_idx[n];
@@ -7,8 +7,21 @@
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MODULE "Test module for cf3::mesh::tecplot::Writer"
 
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include <boost/cstdint.hpp>
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include "common/BoostFilesystem.hpp"
+
 #include "common/Log.hpp"
 #include "common/Core.hpp"
 #include "common/OptionList.hpp"
@@ -30,6 +43,84 @@ using namespace cf3::common;
 
 ////////////////////////////////////////////////////////////////////////////////
 
+/// Contents of a file
+std::string read_file(const std::string& filename)
+{
+  std::ifstream file(filename.c_str(), std::ios_base::in | std::ios_base::binary);
+  std::stringstream contents;
+  contents << file.rdbuf();
+  return contents.str();
+}
+
+/// Appended data section of a vtu file, starting after the leading _
+std::string appended_data(const std::string& filename)
+{
+  const std::string contents = read_file(filename);
+  const std::string marker = "<AppendedData encoding=\"raw\">\n_";
+  const std::size_t begin = contents.find(marker);
+  BOOST_REQUIRE(begin != std::string::npos);
+  return contents.substr(begin + marker.size());
+}
+
+/// Header word i of the appended data
+Uint header_word(const std::string& data, const Uint i)
+{
+  boost::uint32_t result;
+  std::memcpy(&result, data.data() + 4*i, 4);
+  return result;
+}
+
+/// Uncompressed bytes of the first array of appended data that was written without compression
+std::string raw_first_array(const std::string& data)
+{
+  const Uint nb_bytes = header_word(data, 0);
+  BOOST_REQUIRE_LE(4 + nb_bytes, data.size());
+  return data.substr(4, nb_bytes);
+}
+
+/// Uncompressed bytes of the first array of appended data that was compressed with zlib
+std::string decompress_first_array(const std::string& data)
+{
+  const Uint nb_blocks = header_word(data, 0);
+  const Uint blocksize = header_word(data, 1);
+  const Uint last_blocksize = header_word(data, 2);
+
+  std::string result;
+  Uint block_begin = 4*(3 + nb_blocks);
+  for(Uint i = 0; i != nb_blocks; ++i)
+  {
+    const Uint compressed_size = header_word(data, 3 + i);
+    BOOST_REQUIRE_LE(block_begin + compressed_size, data.size());
+
+    std::string block;
+    boost::iostreams::filtering_istream in;
+    in.push(boost::iostreams::zlib_decompressor());
+    in.push(boost::iostreams::array_source(data.data() + block_begin, compressed_size));
+    boost::iostreams::copy(in, boost::iostreams::back_inserter(block));
+
+    BOOST_CHECK_EQUAL(block.size(), i+1 == nb_blocks ? last_blocksize : blocksize);
+    result += block;
+    block_begin += compressed_size;
+  }
+  return result;
+}
+
+/// Check the written points array against the 2D coordinates
+void check_points(const std::string& points, const Field& coords)
+{
+  BOOST_REQUIRE_EQUAL(points.size(), 3*coords.size()*sizeof(Real));
+  std::vector<Real> values(3*coords.size());
+  std::memcpy(&values[0], points.data(), points.size());
+  for(Uint i = 0; i != coords.size(); ++i)
+  {
+    BOOST_CHECK_EQUAL(values[3*i], coords[i][XX]);
+    BOOST_CHECK_EQUAL(values[3*i+1], coords[i][YY]);
+    BOOST_CHECK_EQUAL(values[3*i+2], 0.);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 BOOST_AUTO_TEST_SUITE( VTKXMLSuite )
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -54,6 +145,133 @@ BOOST_AUTO_TEST_CASE( WriteGrid )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+BOOST_AUTO_TEST_CASE( WriteGridThreaded )
+{
+  Component& root = Core::instance().root();
+
+  // large enough to have several compressed blocks per array
+  Handle<Mesh> mesh = root.create_component<Mesh>("mesh_threaded");
+  Tools::MeshGeneration::create_rectangle(*mesh, 5., 5., 100, 100);
+
+  boost::shared_ptr< MeshWriter > vtk_writer = build_component_abstract_type<MeshWriter>("cf3.mesh.VTKXML.Writer","meshwriter");
+
+  std::vector<URI> fields; fields.push_back(mesh->geometry_fields().coordinates().uri());
+  vtk_writer->options().set("fields",fields);
+  vtk_writer->options().set("mesh",mesh);
+  vtk_writer->options().set("compression_level",1);
+  vtk_writer->options().set("file",URI("grid-single.vtu"));
+  vtk_writer->execute();
+
+  vtk_writer->options().set("nb_threads",4u);
+  vtk_writer->options().set("file",URI("grid-threaded.vtu"));
+  vtk_writer->execute();
+
+  // Each block is compressed separately, so the threads must not change the output
+  const std::string threaded = read_file("grid-threaded_P0.vtu");
+  BOOST_CHECK(!threaded.empty());
+  BOOST_CHECK(threaded == read_file("grid-single_P0.vtu"));
+
+  const std::string data = appended_data("grid-threaded_P0.vtu");
+  BOOST_CHECK_GT(header_word(data, 0), 4u);
+  check_points(decompress_first_array(data), mesh->geometry_fields().coordinates());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( WriteGridRaw )
+{
+  Component& root = Core::instance().root();
+
+  Handle<Mesh> mesh = root.create_component<Mesh>("mesh_raw");
+  Tools::MeshGeneration::create_rectangle(*mesh, 5., 5., 5, 5);
+
+  boost::shared_ptr< MeshWriter > vtk_writer = build_component_abstract_type<MeshWriter>("cf3.mesh.VTKXML.Writer","meshwriter");
+
+  std::vector<URI> fields; fields.push_back(mesh->geometry_fields().coordinates().uri());
+  vtk_writer->options().set("fields",fields);
+  vtk_writer->options().set("mesh",mesh);
+  vtk_writer->options().set("file",URI("grid-raw.vtu"));
+  vtk_writer->options().set("compressor",std::string("raw"));
+  vtk_writer->execute();
+
+  const std::string raw_contents = read_file("grid-raw_P0.vtu");
+  BOOST_CHECK(raw_contents.find("compressor=") == std::string::npos);
+  const std::string raw_points = raw_first_array(appended_data("grid-raw_P0.vtu"));
+  check_points(raw_points, mesh->geometry_fields().coordinates());
+
+  // The compressed file holds the same data
+  vtk_writer->options().set("file",URI("grid-zlib.vtu"));
+  vtk_writer->options().set("compressor",std::string("zlib"));
+  vtk_writer->execute();
+
+  BOOST_CHECK(read_file("grid-zlib_P0.vtu").find("compressor=\"vtkZLibDataCompressor\"") != std::string::npos);
+  BOOST_CHECK(decompress_first_array(appended_data("grid-zlib_P0.vtu")) == raw_points);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( WriteLossyField )
+{
+  Component& root = Core::instance().root();
+
+  Handle<Mesh> mesh = root.create_component<Mesh>("mesh_lossy");
+  Tools::MeshGeneration::create_rectangle(*mesh, 5., 5., 50, 50);
+
+  const Field& coords = mesh->geometry_fields().coordinates();
+  Field& stats = mesh->geometry_fields().create_field("stats", "stats");
+  for(Uint i = 0; i != stats.size(); ++i)
+    stats[i][0] = std::sin(coords[i][0]) * std::cos(coords[i][1]);
+
+  boost::shared_ptr< MeshWriter > vtk_writer = build_component_abstract_type<MeshWriter>("cf3.mesh.VTKXML.Writer","meshwriter");
+
+  // Mesh only, to measure the size of the field data
+  std::vector<URI> fields;
+  vtk_writer->options().set("fields",fields);
+  vtk_writer->options().set("mesh",mesh);
+  vtk_writer->options().set("file",URI("stats-none.vtu"));
+  vtk_writer->execute();
+
+  fields.push_back(stats.uri());
+  vtk_writer->options().set("fields",fields);
+  vtk_writer->options().set("file",URI("stats-exact.vtu"));
+  vtk_writer->execute();
+
+  stats.options().set("output_precision", std::string("single"));
+  stats.options().set("output_tolerance", 1e-3);
+  vtk_writer->options().set("file",URI("stats-lossy.vtu"));
+  vtk_writer->execute();
+
+  // The values are kept in double precision in memory
+  BOOST_CHECK_EQUAL(stats[7][0], std::sin(coords[7][0]) * std::cos(coords[7][1]));
+
+  const boost::uintmax_t mesh_size = boost::filesystem::file_size("stats-none_P0.vtu");
+  const boost::uintmax_t exact_size = boost::filesystem::file_size("stats-exact_P0.vtu") - mesh_size;
+  const boost::uintmax_t lossy_size = boost::filesystem::file_size("stats-lossy_P0.vtu") - mesh_size;
+  BOOST_CHECK_LT(2*lossy_size, exact_size);
+
+  std::ifstream lossy_file("stats-lossy_P0.vtu");
+  std::stringstream lossy_contents;
+  lossy_contents << lossy_file.rdbuf();
+  BOOST_CHECK(lossy_contents.str().find("type=\"Float32\" NumberOfComponents=\"1\" Name=\"stats\"") != std::string::npos);
+
+  // Single precision can't hold values this large within the tolerance, so they are written in double precision
+  Field& large = mesh->geometry_fields().create_field("large", "large");
+  for(Uint i = 0; i != large.size(); ++i)
+    large[i][0] = 1e6 + stats[i][0];
+  large.options().set("output_precision", std::string("single"));
+  large.options().set("output_tolerance", 1e-3);
+  fields.clear();
+  fields.push_back(large.uri());
+  vtk_writer->options().set("fields",fields);
+  vtk_writer->options().set("file",URI("large-lossy.vtu"));
+  vtk_writer->execute();
+
+  const std::string large_contents = read_file("large-lossy_P0.vtu");
+  BOOST_CHECK(large_contents.find("type=\"Float64\" NumberOfComponents=\"1\" Name=\"large\"") != std::string::npos);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 BOOST_AUTO_TEST_SUITE_END()
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -37,3 +37,31 @@ cf_check_equal(table[0][0],2,'Table increment failed')
 
 print 'Full table:'
 print table
+
+# Zero-copy views on the table storage
+view = table.buffer()
+cf_check_equal(view.ndim, 2, 'Incorrect view dimension')
+cf_check(view.shape[0] == 10 and view.shape[1] == 2, 'Incorrect view shape')
+
+# The table can not be resized while a view exists
+resize_failed = False
+try:
+  table.resize(20)
+except RuntimeError:
+  resize_failed = True
+cf_check(resize_failed, 'Table with a view on its storage was resized')
+
+del view
+table.resize(20)
+cf_check_equal(len(table),20,'Resize after releasing the view failed')
+
+try:
+  import numpy
+  array = table.array()
+  array[:,1] = 5
+  cf_check_equal(table[19][1], 5, 'Numpy array does not share the table storage')
+  table[3][0] = 7
+  cf_check_equal(array[3,0], 7, 'Table does not share the numpy array storage')
+  del array
+except ImportError:
+  print 'numpy not available, skipping the numpy array checks'
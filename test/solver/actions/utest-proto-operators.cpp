@@ -567,6 +567,78 @@ BOOST_AUTO_TEST_CASE( NodeExprFunctionParsing )
   BOOST_CHECK_EQUAL(total[0], 15.);
 }
 
+BOOST_AUTO_TEST_CASE( NodeExprBatchFunction )
+{
+  Handle<Mesh> mesh = Core::instance().root().create_component<Mesh>("line_batch");
+  Tools::MeshGeneration::create_line(*mesh, 4., 4);
+
+  mesh->geometry_fields().create_field( "solution", "Temperature" ).add_tag("solution");
+
+  FieldVariable<0, ScalarField > T("Temperature", "solution");
+  Real total = 0.;
+
+  std::vector<std::string> vars(1, "x");
+  vars.push_back("t");
+
+  BatchScalarFunction f;
+  f.variables(vars);
+  f.functions(std::vector<std::string>(1, "x+1"));
+  f.parse();
+
+  boost::shared_ptr< Expression > test_expr = nodes_expression
+  (
+    group
+    (
+      T = boost::proto::lit(f),
+      boost::proto::lit(total) += T
+    )
+  );
+
+  test_expr->loop(mesh->topology());
+  BOOST_CHECK_EQUAL(total, 15.);
+  BOOST_CHECK_EQUAL(f.nb_batch_evaluations(), 1u);
+
+  // The function does not depend on time, so the stored values are reused
+  f.set_time(1.);
+  total = 0.;
+  test_expr->loop(mesh->topology());
+  BOOST_CHECK_EQUAL(total, 15.);
+  BOOST_CHECK_EQUAL(f.nb_batch_evaluations(), 1u);
+
+  // A time-dependent function is evaluated again when the time changes, but not when it stays the same
+  f.functions(std::vector<std::string>(1, "x+t"));
+  f.parse();
+  test_expr->loop(mesh->topology());
+  BOOST_CHECK_EQUAL(f.nb_batch_evaluations(), 2u);
+  total = 0.;
+  f.set_time(2.);
+  test_expr->loop(mesh->topology());
+  BOOST_CHECK_EQUAL(total, 20.);
+  BOOST_CHECK_EQUAL(f.nb_batch_evaluations(), 3u);
+  test_expr->loop(mesh->topology());
+  BOOST_CHECK_EQUAL(f.nb_batch_evaluations(), 3u);
+
+  // The results are stored per region, so alternating between regions does not evaluate again
+  Region& xneg = *Handle<Region>(mesh->topology().get_child("xneg"));
+  total = 0.;
+  test_expr->loop(xneg);
+  BOOST_CHECK_EQUAL(total, 2.);
+  BOOST_CHECK_EQUAL(f.nb_batch_evaluations(), 4u);
+  test_expr->loop(mesh->topology());
+  test_expr->loop(xneg);
+  BOOST_CHECK_EQUAL(f.nb_batch_evaluations(), 4u);
+
+  // A new mesh has new regions, evaluated again
+  Core::instance().root().remove_component(*mesh);
+  mesh = Core::instance().root().create_component<Mesh>("line_batch");
+  Tools::MeshGeneration::create_line(*mesh, 2., 2);
+  mesh->geometry_fields().create_field( "solution", "Temperature" ).add_tag("solution");
+  total = 0.;
+  test_expr->loop(mesh->topology());
+  BOOST_CHECK_EQUAL(total, 9.);
+  BOOST_CHECK_EQUAL(f.nb_batch_evaluations(), 5u);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 BOOST_AUTO_TEST_CASE( ProtoAccumulators )
@@ -41,6 +41,9 @@
 #include "solver/actions/LoopOperation.hpp"
 #include "solver/actions/ComputeVolume.hpp"
 #include "solver/actions/ComputeArea.hpp"
+#include "solver/actions/ProbeSet.hpp"
+
+#include "Tools/MeshGeneration/MeshGeneration.hpp"
 
 using namespace boost::assign;
 
@@ -264,6 +267,71 @@ BOOST_AUTO_TEST_CASE ( test_ForAllElementsT )
 
 ////////////////////////////////////////////////////////////////////////////////
 
+BOOST_AUTO_TEST_CASE ( test_ProbeSet )
+{
+  Component& root = Core::instance().root();
+  Handle<Mesh> mesh = root.create_component<Mesh>("probe_mesh");
+  Tools::MeshGeneration::create_rectangle(*mesh, 2., 1., 8, 4);
+
+  // Linear fields, which are interpolated exactly
+  Dictionary& dict = mesh->geometry_fields();
+  const Field& coords = dict.coordinates();
+  Field& field = dict.create_field("probed","p[s],U[v]");
+  for(Uint i = 0; i != field.size(); ++i)
+  {
+    field[i][0] = 1. + 2.*coords[i][XX] + 3.*coords[i][YY];
+    field[i][1] = coords[i][XX];
+    field[i][2] = -coords[i][YY];
+  }
+
+  // The coordinates can be configured before the dictionary. The last probe is outside the mesh.
+  Handle<ProbeSet> probes = root.create_component<ProbeSet>("probes");
+  std::vector<Real> probe_coords = list_of(0.3)(0.2)(1.7)(0.9)(3.)(0.5);
+  probes->options().set("coordinates", probe_coords);
+  probes->options().set("dict", dict.handle<Dictionary>());
+  probes->execute();
+
+  BOOST_CHECK_EQUAL(probes->coordinates().size(), 3u);
+  BOOST_CHECK_EQUAL(probes->coordinates().row_size(), 2u);
+
+  const std::vector<std::string> all_columns = list_of("p")("U[0]")("U[1]");
+  BOOST_CHECK(probes->columns() == all_columns);
+
+  const Table<Real>& values = probes->values();
+  BOOST_REQUIRE_EQUAL(values.size(), 3u);
+  BOOST_REQUIRE_EQUAL(values.row_size(), 3u);
+  for(Uint p = 0; p != 2; ++p)
+  {
+    const Real x = probe_coords[2*p];
+    const Real y = probe_coords[2*p+1];
+    BOOST_CHECK_CLOSE(values[p][0], 1. + 2.*x + 3.*y, 1e-8);
+    BOOST_CHECK_CLOSE(values[p][1], x, 1e-8);
+    BOOST_CHECK_CLOSE(values[p][2], -y, 1e-8);
+  }
+  BOOST_CHECK_EQUAL(values[2][0], 0.);
+
+  // Only the requested variable. The field values are read at every execution.
+  for(Uint i = 0; i != field.size(); ++i)
+    field[i][1] = 2.*coords[i][XX];
+  probes->options().set("variables", std::vector<std::string>(1, "U"));
+  probes->execute();
+
+  const std::vector<std::string> u_columns = list_of("U[0]")("U[1]");
+  BOOST_CHECK(probes->columns() == u_columns);
+  BOOST_REQUIRE_EQUAL(probes->values().row_size(), 2u);
+  BOOST_CHECK_CLOSE(probes->values()[1][0], 2.*1.7, 1e-8);
+  BOOST_CHECK_CLOSE(probes->values()[1][1], -0.9, 1e-8);
+
+  // An unknown variable is reported at setup
+  probes->options().set("variables", std::vector<std::string>(1, "unknown"));
+  BOOST_CHECK_THROW(probes->execute(), SetupError);
+
+  root.remove_component(*probes);
+  root.remove_component(*mesh);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
 BOOST_AUTO_TEST_SUITE_END()
 
 ////////////////////////////////////////////////////////////////////////////////
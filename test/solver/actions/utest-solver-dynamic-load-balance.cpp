@@ -0,0 +1,240 @@
+// Copyright (C) 2010-2013 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test module for cf3::solver::actions::DynamicLoadBalance"
+
+#include <boost/test/unit_test.hpp>
+
+#include "common/Action.hpp"
+#include "common/Core.hpp"
+#include "common/EventHandler.hpp"
+#include "common/FindComponents.hpp"
+#include "common/Foreach.hpp"
+#include "common/OptionList.hpp"
+#include "common/PropertyList.hpp"
+#include "common/Timer.hpp"
+
+#include "common/PE/Comm.hpp"
+#include "common/PE/all_reduce.hpp"
+
+#include "mesh/Mesh.hpp"
+#include "mesh/Cells.hpp"
+#include "mesh/MeshGenerator.hpp"
+#include "mesh/Tags.hpp"
+
+#include "solver/Tags.hpp"
+#include "solver/actions/DynamicLoadBalance.hpp"
+
+using namespace cf3;
+using namespace cf3::common;
+using namespace cf3::mesh;
+using namespace cf3::solver::actions;
+
+////////////////////////////////////////////////////////////////////////////////
+
+/// Action keeping the process busy for a given time, to simulate the work of a solver
+class BusyAction : public common::Action
+{
+public:
+  BusyAction(const std::string& name) : common::Action(name), nb_executions(0)
+  {
+    options().add("duration", 0.)
+        .description("Wall clock time spent in every execution, in seconds");
+  }
+
+  static std::string type_name() { return "BusyAction"; }
+
+  virtual void execute()
+  {
+    const Real duration = options().value<Real>("duration");
+    Timer timer;
+    while (timer.elapsed() < duration) {}
+    ++nb_executions;
+  }
+
+  Uint nb_executions;
+};
+
+/// Counts the "mesh_changed" events
+class MeshChangedCounter : public Component
+{
+public:
+  MeshChangedCounter(const std::string& name) : Component(name), nb_events(0)
+  {
+    Core::instance().event_handler().connect_to_event(mesh::Tags::event_mesh_changed(), this, &MeshChangedCounter::on_mesh_changed);
+  }
+
+  static std::string type_name() { return "MeshChangedCounter"; }
+
+  void on_mesh_changed(SignalArgs&)
+  {
+    ++nb_events;
+  }
+
+  Uint nb_events;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct DynamicLoadBalanceFixture
+{
+  DynamicLoadBalanceFixture()
+  {
+    m_argc = boost::unit_test::framework::master_test_suite().argc;
+    m_argv = boost::unit_test::framework::master_test_suite().argv;
+  }
+
+  /// Create a DynamicLoadBalance on the mesh, with a child action working for the given time on this rank
+  Handle<DynamicLoadBalance> create_load_balance(const std::string& name, const Uint check_interval, const Real duration)
+  {
+    Handle<DynamicLoadBalance> load_balance = Core::instance().root().create_component<DynamicLoadBalance>(name);
+    load_balance->options().set(solver::Tags::mesh(), m_mesh);
+    load_balance->options().set("check_interval", check_interval);
+    load_balance->options().set("imbalance_threshold", 1.2);
+    load_balance->create_component<BusyAction>("work")->options().set("duration", duration);
+    return load_balance;
+  }
+
+  /// Number of cells owned by this rank
+  Uint nb_owned_cells()
+  {
+    Uint nb_cells = 0;
+    boost_foreach(const Cells& cells, find_components_recursively<Cells>(*m_mesh))
+    {
+      for (Uint e=0; e<cells.size(); ++e)
+      {
+        if (!cells.is_ghost(e))
+          ++nb_cells;
+      }
+    }
+    return nb_cells;
+  }
+
+  int m_argc;
+  char** m_argv;
+
+  static Handle<Mesh> m_mesh;
+  static boost::shared_ptr<MeshChangedCounter> counter;
+};
+
+Handle<Mesh> DynamicLoadBalanceFixture::m_mesh;
+boost::shared_ptr<MeshChangedCounter> DynamicLoadBalanceFixture::counter;
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( DynamicLoadBalanceSuite, DynamicLoadBalanceFixture )
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( init_mpi )
+{
+  PE::Comm::instance().init(m_argc,m_argv);
+  BOOST_CHECK_EQUAL(PE::Comm::instance().size(), 2u);
+
+  boost::shared_ptr< MeshGenerator > meshgenerator = build_component_abstract_type<MeshGenerator>("cf3.mesh.SimpleMeshGenerator","generator");
+  meshgenerator->options().set("mesh",URI("//mesh"));
+  std::vector<Uint> nb_cells(2);
+  nb_cells[0] = 16;
+  nb_cells[1] = 8;
+  std::vector<Real> lengths(2);
+  lengths[0] = 2.;
+  lengths[1] = 1.;
+  meshgenerator->options().set("nb_cells",nb_cells);
+  meshgenerator->options().set("lengths",lengths);
+  m_mesh = meshgenerator->generate().handle<Mesh>();
+
+  counter = allocate_component<MeshChangedCounter>("counter");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( check_interval )
+{
+  // Rank 0 works, rank 1 idles, but the imbalance is only measured every 3 executions
+  const Real duration = PE::Comm::instance().rank() == 0 ? 0.05 : 0.;
+  Handle<DynamicLoadBalance> load_balance = create_load_balance("check_interval", 3u, duration);
+  load_balance->execute();
+  load_balance->execute();
+
+  BOOST_CHECK_EQUAL(Handle<BusyAction>(load_balance->get_child("work"))->nb_executions, 2u);
+  BOOST_CHECK_EQUAL(load_balance->imbalance(), 1.);
+  BOOST_CHECK_EQUAL(load_balance->properties().value<Uint>("nb_repartitions"), 0u);
+  BOOST_CHECK_EQUAL(counter->nb_events, 0u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( no_check )
+{
+  // A check interval of 0 disables the measurement
+  const Real duration = PE::Comm::instance().rank() == 0 ? 0.05 : 0.;
+  Handle<DynamicLoadBalance> load_balance = create_load_balance("no_check", 0u, duration);
+  for (Uint i=0; i<3; ++i)
+    load_balance->execute();
+
+  BOOST_CHECK_EQUAL(Handle<BusyAction>(load_balance->get_child("work"))->nb_executions, 3u);
+  BOOST_CHECK_EQUAL(load_balance->imbalance(), 1.);
+  BOOST_CHECK_EQUAL(load_balance->properties().value<Uint>("nb_repartitions"), 0u);
+  BOOST_CHECK_EQUAL(counter->nb_events, 0u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( balanced )
+{
+  // Both ranks work equally long, so the imbalance stays below the threshold
+  Handle<DynamicLoadBalance> load_balance = create_load_balance("balanced", 2u, 0.05);
+  load_balance->execute();
+  load_balance->execute();
+
+  BOOST_CHECK(load_balance->imbalance() < 1.2);
+  BOOST_CHECK_EQUAL(load_balance->properties().value<Real>("imbalance"), load_balance->imbalance());
+  BOOST_CHECK_EQUAL(load_balance->properties().value<Uint>("nb_repartitions"), 0u);
+  BOOST_CHECK_EQUAL(counter->nb_events, 0u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( imbalanced )
+{
+  // Rank 0 does all the work: the maximal time is twice the average
+  const Real duration = PE::Comm::instance().rank() == 0 ? 0.05 : 0.;
+  Handle<DynamicLoadBalance> load_balance = create_load_balance("imbalanced", 2u, duration);
+  load_balance->execute();
+  BOOST_CHECK_EQUAL(load_balance->properties().value<Uint>("nb_repartitions"), 0u);
+  load_balance->execute();
+
+  BOOST_CHECK(load_balance->imbalance() > 1.8);
+  BOOST_CHECK_EQUAL(load_balance->properties().value<Uint>("nb_repartitions"), 1u);
+  // the migration raises the event as well, so only check that it was raised
+  BOOST_CHECK(counter->nb_events > 0u);
+
+  // The mesh is repartitioned without losing cells, and the overlap is grown again
+  Uint nb_cells = nb_owned_cells();
+  Uint total_nb_cells = 0;
+  PE::Comm::instance().all_reduce(PE::plus(),&nb_cells,1,&total_nb_cells);
+  BOOST_CHECK_EQUAL(total_nb_cells, 128u);
+  BOOST_CHECK(nb_cells > 0u);
+
+  // The accumulated time restarts after every check
+  load_balance->execute();
+  BOOST_CHECK_EQUAL(load_balance->properties().value<Uint>("nb_repartitions"), 1u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( finalize_mpi )
+{
+  counter.reset();
+  PE::Comm::instance().finalize();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
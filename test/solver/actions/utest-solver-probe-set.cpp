@@ -0,0 +1,132 @@
+// Copyright (C) 2010-2013 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test module for cf3::solver::actions::ProbeSet in parallel"
+
+#include <boost/test/unit_test.hpp>
+
+#include "common/Core.hpp"
+#include "common/OptionList.hpp"
+#include "common/Table.hpp"
+
+#include "common/PE/Comm.hpp"
+
+#include "mesh/Dictionary.hpp"
+#include "mesh/Field.hpp"
+#include "mesh/Mesh.hpp"
+#include "mesh/MeshGenerator.hpp"
+
+#include "solver/actions/ProbeSet.hpp"
+
+using namespace cf3;
+using namespace cf3::common;
+using namespace cf3::mesh;
+using namespace cf3::solver::actions;
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct ProbeSetFixture
+{
+  ProbeSetFixture()
+  {
+    m_argc = boost::unit_test::framework::master_test_suite().argc;
+    m_argv = boost::unit_test::framework::master_test_suite().argv;
+  }
+
+  /// Linear field, interpolated exactly, scaled by the given factor
+  void set_field(Field& field, const Real factor)
+  {
+    const Field& coords = field.dict().coordinates();
+    for (Uint i=0; i<field.size(); ++i)
+      field[i][0] = factor * (1. + 2.*coords[i][XX] + 3.*coords[i][YY]);
+  }
+
+  int m_argc;
+  char** m_argv;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( ProbeSetSuite, ProbeSetFixture )
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( init_mpi )
+{
+  PE::Comm::instance().init(m_argc,m_argv);
+  BOOST_CHECK_EQUAL(PE::Comm::instance().size(), 2u);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( gather_every_step )
+{
+  // Rectangle of 8x4 quads, distributed in rows over the ranks
+  boost::shared_ptr<MeshGenerator> generator = build_component_abstract_type<MeshGenerator>("cf3.mesh.SimpleMeshGenerator","generator");
+  generator->options().set("mesh",URI("//rectangle"));
+  std::vector<Uint> nb_cells(2);
+  nb_cells[0] = 8;
+  nb_cells[1] = 4;
+  std::vector<Real> lengths(2);
+  lengths[0] = 2.;
+  lengths[1] = 1.;
+  generator->options().set("nb_cells",nb_cells);
+  generator->options().set("lengths",lengths);
+  Mesh& mesh = generator->generate();
+
+  Dictionary& dict = mesh.geometry_fields();
+  Field& field = dict.create_field("probed","p");
+
+  // Probes in the lower and upper half, on the interface between the ranks and outside the mesh
+  std::vector<Real> probe_coords;
+  probe_coords.push_back(0.3); probe_coords.push_back(0.2);
+  probe_coords.push_back(1.7); probe_coords.push_back(0.9);
+  probe_coords.push_back(1.1); probe_coords.push_back(0.5);
+  probe_coords.push_back(3.0); probe_coords.push_back(0.5);
+  Handle<ProbeSet> probes = Core::instance().root().create_component<ProbeSet>("probes");
+  probes->options().set("dict", dict.handle<Dictionary>());
+  probes->options().set("coordinates", probe_coords);
+
+  // The counts of the setup are reused at every execution, on all ranks
+  for (Uint step=1; step<=3; ++step)
+  {
+    set_field(field, static_cast<Real>(step));
+    probes->execute();
+
+    const Table<Real>& values = probes->values();
+    if (PE::Comm::instance().rank() == 0)
+    {
+      BOOST_REQUIRE_EQUAL(values.size(), 4u);
+      for (Uint p=0; p<3; ++p)
+      {
+        const Real x = probe_coords[2*p];
+        const Real y = probe_coords[2*p+1];
+        BOOST_CHECK_CLOSE(values[p][0], step * (1. + 2.*x + 3.*y), 1e-8);
+      }
+      BOOST_CHECK_EQUAL(values[3][0], 0.);
+    }
+    else
+    {
+      BOOST_CHECK_EQUAL(values.size(), 0u);
+    }
+  }
+
+  Core::instance().root().remove_component(*probes);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( finalize_mpi )
+{
+  PE::Comm::instance().finalize();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
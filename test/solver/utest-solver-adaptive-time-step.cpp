@@ -0,0 +1,220 @@
+// Copyright (C) 2010-2013 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test module for cf3::solver::AdaptiveTimeStep"
+
+#include <algorithm>
+#include <cmath>
+
+#include <boost/test/unit_test.hpp>
+
+#include "common/ActionDirector.hpp"
+#include "common/Core.hpp"
+#include "common/OptionList.hpp"
+#include "common/PropertyList.hpp"
+
+#include "mesh/Dictionary.hpp"
+#include "mesh/Field.hpp"
+#include "mesh/Mesh.hpp"
+
+#include "solver/Time.hpp"
+#include "solver/AdaptiveTimeStep.hpp"
+#include "solver/CriterionMilestoneTime.hpp"
+#include "solver/Tags.hpp"
+#include "solver/TimeStepping.hpp"
+
+#include "Tools/MeshGeneration/MeshGeneration.hpp"
+
+using namespace cf3;
+using namespace cf3::common;
+using namespace cf3::mesh;
+using namespace cf3::solver;
+
+////////////////////////////////////////////////////////////////////////////////
+
+/// Sets the field to exp(t) at the end time of the step, and advances the time
+class ExponentialGrowth : public common::Action
+{
+public:
+  ExponentialGrowth(const std::string& name) : common::Action(name)
+  {
+  }
+
+  static std::string type_name () { return "ExponentialGrowth"; }
+
+  void execute()
+  {
+    const Real end_time = time->options().value<Real>("end_time");
+    for(Uint i = 0; i != field->size(); ++i)
+      (*field)[i][0] = std::exp(end_time);
+    time->current_time() = end_time;
+  }
+
+  Handle<Field> field;
+  Handle<Time> time;
+};
+
+/// Field with value 1 on a small mesh
+Field& create_field(const std::string& mesh_name)
+{
+  Handle<Mesh> mesh = Core::instance().root().create_component<Mesh>(mesh_name);
+  Tools::MeshGeneration::create_rectangle(*mesh, 1., 1., 2, 2);
+  Field& field = mesh->geometry_fields().create_field("u");
+  for(Uint i = 0; i != field.size(); ++i)
+    field[i][0] = 1.;
+  return field;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( AdaptiveTimeStepSuite )
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( ControllerSteps )
+{
+  Field& u = create_field("controller_mesh");
+
+  Handle<AdaptiveTimeStep> controller = Core::instance().root().create_component<AdaptiveTimeStep>("controller");
+  controller->options().set("fields", std::vector<URI>(1, u.uri()));
+  controller->options().set("abs_tolerance", 0.);
+  controller->options().set("rel_tolerance", 1e-2);
+
+  // Small change: accepted, and the PI controller increases the time step, starting from a previous error of 1
+  controller->begin_step();
+  for(Uint i = 0; i != u.size(); ++i)
+    u[i][0] = 1.001;
+  Real time_step = 0.1;
+  BOOST_CHECK(controller->end_step(time_step));
+  const Real error = 0.001 / (1e-2*1.001);
+  BOOST_CHECK_CLOSE(controller->error(), error, 1e-10);
+  BOOST_CHECK_CLOSE(time_step, 0.1 * 0.9 * std::pow(error, -0.3/2.) * std::pow(1./error, 0.4/2.), 1e-10);
+
+  // Large change: rejected, the field is restored and the time step is reduced
+  controller->begin_step();
+  for(Uint i = 0; i != u.size(); ++i)
+    u[i][0] = 1.05;
+  time_step = 0.1;
+  BOOST_CHECK(!controller->end_step(time_step));
+  const Real rejected_error = 0.05 / (1e-2*1.05);
+  BOOST_CHECK_CLOSE(controller->error(), rejected_error, 1e-10);
+  BOOST_CHECK_CLOSE(time_step, 0.1 * 0.9 * std::pow(rejected_error, -0.5), 1e-10);
+  BOOST_CHECK_EQUAL(u[3][0], 1.001);
+  BOOST_CHECK_EQUAL(controller->properties().value<Uint>("nb_rejected_steps"), 1u);
+
+  // Right after a rejection, the time step is not increased
+  for(Uint i = 0; i != u.size(); ++i)
+    u[i][0] = 1.0011;
+  time_step = 0.1;
+  BOOST_CHECK(controller->end_step(time_step));
+  BOOST_CHECK_CLOSE(time_step, 0.1, 1e-10);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( MilestonesInActionDirector )
+{
+  Component& root = Core::instance().root();
+  Field& u = create_field("milestone_mesh");
+
+  Handle<Time> time = root.create_component<Time>("time");
+  Handle<TimeStepping> time_stepping = root.create_component<TimeStepping>("time_stepping");
+  time_stepping->add_time(time);
+
+  Handle<AdaptiveTimeStep> controller = time_stepping->create_component<AdaptiveTimeStep>("adaptive_time_step");
+  controller->options().set("fields", std::vector<URI>(1, u.uri()));
+  controller->options().set("abs_tolerance", 0.);
+  controller->options().set("rel_tolerance", 0.1);
+  time_stepping->options().set("time_step_controller", controller);
+
+  // The milestone criterion is not a direct child of the time stepping
+  Handle<ActionDirector> solve = time_stepping->create_component<ActionDirector>("solve");
+  Handle<ExponentialGrowth> growth = solve->create_component<ExponentialGrowth>("growth");
+  growth->field = u.handle<Field>();
+  growth->time = time;
+  Handle<CriterionMilestoneTime> milestone = solve->create_component<CriterionMilestoneTime>("milestone");
+  milestone->options().set(solver::Tags::time(), time);
+  milestone->options().set("interval", 0.3);
+
+  time_stepping->options().set("time_step", 0.01);
+  time_stepping->options().set("end_time", 1.);
+
+  std::vector<Real> times;
+  while(time_stepping->not_finished())
+  {
+    time_stepping->do_step();
+    times.push_back(time_stepping->options().value<Real>("time"));
+    BOOST_REQUIRE_LT(times.size(), 100u);
+  }
+
+  // Every milestone and the end time are hit exactly
+  for(Uint m = 1; m != 4; ++m)
+  {
+    Real closest = 1e10;
+    for(Uint i = 0; i != times.size(); ++i)
+      closest = std::min(closest, std::abs(times[i] - 0.3*m));
+    BOOST_CHECK_SMALL(closest, 1e-12);
+  }
+  BOOST_CHECK_EQUAL(times.back(), 1.);
+  BOOST_CHECK_CLOSE(u[0][0], std::exp(1.), 1e-10);
+
+  // The time step grew from its initial value
+  BOOST_CHECK_GT(time_stepping->options().value<Real>("time_step"), 0.01);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( MilestoneEveryStep )
+{
+  Component& root = Core::instance().root();
+  Field& u = create_field("every_step_mesh");
+
+  Handle<Time> time = root.create_component<Time>("every_step_time");
+  Handle<TimeStepping> time_stepping = root.create_component<TimeStepping>("every_step_time_stepping");
+  time_stepping->add_time(time);
+
+  Handle<AdaptiveTimeStep> controller = time_stepping->create_component<AdaptiveTimeStep>("adaptive_time_step");
+  controller->options().set("fields", std::vector<URI>(1, u.uri()));
+  controller->options().set("abs_tolerance", 0.);
+  controller->options().set("rel_tolerance", 0.1);
+  time_stepping->options().set("time_step_controller", controller);
+
+  Handle<ActionDirector> solve = time_stepping->create_component<ActionDirector>("solve");
+  Handle<ExponentialGrowth> growth = solve->create_component<ExponentialGrowth>("growth");
+  growth->field = u.handle<Field>();
+  growth->time = time;
+
+  // The default interval of 0 uses the time step, which is overwritten by the controller after every step
+  Handle<CriterionMilestoneTime> milestone = solve->create_component<CriterionMilestoneTime>("milestone");
+  milestone->options().set(solver::Tags::time(), time);
+  BOOST_CHECK_EQUAL(milestone->options().value<Real>("interval"), 0.);
+
+  time_stepping->options().set("time_step", 0.01);
+  time_stepping->options().set("end_time", 1.);
+
+  Uint nb_steps = 0;
+  Real max_time_step = 0.;
+  while(time_stepping->not_finished())
+  {
+    time_stepping->do_step();
+    max_time_step = std::max(max_time_step, time_stepping->options().value<Real>("time_step"));
+    ++nb_steps;
+    BOOST_REQUIRE_LT(nb_steps, 100u);
+  }
+
+  // Such a milestone does not bound the time step, which grows as without the milestone
+  BOOST_CHECK_EQUAL(time_stepping->options().value<Real>("time"), 1.);
+  BOOST_CHECK_GT(max_time_step, 0.02);
+  BOOST_CHECK_LT(nb_steps, 50u);
+  BOOST_CHECK_CLOSE(u[0][0], std::exp(1.), 1e-10);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
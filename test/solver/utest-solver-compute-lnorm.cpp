@@ -0,0 +1,196 @@
+// Copyright (C) 2010-2013 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test module for cf3::solver::ComputeLNorm"
+
+#include <cmath>
+
+#include <boost/test/unit_test.hpp>
+
+#include "common/Core.hpp"
+#include "common/Foreach.hpp"
+#include "common/OptionList.hpp"
+#include "common/PropertyList.hpp"
+
+#include "common/PE/Comm.hpp"
+
+#include "mesh/Connectivity.hpp"
+#include "mesh/Dictionary.hpp"
+#include "mesh/Field.hpp"
+#include "mesh/Mesh.hpp"
+#include "mesh/MeshGenerator.hpp"
+#include "mesh/Space.hpp"
+
+#include "solver/ComputeLNorm.hpp"
+
+using namespace cf3;
+using namespace cf3::common;
+using namespace cf3::mesh;
+using namespace cf3::solver;
+
+////////////////////////////////////////////////////////////////////////////////
+
+/// Line of 4 cells, with nodes at x = 0, 1, 2, 3, 4
+struct ComputeLNormFixture
+{
+  ComputeLNormFixture()
+  {
+    m_argc = boost::unit_test::framework::master_test_suite().argc;
+    m_argv = boost::unit_test::framework::master_test_suite().argv;
+  }
+
+  /// Norms of the given field, with the given order and scaling
+  std::vector<Real> norm(Field& field, const Uint order, const bool scale)
+  {
+    Handle<ComputeLNorm> lnorm = Core::instance().root().create_component<ComputeLNorm>("lnorm");
+    lnorm->options().set("order", order);
+    lnorm->options().set("scale", scale);
+    const std::vector<Real> result = lnorm->compute_norm(field);
+    Core::instance().root().remove_component("lnorm");
+    return result;
+  }
+
+  int m_argc;
+  char** m_argv;
+
+  static Handle<Mesh> mesh;
+};
+
+Handle<Mesh> ComputeLNormFixture::mesh;
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( ComputeLNormSuite, ComputeLNormFixture )
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( init_mpi )
+{
+  PE::Comm::instance().init(m_argc,m_argv);
+
+  boost::shared_ptr<MeshGenerator> generator = build_component_abstract_type<MeshGenerator>("cf3.mesh.SimpleMeshGenerator","generator");
+  generator->options().set("mesh",URI("//line"));
+  generator->options().set("lengths",std::vector<Real>(1,4.));
+  generator->options().set("nb_cells",std::vector<Uint>(1,4u));
+  mesh = generator->generate().handle<Mesh>();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( continuous_field )
+{
+  // u = x - 2 takes the values -2, -1, 0, 1, 2 and v = 1 in all 5 nodes
+  Dictionary& nodes = mesh->geometry_fields();
+  Field& solution = nodes.create_field("solution","u[s],v[s]");
+  for (Uint n=0; n<nodes.size(); ++n)
+  {
+    solution[n][0] = nodes.coordinates()[n][XX] - 2.;
+    solution[n][1] = 1.;
+  }
+
+  std::vector<Real> l1 = norm(solution, 1u, false);
+  BOOST_REQUIRE_EQUAL(l1.size(), 2u);
+  BOOST_CHECK_CLOSE(l1[0], 6., 1e-10);
+  BOOST_CHECK_CLOSE(l1[1], 5., 1e-10);
+
+  std::vector<Real> l2 = norm(solution, 2u, false);
+  BOOST_CHECK_CLOSE(l2[0], std::sqrt(10.), 1e-10);
+  BOOST_CHECK_CLOSE(l2[1], std::sqrt(5.), 1e-10);
+
+  std::vector<Real> linf = norm(solution, 0u, false);
+  BOOST_CHECK_CLOSE(linf[0], 2., 1e-10);
+  BOOST_CHECK_CLOSE(linf[1], 1., 1e-10);
+
+  std::vector<Real> l3 = norm(solution, 3u, false);
+  BOOST_CHECK_CLOSE(l3[0], std::pow(18., 1./3.), 1e-10);
+  BOOST_CHECK_CLOSE(l3[1], std::pow(5., 1./3.), 1e-10);
+
+  // The scaling divides by the number of entries, counted per element node: 4 cells of 2 nodes.
+  // The L-inf norm is never scaled
+  std::vector<Real> scaled_l2 = norm(solution, 2u, true);
+  BOOST_CHECK_CLOSE(scaled_l2[0], std::sqrt(10.)/8., 1e-10);
+  BOOST_CHECK_CLOSE(scaled_l2[1], std::sqrt(5.)/8., 1e-10);
+  std::vector<Real> scaled_linf = norm(solution, 0u, true);
+  BOOST_CHECK_CLOSE(scaled_linf[0], 2., 1e-10);
+
+  // The last computed norm is stored in the field
+  BOOST_CHECK_CLOSE(solution.properties().value< std::vector<Real> >("norm")[0], 2., 1e-10);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( discontinuous_field )
+{
+  // One value per cell: 1, 2, 3, 4. The boundary points are not volume elements, and are skipped
+  Dictionary& elems_P0 = mesh->create_discontinuous_space("elems_P0","cf3.mesh.LagrangeP0");
+  Field& cell_field = elems_P0.create_field("cell_field");
+  boost_foreach(const Handle<Space>& space, elems_P0.spaces())
+  {
+    const bool is_cell = space->support().element_type().dimension() == space->support().element_type().dimensionality();
+    for (Uint e=0; e<space->size(); ++e)
+      cell_field[space->connectivity()[e][0]][0] = is_cell ? static_cast<Real>(e+1) : 100.;
+  }
+
+  BOOST_CHECK_CLOSE(norm(cell_field, 1u, false)[0], 10., 1e-10);
+  BOOST_CHECK_CLOSE(norm(cell_field, 2u, false)[0], std::sqrt(30.), 1e-10);
+  BOOST_CHECK_CLOSE(norm(cell_field, 0u, false)[0], 4., 1e-10);
+  BOOST_CHECK_CLOSE(norm(cell_field, 1u, true)[0], 2.5, 1e-10);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( multiple_fields )
+{
+  // w = x takes the values 0, 1, 2, 3, 4
+  Dictionary& nodes = mesh->geometry_fields();
+  Field& solution = *Handle<Field>(nodes.get_child("solution"));
+  Field& w = nodes.create_field("w");
+  for (Uint n=0; n<nodes.size(); ++n)
+    w[n][0] = nodes.coordinates()[n][XX];
+
+  // Both fields are reduced together, the norm property of the action holds the norm of the first one
+  Handle<ComputeLNorm> lnorm = Core::instance().root().create_component<ComputeLNorm>("multiple_lnorm");
+  lnorm->options().set("order", 2u);
+  lnorm->options().set("scale", false);
+  lnorm->options().set("field", solution.handle<Field>());
+  lnorm->options().set("fields", std::vector<URI>(1, w.uri()));
+  lnorm->execute();
+
+  const std::vector<Real> solution_norm = lnorm->properties().value< std::vector<Real> >("norm");
+  BOOST_REQUIRE_EQUAL(solution_norm.size(), 2u);
+  BOOST_CHECK_CLOSE(solution_norm[0], std::sqrt(10.), 1e-10);
+  BOOST_CHECK_CLOSE(solution_norm[1], std::sqrt(5.), 1e-10);
+
+  const std::vector<Real> w_norm = w.properties().value< std::vector<Real> >("norm");
+  BOOST_REQUIRE_EQUAL(w_norm.size(), 1u);
+  BOOST_CHECK_CLOSE(w_norm[0], std::sqrt(30.), 1e-10);
+
+  // Same result through the vector interface, for the L1 norm
+  lnorm->options().set("order", 1u);
+  std::vector< Handle<Field> > fields;
+  fields.push_back(w.handle<Field>());
+  fields.push_back(solution.handle<Field>());
+  std::vector< std::vector<Real> > norms;
+  lnorm->compute_norms(fields, norms);
+  BOOST_REQUIRE_EQUAL(norms.size(), 2u);
+  BOOST_CHECK_CLOSE(norms[0][0], 10., 1e-10);
+  BOOST_CHECK_CLOSE(norms[1][0], 6., 1e-10);
+  BOOST_CHECK_CLOSE(norms[1][1], 5., 1e-10);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( finalize_mpi )
+{
+  PE::Comm::instance().finalize();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
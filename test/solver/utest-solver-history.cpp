@@ -0,0 +1,145 @@
+// Copyright (C) 2010-2013 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test module for cf3::solver::History"
+
+#include <fstream>
+#include <sstream>
+
+#include <boost/test/unit_test.hpp>
+
+#include "common/BoostFilesystem.hpp"
+#include "common/Core.hpp"
+#include "common/OptionList.hpp"
+#include "common/URI.hpp"
+
+#include "solver/History.hpp"
+
+using namespace cf3;
+using namespace cf3::common;
+using namespace cf3::solver;
+
+////////////////////////////////////////////////////////////////////////////////
+
+/// Read the lines of a text file
+std::vector<std::string> read_lines(const std::string& filename)
+{
+  std::ifstream file(filename.c_str());
+  std::vector<std::string> lines;
+  std::string line;
+  while (std::getline(file,line))
+    lines.push_back(line);
+  return lines;
+}
+
+/// Read the first 8 characters of a file
+std::string read_magic(const std::string& filename)
+{
+  std::ifstream file(filename.c_str(), std::ios_base::in | std::ios_base::binary);
+  char magic[8];
+  file.read(magic,8);
+  return file ? std::string(magic,8) : std::string();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( HistorySuite )
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Switching from tsv to binary with pending entries writes them in tsv to the old file
+BOOST_AUTO_TEST_CASE( SwitchTsvToBinary )
+{
+  Handle<History> history = Core::instance().root().create_component<History>("history_tsv_to_binary");
+  history->options().set("dimension",1u);
+  history->options().set("file",URI("history-switch-1.tsv"));
+
+  history->set("iter",1.);
+  history->save_entry(); // opens the file
+
+  history->options().set("flush_entries",10u);
+  history->set("iter",2.);
+  history->save_entry();
+  history->set("iter",3.);
+  history->save_entry();
+
+  history->options().set("format",std::string("binary"));
+  history->options().set("file",URI("history-switch-1.bin"));
+
+  history->set("iter",4.);
+  history->save_entry();
+  history->flush_file();
+
+  // header and 3 rows, all text
+  const std::vector<std::string> tsv_lines = read_lines("history-switch-1.tsv");
+  BOOST_CHECK_EQUAL(tsv_lines.size(), 4u);
+  BOOST_CHECK(tsv_lines[0].find("iter") != std::string::npos);
+  for (Uint i=0; i<tsv_lines.size(); ++i)
+    BOOST_CHECK(tsv_lines[i].find('R') == std::string::npos);
+
+  // the binary file contains all 4 rows
+  BOOST_CHECK_EQUAL(read_magic("history-switch-1.bin"), std::string("cf3hist1"));
+  History::convert_to_tsv(URI("history-switch-1.bin"),URI("history-switch-1-converted.tsv"));
+  const std::vector<std::string> converted_lines = read_lines("history-switch-1-converted.tsv");
+  BOOST_CHECK_EQUAL(converted_lines.size(), 5u);
+  std::stringstream last_row(converted_lines.back());
+  Real last_iter;
+  last_row >> last_iter;
+  BOOST_CHECK_EQUAL(last_iter, 4.);
+
+  Core::instance().root().remove_component(*history);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Switching from binary to tsv with pending entries writes them in binary to the old file
+BOOST_AUTO_TEST_CASE( SwitchBinaryToTsv )
+{
+  Handle<History> history = Core::instance().root().create_component<History>("history_binary_to_tsv");
+  history->options().set("dimension",1u);
+  history->options().set("format",std::string("binary"));
+  history->options().set("file",URI("history-switch-2.bin"));
+
+  history->set("iter",1.);
+  history->save_entry(); // opens the file
+
+  history->options().set("flush_entries",10u);
+  history->set("iter",2.);
+  history->save_entry();
+  history->set("iter",3.);
+  history->save_entry();
+
+  history->options().set("format",std::string("tsv"));
+  history->options().set("file",URI("history-switch-2.tsv"));
+
+  history->set("iter",4.);
+  history->save_entry();
+  history->flush_file();
+
+  // the binary file stays valid and contains the 3 first rows
+  BOOST_CHECK_EQUAL(read_magic("history-switch-2.bin"), std::string("cf3hist1"));
+  History::convert_to_tsv(URI("history-switch-2.bin"),URI("history-switch-2-converted.tsv"));
+  const std::vector<std::string> converted_lines = read_lines("history-switch-2-converted.tsv");
+  BOOST_CHECK_EQUAL(converted_lines.size(), 4u);
+  std::stringstream last_row(converted_lines.back());
+  Real last_iter;
+  last_row >> last_iter;
+  BOOST_CHECK_EQUAL(last_iter, 3.);
+
+  // the tsv file is plain text with all 4 rows
+  BOOST_CHECK(read_magic("history-switch-2.tsv") != std::string("cf3hist1"));
+  const std::vector<std::string> tsv_lines = read_lines("history-switch-2.tsv");
+  BOOST_CHECK_EQUAL(tsv_lines.size(), 5u);
+
+  Core::instance().root().remove_component(*history);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////
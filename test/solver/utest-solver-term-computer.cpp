@@ -0,0 +1,218 @@
+// Copyright (C) 2010-2013 von Karman Institute for Fluid Dynamics, Belgium
+//
+// This software is distributed under the terms of the
+// GNU Lesser General Public License version 3 (LGPLv3).
+// See doc/lgpl.txt and doc/gpl.txt for the license text.
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE "Test module for cf3::solver::TermComputer and TermComputerT"
+
+#include <boost/test/unit_test.hpp>
+
+#include "common/Core.hpp"
+#include "common/Foreach.hpp"
+
+#include "mesh/Dictionary.hpp"
+#include "mesh/ElementType.hpp"
+#include "mesh/Entities.hpp"
+#include "mesh/Mesh.hpp"
+
+#include "solver/TermComputerT.hpp"
+
+#include "Tools/MeshGeneration/MeshGeneration.hpp"
+
+using namespace cf3;
+using namespace cf3::common;
+using namespace cf3::mesh;
+using namespace cf3::solver;
+
+////////////////////////////////////////////////////////////////////////////////
+
+/// x-coordinate of the centroid of a cell
+Real centroid_x(const Entities& cells, const Uint elem_idx)
+{
+  const Connectivity::ConstRow nodes = cells.geometry_space().connectivity()[elem_idx];
+  Real x = 0.;
+  boost_foreach(const Uint node, nodes)
+    x += cells.geometry_fields().coordinates()[node][XX];
+  return x / static_cast<Real>(nodes.size());
+}
+
+/// Adds the x-coordinate of the centroid of every cell to its nodes for the first equation,
+/// and twice that value for the second. The wave speed is the centroid x-coordinate as well.
+class CentroidTerm : public TermComputerT<CentroidTerm>
+{
+public:
+  CentroidTerm(const std::string& name) : TermComputerT<CentroidTerm>(name) {}
+
+  static std::string type_name () { return "CentroidTerm"; }
+
+  virtual bool loop_cells(const Handle<Entities const>& cells)
+  {
+    // Skip the boundary points
+    if (cells->element_type().dimension() != cells->element_type().dimensionality())
+      return false;
+    m_cells = cells;
+    return true;
+  }
+
+  void compute_element(const Uint elem_idx, std::vector<RealVector>& term, std::vector<Real>& wave_speed)
+  {
+    const Real x = centroid_x(*m_cells, elem_idx);
+    for (Uint s=0; s<term.size(); ++s)
+    {
+      term[s][0] = x;
+      term[s][1] = 2.*x;
+      wave_speed[s] = x;
+    }
+  }
+
+private:
+  Handle<Entities const> m_cells;
+};
+
+/// Same term, using the per-element virtual interface of TermComputer
+class CentroidTermVirtual : public TermComputer
+{
+public:
+  CentroidTermVirtual(const std::string& name) : TermComputer(name) {}
+
+  static std::string type_name () { return "CentroidTermVirtual"; }
+
+  virtual bool loop_cells(const Handle<Entities const>& cells)
+  {
+    if (cells->element_type().dimension() != cells->element_type().dimensionality())
+      return false;
+    m_cells = cells;
+    return true;
+  }
+
+  virtual void compute_term(const Uint elem_idx, std::vector<RealVector>& term, std::vector<Real>& wave_speed)
+  {
+    const Uint nb_nodes = m_cells->element_type().nb_nodes();
+    term.resize(nb_nodes, RealVector(2));
+    wave_speed.resize(nb_nodes);
+    const Real x = centroid_x(*m_cells, elem_idx);
+    for (Uint s=0; s<nb_nodes; ++s)
+    {
+      term[s][0] = x;
+      term[s][1] = 2.*x;
+      wave_speed[s] = x;
+    }
+  }
+
+  using TermComputer::compute_term;
+
+private:
+  Handle<Entities const> m_cells;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+/// Line of 4 cells, with nodes at x = 0, 1, 2, 3, 4 and a term and wave speed field
+struct TermComputerFixture
+{
+  TermComputerFixture()
+  {
+    mesh = Core::instance().root().create_component<Mesh>("mesh");
+    Tools::MeshGeneration::create_line(*mesh, 4., 4);
+    term = mesh->geometry_fields().create_field("term", 2u).handle<Field>();
+    wave_speed = mesh->geometry_fields().create_field("wave_speed", 1u).handle<Field>();
+  }
+
+  ~TermComputerFixture()
+  {
+    Core::instance().root().remove_component("mesh");
+  }
+
+  Handle<Mesh> mesh;
+  Handle<Field> term;
+  Handle<Field> wave_speed;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE( TermComputerSuite, TermComputerFixture )
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( FieldTerm )
+{
+  boost::shared_ptr<CentroidTerm> computer = allocate_component<CentroidTerm>("computer");
+
+  // Values left from a previous computation are reset
+  *term = 100.;
+  *wave_speed = 100.;
+  computer->compute_term(*term, *wave_speed);
+
+  // Sum of the centroids of the cells around each node, and their maximum as wave speed
+  const Dictionary& nodes = mesh->geometry_fields();
+  for (Uint n=0; n<nodes.size(); ++n)
+  {
+    const Real x = nodes.coordinates()[n][XX];
+    const Real left = x > 0. ? x - 0.5 : 0.;
+    const Real right = x < 4. ? x + 0.5 : 0.;
+    BOOST_CHECK_CLOSE((*term)[n][0], left + right, 1e-10);
+    BOOST_CHECK_CLOSE((*term)[n][1], 2.*(left + right), 1e-10);
+    BOOST_CHECK_CLOSE((*wave_speed)[n][0], std::max(left, right), 1e-10);
+  }
+
+  // The per-element virtual interface gives the same result
+  boost::shared_ptr<CentroidTermVirtual> virtual_computer = allocate_component<CentroidTermVirtual>("virtual_computer");
+  Field& virtual_term = mesh->geometry_fields().create_field("virtual_term", 2u);
+  Field& virtual_wave_speed = mesh->geometry_fields().create_field("virtual_wave_speed", 1u);
+  virtual_computer->compute_term(virtual_term, virtual_wave_speed);
+  for (Uint n=0; n<nodes.size(); ++n)
+  {
+    BOOST_CHECK_EQUAL(virtual_term[n][0], (*term)[n][0]);
+    BOOST_CHECK_EQUAL(virtual_term[n][1], (*term)[n][1]);
+    BOOST_CHECK_EQUAL(virtual_wave_speed[n][0], (*wave_speed)[n][0]);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE( ElementRanges )
+{
+  boost::shared_ptr<CentroidTerm> computer = allocate_component<CentroidTerm>("computer");
+  const Dictionary& nodes = mesh->geometry_fields();
+
+  Handle<Entities const> cells;
+  boost_foreach(const Handle<Entities>& entities, nodes.entities_range())
+  {
+    if (computer->loop_cells(entities))
+      cells = entities;
+  }
+  BOOST_REQUIRE(is_not_null(cells));
+  const Space& space = nodes.space(*cells);
+  BOOST_REQUIRE_EQUAL(space.size(), 4u);
+
+  // A range only adds the term of its own elements, to each of their 2 nodes
+  *term = 0.;
+  *wave_speed = 0.;
+  computer->compute_term(space, 1, 3, *term, *wave_speed);
+  Real range_sum = 0.;
+  for (Uint n=0; n<nodes.size(); ++n)
+    range_sum += (*term)[n][0];
+  BOOST_CHECK_CLOSE(range_sum, 2.*(centroid_x(*cells,1) + centroid_x(*cells,2)), 1e-10);
+
+  // Adding the remaining ranges gives the result over all elements, the wave speed is only ever increased
+  computer->compute_term(space, 0, 1, *term, *wave_speed);
+  computer->compute_term(space, 3, 4, *term, *wave_speed);
+  boost::shared_ptr<CentroidTerm> full_computer = allocate_component<CentroidTerm>("full_computer");
+  Field& full_term = mesh->geometry_fields().create_field("full_term", 2u);
+  Field& full_wave_speed = mesh->geometry_fields().create_field("full_wave_speed", 1u);
+  full_computer->compute_term(full_term, full_wave_speed);
+  for (Uint n=0; n<nodes.size(); ++n)
+  {
+    BOOST_CHECK_CLOSE((*term)[n][0], full_term[n][0], 1e-10);
+    BOOST_CHECK_CLOSE((*term)[n][1], full_term[n][1], 1e-10);
+    BOOST_CHECK_EQUAL((*wave_speed)[n][0], full_wave_speed[n][0]);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END()
+
+////////////////////////////////////////////////////////////////////////////////